@@ -93,10 +93,12 @@ class Configuration:
             description="CCLD $descpath")
         self.writer.rule("cxxld", "$cxx $mflags $ldflags $lddirs -o $out $in $ldlibs",
             description="CXXLD $descpath")
-        self.writer.rule("dot", "python $in --unroll-min $unroll_min --unroll-max $unroll_max --simd $simd --implementation $implementation --header $header --unittest $unittest",
+        self.writer.rule("dot", "python $in --unroll-min $unroll_min --unroll-max $unroll_max --prefetch-distances $prefetch_distances --prefetch-hints $prefetch_hints --simd $simd --implementation $implementation --header $header --unittest $unittest",
             description="GEN $descpath") 
         self.writer.rule("gemm", "python $in --mr-min $mr_min --mr-max $mr_max --nr-min $nr_min --nr-max $nr_max --simd $simd --implementation $implementation --header $header --unittest $unittest",
             description="GEN $descpath") 
+        self.writer.rule("gemm-batch", "python $in --sizes $sizes --mr $mr --nr $nr --simd $simd --implementation $implementation --header $header --unittest $unittest",
+            description="GEN $descpath")
 
 
     @staticmethod
@@ -193,7 +195,7 @@ class Configuration:
             self.ldflags.append("-pthread")
 
 
-    def cc(self, source_file, object_file=None):
+    def cc(self, source_file, object_file=None, macros=[]):
         if not os.path.isabs(source_file):
             source_file = os.path.join(self.source_dir, source_file)
         if object_file is None:
@@ -203,8 +205,8 @@ class Configuration:
         }
         if self.include_dirs:
             variables["includes"] = " ".join(map(lambda include_dir: "-I" + include_dir, self.include_dirs))
-        if self.macros:
-            variables["cflags"] = "$cflags " + " ".join(map(lambda macro: "-D" + macro, self.macros))
+        if self.macros or macros:
+            variables["cflags"] = "$cflags " + " ".join(map(lambda macro: "-D" + macro, self.macros + macros))
         self.writer.build(object_file, "cc", source_file, variables=variables)
         return object_file
 
@@ -253,7 +255,7 @@ class Configuration:
         return executable_file
 
 
-    def dot(self, unroll_min, unroll_max, simd):
+    def dot(self, unroll_min, unroll_max, simd, prefetch_distances=[], prefetch_hints=["t0"]):
         implementation_file = os.path.join(self.source_dir, "dot", "dot-{simd}.c".format(simd=simd))
         header_file = os.path.join(self.source_dir, "dot", "dot.h")
         unittest_file = os.path.join(self.root_dir, "test", "dot.cpp")
@@ -262,6 +264,8 @@ class Configuration:
             "descpath": os.path.relpath(implementation_file, self.source_dir),
             "unroll_min": str(unroll_min),
             "unroll_max": str(unroll_max),
+            "prefetch_distances": ",".join(map(str, prefetch_distances)),
+            "prefetch_hints": ",".join(prefetch_hints),
             "simd": simd,
             "implementation": implementation_file,
             "header": header_file,
@@ -295,6 +299,27 @@ class Configuration:
         return implementation_file, header_file, unittest_file
 
 
+    def gemm_batch(self, sizes, mr, nr, simd):
+        implementation_file = os.path.join(self.source_dir, "ddgemm-batch", "ddgemm-batch-{simd}.c".format(simd=simd))
+        header_file = os.path.join(self.source_dir, "ddgemm-batch", "ddgemm-batch.h")
+        unittest_file = os.path.join(self.root_dir, "test", "ddgemm-batch.cpp")
+        script_file = os.path.join(self.source_dir, "ddgemm-batch", "ddgemm-batch.py")
+        variables = {
+            "descpath": os.path.relpath(implementation_file, self.source_dir),
+            "sizes": ",".join(map(str, sizes)),
+            "mr": str(mr),
+            "nr": str(nr),
+            "simd": simd,
+            "implementation": implementation_file,
+            "header": header_file,
+            "unittest": unittest_file
+        }
+        self.writer.build(
+            [implementation_file, header_file, unittest_file],
+            "gemm-batch", script_file, variables=variables)
+        return implementation_file, header_file, unittest_file
+
+
 parser = argparse.ArgumentParser(description="FP+ configuration script")
 parser.add_argument("--enable-fpaddre", dest="fpaddre", action="store_true", default=False,
     help="Emulate FPADDRE instruction")
@@ -336,6 +361,20 @@ def main():
     if sys.platform.startswith("linux"):
         config.ldlibs.append("rt")
 
+    # MPFR and GMP are used by the tests and by the accuracy benchmarks
+    has_mpfr = config.host == config.build or (options.mpfr is not None and options.gmp is not None)
+    mpfr_ldlibs, mpfr_ldobjs, mpfr_include_dirs = [], [], []
+    if options.mpfr:
+        mpfr_ldobjs.append(os.path.join(options.mpfr, "lib", "libmpfr.a"))
+        mpfr_include_dirs.append(os.path.join(options.mpfr, "include"))
+    else:
+        mpfr_ldlibs.append("mpfr")
+    if options.gmp:
+        mpfr_ldobjs.append(os.path.join(options.gmp, "lib", "libgmp.a"))
+        mpfr_include_dirs.append(os.path.join(options.gmp, "include"))
+    else:
+        mpfr_ldlibs.append("gmp")
+
     # Build benchmarks
     simd = "avx"
     simd_width = 4
@@ -344,27 +383,115 @@ def main():
         simd_width = 8
 
     utils_object = config.cc("utils.c")
-
-    dot_source, dot_header, dot_test_source = config.dot(1, 8, simd)
+    # Build flags are recorded in the metadata of machine-readable benchmark reports
+    build_flags = " ".join(config.mflags + config.cflags + ["-D" + macro for macro in config.macros])
+    report_object = config.cc("report.c", macros=["FPPLUS_BUILD_FLAGS='\"{flags}\"'".format(flags=build_flags)])
+
+    # Kernels are compiled a second time with emulated ADDRE, and with addre_ prefix in symbol names,
+    # so that ubench and dot-bench can compare both versions in a single binary (--addre option)
+    def addre_cc(source_file):
+        source_path, source_ext = os.path.splitext(os.path.join(config.source_dir, source_file))
+        object_file = os.path.join(config.build_dir,
+            os.path.relpath(source_path, config.source_dir) + "-addre" + source_ext + config.object_ext)
+        return config.cc(source_file, object_file, macros=["FPPLUS_BENCHMARK_ADDRE", "FPPLUS_EMULATE_FPADDRE"])
+
+    # Prefetch distances, in bytes, for the dot-bench --prefetch sweep
+    dot_source, dot_header, dot_test_source = config.dot(1, 8, simd,
+        prefetch_distances=[256, 512, 1024, 2048], prefetch_hints=["t0", "nta"])
     dot_object = config.cc(dot_source)
+    dot_addre_object = addre_cc(dot_source)
     dot_sources = ["dot.c", "dot/dot.c"]
     config.ccld([
         config.cc("dot/benchmark.c"),
         config.cc("dot/options.c"),
-        dot_object, utils_object], "dot-bench")
+        config.cc("dot/threads.c"),
+        dot_object, dot_addre_object, utils_object, report_object], "dot-bench")
+
+    if has_mpfr:
+        config.include_dirs += mpfr_include_dirs
+        config.ccld([
+            config.cc("dot-pareto/benchmark.c"),
+            config.cc("dot-pareto/options.c"),
+            config.cc("dot-pareto/gendot.c"),
+            dot_object, utils_object, report_object] + mpfr_ldobjs, "dot-pareto", ldlibs=mpfr_ldlibs)
 
     gemm_source, gemm_header, gemm_test_source = config.gemm(simd_width, simd_width * 3, 1, 8, simd)
     gemm_object = config.cc(gemm_source)
+    gemm_pack_object = config.cc("ddgemm/pack.c")
+    arena_object = config.cc("arena.c")
     config.ccld([
         config.cc("ddgemm/benchmark.c"),
         config.cc("ddgemm/options.c"),
-        gemm_object, utils_object], "ddgemm-bench")
+        arena_object,
+        gemm_pack_object,
+        gemm_object, utils_object, report_object], "ddgemm-bench")
+
+    gemm_batch_source, gemm_batch_header, gemm_batch_test_source = config.gemm_batch([4, 8, 12, 16, 24, 32], 2, 2, simd)
+    gemm_batch_object = config.cc(gemm_batch_source)
+    gemm_batch_pack_object = config.cc("ddgemm-batch/pack.c")
+    config.ccld([
+        config.cc("ddgemm-batch/benchmark.c"),
+        config.cc("ddgemm-batch/options.c"),
+        gemm_batch_object, gemm_batch_pack_object,
+        gemm_object, gemm_pack_object, utils_object, report_object], "ddgemm-batch-bench")
+
+    fft_object = config.cc("fft/fft.c")
+    config.ccld([
+        config.cc("fft/benchmark.c"),
+        config.cc("fft/options.c"),
+        fft_object, utils_object, report_object], "fft-bench")
 
+    factor_object = config.cc("factor/factor.c")
+    refine_object = config.cc("refine/solve.c")
+    config.ccld([
+        config.cc("refine/benchmark.c"),
+        config.cc("refine/options.c"),
+        refine_object,
+        factor_object, gemm_object, gemm_pack_object, utils_object, report_object], "refine-bench")
+
+    config.ccld([
+        config.cc("factor/benchmark.c"),
+        config.cc("factor/options.c"),
+        arena_object,
+        factor_object, gemm_object, gemm_pack_object, utils_object, report_object], "factor-bench")
+
+    spmv_objects = [config.cc("spmv/spmv.c"), config.cc("spmv/matrix-market.c")]
+    config.ccld([
+        config.cc("spmv/benchmark.c"),
+        config.cc("spmv/options.c")] +
+        spmv_objects + [utils_object, report_object], "spmv-bench")
+
+    decimal_object = config.cc("decimal/decimal.c")
+    if has_mpfr:
+        config.ccld([
+            config.cc("decimal/benchmark.c"),
+            config.cc("decimal/options.c"),
+            decimal_object, utils_object, report_object] + mpfr_ldobjs, "decimal-bench", ldlibs=mpfr_ldlibs)
+
+    ddfile_object = config.cc("ddfile/ddfile.c")
+    config.ccld([
+        config.cc("ddfile/benchmark.c"),
+        config.cc("ddfile/options.c"),
+        ddfile_object, dot_object, utils_object, report_object], "ddfile-bench")
+
+    if options.uarch != "knc":
+        config.ccld([
+            config.cc("ddexpr/benchmark.c"),
+            config.cc("ddexpr/options.c"),
+            config.cxx("ddexpr/axpbz.cpp"),
+            utils_object, report_object], "ddexpr-bench")
+
+    ubench_kernels = [
+        "low-level/doubledouble.c", "low-level/polevl.c", "low-level/eft.c", "low-level/simd.c",
+        "low-level/layout.c", "low-level/complex.c", "low-level/interval.c"]
     ubench_objects = [
         config.cc("low-level/benchmark.c"),
         config.cc("low-level/options.c"),
-        config.cc("low-level/doubledouble.c"),
-        config.cc("low-level/polevl.c")]
+        utils_object, report_object]
+    ubench_objects += [config.cc(kernel) for kernel in ubench_kernels]
+    ubench_objects += [addre_cc(kernel) for kernel in ubench_kernels]
+    if options.uarch != "knc":
+        ubench_objects.append(config.cxx("low-level/doubledouble.cpp"))
     if options.quad:
         ubench_objects.append(config.cc("low-level/quad.c"))
     config.ccld(ubench_objects, "ubench")
@@ -378,28 +505,46 @@ def main():
         os.path.join(gtest_dir, "include")
     ]
 
-    if config.host != config.build and (options.mpfr is None or options.gmp is None):
-        print("Warning: cannot cross-compile tests without explicitly specified paths to MPFR and GMP, see --with-mpfr and --with-gmp options")
+    if not has_mpfr:
+        print("Warning: cannot cross-compile tests and accuracy benchmarks without explicitly specified paths to MPFR and GMP, see --with-mpfr and --with-gmp options")
     elif not options.fpaddre:
-        test_ldlibs, test_ldobjs = [], []
-        if options.mpfr:
-            test_ldobjs.append(os.path.join(options.mpfr, "lib", "libmpfr.a"))
-            config.include_dirs.append(os.path.join(options.mpfr, "include"))
-        else:
-            test_ldlibs.append("mpfr")
-        if options.gmp:
-            test_ldobjs.append(os.path.join(options.gmp, "lib", "libgmp.a"))
-            config.include_dirs.append(os.path.join(options.gmp, "include"))
-        else:
-            test_ldlibs.append("gmp")
+        test_ldlibs, test_ldobjs = mpfr_ldlibs, mpfr_ldobjs
+        config.include_dirs += mpfr_include_dirs
         config.cxxld([config.cxx("error-free-transform.cpp"), gtest_object] + test_ldobjs,
             "eft-test", ldlibs=test_ldlibs)
         config.cxxld([config.cxx("double-double.cpp"), gtest_object] + test_ldobjs,
             "dd-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("float-float.cpp"), gtest_object] + test_ldobjs,
+            "ff-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("double-double-class.cpp"), gtest_object] + test_ldobjs,
+            "dd-class-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("ddcomplex.cpp"), gtest_object] + test_ldobjs,
+            "ddcomplex-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("interval.cpp"), gtest_object] + test_ldobjs,
+            "interval-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("layout.cpp"), gtest_object] + test_ldobjs,
+            "layout-test", ldlibs=test_ldlibs)
+        if options.uarch != "knc":
+            config.cxxld([config.cxx("ddexpr.cpp"), gtest_object] + test_ldobjs,
+                "ddexpr-test", ldlibs=test_ldlibs)
         config.cxxld([config.cxx("dot.cpp"), dot_object, gtest_object] + test_ldobjs,
             "dot-test", ldlibs=test_ldlibs)
-        config.cxxld([config.cxx("ddgemm.cpp"), gemm_object, gtest_object] + test_ldobjs,
+        config.cxxld([config.cxx("ddgemm.cpp"), gemm_object, gemm_pack_object, gtest_object] + test_ldobjs,
             "ddgemm-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("ddgemm-batch.cpp"), gemm_batch_object, gemm_batch_pack_object, gtest_object] + test_ldobjs,
+            "ddgemm-batch-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("fft.cpp"), fft_object, gtest_object] + test_ldobjs,
+            "fft-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("refine.cpp"), refine_object, gtest_object] + test_ldobjs,
+            "refine-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("factor.cpp"), factor_object, gemm_object, gemm_pack_object, gtest_object] + test_ldobjs,
+            "factor-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("spmv.cpp")] + spmv_objects + [gtest_object] + test_ldobjs,
+            "spmv-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("decimal.cpp"), decimal_object, gtest_object] + test_ldobjs,
+            "decimal-test", ldlibs=test_ldlibs)
+        config.cxxld([config.cxx("ddfile.cpp"), ddfile_object, gtest_object] + test_ldobjs,
+            "ddfile-test", ldlibs=test_ldlibs)
 
 
 if __name__ == "__main__":
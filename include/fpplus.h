@@ -5,5 +5,9 @@
 #include <fpplus/common.h>
 #include <fpplus/eft.h>
 #include <fpplus/dd.h>
+#include <fpplus/layout.h>
+#include <fpplus/ff.h>
+#include <fpplus/ddcomplex.h>
+#include <fpplus/interval.h>
 
 #endif /* FPPLUS_H */
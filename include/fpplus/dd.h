@@ -209,6 +209,134 @@ FPPLUS_STATIC_INLINE doubledouble ddmul(const doubledouble a, const doubledouble
 	return product;
 }
 
+/**
+ * @ingroup DD
+ * @brief Wide multiplication of double-double number by a double-precision number.
+ * @details Multiplies double-double number by a double-precision number and produces a double-double result.
+ *
+ * Implementation follows @cite QD2000, multiplication of double-double by double.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>FP ADD</td><td>3</td></tr>
+ *         <tr><td>FP MUL</td><td>1</td></tr>
+ *         <tr><td>FP FMA</td><td>2</td></tr>
+ *     </table>
+ *
+ * @param[in] a - multiplicand, the double-double number to be multiplied.
+ * @param[in] b - multiplier, the double-precision number to multipliy by.
+ * @return The product of @b a and @b b as a double-double number.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddmulw(const doubledouble a, const double b) {
+	doubledouble product = ddmull(a.hi, b);
+#if defined(__CUDA_ARCH__)
+	product.lo = __fma_rn(a.lo, b, product.lo);
+#elif defined(__GNUC__)
+	product.lo = __builtin_fma(a.lo, b, product.lo);
+#else
+	product.lo = fma(a.lo, b, product.lo);
+#endif
+	product.hi = efaddord(product.hi, product.lo, &product.lo);
+	return product;
+}
+
+/**
+ * @ingroup DD
+ * @brief Division of double-double numbers.
+ * @details Divides two double-double numbers and produces double-double result.
+ * The quotient is computed as a double-precision approximation, refined with one correction step
+ * based on the double-double remainder.
+ *
+ * Implementation follows @cite QD2000, sloppy division of double-double numbers.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>FP ADD</td><td>26</td></tr>
+ *         <tr><td>FP MUL</td><td>1</td></tr>
+ *         <tr><td>FP FMA</td><td>2</td></tr>
+ *         <tr><td>FP DIV</td><td>2</td></tr>
+ *     </table>
+ *
+ * @param[in] a - dividend, the double-double number to be divided.
+ * @param[in] b - divisor, the double-double number to divide by.
+ * @return The quotient of @b a and @b b as a double-double number.
+ */
+FPPLUS_STATIC_INLINE doubledouble dddiv(const doubledouble a, const doubledouble b) {
+	doubledouble quotient;
+#ifdef __CUDA_ARCH__
+	quotient.hi = __ddiv_rn(a.hi, b.hi);
+#else
+	quotient.hi = a.hi / b.hi;
+#endif
+
+	/* Remainder a - quotient.hi * b */
+	doubledouble product = ddmulw(b, quotient.hi);
+	product.hi = -product.hi;
+	product.lo = -product.lo;
+	const doubledouble remainder = ddadd(a, product);
+
+#ifdef __CUDA_ARCH__
+	quotient.lo = __ddiv_rn(remainder.hi, b.hi);
+#else
+	quotient.lo = remainder.hi / b.hi;
+#endif
+	quotient.hi = efaddord(quotient.hi, quotient.lo, &quotient.lo);
+	return quotient;
+}
+
+/**
+ * @ingroup DD
+ * @brief Square root of a double-double number.
+ * @details Computes the square root of a double-double number and produces double-double result.
+ * The root is computed as a double-precision approximation, refined with one Newton-Raphson step
+ * based on the double-double remainder.
+ * Zero, negative, infinite, and NaN inputs produce the double-precision square root of the high part with zero low part.
+ *
+ * Implementation follows @cite QD2000, square root of double-double number.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>FP ADD </td><td>23</td></tr>
+ *         <tr><td>FP MUL </td><td>2</td></tr>
+ *         <tr><td>FP FMA </td><td>1</td></tr>
+ *         <tr><td>FP DIV </td><td>1</td></tr>
+ *         <tr><td>FP SQRT</td><td>1</td></tr>
+ *     </table>
+ *
+ * @param[in] a - radicand, the double-double number to take the square root of.
+ * @return The square root of @b a as a double-double number.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddsqrt(const doubledouble a) {
+	doubledouble root;
+#if defined(__CUDA_ARCH__)
+	root.hi = __dsqrt_rn(a.hi);
+#elif defined(__GNUC__)
+	root.hi = __builtin_sqrt(a.hi);
+#else
+	root.hi = sqrt(a.hi);
+#endif
+	root.lo = 0.0;
+	/* a.hi - a.hi is zero for finite a.hi, and NaN for infinite a.hi */
+	if (a.hi > 0.0 && a.hi - a.hi == 0.0) {
+		/* Remainder a - root.hi * root.hi */
+		doubledouble square = ddmull(root.hi, root.hi);
+		square.hi = -square.hi;
+		square.lo = -square.lo;
+		const doubledouble remainder = ddadd(a, square);
+
+#ifdef __CUDA_ARCH__
+		root.lo = __ddiv_rn(remainder.hi, 2.0 * root.hi);
+#else
+		root.lo = remainder.hi / (2.0 * root.hi);
+#endif
+		root.hi = efaddord(root.hi, root.lo, &root.lo);
+	}
+	return root;
+}
+
 #if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
 
 typedef struct {
@@ -407,8 +535,8 @@ FPPLUS_STATIC_INLINE void _mm256_interleavestore_pdd(
 	doubledouble FPPLUS_ARRAY_POINTER(pointer, 4),
 	__m256dd numbers)
 {
-	const __m256d numbers02 = _mm256_unpacklo_pd(numbers.lo, numbers.hi);
-	const __m256d numbers13 = _mm256_unpackhi_pd(numbers.lo, numbers.hi);
+	const __m256d numbers02 = _mm256_unpacklo_pd(numbers.hi, numbers.lo);
+	const __m256d numbers13 = _mm256_unpackhi_pd(numbers.hi, numbers.lo);
 	const __m256d numbers21 = _mm256_permute2f128_pd(numbers02, numbers13, 0x21);
 	const __m256d numbers01 = _mm256_blend_pd(numbers02, numbers21, 0xC);
 	const __m256d numbers23 = _mm256_blend_pd(numbers13, numbers21, 0x3);
@@ -420,8 +548,8 @@ FPPLUS_STATIC_INLINE void _mm256_interleavestoreu_pdd(
 	doubledouble FPPLUS_ARRAY_POINTER(pointer, 4),
 	__m256dd numbers)
 {
-	const __m256d numbers02 = _mm256_unpacklo_pd(numbers.lo, numbers.hi);
-	const __m256d numbers13 = _mm256_unpackhi_pd(numbers.lo, numbers.hi);
+	const __m256d numbers02 = _mm256_unpacklo_pd(numbers.hi, numbers.lo);
+	const __m256d numbers13 = _mm256_unpackhi_pd(numbers.hi, numbers.lo);
 	const __m256d numbers21 = _mm256_permute2f128_pd(numbers02, numbers13, 0x21);
 	const __m256d numbers01 = _mm256_blend_pd(numbers02, numbers21, 0xC);
 	const __m256d numbers23 = _mm256_blend_pd(numbers13, numbers21, 0x3);
@@ -479,6 +607,52 @@ FPPLUS_STATIC_INLINE __m256dd _mm256_mul_pdd(const __m256dd a, const __m256dd b)
 	return product;
 }
 
+FPPLUS_STATIC_INLINE __m256dd _mm256_mulw_pdd(const __m256dd a, const __m256d b) {
+	__m256dd product = _mm256_mull_pd(a.hi, b);
+#if defined(__FMA__) || defined(__AVX2__)
+	product.lo = _mm256_fmadd_pd(a.lo, b, product.lo);
+#else
+	product.lo = _mm256_macc_pd(a.lo, b, product.lo);
+#endif
+	product.hi = _mm256_efaddord_pd(product.hi, product.lo, &product.lo);
+	return product;
+}
+
+FPPLUS_STATIC_INLINE __m256dd _mm256_div_pdd(const __m256dd a, const __m256dd b) {
+	__m256dd quotient;
+	quotient.hi = _mm256_div_pd(a.hi, b.hi);
+
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256dd product = _mm256_mulw_pdd(b, quotient.hi);
+	const __m256dd minus_product = { _mm256_xor_pd(product.hi, sign), _mm256_xor_pd(product.lo, sign) };
+	const __m256dd remainder = _mm256_add_pdd(a, minus_product);
+
+	quotient.lo = _mm256_div_pd(remainder.hi, b.hi);
+	quotient.hi = _mm256_efaddord_pd(quotient.hi, quotient.lo, &quotient.lo);
+	return quotient;
+}
+
+FPPLUS_STATIC_INLINE __m256dd _mm256_sqrt_pdd(const __m256dd a) {
+	__m256dd root;
+	root.hi = _mm256_sqrt_pd(a.hi);
+
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256dd square = _mm256_mull_pd(root.hi, root.hi);
+	const __m256dd minus_square = { _mm256_xor_pd(square.hi, sign), _mm256_xor_pd(square.lo, sign) };
+	const __m256dd remainder = _mm256_add_pdd(a, minus_square);
+	__m256dd refined;
+	refined.lo = _mm256_div_pd(remainder.hi, _mm256_add_pd(root.hi, root.hi));
+	refined.hi = _mm256_efaddord_pd(root.hi, refined.lo, &refined.lo);
+
+	/* Refine only positive finite inputs, as in ddsqrt */
+	const __m256d refine_mask = _mm256_and_pd(
+		_mm256_cmp_pd(a.hi, _mm256_setzero_pd(), _CMP_GT_OQ),
+		_mm256_cmp_pd(_mm256_sub_pd(a.hi, a.hi), _mm256_setzero_pd(), _CMP_EQ_OQ));
+	root.hi = _mm256_blendv_pd(root.hi, refined.hi, refine_mask);
+	root.lo = _mm256_and_pd(refined.lo, refine_mask);
+	return root;
+}
+
 FPPLUS_STATIC_INLINE doubledouble _mm256_reduce_add_pdd(const __m256dd x) {
 	const __m128dd x01 = {
 		_mm256_castpd256_pd128(x.hi),
@@ -0,0 +1,271 @@
+#pragma once
+#ifndef FPPLUS_DD_HPP
+#define FPPLUS_DD_HPP
+
+#include <limits>
+#include <type_traits>
+
+#include <fpplus.h>
+
+namespace fpplus {
+
+/**
+ * @ingroup DD
+ * @brief Double-double number with C++ arithmetic and comparison operators.
+ * @details The class has the same layout as @b doubledouble and converts to and from it implicitly.
+ * Operators are inline calls to the functions of the C API, so loops over @b dd compile to the same code as
+ * loops which call @b ddadd, @b ddmul, and other functions directly.
+ * Operations with double-precision operands map to the wide functions, e.g. @b ddaddw and @b ddmulw.
+ */
+class dd {
+public:
+	/**
+	 * @brief Creates an uninitialized double-double number, like default-initialized double.
+	 */
+	dd() = default;
+
+	/**
+	 * @brief Creates a double-double number with the value of a double-precision number.
+	 */
+	constexpr dd(double x) : hi(x), lo(0.0) {}
+
+	/**
+	 * @brief Creates a double-double number from the high and low parts.
+	 * @note The parts must be normalized: @b hi must be the double-precision rounding of @b hi + @b lo.
+	 */
+	constexpr dd(double hi, double lo) : hi(hi), lo(lo) {}
+
+	/**
+	 * @brief Creates a double-double number from the C representation.
+	 */
+	constexpr dd(doubledouble x) : hi(x.hi), lo(x.lo) {}
+
+	/**
+	 * @brief Converts the number to the C representation, e.g. to pass it to the functions of the C API.
+	 */
+	operator doubledouble() const {
+		doubledouble x;
+		x.hi = hi;
+		x.lo = lo;
+		return x;
+	}
+
+	/**
+	 * @brief Rounds the number to double precision.
+	 */
+	constexpr explicit operator double() const {
+		return hi;
+	}
+
+	inline dd& operator+=(dd b);
+	inline dd& operator+=(double b);
+	inline dd& operator-=(dd b);
+	inline dd& operator-=(double b);
+	inline dd& operator*=(dd b);
+	inline dd& operator*=(double b);
+	inline dd& operator/=(dd b);
+	inline dd& operator/=(double b);
+
+	/**
+	 * @brief The high (largest in magnitude) part of the number.
+	 */
+	double hi;
+	/**
+	 * @brief The low (smallest in magnitude) part of the number.
+	 */
+	double lo;
+};
+
+static_assert(sizeof(dd) == sizeof(doubledouble), "fpplus::dd must have the same layout as doubledouble");
+static_assert(std::is_standard_layout<dd>::value, "fpplus::dd must have the same layout as doubledouble");
+
+inline constexpr dd operator+(dd a) {
+	return a;
+}
+
+inline constexpr dd operator-(dd a) {
+	return dd(-a.hi, -a.lo);
+}
+
+inline dd operator+(dd a, dd b) {
+	return ddadd(a, b);
+}
+
+inline dd operator+(dd a, double b) {
+	return ddaddw(a, b);
+}
+
+inline dd operator+(double a, dd b) {
+	return ddaddw(b, a);
+}
+
+inline dd operator-(dd a, dd b) {
+	return ddadd(a, -b);
+}
+
+inline dd operator-(dd a, double b) {
+	return ddaddw(a, -b);
+}
+
+inline dd operator-(double a, dd b) {
+	return ddaddw(-b, a);
+}
+
+inline dd operator*(dd a, dd b) {
+	return ddmul(a, b);
+}
+
+inline dd operator*(dd a, double b) {
+	return ddmulw(a, b);
+}
+
+inline dd operator*(double a, dd b) {
+	return ddmulw(b, a);
+}
+
+inline dd operator/(dd a, dd b) {
+	return dddiv(a, b);
+}
+
+inline dd operator/(dd a, double b) {
+	return dddiv(a, dd(b));
+}
+
+inline dd operator/(double a, dd b) {
+	return dddiv(dd(a), b);
+}
+
+inline dd& dd::operator+=(dd b) {
+	return *this = *this + b;
+}
+
+inline dd& dd::operator+=(double b) {
+	return *this = *this + b;
+}
+
+inline dd& dd::operator-=(dd b) {
+	return *this = *this - b;
+}
+
+inline dd& dd::operator-=(double b) {
+	return *this = *this - b;
+}
+
+inline dd& dd::operator*=(dd b) {
+	return *this = *this * b;
+}
+
+inline dd& dd::operator*=(double b) {
+	return *this = *this * b;
+}
+
+inline dd& dd::operator/=(dd b) {
+	return *this = *this / b;
+}
+
+inline dd& dd::operator/=(double b) {
+	return *this = *this / b;
+}
+
+/* Comparisons assume normalized numbers: then the low parts matter only if the high parts are equal */
+
+inline constexpr bool operator==(dd a, dd b) {
+	return a.hi == b.hi && a.lo == b.lo;
+}
+
+inline constexpr bool operator!=(dd a, dd b) {
+	return !(a == b);
+}
+
+inline constexpr bool operator<(dd a, dd b) {
+	return a.hi < b.hi || (a.hi == b.hi && a.lo < b.lo);
+}
+
+inline constexpr bool operator>(dd a, dd b) {
+	return b < a;
+}
+
+inline constexpr bool operator<=(dd a, dd b) {
+	return a.hi < b.hi || (a.hi == b.hi && a.lo <= b.lo);
+}
+
+inline constexpr bool operator>=(dd a, dd b) {
+	return b <= a;
+}
+
+} /* namespace fpplus */
+
+namespace std {
+
+/*
+ * Follows the conventions of QD library: precision is 2 * 53 - 1 bits, and the smallest normalized number
+ * is the smallest double-precision number whose low part can be normalized (DBL_MIN * 2**53).
+ */
+template<>
+class numeric_limits<fpplus::dd> {
+public:
+	static constexpr bool is_specialized = true;
+	static constexpr bool is_signed = true;
+	static constexpr bool is_integer = false;
+	static constexpr bool is_exact = false;
+	static constexpr bool has_infinity = numeric_limits<double>::has_infinity;
+	static constexpr bool has_quiet_NaN = numeric_limits<double>::has_quiet_NaN;
+	static constexpr bool has_signaling_NaN = numeric_limits<double>::has_signaling_NaN;
+	static constexpr float_denorm_style has_denorm = denorm_absent;
+	static constexpr bool has_denorm_loss = false;
+	static constexpr float_round_style round_style = round_to_nearest;
+	static constexpr bool is_iec559 = false;
+	static constexpr bool is_bounded = true;
+	static constexpr bool is_modulo = false;
+	static constexpr int digits = 2 * numeric_limits<double>::digits - 1;
+	static constexpr int digits10 = 31;
+	static constexpr int max_digits10 = 33;
+	static constexpr int radix = 2;
+	static constexpr int min_exponent = numeric_limits<double>::min_exponent + numeric_limits<double>::digits;
+	static constexpr int min_exponent10 = -291;
+	static constexpr int max_exponent = numeric_limits<double>::max_exponent;
+	static constexpr int max_exponent10 = numeric_limits<double>::max_exponent10;
+	static constexpr bool traps = false;
+	static constexpr bool tinyness_before = false;
+
+	static constexpr fpplus::dd min() noexcept {
+		return fpplus::dd(numeric_limits<double>::min() / numeric_limits<double>::epsilon() * 2.0);
+	}
+
+	static constexpr fpplus::dd max() noexcept {
+		return fpplus::dd(numeric_limits<double>::max(),
+			numeric_limits<double>::max() * (numeric_limits<double>::epsilon() * 0.25));
+	}
+
+	static constexpr fpplus::dd lowest() noexcept {
+		return -max();
+	}
+
+	static constexpr fpplus::dd epsilon() noexcept {
+		return fpplus::dd(numeric_limits<double>::epsilon() * numeric_limits<double>::epsilon());
+	}
+
+	static constexpr fpplus::dd round_error() noexcept {
+		return fpplus::dd(0.5);
+	}
+
+	static constexpr fpplus::dd infinity() noexcept {
+		return fpplus::dd(numeric_limits<double>::infinity());
+	}
+
+	static constexpr fpplus::dd quiet_NaN() noexcept {
+		return fpplus::dd(numeric_limits<double>::quiet_NaN(), numeric_limits<double>::quiet_NaN());
+	}
+
+	static constexpr fpplus::dd signaling_NaN() noexcept {
+		return fpplus::dd(numeric_limits<double>::signaling_NaN(), numeric_limits<double>::signaling_NaN());
+	}
+
+	static constexpr fpplus::dd denorm_min() noexcept {
+		return min();
+	}
+};
+
+} /* namespace std */
+
+#endif /* FPPLUS_DD_HPP */
@@ -0,0 +1,331 @@
+#pragma once
+#ifndef FPPLUS_DDCOMPLEX_H
+#define FPPLUS_DDCOMPLEX_H
+
+#include <fpplus/dd.h>
+
+/**
+ * @defgroup DDCOMPLEX Complex double-double arithmetic
+ */
+
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Complex number with double-double real and imaginary parts.
+ */
+typedef struct {
+	/**
+	 * @brief The real part of the number.
+	 */
+	doubledouble re;
+	/**
+	 * @brief The imaginary part of the number.
+	 */
+	doubledouble im;
+} ddcomplex;
+
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Negation of a double-double number.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddneg(const doubledouble a) {
+	doubledouble negation;
+	negation.hi = -a.hi;
+	negation.lo = -a.lo;
+	return negation;
+}
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Addition of complex double-double numbers.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD ADD</td><td>2</td></tr>
+ *     </table>
+ *
+ * @param[in] a - addend, the first complex number to be added.
+ * @param[in] b - augend, the second complex number to be added.
+ * @return The sum of @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddcomplex ddcadd(const ddcomplex a, const ddcomplex b) {
+	ddcomplex sum;
+	sum.re = ddadd(a.re, b.re);
+	sum.im = ddadd(a.im, b.im);
+	return sum;
+}
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Subtraction of complex double-double numbers.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD ADD</td><td>2</td></tr>
+ *     </table>
+ *
+ * @param[in] a - minuend, the complex number to subtract from.
+ * @param[in] b - subtrahend, the complex number to be subtracted.
+ * @return The difference of @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddcomplex ddcsub(const ddcomplex a, const ddcomplex b) {
+	ddcomplex difference;
+	difference.re = ddadd(a.re, ddneg(b.re));
+	difference.im = ddadd(a.im, ddneg(b.im));
+	return difference;
+}
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Multiplication of complex double-double numbers.
+ * @details Computes the product with the textbook formula (a.re b.re - a.im b.im) + i (a.re b.im + a.im b.re).
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD MUL</td><td>4</td></tr>
+ *         <tr><td>DD ADD</td><td>2</td></tr>
+ *     </table>
+ *
+ * @param[in] a - multiplicand, the complex number to be multiplied.
+ * @param[in] b - multiplier, the complex number to multiply by.
+ * @return The product of @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddcomplex ddcmul(const ddcomplex a, const ddcomplex b) {
+	ddcomplex product;
+	product.re = ddadd(ddmul(a.re, b.re), ddneg(ddmul(a.im, b.im)));
+	product.im = ddadd(ddmul(a.re, b.im), ddmul(a.im, b.re));
+	return product;
+}
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Multiplication of complex double-double numbers with three real multiplications.
+ * @details Computes the product with Gauss's formula:
+ * k1 = b.re (a.re + a.im), k2 = a.re (b.im - b.re), k3 = a.im (b.re + b.im),
+ * product = (k1 - k3) + i (k1 + k2).
+ *
+ * Unlike double-precision arithmetic, in double-double arithmetic an addition is more expensive than a multiplication,
+ * so this version is usually slower than ddcmul. It is also less accurate when k1 and k3 or k1 and k2 nearly cancel.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD MUL</td><td>3</td></tr>
+ *         <tr><td>DD ADD</td><td>5</td></tr>
+ *     </table>
+ *
+ * @param[in] a - multiplicand, the complex number to be multiplied.
+ * @param[in] b - multiplier, the complex number to multiply by.
+ * @return The product of @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddcomplex ddcmul3(const ddcomplex a, const ddcomplex b) {
+	const doubledouble k1 = ddmul(b.re, ddadd(a.re, a.im));
+	const doubledouble k2 = ddmul(a.re, ddadd(b.im, ddneg(b.re)));
+	const doubledouble k3 = ddmul(a.im, ddadd(b.re, b.im));
+	ddcomplex product;
+	product.re = ddadd(k1, ddneg(k3));
+	product.im = ddadd(k1, k2);
+	return product;
+}
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Division of complex double-double numbers.
+ * @details Computes the quotient as a * conj(b) / |b|^2.
+ * @warning The squared magnitude of @b b is computed without scaling,
+ * so the result overflows or underflows if the squared magnitude of @b b is outside of the double-precision range.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD MUL</td><td>6</td></tr>
+ *         <tr><td>DD ADD</td><td>3</td></tr>
+ *         <tr><td>DD DIV</td><td>2</td></tr>
+ *     </table>
+ *
+ * @param[in] a - dividend, the complex number to be divided.
+ * @param[in] b - divisor, the complex number to divide by.
+ * @return The quotient of @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddcomplex ddcdiv(const ddcomplex a, const ddcomplex b) {
+	const doubledouble norm = ddadd(ddmul(b.re, b.re), ddmul(b.im, b.im));
+	ddcomplex quotient;
+	quotient.re = dddiv(ddadd(ddmul(a.re, b.re), ddmul(a.im, b.im)), norm);
+	quotient.im = dddiv(ddadd(ddmul(a.im, b.re), ddneg(ddmul(a.re, b.im))), norm);
+	return quotient;
+}
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief Magnitude of a complex double-double number.
+ * @details Both parts are scaled by a power of 2 before squaring, so the intermediate results do not overflow or underflow.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD MUL </td><td>2</td></tr>
+ *         <tr><td>DD ADD </td><td>1</td></tr>
+ *         <tr><td>DD SQRT</td><td>1</td></tr>
+ *     </table>
+ *
+ * @param[in] a - the complex number.
+ * @return The magnitude of @b a as a double-double number.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddcabs(const ddcomplex a) {
+	const double re_abs = a.re.hi < 0.0 ? -a.re.hi : a.re.hi;
+	const double im_abs = a.im.hi < 0.0 ? -a.im.hi : a.im.hi;
+	const double max_abs = re_abs > im_abs ? re_abs : im_abs;
+	if (max_abs - max_abs != 0.0) {
+		/* Infinity or NaN */
+		doubledouble magnitude;
+		magnitude.hi = re_abs + im_abs;
+		magnitude.lo = 0.0;
+		return magnitude;
+	}
+
+	/* Exponent of the largest part, but at least the minimum normal exponent: the scaled parts are below 2 in magnitude, and scaling is exact */
+	int exponent = -1022;
+	if (max_abs >= 2.2250738585072014e-308 /* 2**-1022 */) {
+#if defined(__GNUC__) && !defined(__CUDA_ARCH__)
+		exponent = __builtin_ilogb(max_abs);
+#else
+		exponent = ilogb(max_abs);
+#endif
+	}
+#if defined(__GNUC__) && !defined(__CUDA_ARCH__)
+	const double scale = __builtin_ldexp(1.0, -exponent);
+	const double unscale = __builtin_ldexp(1.0, exponent);
+#else
+	const double scale = ldexp(1.0, -exponent);
+	const double unscale = ldexp(1.0, exponent);
+#endif
+
+	doubledouble re, im;
+	re.hi = a.re.hi * scale;
+	re.lo = a.re.lo * scale;
+	im.hi = a.im.hi * scale;
+	im.lo = a.im.lo * scale;
+	doubledouble magnitude = ddsqrt(ddadd(ddmul(re, re), ddmul(im, im)));
+	magnitude.hi *= unscale;
+	magnitude.lo *= unscale;
+	return magnitude;
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+
+/**
+ * @ingroup DDCOMPLEX
+ * @brief 4 complex double-double numbers in AVX registers.
+ */
+typedef struct {
+	__m256dd re;
+	__m256dd im;
+} __m256ddc;
+
+FPPLUS_STATIC_INLINE __m256dd _mm256_neg_pdd(const __m256dd a) {
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	return (__m256dd) { _mm256_xor_pd(a.hi, sign), _mm256_xor_pd(a.lo, sign) };
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_setzero_pddc(void) {
+	return (__m256ddc) { _mm256_setzero_pdd(), _mm256_setzero_pdd() };
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_broadcast_sddc(
+	const ddcomplex FPPLUS_NONNULL_POINTER(pointer))
+{
+	return (__m256ddc) { _mm256_broadcast_sdd(&pointer->re), _mm256_broadcast_sdd(&pointer->im) };
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_loaddeinterleaveu_pddc(
+	const ddcomplex FPPLUS_ARRAY_POINTER(pointer, 4))
+{
+	/* Each number is a row of 4 doubles: re.hi, re.lo, im.hi, im.lo */
+	const __m256d number0 = _mm256_loadu_pd(&pointer[0].re.hi);
+	const __m256d number1 = _mm256_loadu_pd(&pointer[1].re.hi);
+	const __m256d number2 = _mm256_loadu_pd(&pointer[2].re.hi);
+	const __m256d number3 = _mm256_loadu_pd(&pointer[3].re.hi);
+	const __m256d hi01 = _mm256_unpacklo_pd(number0, number1);
+	const __m256d lo01 = _mm256_unpackhi_pd(number0, number1);
+	const __m256d hi23 = _mm256_unpacklo_pd(number2, number3);
+	const __m256d lo23 = _mm256_unpackhi_pd(number2, number3);
+	return (__m256ddc) {
+		{ _mm256_permute2f128_pd(hi01, hi23, 0x20), _mm256_permute2f128_pd(lo01, lo23, 0x20) },
+		{ _mm256_permute2f128_pd(hi01, hi23, 0x31), _mm256_permute2f128_pd(lo01, lo23, 0x31) }
+	};
+}
+
+FPPLUS_STATIC_INLINE void _mm256_interleavestoreu_pddc(
+	ddcomplex FPPLUS_ARRAY_POINTER(pointer, 4),
+	const __m256ddc numbers)
+{
+	const __m256d hi01 = _mm256_permute2f128_pd(numbers.re.hi, numbers.im.hi, 0x20);
+	const __m256d lo01 = _mm256_permute2f128_pd(numbers.re.lo, numbers.im.lo, 0x20);
+	const __m256d hi23 = _mm256_permute2f128_pd(numbers.re.hi, numbers.im.hi, 0x31);
+	const __m256d lo23 = _mm256_permute2f128_pd(numbers.re.lo, numbers.im.lo, 0x31);
+	_mm256_storeu_pd(&pointer[0].re.hi, _mm256_unpacklo_pd(hi01, lo01));
+	_mm256_storeu_pd(&pointer[1].re.hi, _mm256_unpackhi_pd(hi01, lo01));
+	_mm256_storeu_pd(&pointer[2].re.hi, _mm256_unpacklo_pd(hi23, lo23));
+	_mm256_storeu_pd(&pointer[3].re.hi, _mm256_unpackhi_pd(hi23, lo23));
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_add_pddc(const __m256ddc a, const __m256ddc b) {
+	return (__m256ddc) { _mm256_add_pdd(a.re, b.re), _mm256_add_pdd(a.im, b.im) };
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_sub_pddc(const __m256ddc a, const __m256ddc b) {
+	return (__m256ddc) { _mm256_add_pdd(a.re, _mm256_neg_pdd(b.re)), _mm256_add_pdd(a.im, _mm256_neg_pdd(b.im)) };
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_mul_pddc(const __m256ddc a, const __m256ddc b) {
+	return (__m256ddc) {
+		_mm256_add_pdd(_mm256_mul_pdd(a.re, b.re), _mm256_neg_pdd(_mm256_mul_pdd(a.im, b.im))),
+		_mm256_add_pdd(_mm256_mul_pdd(a.re, b.im), _mm256_mul_pdd(a.im, b.re))
+	};
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_mul3_pddc(const __m256ddc a, const __m256ddc b) {
+	const __m256dd k1 = _mm256_mul_pdd(b.re, _mm256_add_pdd(a.re, a.im));
+	const __m256dd k2 = _mm256_mul_pdd(a.re, _mm256_add_pdd(b.im, _mm256_neg_pdd(b.re)));
+	const __m256dd k3 = _mm256_mul_pdd(a.im, _mm256_add_pdd(b.re, b.im));
+	return (__m256ddc) { _mm256_add_pdd(k1, _mm256_neg_pdd(k3)), _mm256_add_pdd(k1, k2) };
+}
+
+FPPLUS_STATIC_INLINE __m256ddc _mm256_div_pddc(const __m256ddc a, const __m256ddc b) {
+	const __m256dd norm = _mm256_add_pdd(_mm256_mul_pdd(b.re, b.re), _mm256_mul_pdd(b.im, b.im));
+	return (__m256ddc) {
+		_mm256_div_pdd(_mm256_add_pdd(_mm256_mul_pdd(a.re, b.re), _mm256_mul_pdd(a.im, b.im)), norm),
+		_mm256_div_pdd(_mm256_add_pdd(_mm256_mul_pdd(a.im, b.re), _mm256_neg_pdd(_mm256_mul_pdd(a.re, b.im))), norm)
+	};
+}
+
+FPPLUS_STATIC_INLINE __m256dd _mm256_abs_pddc(const __m256ddc a) {
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	const __m256d re_abs = _mm256_andnot_pd(sign, a.re.hi);
+	const __m256d im_abs = _mm256_andnot_pd(sign, a.im.hi);
+	const __m256d max_abs = _mm256_max_pd(re_abs, im_abs);
+
+	/* Power of 2 with the exponent of the largest part, but at least the minimum normal number, as in ddcabs */
+	const __m256d exponent_mask = _mm256_set1_pd(__builtin_inf());
+	const __m256d unscale = _mm256_max_pd(_mm256_and_pd(max_abs, exponent_mask), _mm256_set1_pd(2.2250738585072014e-308 /* 2**-1022 */));
+	const __m256d scale = _mm256_div_pd(_mm256_set1_pd(1.0), unscale);
+
+	const __m256dd re = { _mm256_mul_pd(a.re.hi, scale), _mm256_mul_pd(a.re.lo, scale) };
+	const __m256dd im = { _mm256_mul_pd(a.im.hi, scale), _mm256_mul_pd(a.im.lo, scale) };
+	const __m256dd magnitude = _mm256_sqrt_pdd(_mm256_add_pdd(_mm256_mul_pdd(re, re), _mm256_mul_pdd(im, im)));
+
+	/* Infinite and NaN inputs produce re_abs + im_abs, as in ddcabs */
+	const __m256d finite_mask = _mm256_cmp_pd(_mm256_sub_pd(max_abs, max_abs), _mm256_setzero_pd(), _CMP_EQ_OQ);
+	return (__m256dd) {
+		_mm256_blendv_pd(_mm256_add_pd(re_abs, im_abs), _mm256_mul_pd(magnitude.hi, unscale), finite_mask),
+		_mm256_and_pd(_mm256_mul_pd(magnitude.lo, unscale), finite_mask)
+	};
+}
+
+#endif /* AVX */
+
+#endif /* FPPLUS_DDCOMPLEX_H */
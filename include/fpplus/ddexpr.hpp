@@ -0,0 +1,225 @@
+#pragma once
+#ifndef FPPLUS_DDEXPR_HPP
+#define FPPLUS_DDEXPR_HPP
+
+#include <cstddef>
+
+#include <fpplus.h>
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+
+/**
+ * @defgroup DDEXPR Fused double-double array expressions
+ * @details Expression templates which evaluate elementwise expressions over double-double arrays,
+ * e.g. y = a * x + b * z, in a single vectorized loop without temporary arrays.
+ *
+ * @code
+ * using namespace fpplus::ddexpr;
+ * evaluate(n, y, array(a) * array(x) + array(b) * array(z));
+ * @endcode
+ *
+ * Array operands are loaded with _mm256_loaddeinterleaveu_pdd, and the result is stored with
+ * _mm256_interleavestoreu_pdd, so arrays need only the natural alignment of doubledouble.
+ * Elements which do not fill a whole SIMD vector are computed with the scalar functions of dd.h,
+ * which produce the same results as the SIMD functions.
+ */
+
+namespace fpplus {
+namespace ddexpr {
+
+/**
+ * @ingroup DDEXPR
+ * @brief Base class of all expressions (CRTP).
+ * @details An expression type E provides two methods:
+ * - __m256dd load(size_t i) const: elements [i, i + 4) of the expression as a SIMD vector
+ * - doubledouble load_scalar(size_t i) const: element i of the expression
+ */
+template<class E>
+struct expression {
+	const E& self() const {
+		return static_cast<const E&>(*this);
+	}
+};
+
+/**
+ * @ingroup DDEXPR
+ * @brief Expression which reads elements of a double-double array.
+ */
+class array : public expression<array> {
+public:
+	explicit array(const doubledouble* data) : data_(data) {}
+
+	__m256dd load(std::size_t i) const {
+		return _mm256_loaddeinterleaveu_pdd(&data_[i]);
+	}
+
+	doubledouble load_scalar(std::size_t i) const {
+		return data_[i];
+	}
+
+private:
+	const doubledouble* data_;
+};
+
+/**
+ * @ingroup DDEXPR
+ * @brief Expression which has the same double-double value for all elements.
+ */
+class constant : public expression<constant> {
+public:
+	explicit constant(doubledouble value) :
+		vector_(_mm256_broadcast_sdd(&value)),
+		scalar_(value) {}
+
+	__m256dd load(std::size_t) const {
+		return vector_;
+	}
+
+	doubledouble load_scalar(std::size_t) const {
+		return scalar_;
+	}
+
+private:
+	__m256dd vector_;
+	doubledouble scalar_;
+};
+
+/**
+ * @ingroup DDEXPR
+ * @brief Elementwise sum of two expressions (_mm256_add_pdd and ddadd).
+ */
+template<class A, class B>
+class add : public expression<add<A, B>> {
+public:
+	add(const A& a, const B& b) : a_(a), b_(b) {}
+
+	__m256dd load(std::size_t i) const {
+		return _mm256_add_pdd(a_.load(i), b_.load(i));
+	}
+
+	doubledouble load_scalar(std::size_t i) const {
+		return ddadd(a_.load_scalar(i), b_.load_scalar(i));
+	}
+
+private:
+	A a_;
+	B b_;
+};
+
+/**
+ * @ingroup DDEXPR
+ * @brief Elementwise difference of two expressions (addition of the negated subtrahend).
+ */
+template<class A, class B>
+class subtract : public expression<subtract<A, B>> {
+public:
+	subtract(const A& a, const B& b) : a_(a), b_(b) {}
+
+	__m256dd load(std::size_t i) const {
+		const __m256d sign = _mm256_set1_pd(-0.0);
+		const __m256dd b = b_.load(i);
+		const __m256dd minus_b = { _mm256_xor_pd(b.hi, sign), _mm256_xor_pd(b.lo, sign) };
+		return _mm256_add_pdd(a_.load(i), minus_b);
+	}
+
+	doubledouble load_scalar(std::size_t i) const {
+		const doubledouble b = b_.load_scalar(i);
+		const doubledouble minus_b = { -b.hi, -b.lo };
+		return ddadd(a_.load_scalar(i), minus_b);
+	}
+
+private:
+	A a_;
+	B b_;
+};
+
+/**
+ * @ingroup DDEXPR
+ * @brief Elementwise product of two expressions (_mm256_mul_pdd and ddmul).
+ */
+template<class A, class B>
+class multiply : public expression<multiply<A, B>> {
+public:
+	multiply(const A& a, const B& b) : a_(a), b_(b) {}
+
+	__m256dd load(std::size_t i) const {
+		return _mm256_mul_pdd(a_.load(i), b_.load(i));
+	}
+
+	doubledouble load_scalar(std::size_t i) const {
+		return ddmul(a_.load_scalar(i), b_.load_scalar(i));
+	}
+
+private:
+	A a_;
+	B b_;
+};
+
+template<class A, class B>
+inline add<A, B> operator+(const expression<A>& a, const expression<B>& b) {
+	return add<A, B>(a.self(), b.self());
+}
+
+template<class B>
+inline add<constant, B> operator+(doubledouble a, const expression<B>& b) {
+	return add<constant, B>(constant(a), b.self());
+}
+
+template<class A>
+inline add<A, constant> operator+(const expression<A>& a, doubledouble b) {
+	return add<A, constant>(a.self(), constant(b));
+}
+
+template<class A, class B>
+inline subtract<A, B> operator-(const expression<A>& a, const expression<B>& b) {
+	return subtract<A, B>(a.self(), b.self());
+}
+
+template<class B>
+inline subtract<constant, B> operator-(doubledouble a, const expression<B>& b) {
+	return subtract<constant, B>(constant(a), b.self());
+}
+
+template<class A>
+inline subtract<A, constant> operator-(const expression<A>& a, doubledouble b) {
+	return subtract<A, constant>(a.self(), constant(b));
+}
+
+template<class A, class B>
+inline multiply<A, B> operator*(const expression<A>& a, const expression<B>& b) {
+	return multiply<A, B>(a.self(), b.self());
+}
+
+template<class B>
+inline multiply<constant, B> operator*(doubledouble a, const expression<B>& b) {
+	return multiply<constant, B>(constant(a), b.self());
+}
+
+template<class A>
+inline multiply<A, constant> operator*(const expression<A>& a, doubledouble b) {
+	return multiply<A, constant>(a.self(), constant(b));
+}
+
+/**
+ * @ingroup DDEXPR
+ * @brief Evaluates the expression for elements [0, n) in a single pass, and stores the results to y.
+ * @note y may be one of the arrays in the expression: each element is read before the element is written.
+ */
+template<class E>
+inline void evaluate(std::size_t n, doubledouble* y, const expression<E>& e) {
+	const E& expr = e.self();
+	std::size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm256_interleavestoreu_pdd(&y[i], expr.load(i));
+	}
+	for (; i < n; i++) {
+		y[i] = expr.load_scalar(i);
+	}
+}
+
+} /* namespace ddexpr */
+} /* namespace fpplus */
+
+#endif /* AVX + FMA */
+
+#endif /* FPPLUS_DDEXPR_HPP */
@@ -240,6 +240,148 @@ double effma(
 	return mac;
 }
 
+/**
+ * @ingroup EFT
+ * @brief Error-free addition in single precision.
+ * @details Computes @a s and @a e such that
+ *     - s = a + b rounded to the nearest float
+ *     - a + b = s + e exactly
+ *
+ * Single-precision version of efadd: the algorithm is the same, and it is error-free in any binary floating-point format.
+ *
+ * @param[in] a - addend, the first floating-point number to be added.
+ * @param[in] b - augend, the second floating-point number to be added.
+ * @param[out] e - the roundoff error in floating-point addition.
+ * @return The sum @a s of @a and @b rounded to the nearest single-precision number (result of normal floating-point addition).
+ *
+ * @post @f$ s = \circ(a + b) @f$
+ * @post @f$ s + e = a + b @f$
+ */
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+float efaddf(
+	float a,
+	float b,
+	float FPPLUS_NONNULL_POINTER(e))
+{
+#if defined(__CUDA_ARCH__)
+	/* CUDA-specific version */
+	const float sum = __fadd_rn(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const float b_virtual = __fsub_rn(sum, a);
+	const float a_virtual = __fsub_rn(sum, b_virtual);
+	const float b_roundoff = __fsub_rn(b, b_virtual);
+	const float a_roundoff = __fsub_rn(a, a_virtual);
+	*e = __fadd_rn(a_roundoff, b_roundoff);
+#else
+	*e = addref(a, b);
+#endif
+	/* End of CUDA-specific version */
+#else
+	/* Generic version */
+	const float sum = a + b;
+#if FPPLUS_USE_FPADDRE == 0
+	const float b_virtual = sum - a;
+	const float a_virtual = sum - b_virtual;
+	const float b_roundoff = b - b_virtual;
+	const float a_roundoff = a - a_virtual;
+	*e = a_roundoff + b_roundoff;
+#else
+	*e = addref(a, b);
+#endif
+	/* End of generic version */
+#endif
+	return sum;
+}
+
+/**
+ * @ingroup EFT
+ * @brief Fast error-free addition of ordered, in magnitude, values in single precision.
+ * @details Computes @a s and @p e such that
+ *     - s = a + b rounded to the nearest float
+ *     - a + b = s + e exactly
+ *
+ * Single-precision version of efaddord.
+ *
+ * @param[in] a - addend, the first floating-point number to be added. Must be not smaller in magnitude than @p b.
+ * @param[in] b - augend, the second floating-point number to be added. Must be not larger in magnitude than @p a.
+ * @param[out] e - the roundoff error in floating-point addition.
+ * @return The sum @a s of @p a and @p b rounded to the nearest single-precision number (result of normal floating-point addition).
+ *
+ * @pre @f$ |a| >= |b| @f$
+ * @post @f$ s = \circ(a + b) @f$
+ * @post @f$ s + e = a + b @f$
+ */
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+float efaddordf(
+	float a,
+	float b,
+	float FPPLUS_NONNULL_POINTER(e))
+{
+#if defined(__CUDA_ARCH__)
+	/* CUDA-specific version */
+	const float sum = __fadd_rn(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const float b_virtual = __fsub_rn(sum, a);
+	*e = __fsub_rn(b, b_virtual);
+#else
+	*e = addref(a, b);
+#endif
+	/* End of CUDA-specific version */
+#else
+	/* Generic version */
+	const float sum = a + b;
+#if FPPLUS_USE_FPADDRE == 0
+	const float b_virtual = sum - a;
+	*e = b - b_virtual;
+#else
+	*e = addref(a, b);
+#endif
+	/* End of generic version */
+#endif
+	return sum;
+}
+
+/**
+ * @ingroup EFT
+ * @brief Error-free multiplication in single precision.
+ * @details Computes @a p and @p e such that
+ *     - p = a * b rounded to the nearest float
+ *     - a * b = p + e exactly
+ *
+ * Single-precision version of efmul.
+ *
+ * @param[in] a - multiplicand, the first floating-point number to be multiplied.
+ * @param[in] b - multiplier, the second floating-point number to be multiplied.
+ * @param[out] e - the roundoff error in floating-point multiplication.
+ * @return The product @a p of @p a and @p b rounded to the nearest single-precision number (result of normal floating-point multiplication).
+ *
+ * @post @f$ p = \circ(a \times b) @f$
+ * @post @f$ p + e = a \times b @f$
+ */
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+float efmulf(
+	float a,
+	float b,
+	float FPPLUS_NONNULL_POINTER(e))
+{
+#if defined(__CUDA_ARCH__)
+	/* CUDA-specific version */
+	const float product = __fmul_rn(a, b);
+	*e = __fmaf_rn(a, b, -product);
+	/* End of CUDA-specific version */
+#else
+	/* Generic version */
+	const float product = a * b;
+#if defined(__GNUC__)
+	*e = __builtin_fmaf(a, b, -product);
+#else
+	*e = fmaf(a, b, -product);
+#endif
+	/* End of generic version */
+#endif
+	return product;
+}
+
 #if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
 
 FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
@@ -436,6 +578,156 @@ __m256d _mm256_effma_pd(
 	return mac;
 }
 
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m128 _mm_efadd_ss(
+	__m128 a,
+	__m128 b,
+	__m128 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m128 sum = _mm_add_ss(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const __m128 b_virtual = _mm_sub_ss(sum, a);
+	const __m128 a_virtual = _mm_sub_ss(sum, b_virtual);
+	const __m128 b_roundoff = _mm_sub_ss(b, b_virtual);
+	const __m128 a_roundoff = _mm_sub_ss(a, a_virtual);
+	*e = _mm_add_ss(a_roundoff, b_roundoff);
+#else
+	*e = _mm_addre_ss(a, b);
+#endif
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m128 _mm_efadd_ps(
+	__m128 a,
+	__m128 b,
+	__m128 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m128 sum = _mm_add_ps(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const __m128 b_virtual = _mm_sub_ps(sum, a);
+	const __m128 a_virtual = _mm_sub_ps(sum, b_virtual);
+	const __m128 b_roundoff = _mm_sub_ps(b, b_virtual);
+	const __m128 a_roundoff = _mm_sub_ps(a, a_virtual);
+	*e = _mm_add_ps(a_roundoff, b_roundoff);
+#else
+	*e = _mm_addre_ps(a, b);
+#endif
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m256 _mm256_efadd_ps(
+	__m256 a,
+	__m256 b,
+	__m256 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m256 sum = _mm256_add_ps(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const __m256 b_virtual = _mm256_sub_ps(sum, a);
+	const __m256 a_virtual = _mm256_sub_ps(sum, b_virtual);
+	const __m256 b_roundoff = _mm256_sub_ps(b, b_virtual);
+	const __m256 a_roundoff = _mm256_sub_ps(a, a_virtual);
+	*e = _mm256_add_ps(a_roundoff, b_roundoff);
+#else
+	*e = _mm256_addre_ps(a, b);
+#endif
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m128 _mm_efaddord_ss(
+	__m128 a,
+	__m128 b,
+	__m128 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m128 sum = _mm_add_ss(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const __m128 b_virtual = _mm_sub_ss(sum, a);
+	*e = _mm_sub_ss(b, b_virtual);
+#else
+	*e = _mm_addre_ss(a, b);
+#endif
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m128 _mm_efaddord_ps(
+	__m128 a,
+	__m128 b,
+	__m128 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m128 sum = _mm_add_ps(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const __m128 b_virtual = _mm_sub_ps(sum, a);
+	*e = _mm_sub_ps(b, b_virtual);
+#else
+	*e = _mm_addre_ps(a, b);
+#endif
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m256 _mm256_efaddord_ps(
+	__m256 a,
+	__m256 b,
+	__m256 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m256 sum = _mm256_add_ps(a, b);
+#if FPPLUS_USE_FPADDRE == 0
+	const __m256 b_virtual = _mm256_sub_ps(sum, a);
+	*e = _mm256_sub_ps(b, b_virtual);
+#else
+	*e = _mm256_addre_ps(a, b);
+#endif
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m128 _mm_efmul_ss(
+	__m128 a,
+	__m128 b,
+	__m128 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m128 product = _mm_mul_ss(a, b);
+#if defined(__FMA__) || defined(__AVX2__)
+	*e = _mm_fmsub_ss(a, b, product);
+#else
+	*e = _mm_msub_ss(a, b, product);
+#endif
+	return product;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m128 _mm_efmul_ps(
+	__m128 a,
+	__m128 b,
+	__m128 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m128 product = _mm_mul_ps(a, b);
+#if defined(__FMA__) || defined(__AVX2__)
+	*e = _mm_fmsub_ps(a, b, product);
+#else
+	*e = _mm_msub_ps(a, b, product);
+#endif
+	return product;
+}
+
+FPPLUS_STATIC_INLINE FPPLUS_NONNULL_POINTER_ARGUMENTS
+__m256 _mm256_efmul_ps(
+	__m256 a,
+	__m256 b,
+	__m256 FPPLUS_NONNULL_POINTER(e))
+{
+	const __m256 product = _mm256_mul_ps(a, b);
+#if defined(__FMA__) || defined(__AVX2__)
+	*e = _mm256_fmsub_ps(a, b, product);
+#else
+	*e = _mm256_msub_ps(a, b, product);
+#endif
+	return product;
+}
+
 #endif /* AVX */
 
 #if defined(__AVX512F__) || defined(__KNC__)
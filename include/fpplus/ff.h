@@ -0,0 +1,441 @@
+#pragma once
+#ifndef FPPLUS_FF_H
+#define FPPLUS_FF_H
+
+#include <fpplus/eft.h>
+
+/**
+ * @defgroup FF Float-float arithmetic
+ * @details Float-float numbers are unevaluated sums of two single-precision numbers, with about 48 bits of precision.
+ * The algorithms are the same as for double-double numbers, but SIMD versions process twice as many numbers per instruction.
+ */
+
+
+/**
+ * @ingroup FF
+ * @brief Float-float number.
+ */
+typedef struct {
+	/**
+	 * @brief The high (largest in magnitude) part of the number.
+	 * @note The high part is the best single-precision approximation of the float-float number.
+	 */
+	float hi;
+	/**
+	 * @brief The low (smallest in magnitude) part of the number.
+	 */
+	float lo;
+} floatfloat;
+
+
+/**
+ * @ingroup FF
+ * @brief Long addition of single-precision numbers.
+ * @details Adds two single-precision numbers and produces float-float result.
+ * Single-precision version of ddaddl.
+ *
+ * @param[in] a - addend, the first single-precision number to be added.
+ * @param[in] b - augend, the second single-precision number to be added.
+ * @return The sum of @b a and @b b as a float-float number.
+ */
+FPPLUS_STATIC_INLINE floatfloat ffaddl(const float a, const float b) {
+	floatfloat sum;
+	sum.hi = efaddf(a, b, &sum.lo);
+	return sum;
+}
+
+/**
+ * @ingroup FF
+ * @brief Wide addition of single-precision number to a float-float number.
+ * @details Adds single-precision number to a float-float number and produces a float-float result.
+ * Single-precision version of ddaddw.
+ *
+ * @param[in] a - addend, the float-float number to be added to.
+ * @param[in] b - augend, the single-precision number to be added.
+ * @return The sum of @b a and @b b as a float-float number.
+ */
+FPPLUS_STATIC_INLINE floatfloat ffaddw(const floatfloat a, const float b) {
+	floatfloat sum = ffaddl(a.lo, b);
+	float e;
+	sum.hi = efaddf(a.hi, sum.hi, &e);
+#ifdef __CUDA_ARCH__
+	sum.lo = __fadd_rn(sum.lo, e);
+#else
+	sum.lo += e;
+#endif
+	return sum;
+}
+
+/**
+ * @ingroup FF
+ * @brief Addition of two float-float numbers.
+ * @details Adds two float-float numbers and produces a float-float result.
+ * Single-precision version of ddadd.
+ *
+ * @param[in] a - addend, the first float-float number to be added.
+ * @param[in] b - augend, the second float-float number to be added.
+ * @return The sum of @b a and @b b as a float-float number.
+ */
+FPPLUS_STATIC_INLINE floatfloat ffadd(const floatfloat a, const floatfloat b) {
+	const floatfloat s = ffaddl(a.hi, b.hi);
+	const floatfloat t = ffaddl(a.lo, b.lo);
+	floatfloat v;
+#ifdef __CUDA_ARCH__
+	v.hi = efaddordf(s.hi, __fadd_rn(s.lo, t.hi), &v.lo);
+#else
+	v.hi = efaddordf(s.hi, s.lo + t.hi, &v.lo);
+#endif
+	floatfloat z;
+#ifdef __CUDA_ARCH__
+	z.hi = efaddordf(v.hi, __fadd_rn(t.lo, v.lo), &z.lo);
+#else
+	z.hi = efaddordf(v.hi, t.lo + v.lo, &z.lo);
+#endif
+	return z;
+}
+
+/**
+ * @ingroup FF
+ * @brief Fast addition of two float-float numbers with weaker error guarantees.
+ * @details Adds two float-float numbers and produces a float-float result.
+ * Single-precision version of ddadd_fast.
+ *
+ * @param[in] a - addend, the first float-float number to be added.
+ * @param[in] b - augend, the second float-float number to be added.
+ * @return The sum of @b a and @b b as a float-float number.
+ */
+FPPLUS_STATIC_INLINE floatfloat ffadd_fast(const floatfloat a, const floatfloat b) {
+	floatfloat sum = ffaddl(a.hi, b.hi);
+#ifdef __CUDA_ARCH__
+	sum.lo = __fadd_rn(sum.lo, __fadd_rn(a.lo, b.lo));
+#else
+	sum.lo += a.lo + b.lo;
+#endif
+	sum.hi = efaddordf(sum.hi, sum.lo, &sum.lo);
+	return sum;
+}
+
+/**
+ * @ingroup FF
+ * @brief Long multiplication of single-precision numbers.
+ * @details Multiplies two single-precision numbers and produces float-float result.
+ * Single-precision version of ddmull.
+ *
+ * @param[in] a - multiplicand, the single-precision number to be multiplied.
+ * @param[in] b - multiplier, the single-precision number to multipliy by.
+ * @return The product of @b a and @b b as a float-float number.
+ */
+FPPLUS_STATIC_INLINE floatfloat ffmull(const float a, const float b) {
+	floatfloat product;
+	product.hi = efmulf(a, b, &product.lo);
+	return product;
+}
+
+/**
+ * @ingroup FF
+ * @brief Multiplication of float-float numbers.
+ * @details Multiplies two float-float numbers and produces float-float result.
+ * Single-precision version of ddmul.
+ *
+ * @param[in] a - multiplicand, the float-float number to be multiplied.
+ * @param[in] b - multiplier, the float-float number to multipliy by.
+ * @return The product of @b a and @b b as a float-float number.
+ */
+FPPLUS_STATIC_INLINE floatfloat ffmul(const floatfloat a, const floatfloat b) {
+	floatfloat product = ffmull(a.hi, b.hi);
+#if defined(__CUDA_ARCH__)
+	product.lo = __fmaf_rn(a.lo, b.hi, product.lo);
+	product.lo = __fmaf_rn(a.hi, b.lo, product.lo);
+#elif defined(__GNUC__)
+	product.lo = __builtin_fmaf(a.lo, b.hi, product.lo);
+	product.lo = __builtin_fmaf(a.hi, b.lo, product.lo);
+#else
+	product.lo = fmaf(a.lo, b.hi, product.lo);
+	product.lo = fmaf(a.hi, b.lo, product.lo);
+#endif
+	product.hi = efaddordf(product.hi, product.lo, &product.lo);
+	return product;
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+
+typedef struct {
+	__m128 hi;
+	__m128 lo;
+} __m128ff;
+
+FPPLUS_STATIC_INLINE __m128ff _mm_setzero_pff(void) {
+	return (__m128ff) { _mm_setzero_ps(), _mm_setzero_ps() };
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_broadcast_sff(
+	const floatfloat FPPLUS_NONNULL_POINTER(pointer))
+{
+	return (__m128ff) { _mm_broadcast_ss(&pointer->hi), _mm_broadcast_ss(&pointer->lo) };
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_loaddeinterleave_pff(
+	const floatfloat FPPLUS_ARRAY_POINTER(pointer, 4))
+{
+	const __m128 numbers01 = _mm_load_ps(&pointer[0].hi);
+	const __m128 numbers23 = _mm_load_ps(&pointer[2].hi);
+	return (__m128ff) {
+		_mm_shuffle_ps(numbers01, numbers23, _MM_SHUFFLE(2, 0, 2, 0)),
+		_mm_shuffle_ps(numbers01, numbers23, _MM_SHUFFLE(3, 1, 3, 1))
+	};
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_loaddeinterleaveu_pff(
+	const floatfloat FPPLUS_ARRAY_POINTER(pointer, 4))
+{
+	const __m128 numbers01 = _mm_loadu_ps(&pointer[0].hi);
+	const __m128 numbers23 = _mm_loadu_ps(&pointer[2].hi);
+	return (__m128ff) {
+		_mm_shuffle_ps(numbers01, numbers23, _MM_SHUFFLE(2, 0, 2, 0)),
+		_mm_shuffle_ps(numbers01, numbers23, _MM_SHUFFLE(3, 1, 3, 1))
+	};
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_addl_ss(const __m128 a, const __m128 b) {
+	__m128ff sum;
+	sum.hi = _mm_efadd_ss(a, b, &sum.lo);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_addl_ps(const __m128 a, const __m128 b) {
+	__m128ff sum;
+	sum.hi = _mm_efadd_ps(a, b, &sum.lo);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_addw_sff(const __m128ff a, const __m128 b) {
+	__m128ff sum = _mm_addl_ss(a.lo, b);
+	__m128 e;
+	sum.hi = _mm_efadd_ss(a.hi, sum.hi, &e);
+	sum.lo = _mm_add_ss(sum.lo, e);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_addw_pff(const __m128ff a, const __m128 b) {
+	__m128ff sum = _mm_addl_ps(a.lo, b);
+	__m128 e;
+	sum.hi = _mm_efadd_ps(a.hi, sum.hi, &e);
+	sum.lo = _mm_add_ps(sum.lo, e);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_add_sff(const __m128ff a, const __m128ff b) {
+	const __m128ff s = _mm_addl_ss(a.hi, b.hi);
+	const __m128ff t = _mm_addl_ss(a.lo, b.lo);
+	__m128ff v;
+	v.hi = _mm_efaddord_ss(s.hi, s.lo + t.hi, &v.lo);
+	__m128ff z;
+	z.hi = _mm_efaddord_ss(v.hi, t.lo + v.lo, &z.lo);
+	return z;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_add_pff(const __m128ff a, const __m128ff b) {
+	const __m128ff s = _mm_addl_ps(a.hi, b.hi);
+	const __m128ff t = _mm_addl_ps(a.lo, b.lo);
+	__m128ff v;
+	v.hi = _mm_efaddord_ps(s.hi, s.lo + t.hi, &v.lo);
+	__m128ff z;
+	z.hi = _mm_efaddord_ps(v.hi, t.lo + v.lo, &z.lo);
+	return z;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_add_fast_sff(const __m128ff a, const __m128ff b) {
+	__m128ff sum = _mm_addl_ss(a.hi, b.hi);
+	sum.lo += a.lo + b.lo;
+	sum.hi = _mm_efaddord_ss(sum.hi, sum.lo, &sum.lo);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_add_fast_pff(const __m128ff a, const __m128ff b) {
+	__m128ff sum = _mm_addl_ps(a.hi, b.hi);
+	sum.lo += a.lo + b.lo;
+	sum.hi = _mm_efaddord_ps(sum.hi, sum.lo, &sum.lo);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_mull_ss(const __m128 a, const __m128 b) {
+	__m128ff product;
+	product.hi = _mm_efmul_ss(a, b, &product.lo);
+	return product;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_mull_ps(const __m128 a, const __m128 b) {
+	__m128ff product;
+	product.hi = _mm_efmul_ps(a, b, &product.lo);
+	return product;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_mul_sff(const __m128ff a, const __m128ff b) {
+	__m128ff product = _mm_mull_ss(a.hi, b.hi);
+#if defined(__FMA__) || defined(__AVX2__)
+	product.lo = _mm_fmadd_ss(a.lo, b.hi, product.lo);
+	product.lo = _mm_fmadd_ss(a.hi, b.lo, product.lo);
+#else
+	product.lo = _mm_macc_ss(a.lo, b.hi, product.lo);
+	product.lo = _mm_macc_ss(a.hi, b.lo, product.lo);
+#endif
+	product.hi = _mm_efaddord_ss(product.hi, product.lo, &product.lo);
+	return product;
+}
+
+FPPLUS_STATIC_INLINE __m128ff _mm_mul_pff(const __m128ff a, const __m128ff b) {
+	__m128ff product = _mm_mull_ps(a.hi, b.hi);
+#if defined(__FMA__) || defined(__AVX2__)
+	product.lo = _mm_fmadd_ps(a.lo, b.hi, product.lo);
+	product.lo = _mm_fmadd_ps(a.hi, b.lo, product.lo);
+#else
+	product.lo = _mm_macc_ps(a.lo, b.hi, product.lo);
+	product.lo = _mm_macc_ps(a.hi, b.lo, product.lo);
+#endif
+	product.hi = _mm_efaddord_ps(product.hi, product.lo, &product.lo);
+	return product;
+}
+
+FPPLUS_STATIC_INLINE floatfloat _mm_cvtsff_f32ff(const __m128ff x) {
+	return (floatfloat) { _mm_cvtss_f32(x.hi), _mm_cvtss_f32(x.lo) };
+}
+
+FPPLUS_STATIC_INLINE floatfloat _mm_reduce_add_pff(const __m128ff x) {
+	const __m128ff x23 = {
+		_mm_movehl_ps(x.hi, x.hi),
+		_mm_movehl_ps(x.lo, x.lo)
+	};
+	const __m128ff x01 = _mm_add_pff(x, x23);
+	const __m128ff x1 = {
+		_mm_movehdup_ps(x01.hi),
+		_mm_movehdup_ps(x01.lo)
+	};
+	return _mm_cvtsff_f32ff(_mm_add_sff(x01, x1));
+}
+
+typedef struct {
+	__m256 hi;
+	__m256 lo;
+} __m256ff;
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_setzero_pff(void) {
+	return (__m256ff) { _mm256_setzero_ps(), _mm256_setzero_ps() };
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_broadcast_sff(
+	const floatfloat FPPLUS_NONNULL_POINTER(pointer))
+{
+	return (__m256ff) { _mm256_broadcast_ss(&pointer->hi), _mm256_broadcast_ss(&pointer->lo) };
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_loaddeinterleave_pff(
+	const floatfloat FPPLUS_ARRAY_POINTER(pointer, 8))
+{
+	const __m256 numbers0123 = _mm256_load_ps(&pointer[0].hi);
+	const __m256 numbers4567 = _mm256_load_ps(&pointer[4].hi);
+	const __m256 numbers0145 = _mm256_permute2f128_ps(numbers0123, numbers4567, 0x20);
+	const __m256 numbers2367 = _mm256_permute2f128_ps(numbers0123, numbers4567, 0x31);
+	return (__m256ff) {
+		_mm256_shuffle_ps(numbers0145, numbers2367, _MM_SHUFFLE(2, 0, 2, 0)),
+		_mm256_shuffle_ps(numbers0145, numbers2367, _MM_SHUFFLE(3, 1, 3, 1))
+	};
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_loaddeinterleaveu_pff(
+	const floatfloat FPPLUS_ARRAY_POINTER(pointer, 8))
+{
+	const __m256 numbers0123 = _mm256_loadu_ps(&pointer[0].hi);
+	const __m256 numbers4567 = _mm256_loadu_ps(&pointer[4].hi);
+	const __m256 numbers0145 = _mm256_permute2f128_ps(numbers0123, numbers4567, 0x20);
+	const __m256 numbers2367 = _mm256_permute2f128_ps(numbers0123, numbers4567, 0x31);
+	return (__m256ff) {
+		_mm256_shuffle_ps(numbers0145, numbers2367, _MM_SHUFFLE(2, 0, 2, 0)),
+		_mm256_shuffle_ps(numbers0145, numbers2367, _MM_SHUFFLE(3, 1, 3, 1))
+	};
+}
+
+FPPLUS_STATIC_INLINE void _mm256_interleavestore_pff(
+	floatfloat FPPLUS_ARRAY_POINTER(pointer, 8),
+	__m256ff numbers)
+{
+	const __m256 numbers0145 = _mm256_unpacklo_ps(numbers.hi, numbers.lo);
+	const __m256 numbers2367 = _mm256_unpackhi_ps(numbers.hi, numbers.lo);
+	_mm256_store_ps(&pointer[0].hi, _mm256_permute2f128_ps(numbers0145, numbers2367, 0x20));
+	_mm256_store_ps(&pointer[4].hi, _mm256_permute2f128_ps(numbers0145, numbers2367, 0x31));
+}
+
+FPPLUS_STATIC_INLINE void _mm256_interleavestoreu_pff(
+	floatfloat FPPLUS_ARRAY_POINTER(pointer, 8),
+	__m256ff numbers)
+{
+	const __m256 numbers0145 = _mm256_unpacklo_ps(numbers.hi, numbers.lo);
+	const __m256 numbers2367 = _mm256_unpackhi_ps(numbers.hi, numbers.lo);
+	_mm256_storeu_ps(&pointer[0].hi, _mm256_permute2f128_ps(numbers0145, numbers2367, 0x20));
+	_mm256_storeu_ps(&pointer[4].hi, _mm256_permute2f128_ps(numbers0145, numbers2367, 0x31));
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_addl_ps(const __m256 a, const __m256 b) {
+	__m256ff sum;
+	sum.hi = _mm256_efadd_ps(a, b, &sum.lo);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_addw_pff(const __m256ff a, const __m256 b) {
+	__m256ff sum = _mm256_addl_ps(a.lo, b);
+	__m256 e;
+	sum.hi = _mm256_efadd_ps(a.hi, sum.hi, &e);
+	sum.lo = _mm256_add_ps(sum.lo, e);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_add_pff(const __m256ff a, const __m256ff b) {
+	const __m256ff s = _mm256_addl_ps(a.hi, b.hi);
+	const __m256ff t = _mm256_addl_ps(a.lo, b.lo);
+	__m256ff v;
+	v.hi = _mm256_efaddord_ps(s.hi, s.lo + t.hi, &v.lo);
+	__m256ff z;
+	z.hi = _mm256_efaddord_ps(v.hi, t.lo + v.lo, &z.lo);
+	return z;
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_add_fast_pff(const __m256ff a, const __m256ff b) {
+	__m256ff sum = _mm256_addl_ps(a.hi, b.hi);
+	sum.lo += a.lo + b.lo;
+	sum.hi = _mm256_efaddord_ps(sum.hi, sum.lo, &sum.lo);
+	return sum;
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_mull_ps(const __m256 a, const __m256 b) {
+	__m256ff product;
+	product.hi = _mm256_efmul_ps(a, b, &product.lo);
+	return product;
+}
+
+FPPLUS_STATIC_INLINE __m256ff _mm256_mul_pff(const __m256ff a, const __m256ff b) {
+	__m256ff product = _mm256_mull_ps(a.hi, b.hi);
+#if defined(__FMA__) || defined(__AVX2__)
+	product.lo = _mm256_fmadd_ps(a.lo, b.hi, product.lo);
+	product.lo = _mm256_fmadd_ps(a.hi, b.lo, product.lo);
+#else
+	product.lo = _mm256_macc_ps(a.lo, b.hi, product.lo);
+	product.lo = _mm256_macc_ps(a.hi, b.lo, product.lo);
+#endif
+	product.hi = _mm256_efaddord_ps(product.hi, product.lo, &product.lo);
+	return product;
+}
+
+FPPLUS_STATIC_INLINE floatfloat _mm256_reduce_add_pff(const __m256ff x) {
+	const __m128ff x0123 = {
+		_mm256_castps256_ps128(x.hi),
+		_mm256_castps256_ps128(x.lo)
+	};
+	const __m128ff x4567 = {
+		_mm256_extractf128_ps(x.hi, 1),
+		_mm256_extractf128_ps(x.lo, 1)
+	};
+	return _mm_reduce_add_pff(_mm_add_pff(x0123, x4567));
+}
+
+#endif /* AVX */
+
+#endif /* FPPLUS_FF_H */
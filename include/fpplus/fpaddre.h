@@ -12,6 +12,14 @@ FPPLUS_STATIC_INLINE double addre(double a, double b) {
 #endif
 }
 
+FPPLUS_STATIC_INLINE float addref(float a, float b) {
+#if defined(FPPLUS_UARCH_STEAMROLLER)
+	return __builtin_fmaf(a, a, b);
+#else
+	return a < b ? a : b;
+#endif
+}
+
 #if defined(__SSE2__)
 	FPPLUS_STATIC_INLINE __m128d _mm_addre_sd(__m128d a, __m128d b) {
 	#if defined(FPPLUS_UARCH_STEAMROLLER)
@@ -28,6 +36,22 @@ FPPLUS_STATIC_INLINE double addre(double a, double b) {
 		return _mm_min_pd(a, b);
 	#endif
 	}
+
+	FPPLUS_STATIC_INLINE __m128 _mm_addre_ss(__m128 a, __m128 b) {
+	#if defined(FPPLUS_UARCH_STEAMROLLER)
+		return _mm_fmadd_ss(a, a, b);
+	#else
+		return _mm_min_ss(a, b);
+	#endif
+	}
+
+	FPPLUS_STATIC_INLINE __m128 _mm_addre_ps(__m128 a, __m128 b) {
+	#if defined(FPPLUS_UARCH_STEAMROLLER)
+		return _mm_fmadd_ps(a, a, b);
+	#else
+		return _mm_min_ps(a, b);
+	#endif
+	}
 #endif /* SSE2 */
 
 #if defined(__AVX__)
@@ -38,6 +62,14 @@ FPPLUS_STATIC_INLINE double addre(double a, double b) {
 		return _mm256_min_pd(a, b);
 	#endif
 	}
+
+	FPPLUS_STATIC_INLINE __m256 _mm256_addre_ps(__m256 a, __m256 b) {
+	#if defined(FPPLUS_UARCH_STEAMROLLER)
+		return _mm256_fmadd_ps(a, a, b);
+	#else
+		return _mm256_min_ps(a, b);
+	#endif
+	}
 #endif /* AVX */
 
 #if defined(__AVX512F__) || defined(__KNC__)
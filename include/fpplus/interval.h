@@ -0,0 +1,626 @@
+#pragma once
+#ifndef FPPLUS_INTERVAL_H
+#define FPPLUS_INTERVAL_H
+
+#include <fpplus/dd.h>
+
+/**
+ * @defgroup INTERVAL Interval arithmetic
+ * @details Intervals with double-precision and double-double endpoints, which enclose the exact results of operations on
+ * all numbers in the operand intervals. Endpoints are rounded outward without changes of the floating-point rounding mode:
+ * results are computed in round-to-nearest, and the sign of the roundoff error from an error-free transformation selects
+ * between the rounded result and its predecessor or successor.
+ *
+ * The predecessor and successor are computed with the branch-free algorithm of @cite RumpZimmermannBoldoMelquiond2009,
+ * which returns the adjacent floating-point number, except for numbers between 2**-1022 and 2**-1020 in magnitude,
+ * where it may return a number two steps away.
+ *
+ * The error-free transformations of multiplication, division, and square root are inexact when intermediate results underflow.
+ * Directed operations detect results which could underflow and widen them to the predecessor and successor unconditionally.
+ *
+ * Endpoints must not be NaN. On overflow the outer endpoint is infinite, and the inner endpoint is the largest finite number.
+ */
+
+
+/**
+ * @ingroup INTERVAL
+ * @brief Interval with double-precision endpoints.
+ */
+typedef struct {
+	/**
+	 * @brief The lower endpoint (infimum) of the interval.
+	 */
+	double inf;
+	/**
+	 * @brief The upper endpoint (supremum) of the interval.
+	 */
+	double sup;
+} doubleinterval;
+
+/**
+ * @ingroup INTERVAL
+ * @brief Interval with double-double endpoints.
+ */
+typedef struct {
+	/**
+	 * @brief The lower endpoint (infimum) of the interval.
+	 */
+	doubledouble inf;
+	/**
+	 * @brief The upper endpoint (supremum) of the interval.
+	 */
+	doubledouble sup;
+} ddinterval;
+
+
+/**
+ * @ingroup INTERVAL
+ * @brief Lower bound for the predecessor of a double-precision number.
+ * @details Implementation based on @cite RumpZimmermannBoldoMelquiond2009, Algorithm 2, in round-to-nearest.
+ *
+ * @param[in] a - the double-precision number.
+ * @return The largest double-precision number below @b a, or, if |a| is in [2**-1022, 2**-1020], a number at most two steps below @b a.
+ */
+FPPLUS_STATIC_INLINE double ivpred(const double a) {
+	const double abs_a = a < 0.0 ? -a : a;
+	return a - (abs_a * 1.1102230246251568e-16 /* 2**-53 * (1 + 2**-52) */ + 4.9406564584124654e-324 /* 2**-1074 */);
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Upper bound for the successor of a double-precision number.
+ * @details Implementation based on @cite RumpZimmermannBoldoMelquiond2009, Algorithm 2, in round-to-nearest.
+ *
+ * @param[in] a - the double-precision number.
+ * @return The smallest double-precision number above @b a, or, if |a| is in [2**-1022, 2**-1020], a number at most two steps above @b a.
+ */
+FPPLUS_STATIC_INLINE double ivsucc(const double a) {
+	const double abs_a = a < 0.0 ? -a : a;
+	return a + (abs_a * 1.1102230246251568e-16 /* 2**-53 * (1 + 2**-52) */ + 4.9406564584124654e-324 /* 2**-1074 */);
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Addition of double-precision numbers with rounding toward negative infinity.
+ * @details The sum is rounded to nearest, and replaced with its predecessor if the roundoff error is negative.
+ * If the sum overflows to positive infinity, the result is the largest finite number.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>EFADD</td><td>1</td></tr>
+ *         <tr><td>FP ADD</td><td>2</td></tr>
+ *         <tr><td>FP MUL</td><td>1</td></tr>
+ *     </table>
+ *
+ * @param[in] a - addend, the first double-precision number to be added.
+ * @param[in] b - augend, the second double-precision number to be added.
+ * @return The largest double-precision number which does not exceed @b a + @b b,
+ * or, if the sum is in [2**-1022, 2**-1020] in magnitude, a number at most two steps below it.
+ */
+FPPLUS_STATIC_INLINE double addrd(const double a, const double b) {
+	double e;
+	const double s = efadd(a, b, &e);
+	const double lower = e >= 0.0 ? s : ivpred(s);
+	/* Overflow produces NaN error, and NaN is replaced with the largest finite number */
+	return lower < 1.7976931348623157e+308 ? lower : 1.7976931348623157e+308;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Addition of double-precision numbers with rounding toward positive infinity.
+ * @details The sum is rounded to nearest, and replaced with its successor if the roundoff error is positive.
+ * If the sum overflows to negative infinity, the result is the smallest finite number.
+ *
+ * @param[in] a - addend, the first double-precision number to be added.
+ * @param[in] b - augend, the second double-precision number to be added.
+ * @return The smallest double-precision number which is not below @b a + @b b,
+ * or, if the sum is in [2**-1022, 2**-1020] in magnitude, a number at most two steps above it.
+ */
+FPPLUS_STATIC_INLINE double addru(const double a, const double b) {
+	double e;
+	const double s = efadd(a, b, &e);
+	const double upper = e <= 0.0 ? s : ivsucc(s);
+	return upper > -1.7976931348623157e+308 ? upper : -1.7976931348623157e+308;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Multiplication of double-precision numbers with rounding toward negative infinity.
+ * @details The product is rounded to nearest, and replaced with its predecessor if the roundoff error is negative,
+ * or if the product of non-zero numbers is below 2**-960 in magnitude, where the roundoff error may be inexact.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>EFMUL</td><td>1</td></tr>
+ *         <tr><td>FP ADD</td><td>1</td></tr>
+ *         <tr><td>FP MUL</td><td>1</td></tr>
+ *     </table>
+ *
+ * @param[in] a - multiplicand, the first double-precision number to be multiplied.
+ * @param[in] b - multiplier, the second double-precision number to be multiplied.
+ * @return A double-precision number which does not exceed @b a * @b b, and is at most two steps below it.
+ */
+FPPLUS_STATIC_INLINE double mulrd(const double a, const double b) {
+	double e;
+	const double p = efmul(a, b, &e);
+	const double abs_p = p < 0.0 ? -p : p;
+	const int underflow = (abs_p < 1.0261342003245941e-289 /* 2**-960 */) & (a != 0.0) & (b != 0.0);
+	const double lower = (e >= 0.0) & !underflow ? p : ivpred(p);
+	return lower < 1.7976931348623157e+308 ? lower : 1.7976931348623157e+308;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Multiplication of double-precision numbers with rounding toward positive infinity.
+ * @details The product is rounded to nearest, and replaced with its successor if the roundoff error is positive,
+ * or if the product of non-zero numbers is below 2**-960 in magnitude, where the roundoff error may be inexact.
+ *
+ * @param[in] a - multiplicand, the first double-precision number to be multiplied.
+ * @param[in] b - multiplier, the second double-precision number to be multiplied.
+ * @return A double-precision number which is not below @b a * @b b, and is at most two steps above it.
+ */
+FPPLUS_STATIC_INLINE double mulru(const double a, const double b) {
+	double e;
+	const double p = efmul(a, b, &e);
+	const double abs_p = p < 0.0 ? -p : p;
+	const int underflow = (abs_p < 1.0261342003245941e-289 /* 2**-960 */) & (a != 0.0) & (b != 0.0);
+	const double upper = (e <= 0.0) & !underflow ? p : ivsucc(p);
+	return upper > -1.7976931348623157e+308 ? upper : -1.7976931348623157e+308;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Division of double-precision numbers with rounding toward negative infinity.
+ * @details The quotient q is rounded to nearest, and the exact remainder r = a - q * b is computed with fused multiply-add.
+ * The exact quotient is q + r / b, and q is replaced with its predecessor if r / b is negative,
+ * or if the dividend or the quotient is non-zero and below 2**-960 in magnitude, where the remainder may be inexact.
+ *
+ * @param[in] a - dividend, the double-precision number to be divided.
+ * @param[in] b - divisor, the non-zero double-precision number to divide by.
+ * @return A double-precision number which does not exceed @b a / @b b, and is at most two steps below it.
+ */
+FPPLUS_STATIC_INLINE double divrd(const double a, const double b) {
+#if defined(__CUDA_ARCH__)
+	const double q = __ddiv_rn(a, b);
+	const double r = __fma_rn(-q, b, a);
+#else
+	const double q = a / b;
+#if defined(__GNUC__)
+	const double r = __builtin_fma(-q, b, a);
+#else
+	const double r = fma(-q, b, a);
+#endif
+#endif
+	const double e = b > 0.0 ? r : -r;
+	const double abs_a = a < 0.0 ? -a : a;
+	const double abs_q = q < 0.0 ? -q : q;
+	const int underflow = ((abs_a < 1.0261342003245941e-289 /* 2**-960 */) | (abs_q < 1.0261342003245941e-289)) & (a != 0.0);
+	const double lower = (e >= 0.0) & !underflow ? q : ivpred(q);
+	return lower < 1.7976931348623157e+308 ? lower : 1.7976931348623157e+308;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Division of double-precision numbers with rounding toward positive infinity.
+ * @details Same as divrd, but the quotient is replaced with its successor if the remainder divided by @b b is positive.
+ *
+ * @param[in] a - dividend, the double-precision number to be divided.
+ * @param[in] b - divisor, the non-zero double-precision number to divide by.
+ * @return A double-precision number which is not below @b a / @b b, and is at most two steps above it.
+ */
+FPPLUS_STATIC_INLINE double divru(const double a, const double b) {
+#if defined(__CUDA_ARCH__)
+	const double q = __ddiv_rn(a, b);
+	const double r = __fma_rn(-q, b, a);
+#else
+	const double q = a / b;
+#if defined(__GNUC__)
+	const double r = __builtin_fma(-q, b, a);
+#else
+	const double r = fma(-q, b, a);
+#endif
+#endif
+	const double e = b > 0.0 ? r : -r;
+	const double abs_a = a < 0.0 ? -a : a;
+	const double abs_q = q < 0.0 ? -q : q;
+	const int underflow = ((abs_a < 1.0261342003245941e-289 /* 2**-960 */) | (abs_q < 1.0261342003245941e-289)) & (a != 0.0);
+	const double upper = (e <= 0.0) & !underflow ? q : ivsucc(q);
+	return upper > -1.7976931348623157e+308 ? upper : -1.7976931348623157e+308;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Square root of a double-precision number with rounding toward negative infinity.
+ * @details The square root s is rounded to nearest, and replaced with its predecessor if the exact remainder a - s * s
+ * is negative, or if the argument is non-zero and below 2**-960, where the remainder may be inexact.
+ *
+ * @param[in] a - the non-negative double-precision number.
+ * @return A double-precision number which does not exceed the square root of @b a, and is at most two steps below it.
+ */
+FPPLUS_STATIC_INLINE double sqrtrd(const double a) {
+#if defined(__CUDA_ARCH__)
+	const double s = __dsqrt_rn(a);
+	const double r = __fma_rn(-s, s, a);
+#elif defined(__GNUC__)
+	const double s = __builtin_sqrt(a);
+	const double r = __builtin_fma(-s, s, a);
+#else
+	const double s = sqrt(a);
+	const double r = fma(-s, s, a);
+#endif
+	const int underflow = (a < 1.0261342003245941e-289 /* 2**-960 */) & (a != 0.0);
+	const double lower = (r >= 0.0) & !underflow ? s : ivpred(s);
+	return lower < 1.7976931348623157e+308 ? lower : 1.7976931348623157e+308;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Square root of a double-precision number with rounding toward positive infinity.
+ * @details Same as sqrtrd, but the square root is replaced with its successor if the exact remainder is positive.
+ *
+ * @param[in] a - the non-negative double-precision number.
+ * @return A double-precision number which is not below the square root of @b a, and is at most two steps above it.
+ */
+FPPLUS_STATIC_INLINE double sqrtru(const double a) {
+#if defined(__CUDA_ARCH__)
+	const double s = __dsqrt_rn(a);
+	const double r = __fma_rn(-s, s, a);
+#elif defined(__GNUC__)
+	const double s = __builtin_sqrt(a);
+	const double r = __builtin_fma(-s, s, a);
+#else
+	const double s = sqrt(a);
+	const double r = fma(-s, s, a);
+#endif
+	const int underflow = (a < 1.0261342003245941e-289 /* 2**-960 */) & (a != 0.0);
+	return (r <= 0.0) & !underflow ? s : ivsucc(s);
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Addition of intervals with double-precision endpoints.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>EFADD</td><td>2</td></tr>
+ *     </table>
+ *
+ * @param[in] a - addend, the first interval to be added.
+ * @param[in] b - augend, the second interval to be added.
+ * @return An interval which contains the sums of all numbers in @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE doubleinterval ivadd(const doubleinterval a, const doubleinterval b) {
+	doubleinterval sum;
+	sum.inf = addrd(a.inf, b.inf);
+	sum.sup = addru(a.sup, b.sup);
+	return sum;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Subtraction of intervals with double-precision endpoints.
+ *
+ * @param[in] a - minuend, the interval to subtract from.
+ * @param[in] b - subtrahend, the interval to be subtracted.
+ * @return An interval which contains the differences of all numbers in @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE doubleinterval ivsub(const doubleinterval a, const doubleinterval b) {
+	doubleinterval difference;
+	difference.inf = addrd(a.inf, -b.sup);
+	difference.sup = addru(a.sup, -b.inf);
+	return difference;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Multiplication of intervals with double-precision endpoints.
+ * @details The result is the hull of the products of endpoints, without case analysis on the signs of the endpoints:
+ * both directed roundings of each product share one error-free multiplication.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>EFMUL</td><td>4</td></tr>
+ *     </table>
+ *
+ * @param[in] a - multiplicand, the first interval to be multiplied.
+ * @param[in] b - multiplier, the second interval to be multiplied.
+ * @return An interval which contains the products of all numbers in @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE doubleinterval ivmul(const doubleinterval a, const doubleinterval b) {
+	const double lower0 = mulrd(a.inf, b.inf);
+	const double lower1 = mulrd(a.inf, b.sup);
+	const double lower2 = mulrd(a.sup, b.inf);
+	const double lower3 = mulrd(a.sup, b.sup);
+	const double upper0 = mulru(a.inf, b.inf);
+	const double upper1 = mulru(a.inf, b.sup);
+	const double upper2 = mulru(a.sup, b.inf);
+	const double upper3 = mulru(a.sup, b.sup);
+	const double lower01 = lower0 < lower1 ? lower0 : lower1;
+	const double lower23 = lower2 < lower3 ? lower2 : lower3;
+	const double upper01 = upper0 > upper1 ? upper0 : upper1;
+	const double upper23 = upper2 > upper3 ? upper2 : upper3;
+	doubleinterval product;
+	product.inf = lower01 < lower23 ? lower01 : lower23;
+	product.sup = upper01 > upper23 ? upper01 : upper23;
+	return product;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Division of intervals with double-precision endpoints.
+ * @details If the divisor contains zero, the result is the entire real line.
+ *
+ * @param[in] a - dividend, the interval to be divided.
+ * @param[in] b - divisor, the interval to divide by.
+ * @return An interval which contains the quotients of all numbers in @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE doubleinterval ivdiv(const doubleinterval a, const doubleinterval b) {
+	doubleinterval quotient;
+	if ((b.inf <= 0.0) & (b.sup >= 0.0)) {
+#if defined(__CUDA_ARCH__) || !defined(__GNUC__)
+		quotient.inf = -HUGE_VAL;
+		quotient.sup = HUGE_VAL;
+#else
+		quotient.inf = -__builtin_inf();
+		quotient.sup = __builtin_inf();
+#endif
+		return quotient;
+	}
+	const double lower0 = divrd(a.inf, b.inf);
+	const double lower1 = divrd(a.inf, b.sup);
+	const double lower2 = divrd(a.sup, b.inf);
+	const double lower3 = divrd(a.sup, b.sup);
+	const double upper0 = divru(a.inf, b.inf);
+	const double upper1 = divru(a.inf, b.sup);
+	const double upper2 = divru(a.sup, b.inf);
+	const double upper3 = divru(a.sup, b.sup);
+	const double lower01 = lower0 < lower1 ? lower0 : lower1;
+	const double lower23 = lower2 < lower3 ? lower2 : lower3;
+	const double upper01 = upper0 > upper1 ? upper0 : upper1;
+	const double upper23 = upper2 > upper3 ? upper2 : upper3;
+	quotient.inf = lower01 < lower23 ? lower01 : lower23;
+	quotient.sup = upper01 > upper23 ? upper01 : upper23;
+	return quotient;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Square root of an interval with double-precision endpoints.
+ * @details The negative part of the interval is ignored. The upper endpoint must be non-negative.
+ *
+ * @param[in] a - the interval.
+ * @return An interval which contains the square roots of all non-negative numbers in @b a.
+ */
+FPPLUS_STATIC_INLINE doubleinterval ivsqrt(const doubleinterval a) {
+	doubleinterval root;
+	root.inf = sqrtrd(a.inf > 0.0 ? a.inf : 0.0);
+	root.sup = sqrtru(a.sup);
+	return root;
+}
+
+
+/**
+ * @ingroup INTERVAL
+ * @brief Minimum of two double-double numbers.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddmin(const doubledouble a, const doubledouble b) {
+	return (a.hi < b.hi) | ((a.hi == b.hi) & (a.lo < b.lo)) ? a : b;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Maximum of two double-double numbers.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddmax(const doubledouble a, const doubledouble b) {
+	return (a.hi > b.hi) | ((a.hi == b.hi) & (a.lo > b.lo)) ? a : b;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Bound on the error of a double-double addition or multiplication with result of magnitude up to @b abs_hi.
+ * @details The relative errors of ddadd and ddmul on normalized double-double numbers are a few units of 2**-106
+ * (@cite JoldesMullerPopescu2017). The bound adds a wide margin: it is 2**-100 relative to the result,
+ * plus 2**-1068 for the absolute roundoff errors of subnormal intermediate results.
+ */
+FPPLUS_STATIC_INLINE double ddiverror(const double abs_hi) {
+	return abs_hi * 7.888609052210118e-31 /* 2**-100 */ + 3.16e-322 /* 2**-1068 */;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Moves a double-double number down by at least the error bound.
+ * @details The low part is decremented with rounding toward negative infinity, and the result is renormalized.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddivdown(const doubledouble a, const double bound) {
+	doubledouble lower;
+	const double lo = addrd(a.lo, -bound);
+	/* The sum of the parts is representable as a double-double number: the renormalization is exact */
+	lower.hi = efadd(a.hi, lo, &lower.lo);
+	return lower;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Moves a double-double number up by at least the error bound.
+ * @details The low part is incremented with rounding toward positive infinity, and the result is renormalized.
+ */
+FPPLUS_STATIC_INLINE doubledouble ddivup(const doubledouble a, const double bound) {
+	doubledouble upper;
+	const double lo = addru(a.lo, bound);
+	upper.hi = efadd(a.hi, lo, &upper.lo);
+	return upper;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Addition of intervals with double-double endpoints.
+ * @details The endpoints are computed with ddadd, and moved outward by a bound on its roundoff error.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD ADD</td><td>2</td></tr>
+ *         <tr><td>EFADD</td><td>4</td></tr>
+ *     </table>
+ *
+ * @param[in] a - addend, the first interval to be added.
+ * @param[in] b - augend, the second interval to be added.
+ * @return An interval which contains the sums of all numbers in @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddinterval ddivadd(const ddinterval a, const ddinterval b) {
+	const doubledouble lower = ddadd(a.inf, b.inf);
+	const doubledouble upper = ddadd(a.sup, b.sup);
+	ddinterval sum;
+	sum.inf = ddivdown(lower, ddiverror(lower.hi < 0.0 ? -lower.hi : lower.hi));
+	sum.sup = ddivup(upper, ddiverror(upper.hi < 0.0 ? -upper.hi : upper.hi));
+	return sum;
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Subtraction of intervals with double-double endpoints.
+ *
+ * @param[in] a - minuend, the interval to subtract from.
+ * @param[in] b - subtrahend, the interval to be subtracted.
+ * @return An interval which contains the differences of all numbers in @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddinterval ddivsub(const ddinterval a, const ddinterval b) {
+	ddinterval negation;
+	negation.inf.hi = -b.sup.hi;
+	negation.inf.lo = -b.sup.lo;
+	negation.sup.hi = -b.inf.hi;
+	negation.sup.lo = -b.inf.lo;
+	return ddivadd(a, negation);
+}
+
+/**
+ * @ingroup INTERVAL
+ * @brief Multiplication of intervals with double-double endpoints.
+ * @details The endpoints are the minimum and the maximum of the ddmul products of the endpoints,
+ * moved outward by a bound on the roundoff error of the largest product, which also bounds the errors of all other products.
+ *
+ * @par	Computational complexity
+ *     <table>
+ *         <tr><th>Operation</th><th>Count (default ISA)</th></tr>
+ *         <tr><td>DD MUL</td><td>4</td></tr>
+ *         <tr><td>EFADD</td><td>4</td></tr>
+ *     </table>
+ *
+ * @param[in] a - multiplicand, the first interval to be multiplied.
+ * @param[in] b - multiplier, the second interval to be multiplied.
+ * @return An interval which contains the products of all numbers in @b a and @b b.
+ */
+FPPLUS_STATIC_INLINE ddinterval ddivmul(const ddinterval a, const ddinterval b) {
+	const doubledouble product0 = ddmul(a.inf, b.inf);
+	const doubledouble product1 = ddmul(a.inf, b.sup);
+	const doubledouble product2 = ddmul(a.sup, b.inf);
+	const doubledouble product3 = ddmul(a.sup, b.sup);
+	const doubledouble lower = ddmin(ddmin(product0, product1), ddmin(product2, product3));
+	const doubledouble upper = ddmax(ddmax(product0, product1), ddmax(product2, product3));
+	const double abs_lower = lower.hi < 0.0 ? -lower.hi : lower.hi;
+	const double abs_upper = upper.hi < 0.0 ? -upper.hi : upper.hi;
+	const double bound = ddiverror(abs_lower > abs_upper ? abs_lower : abs_upper);
+	ddinterval product;
+	product.inf = ddivdown(lower, bound);
+	product.sup = ddivup(upper, bound);
+	return product;
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+
+/**
+ * @ingroup INTERVAL
+ * @brief 4 intervals with double-precision endpoints in AVX registers.
+ */
+typedef struct {
+	__m256d inf;
+	__m256d sup;
+} __m256di;
+
+FPPLUS_STATIC_INLINE __m256di _mm256_broadcast_sdi(
+	const doubleinterval FPPLUS_NONNULL_POINTER(pointer))
+{
+	return (__m256di) { _mm256_broadcast_sd(&pointer->inf), _mm256_broadcast_sd(&pointer->sup) };
+}
+
+FPPLUS_STATIC_INLINE __m256d _mm256_pred_pd(const __m256d a) {
+	const __m256d abs_a = _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+	const __m256d phi = _mm256_set1_pd(1.1102230246251568e-16 /* 2**-53 * (1 + 2**-52) */);
+	const __m256d eta = _mm256_set1_pd(4.9406564584124654e-324 /* 2**-1074 */);
+	return _mm256_sub_pd(a, _mm256_add_pd(_mm256_mul_pd(abs_a, phi), eta));
+}
+
+FPPLUS_STATIC_INLINE __m256d _mm256_succ_pd(const __m256d a) {
+	const __m256d abs_a = _mm256_andnot_pd(_mm256_set1_pd(-0.0), a);
+	const __m256d phi = _mm256_set1_pd(1.1102230246251568e-16 /* 2**-53 * (1 + 2**-52) */);
+	const __m256d eta = _mm256_set1_pd(4.9406564584124654e-324 /* 2**-1074 */);
+	return _mm256_add_pd(a, _mm256_add_pd(_mm256_mul_pd(abs_a, phi), eta));
+}
+
+FPPLUS_STATIC_INLINE __m256d _mm256_addrd_pd(const __m256d a, const __m256d b) {
+	__m256d e;
+	const __m256d s = _mm256_efadd_pd(a, b, &e);
+	const __m256d exact_mask = _mm256_cmp_pd(e, _mm256_setzero_pd(), _CMP_GE_OQ);
+	/* NaN error on overflow selects the predecessor, which is NaN, and min replaces NaN with the largest finite number */
+	return _mm256_min_pd(_mm256_blendv_pd(_mm256_pred_pd(s), s, exact_mask), _mm256_set1_pd(1.7976931348623157e+308));
+}
+
+FPPLUS_STATIC_INLINE __m256d _mm256_addru_pd(const __m256d a, const __m256d b) {
+	__m256d e;
+	const __m256d s = _mm256_efadd_pd(a, b, &e);
+	const __m256d exact_mask = _mm256_cmp_pd(e, _mm256_setzero_pd(), _CMP_LE_OQ);
+	return _mm256_max_pd(_mm256_blendv_pd(_mm256_succ_pd(s), s, exact_mask), _mm256_set1_pd(-1.7976931348623157e+308));
+}
+
+/* Mask of products of non-zero numbers below 2**-960 in magnitude, where the error of efmul may be inexact */
+FPPLUS_STATIC_INLINE __m256d _mm256_mulunderflow_pd(const __m256d a, const __m256d b, const __m256d p) {
+	const __m256d zero = _mm256_setzero_pd();
+	const __m256d abs_p = _mm256_andnot_pd(_mm256_set1_pd(-0.0), p);
+	const __m256d tiny_mask = _mm256_cmp_pd(abs_p, _mm256_set1_pd(1.0261342003245941e-289 /* 2**-960 */), _CMP_LT_OQ);
+	const __m256d zero_mask = _mm256_or_pd(_mm256_cmp_pd(a, zero, _CMP_EQ_OQ), _mm256_cmp_pd(b, zero, _CMP_EQ_OQ));
+	return _mm256_andnot_pd(zero_mask, tiny_mask);
+}
+
+FPPLUS_STATIC_INLINE __m256d _mm256_mulrd_pd(const __m256d a, const __m256d b) {
+	__m256d e;
+	const __m256d p = _mm256_efmul_pd(a, b, &e);
+	const __m256d exact_mask = _mm256_andnot_pd(_mm256_mulunderflow_pd(a, b, p),
+		_mm256_cmp_pd(e, _mm256_setzero_pd(), _CMP_GE_OQ));
+	return _mm256_min_pd(_mm256_blendv_pd(_mm256_pred_pd(p), p, exact_mask), _mm256_set1_pd(1.7976931348623157e+308));
+}
+
+FPPLUS_STATIC_INLINE __m256d _mm256_mulru_pd(const __m256d a, const __m256d b) {
+	__m256d e;
+	const __m256d p = _mm256_efmul_pd(a, b, &e);
+	const __m256d exact_mask = _mm256_andnot_pd(_mm256_mulunderflow_pd(a, b, p),
+		_mm256_cmp_pd(e, _mm256_setzero_pd(), _CMP_LE_OQ));
+	return _mm256_max_pd(_mm256_blendv_pd(_mm256_succ_pd(p), p, exact_mask), _mm256_set1_pd(-1.7976931348623157e+308));
+}
+
+FPPLUS_STATIC_INLINE __m256di _mm256_add_pdi(const __m256di a, const __m256di b) {
+	return (__m256di) { _mm256_addrd_pd(a.inf, b.inf), _mm256_addru_pd(a.sup, b.sup) };
+}
+
+FPPLUS_STATIC_INLINE __m256di _mm256_sub_pdi(const __m256di a, const __m256di b) {
+	const __m256d sign = _mm256_set1_pd(-0.0);
+	return (__m256di) {
+		_mm256_addrd_pd(a.inf, _mm256_xor_pd(b.sup, sign)),
+		_mm256_addru_pd(a.sup, _mm256_xor_pd(b.inf, sign))
+	};
+}
+
+FPPLUS_STATIC_INLINE __m256di _mm256_mul_pdi(const __m256di a, const __m256di b) {
+	const __m256d lower01 = _mm256_min_pd(_mm256_mulrd_pd(a.inf, b.inf), _mm256_mulrd_pd(a.inf, b.sup));
+	const __m256d lower23 = _mm256_min_pd(_mm256_mulrd_pd(a.sup, b.inf), _mm256_mulrd_pd(a.sup, b.sup));
+	const __m256d upper01 = _mm256_max_pd(_mm256_mulru_pd(a.inf, b.inf), _mm256_mulru_pd(a.inf, b.sup));
+	const __m256d upper23 = _mm256_max_pd(_mm256_mulru_pd(a.sup, b.inf), _mm256_mulru_pd(a.sup, b.sup));
+	return (__m256di) { _mm256_min_pd(lower01, lower23), _mm256_max_pd(upper01, upper23) };
+}
+
+#endif /* AVX */
+
+#endif /* FPPLUS_INTERVAL_H */
@@ -0,0 +1,280 @@
+#pragma once
+#ifndef FPPLUS_LAYOUT_H
+#define FPPLUS_LAYOUT_H
+
+#include <fpplus/dd.h>
+
+#if !defined(__OPENCL_VERSION__) && !defined(__CUDA_ARCH__)
+	#include <stddef.h>
+	#include <stdlib.h>
+	#include <string.h>
+	#if defined(_MSC_VER)
+		#include <malloc.h>
+	#endif
+#endif
+
+/**
+ * @defgroup LAYOUT Memory layouts of double-double arrays
+ * @details Arrays of doubledouble structures (AoS) interleave high and low parts in memory,
+ * so SIMD loads and stores of AoS arrays need shuffles (see _mm256_loaddeinterleave_pdd and _mm256_interleavestore_pdd).
+ * This header provides two layouts which keep high and low parts in separate streams:
+ * - Structure of arrays (SoA): all high parts, followed by all low parts in a separate array.
+ * - Array of structures of arrays (AoSoA): blocks of 4 high parts followed by 4 low parts,
+ *   which matches the layout of __m256dd and keeps both parts of an element in the same cache line.
+ */
+
+
+#if !defined(__OPENCL_VERSION__) && !defined(__CUDA_ARCH__)
+
+/**
+ * @ingroup LAYOUT
+ * @brief Alignment, in bytes, of the arrays allocated by ddsoa_alloc and ddaosoa4_alloc.
+ * @details Cache line size, which is also sufficient for aligned loads of 256-bit and 512-bit SIMD vectors.
+ */
+#define FPPLUS_LAYOUT_ALIGNMENT 64
+
+FPPLUS_STATIC_INLINE void* fpplus_layout_alloc(size_t size) {
+#if defined(_MSC_VER)
+	return _aligned_malloc(size, FPPLUS_LAYOUT_ALIGNMENT);
+#else
+	void* pointer = NULL;
+	if (posix_memalign(&pointer, FPPLUS_LAYOUT_ALIGNMENT, size) != 0) {
+		return NULL;
+	}
+	return pointer;
+#endif
+}
+
+FPPLUS_STATIC_INLINE void fpplus_layout_free(void* pointer) {
+#if defined(_MSC_VER)
+	_aligned_free(pointer);
+#else
+	free(pointer);
+#endif
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Structure-of-arrays double-double array.
+ */
+typedef struct {
+	/**
+	 * @brief High parts of the elements, aligned on FPPLUS_LAYOUT_ALIGNMENT.
+	 */
+	double* hi;
+	/**
+	 * @brief Low parts of the elements, aligned on FPPLUS_LAYOUT_ALIGNMENT.
+	 */
+	double* lo;
+	/**
+	 * @brief The number of elements.
+	 */
+	size_t length;
+} ddsoa;
+
+/**
+ * @ingroup LAYOUT
+ * @brief Allocates a structure-of-arrays double-double array.
+ * @details Both streams are padded with zeros to a multiple of FPPLUS_LAYOUT_ALIGNMENT bytes,
+ * so SIMD loops may process the last partial vector without a scalar remainder.
+ *
+ * @param length - the number of elements in the array.
+ * @return The allocated array. On allocation failure, both @b hi and @b lo are NULL.
+ */
+FPPLUS_STATIC_INLINE ddsoa ddsoa_alloc(size_t length) {
+	const size_t elements_per_line = FPPLUS_LAYOUT_ALIGNMENT / sizeof(double);
+	const size_t padded_length = (length + elements_per_line - 1) / elements_per_line * elements_per_line;
+	ddsoa array = { NULL, NULL, length };
+	array.hi = (double*) fpplus_layout_alloc(2 * padded_length * sizeof(double));
+	if (array.hi != NULL) {
+		memset(array.hi, 0, 2 * padded_length * sizeof(double));
+		array.lo = array.hi + padded_length;
+	}
+	return array;
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Releases an array allocated by ddsoa_alloc.
+ */
+FPPLUS_STATIC_INLINE void ddsoa_free(ddsoa array) {
+	fpplus_layout_free(array.hi);
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Block of 4 double-double numbers in array-of-structures-of-arrays layout.
+ * @details The layout of the block is the same as the layout of __m256dd.
+ */
+typedef struct {
+	/**
+	 * @brief High parts of the 4 elements in the block.
+	 */
+	double hi[4];
+	/**
+	 * @brief Low parts of the 4 elements in the block.
+	 */
+	double lo[4];
+} ddaosoa4;
+
+/**
+ * @ingroup LAYOUT
+ * @brief Allocates an array-of-structures-of-arrays double-double array.
+ * @details The last block is padded with zeros.
+ *
+ * @param length - the number of elements in the array.
+ * @return Pointer to the first of (@b length + 3) / 4 blocks, aligned on FPPLUS_LAYOUT_ALIGNMENT, or NULL on allocation failure.
+ */
+FPPLUS_STATIC_INLINE ddaosoa4* ddaosoa4_alloc(size_t length) {
+	const size_t blocks = (length + 3) / 4;
+	ddaosoa4* array = (ddaosoa4*) fpplus_layout_alloc(blocks * sizeof(ddaosoa4));
+	if (array != NULL) {
+		memset(array, 0, blocks * sizeof(ddaosoa4));
+	}
+	return array;
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Releases an array allocated by ddaosoa4_alloc.
+ */
+FPPLUS_STATIC_INLINE void ddaosoa4_free(ddaosoa4* array) {
+	fpplus_layout_free(array);
+}
+
+#endif /* !OpenCL && !CUDA */
+
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+
+/**
+ * @ingroup LAYOUT
+ * @brief Loads 4 double-double numbers from separate streams of high and low parts.
+ * @param hi - pointer to the high parts, aligned on 32 bytes.
+ * @param lo - pointer to the low parts, aligned on 32 bytes.
+ */
+FPPLUS_STATIC_INLINE __m256dd _mm256_loadsoa_pdd(
+	const double FPPLUS_ARRAY_POINTER(hi, 4),
+	const double FPPLUS_ARRAY_POINTER(lo, 4))
+{
+	return (__m256dd) { _mm256_load_pd(hi), _mm256_load_pd(lo) };
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Stores 4 double-double numbers to separate streams of high and low parts.
+ * @param hi - pointer to the high parts, aligned on 32 bytes.
+ * @param lo - pointer to the low parts, aligned on 32 bytes.
+ */
+FPPLUS_STATIC_INLINE void _mm256_storesoa_pdd(
+	double FPPLUS_ARRAY_POINTER(hi, 4),
+	double FPPLUS_ARRAY_POINTER(lo, 4),
+	__m256dd numbers)
+{
+	_mm256_store_pd(hi, numbers.hi);
+	_mm256_store_pd(lo, numbers.lo);
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Loads a block of 4 double-double numbers in AoSoA layout.
+ * @param block - pointer to the block, aligned on 32 bytes.
+ */
+FPPLUS_STATIC_INLINE __m256dd _mm256_loadaosoa_pdd(
+	const ddaosoa4 FPPLUS_NONNULL_POINTER(block))
+{
+	return (__m256dd) { _mm256_load_pd(block->hi), _mm256_load_pd(block->lo) };
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Stores a block of 4 double-double numbers in AoSoA layout.
+ * @param block - pointer to the block, aligned on 32 bytes.
+ */
+FPPLUS_STATIC_INLINE void _mm256_storeaosoa_pdd(
+	ddaosoa4 FPPLUS_NONNULL_POINTER(block),
+	__m256dd numbers)
+{
+	_mm256_store_pd(block->hi, numbers.hi);
+	_mm256_store_pd(block->lo, numbers.lo);
+}
+
+#endif /* AVX */
+
+
+/**
+ * @ingroup LAYOUT
+ * @brief Converts an array of doubledouble structures to separate arrays of high and low parts.
+ */
+FPPLUS_STATIC_INLINE void ddsoa_from_aos(size_t length,
+	const doubledouble FPPLUS_ARRAY_POINTER(aos, length),
+	double FPPLUS_ARRAY_POINTER(hi, length),
+	double FPPLUS_ARRAY_POINTER(lo, length))
+{
+	size_t i = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	for (; i + 4 <= length; i += 4) {
+		const __m256dd numbers = _mm256_loaddeinterleaveu_pdd(&aos[i]);
+		_mm256_storeu_pd(&hi[i], numbers.hi);
+		_mm256_storeu_pd(&lo[i], numbers.lo);
+	}
+#endif
+	for (; i < length; i++) {
+		hi[i] = aos[i].hi;
+		lo[i] = aos[i].lo;
+	}
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Converts separate arrays of high and low parts to an array of doubledouble structures.
+ */
+FPPLUS_STATIC_INLINE void ddsoa_to_aos(size_t length,
+	const double FPPLUS_ARRAY_POINTER(hi, length),
+	const double FPPLUS_ARRAY_POINTER(lo, length),
+	doubledouble FPPLUS_ARRAY_POINTER(aos, length))
+{
+	size_t i = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	for (; i + 4 <= length; i += 4) {
+		const __m256dd numbers = { _mm256_loadu_pd(&hi[i]), _mm256_loadu_pd(&lo[i]) };
+		_mm256_interleavestoreu_pdd(&aos[i], numbers);
+	}
+#endif
+	for (; i < length; i++) {
+		aos[i].hi = hi[i];
+		aos[i].lo = lo[i];
+	}
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Converts an array of doubledouble structures to AoSoA blocks.
+ * @details Elements of the last block beyond @b length are set to zero.
+ */
+FPPLUS_STATIC_INLINE void ddaosoa4_from_aos(size_t length,
+	const doubledouble FPPLUS_ARRAY_POINTER(aos, length),
+	ddaosoa4 FPPLUS_ARRAY_POINTER(blocks, (length + 3) / 4))
+{
+	for (size_t i = 0; i < (length + 3) / 4 * 4; i++) {
+		const doubledouble number = i < length ? aos[i] : (doubledouble) { 0.0, 0.0 };
+		blocks[i / 4].hi[i % 4] = number.hi;
+		blocks[i / 4].lo[i % 4] = number.lo;
+	}
+}
+
+/**
+ * @ingroup LAYOUT
+ * @brief Converts AoSoA blocks to an array of doubledouble structures.
+ */
+FPPLUS_STATIC_INLINE void ddaosoa4_to_aos(size_t length,
+	const ddaosoa4 FPPLUS_ARRAY_POINTER(blocks, (length + 3) / 4),
+	doubledouble FPPLUS_ARRAY_POINTER(aos, length))
+{
+	for (size_t i = 0; i < length; i++) {
+		aos[i].hi = blocks[i / 4].hi[i % 4];
+		aos[i].lo = blocks[i / 4].lo[i % 4];
+	}
+}
+
+#endif /* FPPLUS_LAYOUT_H */
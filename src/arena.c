@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#include <arena.h>
+
+/* Size of transparent huge pages on x86-64 */
+#define ARENA_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+bool arena_init(struct arena arena[restrict static 1], size_t capacity, uint32_t flags) {
+    memset(arena, 0, sizeof(struct arena));
+    if (capacity == 0) {
+        capacity = ARENA_ALIGNMENT;
+    }
+#if defined(__linux__)
+    const size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+    if (flags & arena_flag_huge_pages) {
+        capacity = (capacity + ARENA_HUGE_PAGE_SIZE - 1) / ARENA_HUGE_PAGE_SIZE * ARENA_HUGE_PAGE_SIZE;
+        /* Over-allocate to align the arena on huge page boundary, and unmap the unaligned head and tail */
+        char* region = mmap(NULL, capacity + ARENA_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+            return false;
+        }
+        char* base = (char*) (((uintptr_t) region + ARENA_HUGE_PAGE_SIZE - 1) & ~((uintptr_t) ARENA_HUGE_PAGE_SIZE - 1));
+        if (base != region) {
+            munmap(region, (size_t) (base - region));
+        }
+        munmap(base + capacity, ARENA_HUGE_PAGE_SIZE - (size_t) (base - region));
+#ifdef MADV_HUGEPAGE
+        madvise(base, capacity, MADV_HUGEPAGE);
+#endif
+        arena->base = base;
+    } else {
+        capacity = (capacity + page_size - 1) / page_size * page_size;
+        char* base = mmap(NULL, capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            return false;
+        }
+        arena->base = base;
+    }
+    arena->mapped = true;
+#else
+    const size_t page_size = 4096;
+    capacity = (capacity + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    void* base = NULL;
+    if (posix_memalign(&base, ARENA_ALIGNMENT, capacity) != 0) {
+        return false;
+    }
+    arena->base = base;
+#endif
+    arena->capacity = capacity;
+    if (flags & arena_flag_prefault) {
+        /* Write, rather than read, so the pages are not mapped to the shared zero page */
+        for (size_t offset = 0; offset < capacity; offset += page_size) {
+            ((volatile char*) arena->base)[offset] = 0;
+        }
+    }
+    return true;
+}
+
+void* arena_alloc(struct arena arena[restrict static 1], size_t size) {
+    const size_t offset = (arena->offset + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+    if (offset > arena->capacity || size > arena->capacity - offset) {
+        return NULL;
+    }
+    arena->offset = offset + size;
+    return arena->base + offset;
+}
+
+void arena_reset(struct arena arena[restrict static 1]) {
+    arena->offset = 0;
+}
+
+void arena_release(struct arena arena[restrict static 1]) {
+#if defined(__linux__)
+    if (arena->mapped) {
+        munmap(arena->base, arena->capacity);
+    }
+#else
+    free(arena->base);
+#endif
+    memset(arena, 0, sizeof(struct arena));
+}
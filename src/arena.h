@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Alignment of allocations from an arena: cache line size, which is also sufficient for all SIMD loads
+ */
+#define ARENA_ALIGNMENT 64
+
+/**
+ * @brief Options of arena initialization (bit mask)
+ */
+enum arena_flags {
+    /** Ask the kernel to back the arena with transparent huge pages (madvise(MADV_HUGEPAGE) on Linux) */
+    arena_flag_huge_pages = 1,
+    /** Touch all pages of the arena at initialization, so allocations do not page-fault later */
+    arena_flag_prefault = 2,
+};
+
+/**
+ * @brief Bump-pointer allocator for benchmark arrays and work buffers
+ * @details Memory is reserved once in arena_init. Allocations from the arena are never freed individually:
+ *          arena_reset releases all of them at once, and the memory is reused by subsequent allocations
+ *          without returning it to the operating system.
+ */
+struct arena {
+    char* base;
+    size_t capacity;
+    size_t offset;
+    /* Whether the memory was mapped with mmap, rather than allocated with posix_memalign */
+    bool mapped;
+};
+
+/**
+ * @brief Reserves memory for an arena
+ * @param capacity - the size of the arena in bytes. With arena_flag_huge_pages, it is rounded up to a whole number of 2 MB pages.
+ * @param flags - bit mask of arena_flags.
+ * @return true on success, false if the memory can not be reserved.
+ */
+bool arena_init(struct arena arena[restrict static 1], size_t capacity, uint32_t flags);
+
+/**
+ * @brief Allocates memory from the arena, aligned on ARENA_ALIGNMENT bytes
+ * @return Pointer to the allocated memory, or NULL if the arena does not have enough space left.
+ */
+void* arena_alloc(struct arena arena[restrict static 1], size_t size);
+
+/**
+ * @brief Releases all allocations from the arena, but keeps the memory reserved
+ */
+void arena_reset(struct arena arena[restrict static 1]);
+
+/**
+ * @brief Returns the memory of the arena to the operating system
+ */
+void arena_release(struct arena arena[restrict static 1]);
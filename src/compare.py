@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+
+from __future__ import print_function
+
+import sys
+import csv
+import json
+import math
+import argparse
+
+
+parser = argparse.ArgumentParser(
+    description="Compare two benchmark reports produced with --format=csv or --format=json")
+parser.add_argument("baseline", help="Report of the baseline build")
+parser.add_argument("candidate", help="Report of the candidate build")
+parser.add_argument("--threshold", dest="threshold", type=float, default=0.02,
+    help="Minimal relative change of the median to consider (default: 0.02)")
+parser.add_argument("--alpha", dest="alpha", type=float, default=0.01,
+    help="Significance level of the Welch t-test (default: 0.01)")
+
+
+def load_report(path):
+    with open(path) as report_file:
+        content = report_file.read()
+    if content.lstrip().startswith("{"):
+        report = json.loads(content)
+        metadata = {key: value for key, value in report.items() if key != "results"}
+        results = report["results"]
+    else:
+        metadata, lines = {}, []
+        for line in content.splitlines():
+            if line.startswith("#"):
+                key, _, value = line[1:].partition(":")
+                metadata[key.strip()] = value.strip()
+            elif line.strip():
+                lines.append(line)
+        results = list(csv.DictReader(lines))
+        for result in results:
+            result["size"] = int(result["size"])
+            result["count"] = int(result["count"])
+            for key in ["min", "median", "mean", "max", "stddev"]:
+                result[key] = float(result[key])
+    return metadata, {(result["name"], result["size"], result["unit"]): result for result in results}
+
+
+def welch_p_value(a, b):
+    """Two-sided p-value of the Welch t-test from summary statistics.
+
+    Uses the normal approximation of the t distribution: benchmarks run tens to thousands of iterations,
+    and the approximation avoids a dependency on SciPy."""
+    variance = a["stddev"] ** 2 / a["count"] + b["stddev"] ** 2 / b["count"]
+    if variance == 0.0:
+        return 0.0 if a["mean"] != b["mean"] else 1.0
+    t = (a["mean"] - b["mean"]) / math.sqrt(variance)
+    return math.erfc(abs(t) / math.sqrt(2.0))
+
+
+def main(options):
+    baseline_metadata, baseline = load_report(options.baseline)
+    candidate_metadata, candidate = load_report(options.candidate)
+
+    for key in ["benchmark", "cpu", "uarch", "fpaddre"]:
+        if baseline_metadata.get(key) != candidate_metadata.get(key):
+            print("Warning: {key} differs: \"{baseline}\" vs \"{candidate}\"".format(key=key,
+                baseline=baseline_metadata.get(key), candidate=candidate_metadata.get(key)), file=sys.stderr)
+
+    regressions = 0
+    for key in sorted(set(baseline) & set(candidate)):
+        old, new = baseline[key], candidate[key]
+        if old["median"] != 0.0:
+            change = (new["median"] - old["median"]) / old["median"]
+        else:
+            # Exact results (zero relative error) in the baseline
+            change = 0.0 if new["median"] == 0.0 else math.copysign(float("inf"), new["median"])
+        if old["better"] == "higher":
+            change = -change
+        p_value = welch_p_value(old, new)
+        if abs(change) < options.threshold or p_value >= options.alpha:
+            verdict = ""
+        elif change > 0.0:
+            verdict = "REGRESSION"
+            regressions += 1
+        else:
+            verdict = "improvement"
+        print("{name:32s} {size:>10d} {old:>12.4g} {new:>12.4g} {unit:>15s} {change:>+8.1%} p={p:<8.2g} {verdict}".format(
+            name=key[0], size=key[1], old=old["median"], new=new["median"], unit=key[2],
+            change=-change if old["better"] == "higher" else change, p=p_value, verdict=verdict))
+
+    for key in sorted(set(baseline) ^ set(candidate)):
+        print("{name:32s} {size:>10d} {unit:>15s} only in {report}".format(name=key[0], size=key[1], unit=key[2],
+            report="baseline" if key in baseline else "candidate"))
+
+    if regressions != 0:
+        print("{count} regression(s) found".format(count=regressions), file=sys.stderr)
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main(parser.parse_args())
@@ -0,0 +1,29 @@
+#include <cstddef>
+
+#include <fpplus/ddexpr.hpp>
+
+/*
+ * Both kernels use the same SIMD double-double operations, so they produce the same results,
+ * and differ only in memory traffic: the fused kernel reads 4 arrays and writes 1 array,
+ * the composed kernel reads 6 arrays and writes 3 arrays.
+ */
+
+using namespace fpplus::ddexpr;
+
+extern "C" void axpbz_fused(size_t n,
+	const doubledouble* a, const doubledouble* x,
+	const doubledouble* b, const doubledouble* z,
+	doubledouble* y)
+{
+	evaluate(n, y, array(a) * array(x) + array(b) * array(z));
+}
+
+extern "C" void axpbz_composed(size_t n,
+	const doubledouble* a, const doubledouble* x,
+	const doubledouble* b, const doubledouble* z,
+	doubledouble* y, doubledouble* t)
+{
+	evaluate(n, t, array(a) * array(x));
+	evaluate(n, y, array(b) * array(z));
+	evaluate(n, y, array(t) + array(y));
+}
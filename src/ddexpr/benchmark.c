@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+#include <utils.h>
+#include <ddexpr/common.h>
+
+
+/* Prints cycles per element and effective memory bandwidth, or reports both as separate measurements */
+static void report(
+    const char* name,
+    enum report_format format,
+    size_t iterations,
+    const uint64_t iteration_ticks[restrict static iterations],
+    double iteration_times[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    size_t elements, size_t bytes_per_element)
+{
+    double counters[perf_counter_count];
+    median_perf_counters(iterations, iteration_counters, (double) elements, counters);
+    double iteration_cycles[iterations];
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        iteration_cycles[iteration] = ((double) iteration_ticks[iteration]) / ((double) elements);
+    }
+    /* Convert iteration times to GB/s in-place */
+    double* iteration_bandwidth = iteration_times;
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        iteration_bandwidth[iteration] = ((double) (elements * bytes_per_element)) / iteration_times[iteration];
+    }
+    if (format == report_format_text) {
+        printf("%s\t" "%10zu\t" "%.2lf\t" "%zu\t" "%.2lf",
+            name, elements, median_double(iteration_cycles, iterations),
+            bytes_per_element, median_double(iteration_bandwidth, iterations));
+        report_text_counters(counters);
+    } else {
+        const struct sample_statistics cycles_statistics = compute_sample_statistics(iteration_cycles, iterations);
+        report_measurement(name, elements, report_unit_cycles_per_element, &cycles_statistics, counters);
+        const struct sample_statistics bandwidth_statistics = compute_sample_statistics(iteration_bandwidth, iterations);
+        report_measurement(name, elements, report_unit_gbytes_per_second, &bandwidth_statistics, counters);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const struct benchmark_options options = parse_options(argc, argv);
+
+    const size_t elements = options.array_size / sizeof(doubledouble);
+    doubledouble* a = valloc(elements * sizeof(doubledouble));
+    doubledouble* x = valloc(elements * sizeof(doubledouble));
+    doubledouble* b = valloc(elements * sizeof(doubledouble));
+    doubledouble* z = valloc(elements * sizeof(doubledouble));
+    doubledouble* y_fused = valloc(elements * sizeof(doubledouble));
+    doubledouble* y_composed = valloc(elements * sizeof(doubledouble));
+    doubledouble* t = valloc(elements * sizeof(doubledouble));
+    for (size_t i = 0; i < elements; i++) {
+        a[i] = (doubledouble) { M_PI, 1.2246467991473532e-16 };
+        x[i] = (doubledouble) { (double) i, 0.0 };
+        b[i] = (doubledouble) { M_E, 1.4456468917292502e-16 };
+        z[i] = (doubledouble) { 1.0 / (double) (i + 1), 0.0 };
+    }
+
+    /* Both versions must produce the same results: they only differ in the number of passes over memory */
+    axpbz_fused(elements, a, x, b, z, y_fused);
+    axpbz_composed(elements, a, x, b, z, y_composed, t);
+    if (memcmp(y_fused, y_composed, elements * sizeof(doubledouble)) != 0) {
+        fprintf(stderr, "Error: fused and composed expressions produced different results\n");
+        exit(EXIT_FAILURE);
+    }
+
+    perf_counters_open(options.counters);
+    report_begin(options.format, "ddexpr-bench", argc, argv);
+
+    uint64_t iteration_ticks[options.iterations];
+    double iteration_times[options.iterations];
+    struct perf_counter_values iteration_counters[options.iterations];
+
+    /* 3 passes: read a, x and write t; read b, z and write y; read t, y and write y */
+    for (size_t iteration = 0; iteration < options.iterations; iteration++) {
+        perf_counters_start();
+        const double start_time = high_precision_time();
+        const uint64_t start_ticks = cpu_ticks();
+
+        axpbz_composed(elements, a, x, b, z, y_composed, t);
+
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        iteration_times[iteration] = high_precision_time() - start_time;
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+    report("composed", options.format, options.iterations, iteration_ticks, iteration_times, iteration_counters,
+        elements, 9 * sizeof(doubledouble));
+
+    /* 1 pass: read a, x, b, z and write y */
+    for (size_t iteration = 0; iteration < options.iterations; iteration++) {
+        perf_counters_start();
+        const double start_time = high_precision_time();
+        const uint64_t start_ticks = cpu_ticks();
+
+        axpbz_fused(elements, a, x, b, z, y_fused);
+
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        iteration_times[iteration] = high_precision_time() - start_time;
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+    report("fused", options.format, options.iterations, iteration_ticks, iteration_times, iteration_counters,
+        elements, 5 * sizeof(doubledouble));
+
+    report_end();
+    perf_counters_close();
+
+    free(a);
+    free(x);
+    free(b);
+    free(z);
+    free(y_fused);
+    free(y_composed);
+    free(t);
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <fpplus.h>
+#include <report.h>
+
+
+struct benchmark_options {
+	size_t iterations;
+	size_t array_size;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+};
+
+struct benchmark_options parse_options(int argc, char** argv);
+
+/* y = a * x + b * z in a single pass with fpplus::ddexpr expression templates */
+void axpbz_fused(size_t n,
+	const doubledouble a[restrict static n], const doubledouble x[restrict static n],
+	const doubledouble b[restrict static n], const doubledouble z[restrict static n],
+	doubledouble y[restrict static n]);
+
+/* y = a * x + b * z as three passes over the arrays with one temporary array t */
+void axpbz_composed(size_t n,
+	const doubledouble a[restrict static n], const doubledouble x[restrict static n],
+	const doubledouble b[restrict static n], const doubledouble z[restrict static n],
+	doubledouble y[restrict static n], doubledouble t[restrict static n]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
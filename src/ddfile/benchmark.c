@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <utils.h>
+#include <dot/dot.h>
+#include <ddfile/common.h>
+
+
+static doubledouble random_doubledouble(uint64_t state[restrict static 1]) {
+	const double hi = ldexp((double) random_bits(state), -53) - 0.5;
+	const double lo = ldexp(ldexp((double) random_bits(state), -53) - 0.5, -53);
+	doubledouble x;
+	x.hi = efaddord(hi, lo, &x.lo);
+	return x;
+}
+
+/*
+ * y = A x, with A and x in SoA layout. The streams of high and low parts are the inputs of the dot product kernels:
+ * A_hi x_hi is computed with the compensated dot product, and A_hi x_lo + A_lo x_hi in double precision,
+ * while A_lo x_lo is below double-double precision. The kernels use aligned loads, which is valid for allocated, read,
+ * and mapped arrays alike: their rows are aligned on FPPLUS_LAYOUT_ALIGNMENT bytes, a multiple of DOT_PRODUCT_ALIGNMENT.
+ */
+static void ddgemv_soa(size_t rows, size_t columns, size_t row_stride,
+	const double a_hi[restrict static rows * row_stride],
+	const double a_lo[restrict static rows * row_stride],
+	const double x_hi[restrict static row_stride],
+	const double x_lo[restrict static row_stride],
+	doubledouble y[restrict static rows])
+{
+	for (size_t i = 0; i < rows; i++) {
+		const double* row_hi = a_hi + i * row_stride;
+		const double* row_lo = a_lo + i * row_stride;
+		const doubledouble product = compensated_dot_product_efmuladd_unroll4(columns, row_hi, x_hi);
+		const double cross_product = dot_product_fma_unroll4(columns, row_hi, x_lo) + dot_product_fma_unroll4(columns, row_lo, x_hi);
+		y[i] = ddaddw(product, cross_product);
+	}
+}
+
+enum load_method {
+	/* read() of an AoS file, and conversion to SoA layout */
+	load_method_read_copy,
+	/* read() of a SoA file */
+	load_method_read,
+	/* mmap() of a SoA file, with pages faulted in by the kernel */
+	load_method_map,
+	/* mmap() of a SoA file, with pages mapped before the kernel */
+	load_method_map_populate,
+};
+
+/* Loads the matrix in SoA layout, and returns false on failure */
+static bool load_matrix(enum load_method method, const char* aos_path, const char* soa_path, struct ddfile_array matrix[restrict static 1]) {
+	switch (method) {
+		case load_method_read_copy:
+		{
+			struct ddfile_array aos;
+			if (!ddfile_read(aos_path, &aos)) {
+				return false;
+			}
+			if (!ddfile_array_alloc(ddfile_layout_soa, aos.rows, aos.columns, matrix)) {
+				ddfile_array_release(&aos);
+				return false;
+			}
+			ddsoa_from_aos(aos.rows * aos.row_stride, aos.aos, matrix->hi, matrix->lo);
+			ddfile_array_release(&aos);
+			return true;
+		}
+		case load_method_read:
+			return ddfile_read(soa_path, matrix);
+		case load_method_map:
+			return ddfile_map(soa_path, false, matrix);
+		case load_method_map_populate:
+			return ddfile_map(soa_path, true, matrix);
+	}
+	return false;
+}
+
+static bool identical(size_t n, const doubledouble x[restrict static n], const doubledouble y[restrict static n]) {
+	for (size_t i = 0; i < n; i++) {
+		if (x[i].hi != y[i].hi || x[i].lo != y[i].lo) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	const struct benchmark_options options = parse_options(argc, argv);
+	const size_t n = options.size, iterations = options.iterations;
+
+	struct ddfile_array aos_matrix, soa_matrix, x;
+	doubledouble* y = malloc(n * sizeof(doubledouble));
+	doubledouble* y_reference = malloc(n * sizeof(doubledouble));
+	if (y == NULL || y_reference == NULL ||
+		!ddfile_array_alloc(ddfile_layout_aos, n, n, &aos_matrix) ||
+		!ddfile_array_alloc(ddfile_layout_soa, n, n, &soa_matrix) ||
+		!ddfile_array_alloc(ddfile_layout_soa, 1, n, &x))
+	{
+		fprintf(stderr, "Error: failed to allocate memory for %zux%zu matrix\n", n, n);
+		exit(EXIT_FAILURE);
+	}
+	uint64_t state = UINT64_C(0x853C49E6748FEA9B);
+	for (size_t i = 0; i < n; i++) {
+		for (size_t j = 0; j < n; j++) {
+			const doubledouble a = random_doubledouble(&state);
+			aos_matrix.aos[i * aos_matrix.row_stride + j] = a;
+			soa_matrix.hi[i * soa_matrix.row_stride + j] = a.hi;
+			soa_matrix.lo[i * soa_matrix.row_stride + j] = a.lo;
+		}
+		const doubledouble b = random_doubledouble(&state);
+		x.hi[i] = b.hi;
+		x.lo[i] = b.lo;
+	}
+	ddgemv_soa(n, n, soa_matrix.row_stride, soa_matrix.hi, soa_matrix.lo, x.hi, x.lo, y_reference);
+
+	const size_t path_length = strlen(options.directory) + 64;
+	char aos_path[path_length], soa_path[path_length];
+	snprintf(aos_path, path_length, "%s/ddfile-bench-%ld-aos.dd", options.directory, (long) getpid());
+	snprintf(soa_path, path_length, "%s/ddfile-bench-%ld-soa.dd", options.directory, (long) getpid());
+	if (!ddfile_write(aos_path, &aos_matrix) || !ddfile_write(soa_path, &soa_matrix)) {
+		exit(EXIT_FAILURE);
+	}
+	const size_t bytes = n * soa_matrix.row_stride * sizeof(doubledouble);
+	ddfile_array_release(&aos_matrix);
+	ddfile_array_release(&soa_matrix);
+
+	perf_counters_open(options.counters);
+	report_begin(options.format, "ddfile-bench", argc, argv);
+
+	const struct {
+		enum load_method method;
+		const char* name;
+	} methods[] = {
+		{ load_method_read_copy, "ddfile/read-copy/aos" },
+		{ load_method_read, "ddfile/read/soa" },
+		{ load_method_map, "ddfile/mmap/soa" },
+		{ load_method_map_populate, "ddfile/mmap-populate/soa" },
+	};
+	/*
+	 * Each iteration measures the time from the start of loading the matrix to the end of the first GEMV on it.
+	 * The files were just written, so they are in the page cache: the measurement does not include disk I/O.
+	 */
+	for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); m++) {
+		double times[iterations];
+		struct perf_counter_values iteration_counters[iterations];
+		for (size_t iteration = 0; iteration < iterations; iteration++) {
+			struct ddfile_array matrix;
+			memset(y, 0, n * sizeof(doubledouble));
+			perf_counters_start();
+			const double start_time = high_precision_time();
+			if (!load_matrix(methods[m].method, aos_path, soa_path, &matrix)) {
+				unlink(aos_path);
+				unlink(soa_path);
+				exit(EXIT_FAILURE);
+			}
+			ddgemv_soa(matrix.rows, matrix.columns, matrix.row_stride, matrix.hi, matrix.lo, x.hi, x.lo, y);
+			times[iteration] = high_precision_time() - start_time;
+			perf_counters_stop(&iteration_counters[iteration]);
+			ddfile_array_release(&matrix);
+
+			if (!identical(n, y, y_reference)) {
+				fprintf(stderr, "Error: GEMV on the matrix loaded by %s does not match the reference\n", methods[m].name);
+				unlink(aos_path);
+				unlink(soa_path);
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		double counters[perf_counter_count];
+		median_perf_counters(iterations, iteration_counters, (double) (n * n), counters);
+		const double median_time = median_double(times, iterations);
+		/* Convert iteration times to GB/s of matrix data in-place */
+		for (size_t iteration = 0; iteration < iterations; iteration++) {
+			times[iteration] = (double) bytes / times[iteration];
+		}
+		if (options.format == report_format_text) {
+			printf("%s\t" "%5zu\t" "%.2lf ms\t" "%.2lf GB/s", methods[m].name, n, median_time * 1.0e-6, median_double(times, iterations));
+			report_text_counters(counters);
+		} else {
+			const struct sample_statistics statistics = compute_sample_statistics(times, iterations);
+			report_measurement(methods[m].name, n, report_unit_gbytes_per_second, &statistics, counters);
+		}
+	}
+	report_end();
+
+	perf_counters_close();
+	unlink(aos_path);
+	unlink(soa_path);
+	ddfile_array_release(&x);
+	free(y);
+	free(y_reference);
+	return EXIT_SUCCESS;
+}
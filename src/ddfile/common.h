@@ -0,0 +1,28 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <report.h>
+#include <ddfile/ddfile.h>
+
+
+struct benchmark_options {
+	/* The number of rows and columns of the matrix */
+	size_t size;
+	/* Directory for temporary files */
+	const char* directory;
+	size_t iterations;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+};
+
+struct benchmark_options parse_options(int argc, char** argv);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
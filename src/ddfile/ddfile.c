@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <ddfile/ddfile.h>
+
+
+static size_t round_up(size_t number, size_t alignment) {
+	return (number + alignment - 1) / alignment * alignment;
+}
+
+/* Sizes of the data region of a file, relative to data_offset. Returns false on overflow. */
+static bool compute_data_sizes(enum ddfile_layout layout, size_t rows, size_t row_stride,
+	size_t lo_offset[restrict static 1],
+	size_t data_size[restrict static 1])
+{
+	if (row_stride != 0 && rows > SIZE_MAX / row_stride) {
+		return false;
+	}
+	const size_t elements = rows * row_stride;
+	if (elements > (SIZE_MAX - DDFILE_PAGE_SIZE) / sizeof(doubledouble)) {
+		return false;
+	}
+	switch (layout) {
+		case ddfile_layout_aos:
+		case ddfile_layout_aosoa4:
+			*lo_offset = 0;
+			*data_size = elements * sizeof(doubledouble);
+			return true;
+		case ddfile_layout_soa:
+			*lo_offset = round_up(elements * sizeof(double), DDFILE_PAGE_SIZE);
+			*data_size = *lo_offset + elements * sizeof(double);
+			return true;
+	}
+	return false;
+}
+
+static void set_layout_pointers(struct ddfile_array array[restrict static 1], char* data, size_t lo_offset) {
+	array->aos = NULL;
+	array->hi = array->lo = NULL;
+	array->aosoa4 = NULL;
+	switch (array->layout) {
+		case ddfile_layout_aos:
+			array->aos = (doubledouble*) data;
+			break;
+		case ddfile_layout_soa:
+			array->hi = (double*) data;
+			array->lo = (double*) (data + lo_offset);
+			break;
+		case ddfile_layout_aosoa4:
+			array->aosoa4 = (ddaosoa4*) data;
+			break;
+	}
+}
+
+bool ddfile_array_alloc(enum ddfile_layout layout, size_t rows, size_t columns, struct ddfile_array array[restrict static 1]) {
+	memset(array, 0, sizeof(struct ddfile_array));
+	const size_t row_stride = round_up(columns, DDFILE_ROW_ALIGNMENT);
+	size_t lo_offset, data_size;
+	if (row_stride < columns || !compute_data_sizes(layout, rows, row_stride, &lo_offset, &data_size)) {
+		return false;
+	}
+
+	void* memory = NULL;
+	if (posix_memalign(&memory, DDFILE_PAGE_SIZE, data_size == 0 ? DDFILE_PAGE_SIZE : data_size) != 0) {
+		return false;
+	}
+	memset(memory, 0, data_size);
+
+	array->layout = layout;
+	array->rows = rows;
+	array->columns = columns;
+	array->row_stride = row_stride;
+	array->memory = memory;
+	array->memory_size = data_size;
+	array->mapped = false;
+	set_layout_pointers(array, memory, lo_offset);
+	return true;
+}
+
+void ddfile_array_release(struct ddfile_array array[restrict static 1]) {
+	if (array->mapped) {
+		munmap(array->memory, array->memory_size);
+	} else {
+		free(array->memory);
+	}
+	memset(array, 0, sizeof(struct ddfile_array));
+}
+
+static bool write_all(FILE* file, const void* data, size_t size) {
+	return size == 0 || fwrite(data, size, 1, file) == 1;
+}
+
+static bool write_zeros(FILE* file, size_t size) {
+	static const char zeros[DDFILE_PAGE_SIZE];
+	while (size != 0) {
+		const size_t chunk = size < sizeof(zeros) ? size : sizeof(zeros);
+		if (!write_all(file, zeros, chunk)) {
+			return false;
+		}
+		size -= chunk;
+	}
+	return true;
+}
+
+bool ddfile_write(const char* path, const struct ddfile_array array[restrict static 1]) {
+	size_t lo_offset, data_size;
+	if (!compute_data_sizes(array->layout, array->rows, array->row_stride, &lo_offset, &data_size)) {
+		fprintf(stderr, "Error: %zux%zu array is too large\n", array->rows, array->columns);
+		return false;
+	}
+
+	struct ddfile_header header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, DDFILE_MAGIC, sizeof(header.magic));
+	header.version = DDFILE_VERSION;
+	header.byte_order = DDFILE_BYTE_ORDER_MARK;
+	header.layout = (uint32_t) array->layout;
+	header.rows = array->rows;
+	header.columns = array->columns;
+	header.row_stride = array->row_stride;
+	header.data_offset = DDFILE_PAGE_SIZE;
+	header.lo_offset = array->layout == ddfile_layout_soa ? DDFILE_PAGE_SIZE + lo_offset : 0;
+
+	FILE* file = fopen(path, "wb");
+	if (file == NULL) {
+		fprintf(stderr, "Error: failed to create file %s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	const size_t elements = array->rows * array->row_stride;
+	bool success = write_all(file, &header, sizeof(header)) && write_zeros(file, DDFILE_PAGE_SIZE - sizeof(header));
+	switch (array->layout) {
+		case ddfile_layout_aos:
+			success = success && write_all(file, array->aos, data_size);
+			break;
+		case ddfile_layout_soa:
+			success = success &&
+				write_all(file, array->hi, elements * sizeof(double)) &&
+				write_zeros(file, lo_offset - elements * sizeof(double)) &&
+				write_all(file, array->lo, elements * sizeof(double));
+			break;
+		case ddfile_layout_aosoa4:
+			success = success && write_all(file, array->aosoa4, data_size);
+			break;
+	}
+	if (fclose(file) != 0) {
+		success = false;
+	}
+	if (!success) {
+		fprintf(stderr, "Error: failed to write file %s\n", path);
+	}
+	return success;
+}
+
+/* Checks the header against the file size, and computes the offsets of the data streams */
+static bool validate_header(const char* path, const struct ddfile_header header[restrict static 1], size_t file_size,
+	size_t lo_offset[restrict static 1],
+	size_t data_size[restrict static 1])
+{
+	if (memcmp(header->magic, DDFILE_MAGIC, sizeof(header->magic)) != 0) {
+		fprintf(stderr, "Error: %s is not a double-double array file\n", path);
+		return false;
+	}
+	if (header->byte_order != DDFILE_BYTE_ORDER_MARK) {
+		fprintf(stderr, "Error: unsupported byte order in file %s\n", path);
+		return false;
+	}
+	if (header->version != DDFILE_VERSION) {
+		fprintf(stderr, "Error: unsupported version %"PRIu32" of file %s\n", header->version, path);
+		return false;
+	}
+	if (header->layout > ddfile_layout_aosoa4) {
+		fprintf(stderr, "Error: unsupported layout %"PRIu32" in file %s\n", header->layout, path);
+		return false;
+	}
+	if (header->rows > SIZE_MAX || header->row_stride > SIZE_MAX ||
+		header->columns > header->row_stride || header->row_stride % DDFILE_ROW_ALIGNMENT != 0)
+	{
+		fprintf(stderr, "Error: invalid dimensions %"PRIu64"x%"PRIu64" with row stride %"PRIu64" in file %s\n",
+			header->rows, header->columns, header->row_stride, path);
+		return false;
+	}
+	if (header->data_offset < sizeof(struct ddfile_header) || header->data_offset % DDFILE_PAGE_SIZE != 0 ||
+		header->data_offset > file_size)
+	{
+		fprintf(stderr, "Error: invalid data offset %"PRIu64" in file %s\n", header->data_offset, path);
+		return false;
+	}
+
+	size_t min_lo_offset, min_data_size;
+	if (!compute_data_sizes((enum ddfile_layout) header->layout, header->rows, header->row_stride, &min_lo_offset, &min_data_size)) {
+		fprintf(stderr, "Error: array in file %s is too large\n", path);
+		return false;
+	}
+	*lo_offset = 0;
+	*data_size = min_data_size;
+	if (header->layout == ddfile_layout_soa) {
+		/* The low parts may be anywhere after the high parts, as long as they are page-aligned */
+		const size_t stream_size = min_data_size - min_lo_offset;
+		if (header->lo_offset % DDFILE_PAGE_SIZE != 0 || header->lo_offset < header->data_offset ||
+			header->lo_offset - header->data_offset < min_lo_offset || header->lo_offset > file_size)
+		{
+			fprintf(stderr, "Error: invalid low part offset %"PRIu64" in file %s\n", header->lo_offset, path);
+			return false;
+		}
+		*lo_offset = header->lo_offset - header->data_offset;
+		*data_size = *lo_offset + stream_size;
+	}
+	if (*data_size > file_size - header->data_offset) {
+		fprintf(stderr, "Error: file %s is truncated\n", path);
+		return false;
+	}
+	return true;
+}
+
+static void set_array_dimensions(struct ddfile_array array[restrict static 1], const struct ddfile_header header[restrict static 1]) {
+	array->layout = (enum ddfile_layout) header->layout;
+	array->rows = (size_t) header->rows;
+	array->columns = (size_t) header->columns;
+	array->row_stride = (size_t) header->row_stride;
+}
+
+static bool read_all(int fd, void* data, size_t size, off_t offset) {
+	char* bytes = data;
+	while (size != 0) {
+		const ssize_t bytes_read = pread(fd, bytes, size, offset);
+		if (bytes_read <= 0) {
+			if (bytes_read < 0 && errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		bytes += bytes_read;
+		offset += bytes_read;
+		size -= (size_t) bytes_read;
+	}
+	return true;
+}
+
+bool ddfile_read(const char* path, struct ddfile_array array[restrict static 1]) {
+	memset(array, 0, sizeof(struct ddfile_array));
+	const int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "Error: failed to open file %s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	bool success = false;
+	struct stat file_stat;
+	struct ddfile_header header;
+	if (fstat(fd, &file_stat) != 0 || (size_t) file_stat.st_size < sizeof(header) || !read_all(fd, &header, sizeof(header), 0)) {
+		fprintf(stderr, "Error: failed to read header of file %s\n", path);
+		goto cleanup;
+	}
+	size_t lo_offset, data_size;
+	if (!validate_header(path, &header, (size_t) file_stat.st_size, &lo_offset, &data_size)) {
+		goto cleanup;
+	}
+
+	void* memory = NULL;
+	if (posix_memalign(&memory, DDFILE_PAGE_SIZE, data_size == 0 ? DDFILE_PAGE_SIZE : data_size) != 0) {
+		fprintf(stderr, "Error: failed to allocate %zu bytes for file %s\n", data_size, path);
+		goto cleanup;
+	}
+	if (!read_all(fd, memory, data_size, (off_t) header.data_offset)) {
+		fprintf(stderr, "Error: failed to read file %s\n", path);
+		free(memory);
+		goto cleanup;
+	}
+
+	set_array_dimensions(array, &header);
+	array->memory = memory;
+	array->memory_size = data_size;
+	array->mapped = false;
+	set_layout_pointers(array, memory, lo_offset);
+	success = true;
+
+cleanup:
+	close(fd);
+	return success;
+}
+
+bool ddfile_map(const char* path, bool populate, struct ddfile_array array[restrict static 1]) {
+	memset(array, 0, sizeof(struct ddfile_array));
+	const int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "Error: failed to open file %s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || (size_t) file_stat.st_size < sizeof(struct ddfile_header)) {
+		fprintf(stderr, "Error: failed to read header of file %s\n", path);
+		close(fd);
+		return false;
+	}
+	const size_t file_size = (size_t) file_stat.st_size;
+
+	int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+	if (populate) {
+		flags |= MAP_POPULATE;
+	}
+#endif
+	void* mapping = mmap(NULL, file_size, PROT_READ | PROT_WRITE, flags, fd, 0);
+	/* The mapping keeps a reference to the file */
+	close(fd);
+	if (mapping == MAP_FAILED) {
+		fprintf(stderr, "Error: failed to map file %s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	const struct ddfile_header* header = mapping;
+	size_t lo_offset, data_size;
+	if (!validate_header(path, header, file_size, &lo_offset, &data_size)) {
+		munmap(mapping, file_size);
+		return false;
+	}
+
+	set_array_dimensions(array, header);
+	array->memory = mapping;
+	array->memory_size = file_size;
+	array->mapped = true;
+	set_layout_pointers(array, (char*) mapping + header->data_offset, lo_offset);
+	return true;
+}
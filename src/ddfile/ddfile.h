@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <fpplus.h>
+#include <fpplus/layout.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * File format for matrices and vectors of double-double numbers:
+ * - 64-byte header (struct ddfile_header) in little-endian byte order.
+ * - Padding to data_offset, a multiple of DDFILE_PAGE_SIZE.
+ * - Elements in row-major order, with rows padded to row_stride elements, in one of the layouts of fpplus/layout.h.
+ *   For SoA layout, the high parts start at data_offset and the low parts at lo_offset, also a multiple of DDFILE_PAGE_SIZE.
+ * Padding elements are zeros. Because the data starts at a page boundary and row_stride is a multiple of 8,
+ * every row of a memory-mapped file is aligned on FPPLUS_LAYOUT_ALIGNMENT bytes in all layouts.
+ */
+
+#define DDFILE_MAGIC "FPPLUSDD"
+#define DDFILE_VERSION 1
+#define DDFILE_BYTE_ORDER_MARK UINT32_C(0x01020304)
+/* Alignment of data streams in the file. Mapped files start at a page boundary, so streams are page-aligned in memory too */
+#define DDFILE_PAGE_SIZE 4096
+/* row_stride is a multiple of this number of elements, to keep rows aligned on FPPLUS_LAYOUT_ALIGNMENT bytes */
+#define DDFILE_ROW_ALIGNMENT 8
+
+enum ddfile_layout {
+	/* Array of doubledouble structures */
+	ddfile_layout_aos = 0,
+	/* Separate streams of high and low parts */
+	ddfile_layout_soa = 1,
+	/* ddaosoa4 blocks of 4 high parts followed by 4 low parts */
+	ddfile_layout_aosoa4 = 2,
+};
+
+struct ddfile_header {
+	char magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint32_t layout;
+	uint32_t reserved;
+	uint64_t rows;
+	uint64_t columns;
+	/* Elements between the starts of consecutive rows */
+	uint64_t row_stride;
+	/* File offsets of the first data byte, and of the low parts in SoA layout (0 in other layouts) */
+	uint64_t data_offset;
+	uint64_t lo_offset;
+};
+
+/**
+ * @brief Matrix of double-double numbers in memory, allocated, read, or mapped from a file
+ * @details Only the pointers of the layout are non-NULL: aos, hi and lo, or aosoa4.
+ *          Element (i, j) is aos[i * row_stride + j], (hi, lo)[i * row_stride + j], or aosoa4[(i * row_stride + j) / 4] lane j % 4.
+ */
+struct ddfile_array {
+	enum ddfile_layout layout;
+	size_t rows;
+	size_t columns;
+	size_t row_stride;
+	doubledouble* aos;
+	double* hi;
+	double* lo;
+	ddaosoa4* aosoa4;
+	/* Allocated or mapped memory */
+	void* memory;
+	size_t memory_size;
+	bool mapped;
+};
+
+/**
+ * @brief Allocates a zero-initialized matrix in the layout of the file format, aligned on DDFILE_PAGE_SIZE
+ * @return true on success, false if the memory can not be allocated.
+ */
+bool ddfile_array_alloc(enum ddfile_layout layout, size_t rows, size_t columns, struct ddfile_array FPPLUS_NONNULL_POINTER(array));
+
+/**
+ * @brief Releases an array allocated by ddfile_array_alloc or loaded by ddfile_read or ddfile_map
+ */
+void ddfile_array_release(struct ddfile_array FPPLUS_NONNULL_POINTER(array));
+
+/**
+ * @brief Writes the array to a file
+ * @return true on success, false on failure (with an error message on stderr).
+ */
+bool ddfile_write(const char* path, const struct ddfile_array FPPLUS_NONNULL_POINTER(array));
+
+/**
+ * @brief Loads the file into allocated memory with read()
+ * @return true on success, false if the file can not be read or is not valid (with an error message on stderr).
+ */
+bool ddfile_read(const char* path, struct ddfile_array FPPLUS_NONNULL_POINTER(array));
+
+/**
+ * @brief Maps the file into memory without copying
+ * @details The mapping is private: the array can be modified, and the changes are not written to the file.
+ * @param populate - whether to read the whole file into the page cache and map it before returning,
+ *                   rather than on the first access to each page.
+ * @return true on success, false if the file can not be mapped or is not valid (with an error message on stderr).
+ */
+bool ddfile_map(const char* path, bool populate, struct ddfile_array FPPLUS_NONNULL_POINTER(array));
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <utils.h>
+#include <ddgemm/ddgemm.h>
+#include <ddgemm/pack.h>
+#include <ddgemm-batch/common.h>
+#include <ddgemm-batch/pack.h>
+
+
+static void generate_matrices(size_t count, doubledouble x[restrict static count], uint64_t state[restrict static 1]) {
+	for (size_t i = 0; i < count; i++) {
+		const double hi = ldexp((double) random_bits(state), -53) - 0.5;
+		const double lo = ldexp(ldexp((double) random_bits(state), -53) - 0.5, -53);
+		x[i].hi = efaddord(hi, lo, &x[i].lo);
+	}
+}
+
+/* Largest register tile of the ddgemm micro-kernels which divides n, or 0 if there is none */
+static size_t select_ukernel_tile(size_t n, size_t tile_min, size_t tile_max, size_t tile_step) {
+	size_t tile = 0;
+	for (size_t t = tile_min; t <= tile_max; t += tile_step) {
+		if (n % t == 0) {
+			tile = t;
+		}
+	}
+	return tile;
+}
+
+/*
+ * C += A * B for each matrix in the batch with the ddgemm micro-kernels, as a blocked GEMM driver would do for one
+ * small product: pack the panels of A and B, call the micro-kernel on each tile of C, and add the tile to C.
+ * Matrices are column-major, as in ddgemm_pack_a and ddgemm_pack_b.
+ */
+static void ddgemm_batch_ukernel(size_t n, size_t mr, size_t nr, size_t batch,
+	const doubledouble a[restrict static batch * n * n],
+	const doubledouble b[restrict static batch * n * n],
+	doubledouble c[restrict static batch * n * n],
+	double packed_a[restrict static 2 * mr * n],
+	doubledouble packed_b[restrict static n * n],
+	doubledouble tile[restrict static mr * nr])
+{
+	const ddgemm_function ddgemm = select_ddgemm_kernel(mr, nr);
+	for (size_t matrix = 0; matrix < batch; matrix++) {
+		const doubledouble* matrix_a = a + matrix * n * n;
+		const doubledouble* matrix_b = b + matrix * n * n;
+		doubledouble* matrix_c = c + matrix * n * n;
+		for (size_t j = 0; j < n; j += nr) {
+			ddgemm_pack_b(nr, n, matrix_b + j * n, n, packed_b + j * n);
+		}
+		for (size_t i = 0; i < n; i += mr) {
+			ddgemm_pack_a(mr, DDGEMM_MR_STEP, n, matrix_a + i, n, packed_a);
+			for (size_t j = 0; j < n; j += nr) {
+				memset(tile, 0, mr * nr * sizeof(doubledouble));
+				ddgemm(n, packed_a, packed_b + j * n, tile);
+				for (size_t jj = 0; jj < nr; jj++) {
+					for (size_t ii = 0; ii < mr; ii++) {
+						doubledouble* element = &matrix_c[(j + jj) * n + i + ii];
+						*element = ddadd(*element, tile[jj * mr + ii]);
+					}
+				}
+			}
+		}
+	}
+}
+
+static void report(const char* name, enum report_format format, size_t n, size_t count,
+	size_t iterations, double iteration_times[restrict static iterations],
+	const struct perf_counter_values iteration_counters[restrict static iterations])
+{
+	/* Counters are normalized per double-double multiply-add */
+	double counters[perf_counter_count];
+	median_perf_counters(iterations, iteration_counters, (double) (count * n * n * n), counters);
+	const double median_time = median_double(iteration_times, iterations);
+	/* Convert iteration times to millions of matrix products per second in-place */
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		iteration_times[iteration] = 1.0e+3 * (double) count / iteration_times[iteration];
+	}
+	if (format == report_format_text) {
+		printf("%s\t" "%2zu\t" "%.3lf Mmatrices/s\t" "%.1lf MFLOPS", name, n,
+			median_double(iteration_times, iterations), 2.0e+3 * (double) (count * n * n * n) / median_time);
+		report_text_counters(counters);
+	} else {
+		const struct sample_statistics statistics = compute_sample_statistics(iteration_times, iterations);
+		report_measurement(name, n, report_unit_mmatrices_per_second, &statistics, counters);
+	}
+}
+
+static bool identical(size_t count, const doubledouble x[restrict static count], const doubledouble y[restrict static count]) {
+	for (size_t i = 0; i < count; i++) {
+		if (x[i].hi != y[i].hi || x[i].lo != y[i].lo) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Transposes each n x n matrix in the batch */
+static void transpose_batch(size_t n, size_t batch, const doubledouble x[restrict static batch * n * n], doubledouble y[restrict static batch * n * n]) {
+	for (size_t matrix = 0; matrix < batch; matrix++) {
+		for (size_t i = 0; i < n; i++) {
+			for (size_t j = 0; j < n; j++) {
+				y[matrix * n * n + j * n + i] = x[matrix * n * n + i * n + j];
+			}
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	const struct benchmark_options options = parse_options(argc, argv);
+	const size_t count = options.count, iterations = options.iterations;
+	const size_t groups = (count + DDGEMM_BATCH_SIMD_WIDTH - 1) / DDGEMM_BATCH_SIMD_WIDTH;
+
+	perf_counters_open(options.counters);
+	report_begin(options.format, "ddgemm-batch-bench", argc, argv);
+	for (size_t n = DDGEMM_BATCH_SIZE_MIN; n <= DDGEMM_BATCH_SIZE_MAX; n++) {
+		const ddgemm_batch_function ddgemm_batch = select_ddgemm_batch_kernel(n);
+		if (ddgemm_batch == NULL) {
+			continue;
+		}
+
+		/* Row-major matrices for the batched kernels, and their column-major copies for the micro-kernels */
+		const size_t elements = count * n * n;
+		const size_t packed_size = 2 * groups * DDGEMM_BATCH_SIMD_WIDTH * n * n;
+		doubledouble* a = malloc(elements * sizeof(doubledouble));
+		doubledouble* b = malloc(elements * sizeof(doubledouble));
+		doubledouble* c = malloc(elements * sizeof(doubledouble));
+		doubledouble* ukernel_a = malloc(elements * sizeof(doubledouble));
+		doubledouble* ukernel_b = malloc(elements * sizeof(doubledouble));
+		doubledouble* ukernel_c = malloc(elements * sizeof(doubledouble));
+		double* packed_a = valloc(packed_size * sizeof(double));
+		double* packed_b = valloc(packed_size * sizeof(double));
+		double* packed_c = valloc(packed_size * sizeof(double));
+		double* ukernel_packed_a = valloc(2 * DDGEMM_MR_MAX * n * sizeof(double));
+		doubledouble* ukernel_packed_b = valloc(n * n * sizeof(doubledouble));
+		doubledouble* ukernel_tile = valloc(DDGEMM_MR_MAX * DDGEMM_NR_MAX * sizeof(doubledouble));
+		if (a == NULL || b == NULL || c == NULL || ukernel_a == NULL || ukernel_b == NULL || ukernel_c == NULL ||
+			packed_a == NULL || packed_b == NULL || packed_c == NULL ||
+			ukernel_packed_a == NULL || ukernel_packed_b == NULL || ukernel_tile == NULL)
+		{
+			fprintf(stderr, "Error: failed to allocate memory for %zu %zux%zu matrices\n", count, n, n);
+			exit(EXIT_FAILURE);
+		}
+		uint64_t state = UINT64_C(0x853C49E6748FEA9B);
+		generate_matrices(elements, a, &state);
+		generate_matrices(elements, b, &state);
+		memset(c, 0, elements * sizeof(doubledouble));
+		ddgemm_batch_pack(n, DDGEMM_BATCH_SIMD_WIDTH, count, a, packed_a);
+		ddgemm_batch_pack(n, DDGEMM_BATCH_SIMD_WIDTH, count, b, packed_b);
+		ddgemm_batch_pack(n, DDGEMM_BATCH_SIMD_WIDTH, count, c, packed_c);
+		transpose_batch(n, count, a, ukernel_a);
+		transpose_batch(n, count, b, ukernel_b);
+		memset(ukernel_c, 0, elements * sizeof(doubledouble));
+
+		double times[iterations];
+		struct perf_counter_values iteration_counters[iterations];
+		for (size_t iteration = 0; iteration < iterations; iteration++) {
+			perf_counters_start();
+			const double start_time = high_precision_time();
+			ddgemm_batch(groups, packed_a, packed_b, packed_c);
+			times[iteration] = high_precision_time() - start_time;
+			perf_counters_stop(&iteration_counters[iteration]);
+		}
+		report("ddgemm-batch/compact", options.format, n, count, iterations, times, iteration_counters);
+
+		const size_t mr = select_ukernel_tile(n, DDGEMM_MR_MIN, DDGEMM_MR_MAX, DDGEMM_MR_STEP);
+		const size_t nr = select_ukernel_tile(n, DDGEMM_NR_MIN, DDGEMM_NR_MAX, 1);
+		if (mr != 0) {
+			for (size_t iteration = 0; iteration < iterations; iteration++) {
+				perf_counters_start();
+				const double start_time = high_precision_time();
+				ddgemm_batch_ukernel(n, mr, nr, count, ukernel_a, ukernel_b, ukernel_c,
+					ukernel_packed_a, ukernel_packed_b, ukernel_tile);
+				times[iteration] = high_precision_time() - start_time;
+				perf_counters_stop(&iteration_counters[iteration]);
+			}
+			char name[48];
+			snprintf(name, sizeof(name), "ddgemm-batch/ukernel%zux%zu", mr, nr);
+			report(name, options.format, n, count, iterations, times, iteration_counters);
+
+			/* Both versions accumulate the products in the same order, and must produce identical results */
+			ddgemm_batch_unpack(n, DDGEMM_BATCH_SIMD_WIDTH, count, packed_c, c);
+			transpose_batch(n, count, ukernel_c, a);
+			if (!identical(elements, a, c)) {
+				fprintf(stderr, "Error: batched and micro-kernel results for %zux%zu matrices do not match\n", n, n);
+				exit(EXIT_FAILURE);
+			}
+		}
+
+		free(a);
+		free(b);
+		free(c);
+		free(ukernel_a);
+		free(ukernel_b);
+		free(ukernel_c);
+		free(packed_a);
+		free(packed_b);
+		free(packed_c);
+		free(ukernel_packed_a);
+		free(ukernel_packed_b);
+		free(ukernel_tile);
+	}
+	report_end();
+	perf_counters_close();
+	return EXIT_SUCCESS;
+}
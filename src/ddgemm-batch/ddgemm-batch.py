@@ -0,0 +1,209 @@
+#!/usr/bin/env python
+from __future__ import division
+
+import sys
+import os
+import argparse
+
+root_dir = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(root_dir, ".."))
+
+
+parser = argparse.ArgumentParser(description="Batched DDGEMM kernel generator")
+parser.add_argument("--sizes", dest="sizes", required=True,
+	help="Comma-separated list of matrix sizes")
+parser.add_argument("--mr", dest="mr", required=True, type=int,
+	help="Maximum register tiling of M dimension")
+parser.add_argument("--nr", dest="nr", required=True, type=int,
+	help="Maximum register tiling of N dimension")
+parser.add_argument("--simd", dest="simd", required=True,
+	choices=("scalar", "sse", "avx", "mic", "armv8", "vsx", "qpx"),
+	help="SIMD intrinsics")
+parser.add_argument("--implementation", dest="implementation", required=True,
+	help="Output file name for C implementation")
+parser.add_argument("--header", dest="header", required=True,
+	help="Output file name for C/C++ header")
+parser.add_argument("--unittest", dest="unittest", required=True,
+	help="Output file name for C++ unit test")
+
+
+def register_tile(size, max_tile):
+	"""Largest register tile which is not bigger than max_tile and divides the size, so the kernel needs no edge handling"""
+	return max(tile for tile in range(1, max_tile + 1) if size % tile == 0)
+
+
+def main():
+	options = parser.parse_args()
+	sizes = sorted(set(int(size) for size in options.sizes.split(",")))
+
+	from code import CodeWriter, CodeBlock
+	from simd import SimdOperations
+	with CodeWriter() as impl:
+		impl.line("#include <fpplus.h>")
+		impl.line("#include <ddgemm-batch/ddgemm-batch.h>")
+		impl.line()
+
+		simd = SimdOperations(options.simd)
+		for n in sizes:
+			mr = register_tile(n, options.mr)
+			nr = register_tile(n, options.nr)
+			# Doubles in a group of simd.width interleaved n x n matrices
+			group_size = 2 * simd.width * n * n
+			impl.line("""\
+void ddgemm_batch{n}x{n}(size_t groups,
+	const double a[restrict static groups*{group_size}],
+	const double b[restrict static groups*{group_size}],
+	double c[restrict static groups*{group_size}])
+{{""".format(n=n, group_size=group_size))
+			with CodeBlock():
+				impl.line("do {")
+				with CodeBlock():
+					impl.line("for (size_t i = 0; i < {n}; i += {mr}) {{".format(n=n, mr=mr))
+					with CodeBlock():
+						impl.line("for (size_t j = 0; j < {n}; j += {nr}) {{".format(n=n, nr=nr))
+						with CodeBlock():
+							for m in range(mr):
+								impl.line("{ddvec} {vars};".format(ddvec=simd.ddvec,
+									vars=", ".join("va{m}b{n} = {ddzero}()".format(m=m, n=nn, ddzero=simd.ddzero) for nn in range(nr))))
+							impl.line("for (size_t k = 0; k < {n}; k++) {{".format(n=n))
+							with CodeBlock():
+								for m in range(mr):
+									index = "((i+{m})*{n}+k)*{stride}".format(m=m, n=n, stride=2*simd.width)
+									impl.line("const {ddvec} va{m} = {{ {dload}(a + {index}), {dload}(a + {index} + {width}) }};"
+										.format(ddvec=simd.ddvec, m=m, dload=simd._dload, index=index, width=simd.width))
+								for nn in range(nr):
+									index = "(k*{n}+j+{nn})*{stride}".format(n=n, nn=nn, stride=2*simd.width)
+									impl.line("const {ddvec} vb{nn} = {{ {dload}(b + {index}), {dload}(b + {index} + {width}) }};"
+										.format(ddvec=simd.ddvec, nn=nn, dload=simd._dload, index=index, width=simd.width))
+								impl.line()
+
+								for m in range(mr):
+									for nn in range(nr):
+										vambn = "va{m}b{n}".format(m=m, n=nn)
+										impl.line(vambn + " = " + simd.ddadd(vambn, simd.ddmul("va" + str(m), "vb" + str(nn))) + ";")
+							impl.line("}")
+							impl.line()
+
+							for m in range(mr):
+								for nn in range(nr):
+									index = "((i+{m})*{n}+j+{nn})*{stride}".format(m=m, n=n, nn=nn, stride=2*simd.width)
+									impl.line("{ddvec} vc{m}{nn} = {{ {dload}(c + {index}), {dload}(c + {index} + {width}) }};"
+										.format(ddvec=simd.ddvec, m=m, nn=nn, dload=simd._dload, index=index, width=simd.width))
+									impl.line("vc{m}{nn} = {ddadd}(vc{m}{nn}, va{m}b{nn});".format(m=m, nn=nn, ddadd=simd._ddadd))
+									impl.line("{dstore}(c + {index}, vc{m}{nn}.hi);".format(dstore=simd._dstore, index=index, m=m, nn=nn))
+									impl.line("{dstore}(c + {index} + {width}, vc{m}{nn}.lo);"
+										.format(dstore=simd._dstore, index=index, width=simd.width, m=m, nn=nn))
+						impl.line("}")
+					impl.line("}")
+					impl.line()
+
+					impl.line("a += {group_size};".format(group_size=group_size))
+					impl.line("b += {group_size};".format(group_size=group_size))
+					impl.line("c += {group_size};".format(group_size=group_size))
+				impl.line("} while (--groups);")
+			impl.line("}")
+			impl.line()
+
+	with CodeWriter() as header:
+		header.line("""\
+#pragma once
+
+#include <stddef.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {{
+#endif
+
+/* The number of matrices interleaved in a group: one matrix per SIMD lane */
+#define DDGEMM_BATCH_SIMD_WIDTH {simd_width}
+#define DDGEMM_BATCH_SIZE_MIN {size_min}
+#define DDGEMM_BATCH_SIZE_MAX {size_max}
+
+/*
+ * Batched kernels compute C += A * B for groups of DDGEMM_BATCH_SIMD_WIDTH products of n x n matrices.
+ * Each group stores the matrices interleaved element by element, in row-major order: for each element,
+ * DDGEMM_BATCH_SIMD_WIDTH high parts followed by DDGEMM_BATCH_SIMD_WIDTH low parts, one from each matrix.
+ * The arrays must be aligned on the SIMD vector size, and the number of groups must be positive.
+ */
+typedef void (*ddgemm_batch_function)(size_t, const double*, const double*, double*);
+
+""".format(simd_width=simd.width, size_min=sizes[0], size_max=sizes[-1]))
+		for n in sizes:
+			# Prototypes repeat the array bounds of the definitions
+			group_size = 2 * simd.width * n * n
+			header.line("void ddgemm_batch{n}x{n}(size_t groups,".format(n=n))
+			header.indent_line("const double FPPLUS_ARRAY_POINTER(a, groups*{group_size}),".format(group_size=group_size))
+			header.indent_line("const double FPPLUS_ARRAY_POINTER(b, groups*{group_size}),".format(group_size=group_size))
+			header.indent_line("double FPPLUS_ARRAY_POINTER(c, groups*{group_size}));".format(group_size=group_size))
+
+		header.line()
+		header.line()
+
+		header.line("static inline ddgemm_batch_function select_ddgemm_batch_kernel(size_t n) {")
+		with CodeBlock():
+			header.line("switch (n) {")
+			with CodeBlock():
+				for n in sizes:
+					header.line("case {n}:".format(n=n))
+					header.indent_line("return ddgemm_batch{n}x{n};".format(n=n))
+				header.line("default:")
+				header.indent_line("return NULL;")
+			header.line("}")
+		header.line("}")
+
+		header.line("""
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+""")
+
+
+	with CodeWriter() as unittest:
+		unittest.line("""\
+#include <cstddef>
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+
+#include <ddgemm-batch/ddgemm-batch.h>
+#include <ddgemm-batch/pack.h>
+
+#include "ddgemm-batch-tester.h"
+
+""")
+		for n in sizes:
+			unittest.line("""\
+TEST(ddgemm_batch, kernel{n}x{n}) {{
+	DDGEMMBatchTester<{n}, ddgemm_batch{n}x{n}>().test();
+}}
+""".format(n=n))
+
+		for n in sizes:
+			unittest.line("""\
+TEST(ddgemm_batch, pack{n}x{n}) {{
+	DDGEMMBatchPackTester<{n}>().test();
+}}
+""".format(n=n))
+
+		unittest.line("""\
+int main(int argc, char* argv[]) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+""")
+
+	with open(options.implementation, "w") as impl_file:
+		impl_file.write(str(impl))
+
+	with open(options.header, "w") as header_file:
+		header_file.write(str(header))
+
+	with open(options.unittest, "w") as unittest_file:
+		unittest_file.write(str(unittest))
+
+
+if __name__ == "__main__":
+	sys.exit(main())
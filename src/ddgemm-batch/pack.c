@@ -0,0 +1,40 @@
+#include <ddgemm-batch/pack.h>
+
+
+void ddgemm_batch_pack(size_t n, size_t simd_width, size_t batch,
+	const doubledouble matrices[restrict static batch * n * n],
+	double packed[restrict static 1])
+{
+	for (size_t group_start = 0; group_start < batch; group_start += simd_width) {
+		for (size_t element = 0; element < n * n; element++) {
+			for (size_t lane = 0; lane < simd_width; lane++) {
+				const size_t matrix = group_start + lane;
+				if (matrix < batch) {
+					packed[lane] = matrices[matrix * n * n + element].hi;
+					packed[simd_width + lane] = matrices[matrix * n * n + element].lo;
+				} else {
+					packed[lane] = packed[simd_width + lane] = 0.0;
+				}
+			}
+			packed += 2 * simd_width;
+		}
+	}
+}
+
+void ddgemm_batch_unpack(size_t n, size_t simd_width, size_t batch,
+	const double packed[restrict static 1],
+	doubledouble matrices[restrict static batch * n * n])
+{
+	for (size_t group_start = 0; group_start < batch; group_start += simd_width) {
+		for (size_t element = 0; element < n * n; element++) {
+			for (size_t lane = 0; lane < simd_width; lane++) {
+				const size_t matrix = group_start + lane;
+				if (matrix < batch) {
+					matrices[matrix * n * n + element].hi = packed[lane];
+					matrices[matrix * n * n + element].lo = packed[simd_width + lane];
+				}
+			}
+			packed += 2 * simd_width;
+		}
+	}
+}
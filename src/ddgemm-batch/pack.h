@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Packs a batch of row-major n x n matrices into groups of simd_width interleaved matrices for batched kernels
+ * @details The last group is padded with zero matrices if batch is not a multiple of simd_width.
+ * @param matrices - batch consecutive matrices, matrices[(b * n + i) * n + j] is the element in row i and column j of matrix b.
+ * @param packed - buffer for 2 * n * n doubles per matrix, with batch rounded up to a multiple of simd_width,
+ *                 aligned on the SIMD vector size.
+ */
+void ddgemm_batch_pack(size_t n, size_t simd_width, size_t batch,
+	const doubledouble FPPLUS_ARRAY_POINTER(matrices, batch * n * n),
+	double FPPLUS_NONNULL_POINTER(packed));
+
+/**
+ * @brief Unpacks the first batch matrices from groups of simd_width interleaved matrices into row-major n x n matrices
+ */
+void ddgemm_batch_unpack(size_t n, size_t simd_width, size_t batch,
+	const double FPPLUS_NONNULL_POINTER(packed),
+	doubledouble FPPLUS_ARRAY_POINTER(matrices, batch * n * n));
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -7,12 +7,15 @@
 #include <string.h>
 
 #include <utils.h>
+#include <arena.h>
 #include <ddgemm/common.h>
+#include <ddgemm/pack.h>
 
 
 static void benchmark(
 	ddgemm_function ddgemm,
-	size_t nr, size_t mr,
+	size_t mr, size_t nr,
+	enum report_format format,
 	size_t iterations,
 	size_t block_size,
 	const double a[restrict],
@@ -20,41 +23,162 @@ static void benchmark(
 	doubledouble c[restrict])
 {
 	double iteration_times[iterations];
+	struct perf_counter_values iteration_counters[iterations];
 	const size_t kc = block_size / ((nr + mr) * sizeof(doubledouble));
 	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
 		const double start_time = high_precision_time();
 
 		ddgemm(kc, a, b, c);
 
 		iteration_times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	/* Counters are normalized per double-double multiply-add */
+	double counters[perf_counter_count];
+	median_perf_counters(iterations, iteration_counters, (double) (nr * mr * kc), counters);
+	if (format == report_format_text) {
+		const double median_time_ns = median_double(iteration_times, iterations);
+		const double gflops = 2.0 * nr * mr * kc / median_time_ns;
+		printf("%zu\t" "%zu\t" "%zu\t" "%zu\t" "%.1lf", block_size, mr, nr, kc, gflops * 1000.0);
+		report_text_counters(counters);
+	} else {
+		/* Convert iteration times to MFLOPS in-place */
+		double* iteration_mflops = iteration_times;
+		for (size_t iteration = 0; iteration < iterations; iteration++) {
+			iteration_mflops[iteration] = 2.0e+3 * nr * mr * kc / iteration_times[iteration];
+		}
+		const struct sample_statistics statistics = compute_sample_statistics(iteration_mflops, iterations);
+
+		char name[32];
+		snprintf(name, sizeof(name), "ddgemm%zux%zu", mr, nr);
+		report_measurement(name, block_size, report_unit_mflops, &statistics, counters);
+	}
+}
+
+/*
+ * Measures calls which pack mr x kc panel of A and kc x nr panel of B before the micro-kernel,
+ * as a GEMM driver would, with packing buffers allocated by valloc or from an arena on each call.
+ */
+static void benchmark_packing(
+	ddgemm_function ddgemm,
+	size_t mr, size_t nr,
+	enum report_format format,
+	size_t iterations,
+	size_t block_size,
+	const doubledouble a[restrict],
+	const doubledouble b[restrict],
+	doubledouble c[restrict],
+	struct arena scratch_arena[restrict static 1])
+{
+	double valloc_times[iterations], arena_times[iterations];
+	struct perf_counter_values valloc_iteration_counters[iterations], arena_iteration_counters[iterations];
+	const size_t kc = block_size / ((nr + mr) * sizeof(doubledouble));
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+
+		double* packed_a = valloc(2 * mr * kc * sizeof(double));
+		doubledouble* packed_b = valloc(nr * kc * sizeof(doubledouble));
+		ddgemm_pack_a(mr, DDGEMM_MR_STEP, kc, a, mr, packed_a);
+		ddgemm_pack_b(nr, kc, b, kc, packed_b);
+		ddgemm(kc, packed_a, packed_b, c);
+		free(packed_a);
+		free(packed_b);
+
+		valloc_times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&valloc_iteration_counters[iteration]);
+	}
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+
+		arena_reset(scratch_arena);
+		double* packed_a = arena_alloc(scratch_arena, 2 * mr * kc * sizeof(double));
+		doubledouble* packed_b = arena_alloc(scratch_arena, nr * kc * sizeof(doubledouble));
+		ddgemm_pack_a(mr, DDGEMM_MR_STEP, kc, a, mr, packed_a);
+		ddgemm_pack_b(nr, kc, b, kc, packed_b);
+		ddgemm(kc, packed_a, packed_b, c);
+
+		arena_times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&arena_iteration_counters[iteration]);
+	}
+	/* Counters are normalized per double-double multiply-add */
+	double valloc_counters[perf_counter_count], arena_counters[perf_counter_count];
+	median_perf_counters(iterations, valloc_iteration_counters, (double) (nr * mr * kc), valloc_counters);
+	median_perf_counters(iterations, arena_iteration_counters, (double) (nr * mr * kc), arena_counters);
+	if (format == report_format_text) {
+		const double valloc_time_ns = median_double(valloc_times, iterations);
+		const double arena_time_ns = median_double(arena_times, iterations);
+		printf("%zu\t" "%zu\t" "%zu\t" "%zu\t" "%.1lf\t" "%.1lf\t" "%.0lf ns",
+			block_size, mr, nr, kc,
+			2.0e+3 * nr * mr * kc / valloc_time_ns, 2.0e+3 * nr * mr * kc / arena_time_ns,
+			valloc_time_ns - arena_time_ns);
+		report_text_counters(arena_counters);
+	} else {
+		/* Convert iteration times to MFLOPS in-place */
+		for (size_t iteration = 0; iteration < iterations; iteration++) {
+			valloc_times[iteration] = 2.0e+3 * nr * mr * kc / valloc_times[iteration];
+			arena_times[iteration] = 2.0e+3 * nr * mr * kc / arena_times[iteration];
+		}
+		const struct sample_statistics valloc_statistics = compute_sample_statistics(valloc_times, iterations);
+		const struct sample_statistics arena_statistics = compute_sample_statistics(arena_times, iterations);
+
+		char name[48];
+		snprintf(name, sizeof(name), "ddgemm%zux%zu/pack/valloc", mr, nr);
+		report_measurement(name, block_size, report_unit_mflops, &valloc_statistics, valloc_counters);
+		snprintf(name, sizeof(name), "ddgemm%zux%zu/pack/arena", mr, nr);
+		report_measurement(name, block_size, report_unit_mflops, &arena_statistics, arena_counters);
 	}
-	const double median_time_ns = median_double(iteration_times, iterations);
-	const double gflops = 2.0 * nr * mr * kc / median_time_ns;
-	printf("%zu\t" "%zu\t" "%zu\t" "%zu\t" "%.1lf\n", block_size, mr, nr, kc, gflops * 1000.0);
 }
 
 int main(int argc, char *argv[]) {
     const struct benchmark_options options = parse_options(argc, argv);
 
-	void* a_array = valloc(options.block_size);
-	void* b_array = valloc(options.block_size);
-	void* c_array = valloc(DDGEMM_MR_MAX * DDGEMM_NR_MAX * sizeof(doubledouble));
+	/* Micro-kernel operands, and column-major matrices which are packed into them in --packing mode */
+	struct arena data_arena, scratch_arena;
+	const size_t c_size = DDGEMM_MR_MAX * DDGEMM_NR_MAX * sizeof(doubledouble);
+	if (!arena_init(&data_arena, 4 * options.block_size + c_size + 5 * ARENA_ALIGNMENT, options.arena_flags) ||
+		!arena_init(&scratch_arena, 2 * options.block_size + 2 * ARENA_ALIGNMENT, options.arena_flags))
+	{
+		fprintf(stderr, "Error: failed to allocate memory for the benchmark\n");
+		exit(EXIT_FAILURE);
+	}
+	void* a_array = arena_alloc(&data_arena, options.block_size);
+	void* b_array = arena_alloc(&data_arena, options.block_size);
+	void* c_array = arena_alloc(&data_arena, c_size);
+	void* a_matrix = arena_alloc(&data_arena, options.block_size);
+	void* b_matrix = arena_alloc(&data_arena, options.block_size);
 	for (double* double_array = a_array; double_array != a_array + options.block_size; double_array++) {
 		*double_array = M_PI;
 	}
 	for (double* double_array = b_array; double_array != b_array + options.block_size; double_array++) {
 		*double_array = M_E;
 	}
-	memset(c_array, 0, DDGEMM_MR_MAX * DDGEMM_NR_MAX * sizeof(doubledouble));
+	for (double* double_array = a_matrix; double_array != a_matrix + options.block_size; double_array++) {
+		*double_array = M_PI;
+	}
+	for (double* double_array = b_matrix; double_array != b_matrix + options.block_size; double_array++) {
+		*double_array = M_E;
+	}
+	memset(c_array, 0, c_size);
 
+	perf_counters_open(options.counters);
+	report_begin(options.format, "ddgemm-bench", argc, argv);
 	for (size_t mr = DDGEMM_MR_MIN; mr <= DDGEMM_MR_MAX; mr += DDGEMM_MR_STEP) {
 		for (size_t nr = DDGEMM_NR_MIN; nr <= DDGEMM_NR_MAX; nr += 1) {
 			ddgemm_function ddgemm = select_ddgemm_kernel(mr, nr);
-			benchmark(ddgemm, mr, nr, options.iterations, options.block_size, a_array, b_array, c_array);
+			if (options.packing) {
+				benchmark_packing(ddgemm, mr, nr, options.format, options.iterations, options.block_size,
+					a_matrix, b_matrix, c_array, &scratch_arena);
+			} else {
+				benchmark(ddgemm, mr, nr, options.format, options.iterations, options.block_size, a_array, b_array, c_array);
+			}
 		}
 	}
+	report_end();
+	perf_counters_close();
 
-	free(a_array);
-	free(b_array);
-	free(c_array);
+	arena_release(&data_arena);
+	arena_release(&scratch_arena);
 }
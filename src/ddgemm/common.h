@@ -5,12 +5,22 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <report.h>
 #include <ddgemm/ddgemm.h>
 
 
 struct benchmark_options {
 	size_t iterations;
 	size_t block_size;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+	/* Include allocation of packing buffers and packing of A and B panels in the measurements */
+	bool packing;
+	/* Bit mask of arena_flags for the arrays allocated by the benchmark */
+	uint32_t arena_flags;
 };
 
 struct benchmark_options parse_options(int argc, char** argv);
@@ -155,6 +155,7 @@ typedef void (*ddgemm_function)(size_t, const double*, const doubledouble*, doub
 #include <gtest/gtest.h>
 
 #include <ddgemm/ddgemm.h>
+#include <ddgemm/pack.h>
 
 #include "ddgemm-tester.h"
 
@@ -167,6 +168,12 @@ TEST(ddgemm, ukernel{mr}x{nr}) {{
 }}
 """.format(mr=mr, nr=nr, simd_width=simd.width))
 
+		unittest.line("""\
+TEST(ddgemm, pack) {{
+	DDGEMMPackTester<{mr}, {nr}, {simd_width}>().test();
+}}
+""".format(mr=options.mr_max, nr=options.nr_max, simd_width=simd.width))
+
 		unittest.line("""\
 int main(int argc, char* argv[]) {
 	testing::InitGoogleTest(&argc, argv);
@@ -2,16 +2,24 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <arena.h>
 #include <ddgemm/common.h>
 
 
 static void print_options_help(const char* program_name) {
 	printf(
-"%s -b block-size [-i iterations]\n"
+"%s -b block-size [-i iterations] [-f format] [-c counters] [-p] [--huge-pages] [--prefault]\n"
 "Required parameters:\n"
 "  -b   --block-size   The size of block processed in micro-kernel (usually L1 cache size)\n"
 "Optional parameters:\n"
-"  -i   --iterations   The number of benchmark iterations (default: 1000)\n",
+"  -i   --iterations   The number of benchmark iterations (default: 1000)\n"
+"  -f   --format       Output format: text (default), csv, or json\n"
+"  -c   --counters     Comma-separated list of performance counters to measure, or all:\n"
+"                      cycles, instructions, fp-scalar, fp-128, fp-256, fp-512, l1d-misses, llc-misses\n"
+"  -p   --packing      Also pack A and B panels on each call, with packing buffers from valloc and from an arena,\n"
+"                      and report the time saved by the arena\n"
+"       --huge-pages   Back the benchmark arrays and the arena with transparent huge pages\n"
+"       --prefault     Touch all pages of the benchmark arrays and the arena before the measurements\n",
 		program_name);
 }
 
@@ -19,6 +27,10 @@ struct benchmark_options parse_options(int argc, char** argv) {
 	struct benchmark_options options = {
 		.iterations = 1000,
 		.block_size = 0,
+		.format = report_format_text,
+		.counters = 0,
+		.packing = false,
+		.arena_flags = 0,
 	};
 	for (int argi = 1; argi < argc; argi += 1) {
 		if ((strcmp(argv[argi], "--block-size") == 0) || (strcmp(argv[argi], "-b") == 0)) {
@@ -49,6 +61,37 @@ struct benchmark_options parse_options(int argc, char** argv) {
 				exit(EXIT_FAILURE);
 			}
 			argi += 1;
+		} else if ((strcmp(argv[argi], "--format") == 0) || (strcmp(argv[argi], "-f") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected output format\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_report_format(argv[argi + 1], &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strncmp(argv[argi], "--format=", strlen("--format=")) == 0) {
+			if (!parse_report_format(argv[argi] + strlen("--format="), &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi] + strlen("--format="));
+				exit(EXIT_FAILURE);
+			}
+		} else if ((strcmp(argv[argi], "--counters") == 0) || (strcmp(argv[argi], "-c") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected list of performance counters\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_perf_counters(argv[argi + 1], &options.counters)) {
+				fprintf(stderr, "Error: invalid list of performance counters %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--packing") == 0) || (strcmp(argv[argi], "-p") == 0)) {
+			options.packing = true;
+		} else if (strcmp(argv[argi], "--huge-pages") == 0) {
+			options.arena_flags |= arena_flag_huge_pages;
+		} else if (strcmp(argv[argi], "--prefault") == 0) {
+			options.arena_flags |= arena_flag_prefault;
 		} else if ((strcmp(argv[argi], "--help") == 0) || (strcmp(argv[argi], "-h") == 0)) {
 			print_options_help(argv[0]);
 			exit(EXIT_SUCCESS);
@@ -0,0 +1,29 @@
+#include <ddgemm/pack.h>
+
+
+void ddgemm_pack_a(size_t mr, size_t simd_width, size_t k,
+	const doubledouble a[restrict static 1], size_t lda,
+	double packed[restrict static 2 * mr * k])
+{
+	for (size_t kk = 0; kk < k; kk++) {
+		for (size_t m = 0; m < mr; m += simd_width) {
+			for (size_t i = 0; i < simd_width; i++) {
+				packed[i] = a[kk * lda + m + i].hi;
+				packed[simd_width + i] = a[kk * lda + m + i].lo;
+			}
+			packed += 2 * simd_width;
+		}
+	}
+}
+
+void ddgemm_pack_b(size_t nr, size_t k,
+	const doubledouble b[restrict static 1], size_t ldb,
+	doubledouble packed[restrict static nr * k])
+{
+	for (size_t kk = 0; kk < k; kk++) {
+		for (size_t n = 0; n < nr; n++) {
+			packed[n] = b[n * ldb + kk];
+		}
+		packed += nr;
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stddef.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Packs a panel of mr rows and k columns of a column-major matrix A into the layout of ddgemm micro-kernels
+ * @details For each of k columns, the packed panel contains mr / simd_width pairs of SIMD vectors:
+ *          simd_width high parts followed by simd_width low parts of consecutive rows.
+ * @param a - pointer to the first element of the panel, a[m + k * lda] is the element in row m and column k.
+ * @param packed - buffer for 2 * mr * k doubles, aligned on the SIMD vector size.
+ */
+void ddgemm_pack_a(size_t mr, size_t simd_width, size_t k,
+	const doubledouble FPPLUS_NONNULL_POINTER(a), size_t lda,
+	double FPPLUS_ARRAY_POINTER(packed, 2 * mr * k));
+
+/**
+ * @brief Packs a panel of k rows and nr columns of a column-major matrix B into the layout of ddgemm micro-kernels
+ * @details The packed panel stores nr consecutive elements of each of k rows.
+ * @param b - pointer to the first element of the panel, b[k + n * ldb] is the element in row k and column n.
+ * @param packed - buffer for nr * k double-double elements.
+ */
+void ddgemm_pack_b(size_t nr, size_t k,
+	const doubledouble FPPLUS_NONNULL_POINTER(b), size_t ldb,
+	doubledouble FPPLUS_ARRAY_POINTER(packed, nr * k));
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
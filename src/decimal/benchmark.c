@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+#include <mpfr.h>
+
+#include <utils.h>
+#include <decimal/common.h>
+
+
+/* Enough for the 34 significant digits which MPFR prints, the sign, and the exponent */
+#define MPFR_DECIMAL_MAX_LENGTH 48
+/* Precision of MPFR numbers: double-double numbers with up to 20 bits between the high and the low parts are exact */
+#define MPFR_PRECISION 128
+
+/* Random double-double numbers between 2**-300 and 2**300 in magnitude, with a gap of 0 to 20 bits between the high and the low parts */
+static void generate_numbers(size_t count, doubledouble x[restrict static count]) {
+	uint64_t state = UINT64_C(0x853C49E6748FEA9B);
+	for (size_t i = 0; i < count; i++) {
+		const int exponent = (int) (random_bits(&state) % 601) - 300;
+		const double hi = ldexp(1.0 + ldexp((double) random_bits(&state), -53), exponent);
+		const int gap = (int) (random_bits(&state) % 21);
+		const double lo = ldexp(ldexp((double) random_bits(&state), -53) - 0.5, exponent - 52 - gap);
+		const double sign = random_bits(&state) & 1 ? -1.0 : 1.0;
+		x[i].hi = efaddord(sign * hi, sign * lo, &x[i].lo);
+	}
+}
+
+static size_t mpfr_print_array(size_t count, const doubledouble x[restrict static count], char* buffer, mpfr_t number) {
+	char* position = buffer;
+	for (size_t i = 0; i < count; i++) {
+		mpfr_set_d(number, x[i].hi, MPFR_RNDN);
+		mpfr_add_d(number, number, x[i].lo, MPFR_RNDN);
+		/* Null-terminated strings: mpfr_strtofr takes time proportional to the length of the rest of the string */
+		position += mpfr_sprintf(position, "%.33Re", number) + 1;
+	}
+	return (size_t) (position - buffer);
+}
+
+static size_t mpfr_parse_array(size_t count, const char* buffer, doubledouble x[restrict static count], mpfr_t number) {
+	const char* position = buffer;
+	size_t parsed = 0;
+	for (; parsed < count; parsed++) {
+		char* end;
+		mpfr_strtofr(number, position, &end, 10, MPFR_RNDN);
+		if (end == position) {
+			break;
+		}
+		position = end + 1;
+		x[parsed].hi = mpfr_get_d(number, MPFR_RNDN);
+		mpfr_sub_d(number, number, x[parsed].hi, MPFR_RNDN);
+		x[parsed].lo = mpfr_get_d(number, MPFR_RNDN);
+	}
+	return parsed;
+}
+
+/* Prints MB/s of text, or reports it as a measurement */
+static void report(const char* name, enum report_format format, size_t count, size_t bytes,
+	size_t iterations, double iteration_times[restrict static iterations],
+	const struct perf_counter_values iteration_counters[restrict static iterations])
+{
+	double counters[perf_counter_count];
+	median_perf_counters(iterations, iteration_counters, (double) count, counters);
+	/* Convert iteration times to MB/s in-place */
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		iteration_times[iteration] = 1.0e+3 * (double) bytes / iteration_times[iteration];
+	}
+	if (format == report_format_text) {
+		printf("%s\t" "%10zu\t" "%.1lf MB/s", name, count, median_double(iteration_times, iterations));
+		report_text_counters(counters);
+	} else {
+		const struct sample_statistics statistics = compute_sample_statistics(iteration_times, iterations);
+		report_measurement(name, count, report_unit_mbytes_per_second, &statistics, counters);
+	}
+}
+
+static bool identical(doubledouble a, doubledouble b) {
+	return a.hi == b.hi && a.lo == b.lo;
+}
+
+int main(int argc, char *argv[]) {
+	const struct benchmark_options options = parse_options(argc, argv);
+	const size_t count = options.count, iterations = options.iterations;
+
+	doubledouble* x = malloc(count * sizeof(doubledouble));
+	doubledouble* y = malloc(count * sizeof(doubledouble));
+	char* text = malloc(count * DD_DECIMAL_MAX_LENGTH);
+	char* mpfr_text = malloc(count * MPFR_DECIMAL_MAX_LENGTH + 1);
+	if (x == NULL || y == NULL || text == NULL || mpfr_text == NULL) {
+		fprintf(stderr, "Error: failed to allocate memory for %zu numbers\n", count);
+		exit(EXIT_FAILURE);
+	}
+	generate_numbers(count, x);
+	mpfr_t number;
+	mpfr_init2(number, MPFR_PRECISION);
+
+	perf_counters_open(options.counters);
+	report_begin(options.format, "decimal-bench", argc, argv);
+
+	double times[iterations];
+	struct perf_counter_values iteration_counters[iterations];
+	size_t text_length = 0, mpfr_text_length = 0;
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		text_length = ddtoa_array(count, x, text);
+		times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	report("decimal/print/fpplus", options.format, count, text_length, iterations, times, iteration_counters);
+
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		mpfr_text_length = mpfr_print_array(count, x, mpfr_text, number);
+		times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	report("decimal/print/mpfr", options.format, count, mpfr_text_length, iterations, times, iteration_counters);
+
+	size_t parsed = 0;
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		parsed = strtodd_array(count, text, NULL, y);
+		times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	report("decimal/parse/fpplus", options.format, count, text_length, iterations, times, iteration_counters);
+	size_t mismatches = count - parsed;
+	for (size_t i = 0; i < parsed; i++) {
+		mismatches += !identical(x[i], y[i]);
+	}
+	if (mismatches != 0) {
+		fprintf(stderr, "Error: %zu of %zu numbers do not round-trip through ddtoa and strtodd\n", mismatches, count);
+		exit(EXIT_FAILURE);
+	}
+
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		parsed = mpfr_parse_array(count, mpfr_text, y, number);
+		times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	report("decimal/parse/mpfr", options.format, count, mpfr_text_length, iterations, times, iteration_counters);
+
+	report_end();
+	perf_counters_close();
+
+	mpfr_clear(number);
+	free(x);
+	free(y);
+	free(text);
+	free(mpfr_text);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <report.h>
+#include <decimal/decimal.h>
+
+
+struct benchmark_options {
+	/* The number of converted double-double numbers */
+	size_t count;
+	size_t iterations;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+};
+
+struct benchmark_options parse_options(int argc, char** argv);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
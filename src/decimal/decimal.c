@@ -0,0 +1,1287 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <decimal/decimal.h>
+
+
+/*
+ * Both conversions are exact computations on big integers:
+ * - strtodd represents the decimal as num / den * 2**exponent with den = 5**k,
+ *   and extracts the high and the low part with two correctly rounded divisions.
+ * - ddtoa generates the shortest digits in the interval of numbers which round to the same double-double number
+ *   (Steele & White free-format algorithm with the improvements of Burger & Dybvig).
+ * ddtoa first tries two fast paths, and uses the exact algorithm only when they do not apply:
+ * - if lo is zero, the digits are the exact decimal expansion of hi;
+ * - otherwise, if the value and its interval fit into 192-bit fixed-point numbers, the digits are generated with Grisu3
+ *   (Loitsch, "Printing floating-point numbers quickly and accurately with integers"), which detects when the rounding
+ *   errors of the approximate powers of 10 could change the result.
+ */
+
+/*
+ * strtodd keeps at most this many significant digits, and replaces the rest with a single non-zero digit if any of them is non-zero.
+ * Any rounding boundary of double-double numbers is a multiple of 2**-1076 smaller than 2**1024,
+ * and has at most 1385 significant digits, so the replacement never changes the rounding.
+ */
+#define MAX_SIGNIFICANT_DIGITS 1400
+
+/* The largest numbers are (10**1401) * 2**54 in strtodd, 4708 bits */
+#define BIGINT_CAPACITY 160
+
+struct bigint {
+	/* The number of significant 32-bit limbs, no leading zero limbs */
+	uint32_t size;
+	/* Limbs in little-endian order */
+	uint32_t limbs[BIGINT_CAPACITY];
+};
+
+static inline void bigint_set_u64(struct bigint a[restrict static 1], uint64_t value) {
+	a->limbs[0] = (uint32_t) value;
+	a->limbs[1] = (uint32_t) (value >> 32);
+	a->size = a->limbs[1] != 0 ? 2 : a->limbs[0] != 0 ? 1 : 0;
+}
+
+static inline bool bigint_is_zero(const struct bigint a[restrict static 1]) {
+	return a->size == 0;
+}
+
+/* Copies only the significant limbs, the structure is large */
+static inline void bigint_copy(struct bigint destination[restrict static 1], const struct bigint source[restrict static 1]) {
+	destination->size = source->size;
+	memcpy(destination->limbs, source->limbs, source->size * sizeof(uint32_t));
+}
+
+static inline uint32_t bigint_bit_length(const struct bigint a[restrict static 1]) {
+	if (a->size == 0) {
+		return 0;
+	}
+	return 32 * a->size - (uint32_t) __builtin_clz(a->limbs[a->size - 1]);
+}
+
+/* a = a * multiplier + addend */
+static void bigint_mul_add_small(struct bigint a[restrict static 1], uint32_t multiplier, uint32_t addend) {
+	uint64_t carry = addend;
+	for (uint32_t i = 0; i < a->size; i++) {
+		const uint64_t product = (uint64_t) a->limbs[i] * (uint64_t) multiplier + carry;
+		a->limbs[i] = (uint32_t) product;
+		carry = product >> 32;
+	}
+	if (carry != 0) {
+		a->limbs[a->size++] = (uint32_t) carry;
+	}
+}
+
+/* a = a * multiplier */
+static void bigint_mul_u64(struct bigint a[restrict static 1], uint64_t multiplier) {
+	unsigned __int128 carry = 0;
+	for (uint32_t i = 0; i < a->size; i++) {
+		const unsigned __int128 product = (unsigned __int128) a->limbs[i] * multiplier + carry;
+		a->limbs[i] = (uint32_t) product;
+		carry = product >> 32;
+	}
+	while (carry != 0) {
+		a->limbs[a->size++] = (uint32_t) carry;
+		carry >>= 32;
+	}
+	while (a->size != 0 && a->limbs[a->size - 1] == 0) {
+		a->size -= 1;
+	}
+}
+
+static void bigint_mul_pow5(struct bigint a[restrict static 1], uint32_t power) {
+	/* 5**13 is the largest power of 5 which fits into a limb */
+	static const uint32_t powers_of_5[14] = {
+		1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625, 1220703125
+	};
+	for (; power >= 13; power -= 13) {
+		bigint_mul_add_small(a, powers_of_5[13], 0);
+	}
+	if (power != 0) {
+		bigint_mul_add_small(a, powers_of_5[power], 0);
+	}
+}
+
+static void bigint_shift_left(struct bigint a[restrict static 1], uint32_t shift) {
+	if (a->size == 0) {
+		return;
+	}
+	const uint32_t limb_shift = shift / 32, bit_shift = shift % 32;
+	if (bit_shift == 0) {
+		for (uint32_t i = a->size; i != 0; i--) {
+			a->limbs[i - 1 + limb_shift] = a->limbs[i - 1];
+		}
+	} else {
+		a->limbs[a->size + limb_shift] = a->limbs[a->size - 1] >> (32 - bit_shift);
+		for (uint32_t i = a->size - 1; i != 0; i--) {
+			a->limbs[i + limb_shift] = (a->limbs[i] << bit_shift) | (a->limbs[i - 1] >> (32 - bit_shift));
+		}
+		a->limbs[limb_shift] = a->limbs[0] << bit_shift;
+		a->size += 1;
+	}
+	memset(a->limbs, 0, limb_shift * sizeof(uint32_t));
+	a->size += limb_shift;
+	if (a->limbs[a->size - 1] == 0) {
+		a->size -= 1;
+	}
+}
+
+static void bigint_shift_right(struct bigint a[restrict static 1], uint32_t shift) {
+	const uint32_t limb_shift = shift / 32, bit_shift = shift % 32;
+	if (limb_shift >= a->size) {
+		a->size = 0;
+		return;
+	}
+	const uint32_t size = a->size - limb_shift;
+	for (uint32_t i = 0; i < size; i++) {
+		const uint64_t pair = (uint64_t) a->limbs[i + limb_shift] |
+			(i + limb_shift + 1 < a->size ? (uint64_t) a->limbs[i + limb_shift + 1] << 32 : 0);
+		a->limbs[i] = (uint32_t) (pair >> bit_shift);
+	}
+	a->size = size;
+	if (a->limbs[a->size - 1] == 0) {
+		a->size -= 1;
+	}
+}
+
+/* The number of trailing zero bits of a non-zero number */
+static uint32_t bigint_trailing_zeros(const struct bigint a[restrict static 1]) {
+	uint32_t i = 0;
+	while (a->limbs[i] == 0) {
+		i++;
+	}
+	return 32 * i + (uint32_t) __builtin_ctz(a->limbs[i]);
+}
+
+/* a = floor(a / divisor), returns the remainder */
+static uint32_t bigint_div_small(struct bigint a[restrict static 1], uint32_t divisor) {
+	uint64_t remainder = 0;
+	for (uint32_t i = a->size; i != 0; i--) {
+		const uint64_t dividend = (remainder << 32) | a->limbs[i - 1];
+		a->limbs[i - 1] = (uint32_t) (dividend / divisor);
+		remainder = dividend % divisor;
+	}
+	while (a->size != 0 && a->limbs[a->size - 1] == 0) {
+		a->size -= 1;
+	}
+	return (uint32_t) remainder;
+}
+
+static void bigint_mul_pow10(struct bigint a[restrict static 1], uint32_t power) {
+	bigint_mul_pow5(a, power);
+	bigint_shift_left(a, power);
+}
+
+static int bigint_compare(const struct bigint a[restrict static 1], const struct bigint b[restrict static 1]) {
+	if (a->size != b->size) {
+		return a->size > b->size ? 1 : -1;
+	}
+	for (uint32_t i = a->size; i != 0; i--) {
+		if (a->limbs[i - 1] != b->limbs[i - 1]) {
+			return a->limbs[i - 1] > b->limbs[i - 1] ? 1 : -1;
+		}
+	}
+	return 0;
+}
+
+/* a = a + b */
+static void bigint_add(struct bigint a[restrict static 1], const struct bigint b[restrict static 1]) {
+	const uint32_t size = a->size > b->size ? a->size : b->size;
+	uint64_t carry = 0;
+	for (uint32_t i = 0; i < size; i++) {
+		const uint64_t sum = (uint64_t) (i < a->size ? a->limbs[i] : 0) + (uint64_t) (i < b->size ? b->limbs[i] : 0) + carry;
+		a->limbs[i] = (uint32_t) sum;
+		carry = sum >> 32;
+	}
+	a->size = size;
+	if (carry != 0) {
+		a->limbs[a->size++] = (uint32_t) carry;
+	}
+}
+
+/* Compares a + b with c */
+static int bigint_compare_sum(const struct bigint a[restrict static 1], const struct bigint b[restrict static 1], const struct bigint c[restrict static 1]) {
+	struct bigint sum;
+	bigint_copy(&sum, a);
+	bigint_add(&sum, b);
+	return bigint_compare(&sum, c);
+}
+
+/* a = a - b, requires a >= b */
+static void bigint_sub(struct bigint a[restrict static 1], const struct bigint b[restrict static 1]) {
+	uint32_t borrow = 0;
+	for (uint32_t i = 0; i < a->size; i++) {
+		const uint64_t subtrahend = (uint64_t) (i < b->size ? b->limbs[i] : 0) + borrow;
+		borrow = (uint64_t) a->limbs[i] < subtrahend;
+		a->limbs[i] = (uint32_t) ((uint64_t) a->limbs[i] - subtrahend);
+	}
+	while (a->size != 0 && a->limbs[a->size - 1] == 0) {
+		a->size -= 1;
+	}
+}
+
+/* a = b - a, requires b >= a */
+static void bigint_reverse_sub(struct bigint a[restrict static 1], const struct bigint b[restrict static 1]) {
+	struct bigint difference;
+	bigint_copy(&difference, b);
+	bigint_sub(&difference, a);
+	bigint_copy(a, &difference);
+}
+
+/* The top 64 bits of a >> shift, for shift such that the result fits into 64 bits */
+static uint64_t bigint_extract_u64(const struct bigint a[restrict static 1], uint32_t shift) {
+	uint64_t result = 0;
+	const uint32_t limb_shift = shift / 32, bit_shift = shift % 32;
+	for (uint32_t i = 0; i < 3; i++) {
+		const uint32_t limb_index = limb_shift + i;
+		const uint64_t limb = limb_index < a->size ? a->limbs[limb_index] : 0;
+		if (i == 0) {
+			result = limb >> bit_shift;
+		} else {
+			const uint32_t position = 32 * i - bit_shift;
+			if (position < 64) {
+				result |= limb << position;
+			}
+		}
+	}
+	return result;
+}
+
+/*
+ * Divides num by den, and replaces num with the remainder.
+ * The quotient must be smaller than 2**55.
+ */
+static uint64_t bigint_divide(struct bigint num[restrict static 1], const struct bigint den[restrict static 1]) {
+	const uint32_t den_bits = bigint_bit_length(den);
+	uint64_t quotient;
+	if (den_bits <= 64) {
+		const uint64_t divisor = bigint_extract_u64(den, 0);
+		const unsigned __int128 dividend = (unsigned __int128) bigint_extract_u64(num, 0) |
+			((unsigned __int128) bigint_extract_u64(num, 64) << 64);
+		quotient = (uint64_t) (dividend / divisor);
+		bigint_set_u64(num, (uint64_t) (dividend % divisor));
+		return quotient;
+	}
+
+	/*
+	 * Estimate the quotient from the leading 64 bits of den: the estimate is not larger than the quotient,
+	 * and smaller by at most 2 because the quotient is smaller than 2**55.
+	 */
+	const uint32_t shift = den_bits - 64;
+	const uint64_t divisor = bigint_extract_u64(den, shift);
+	const unsigned __int128 dividend = (unsigned __int128) bigint_extract_u64(num, shift) |
+		((unsigned __int128) bigint_extract_u64(num, shift + 64) << 64);
+	quotient = (uint64_t) (dividend / ((unsigned __int128) divisor + 1));
+	struct bigint product;
+	bigint_copy(&product, den);
+	bigint_mul_u64(&product, quotient);
+	bigint_sub(num, &product);
+	while (bigint_compare(num, den) >= 0) {
+		bigint_sub(num, den);
+		quotient += 1;
+	}
+	return quotient;
+}
+
+
+static inline double double_from_bits(uint64_t bits) {
+	double value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+static inline uint64_t double_to_bits(double value) {
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+/*
+ * Rounds the positive number num / den * 2**exponent to the nearest double, with ties to even.
+ * Replaces num and exponent with the magnitude of the rounding error num' / den * 2**exponent',
+ * and sets remainder_negative if the rounded value is larger than the number.
+ */
+static double round_quotient(struct bigint num[restrict static 1], const struct bigint den[restrict static 1],
+	int32_t exponent[restrict static 1], bool remainder_negative[restrict static 1])
+{
+	*remainder_negative = false;
+	if (bigint_is_zero(num)) {
+		return 0.0;
+	}
+
+	/* floor(log2(num / den)) is either bit_length(num) - bit_length(den) or one less */
+	int32_t log2_value = (int32_t) bigint_bit_length(num) - (int32_t) bigint_bit_length(den);
+	struct bigint scaled;
+	bigint_copy(&scaled, log2_value >= 0 ? den : num);
+	bigint_shift_left(&scaled, (uint32_t) (log2_value >= 0 ? log2_value : -log2_value));
+	if (log2_value >= 0 ? bigint_compare(num, &scaled) < 0 : bigint_compare(&scaled, den) < 0) {
+		log2_value -= 1;
+	}
+	log2_value += *exponent;
+	if (log2_value > 1023) {
+		bigint_set_u64(num, 0);
+		return double_from_bits(UINT64_C(0x7FF0000000000000));
+	}
+
+	/* The exponent of the last bit of the result: 52 bits after the leading bit, or the last bit of subnormal numbers */
+	const int32_t last_bit_exponent = log2_value - 52 > -1074 ? log2_value - 52 : -1074;
+	const int32_t shift = last_bit_exponent - *exponent;
+	uint64_t quotient;
+	struct bigint divisor;
+	bigint_copy(&divisor, den);
+	if (shift >= 0) {
+		bigint_shift_left(&divisor, (uint32_t) shift);
+		quotient = bigint_divide(num, &divisor);
+	} else {
+		bigint_shift_left(num, (uint32_t) -shift);
+		quotient = bigint_divide(num, &divisor);
+		*exponent = last_bit_exponent;
+	}
+
+	/* Compare the remainder with a half of the divisor */
+	struct bigint twice_remainder;
+	bigint_copy(&twice_remainder, num);
+	bigint_shift_left(&twice_remainder, 1);
+	const int remainder_comparison = bigint_compare(&twice_remainder, &divisor);
+	if (remainder_comparison > 0 || (remainder_comparison == 0 && (quotient & 1) != 0)) {
+		quotient += 1;
+		bigint_reverse_sub(num, &divisor);
+		*remainder_negative = true;
+	}
+
+	/* quotient * 2**last_bit_exponent with quotient <= 2**53, and quotient < 2**52 only for subnormal numbers */
+	if (quotient < (UINT64_C(1) << 52)) {
+		return double_from_bits(quotient);
+	}
+	const uint64_t biased_exponent = (uint64_t) (last_bit_exponent + 1075);
+	/* If quotient == 2**53 the mantissa overflows into the exponent, which is still correct */
+	const uint64_t bits = (biased_exponent << 52) + (quotient - (UINT64_C(1) << 52));
+	return double_from_bits(bits >= UINT64_C(0x7FF0000000000000) ? UINT64_C(0x7FF0000000000000) : bits);
+}
+
+static inline bool is_digit(char c) {
+	return (unsigned char) (c - '0') < 10;
+}
+
+static inline bool is_space(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/* Case-insensitive comparison of the beginning of string with a lower-case prefix */
+static bool has_prefix(const char* string, const char* prefix) {
+	for (; *prefix != '\0'; string++, prefix++) {
+		if ((*string | 0x20) != *prefix) {
+			return false;
+		}
+	}
+	return true;
+}
+
+doubledouble strtodd(const char* string, char** end) {
+	const char* position = string;
+	while (is_space(*position)) {
+		position++;
+	}
+	bool negative = false;
+	if (*position == '+' || *position == '-') {
+		negative = *position == '-';
+		position++;
+	}
+	const double sign = negative ? -1.0 : 1.0;
+
+	if (has_prefix(position, "inf")) {
+		position += has_prefix(position, "infinity") ? 8 : 3;
+		if (end != NULL) {
+			*end = (char*) position;
+		}
+		return (doubledouble) { sign * double_from_bits(UINT64_C(0x7FF0000000000000)), 0.0 };
+	}
+	if (has_prefix(position, "nan")) {
+		if (end != NULL) {
+			*end = (char*) (position + 3);
+		}
+		return (doubledouble) { double_from_bits(UINT64_C(0x7FF8000000000000)), 0.0 };
+	}
+
+	/*
+	 * Significant digits are accumulated into an integer in groups of 9 digits.
+	 * The value is significand * 10**(decimal_point + exponent - digits).
+	 */
+	struct bigint num;
+	bigint_set_u64(&num, 0);
+	uint32_t group = 0, group_digits = 0;
+	int64_t digits = 0, decimal_point = 0;
+	bool any_digits = false, seen_point = false, truncated = false;
+	for (;; position++) {
+		if (is_digit(*position)) {
+			any_digits = true;
+			const uint32_t digit = (uint32_t) (*position - '0');
+			if (digits == 0 && digit == 0) {
+				/* Leading zeros are not significant */
+				decimal_point -= seen_point;
+				continue;
+			}
+			if (!seen_point) {
+				decimal_point += 1;
+			}
+			if (digits < MAX_SIGNIFICANT_DIGITS) {
+				group = group * 10 + digit;
+				digits += 1;
+				if (++group_digits == 9) {
+					bigint_mul_add_small(&num, 1000000000, group);
+					group = 0;
+					group_digits = 0;
+				}
+			} else {
+				truncated |= digit != 0;
+			}
+		} else if (*position == '.' && !seen_point) {
+			seen_point = true;
+		} else {
+			break;
+		}
+	}
+	if (!any_digits) {
+		if (end != NULL) {
+			*end = (char*) string;
+		}
+		return (doubledouble) { 0.0, 0.0 };
+	}
+	if (truncated) {
+		/* A non-zero digit after the kept digits marks the number as larger than the kept digits */
+		group = group * 10 + 1;
+		group_digits += 1;
+		digits += 1;
+	}
+	if (group_digits != 0) {
+		static const uint32_t powers_of_10[10] = {
+			1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+		};
+		bigint_mul_add_small(&num, powers_of_10[group_digits], group);
+	}
+
+	int64_t exponent = 0;
+	if ((*position | 0x20) == 'e') {
+		const char* exponent_position = position + 1;
+		bool negative_exponent = false;
+		if (*exponent_position == '+' || *exponent_position == '-') {
+			negative_exponent = *exponent_position == '-';
+			exponent_position++;
+		}
+		if (is_digit(*exponent_position)) {
+			for (; is_digit(*exponent_position); exponent_position++) {
+				/* Saturate: the value is zero or infinity long before */
+				if (exponent < 100000000) {
+					exponent = exponent * 10 + (*exponent_position - '0');
+				}
+			}
+			exponent = negative_exponent ? -exponent : exponent;
+			position = exponent_position;
+		}
+	}
+	if (end != NULL) {
+		*end = (char*) position;
+	}
+
+	/* The value is in [10**(magnitude-1), 10**magnitude) */
+	const int64_t magnitude = decimal_point + exponent;
+	if (bigint_is_zero(&num) || magnitude <= -324) {
+		/* Smaller than 10**-324, which rounds to zero */
+		return (doubledouble) { sign * 0.0, 0.0 };
+	}
+	if (magnitude > 310) {
+		return (doubledouble) { sign * double_from_bits(UINT64_C(0x7FF0000000000000)), 0.0 };
+	}
+
+	/* num * 10**power10 = num * 5**power10 * 2**power10 */
+	const int32_t power10 = (int32_t) (magnitude - digits);
+	struct bigint den;
+	bigint_set_u64(&den, 1);
+	if (power10 >= 0) {
+		bigint_mul_pow5(&num, (uint32_t) power10);
+	} else {
+		bigint_mul_pow5(&den, (uint32_t) -power10);
+	}
+	int32_t binary_exponent = power10;
+
+	bool lo_negative;
+	const double hi = round_quotient(&num, &den, &binary_exponent, &lo_negative);
+	if (double_to_bits(hi) == UINT64_C(0x7FF0000000000000)) {
+		return (doubledouble) { sign * hi, 0.0 };
+	}
+	bool ignored;
+	const double lo = round_quotient(&num, &den, &binary_exponent, &ignored);
+	/* A zero low part is +0.0 for either sign of the number, as in the results of double-double arithmetic */
+	if (lo == 0.0) {
+		return (doubledouble) { sign * hi, 0.0 };
+	}
+	return (doubledouble) { sign * hi, lo_negative ? -sign * lo : sign * lo };
+}
+
+
+struct double_parts {
+	/* value = mantissa * 2**exponent */
+	uint64_t mantissa;
+	int32_t exponent;
+	/* Whether the next smaller double is closer than the next larger, i.e. the value is a power of 2 with a normal predecessor */
+	bool closer_predecessor;
+};
+
+/* Decomposes a finite positive double, or zero */
+static struct double_parts decompose_double(double value) {
+	const uint64_t bits = double_to_bits(value) & UINT64_C(0x7FFFFFFFFFFFFFFF);
+	const uint64_t fraction = bits & UINT64_C(0x000FFFFFFFFFFFFF);
+	const int32_t biased_exponent = (int32_t) (bits >> 52);
+	if (biased_exponent == 0) {
+		return (struct double_parts) { fraction, -1074, false };
+	}
+	return (struct double_parts) {
+		fraction | (UINT64_C(1) << 52),
+		biased_exponent - 1075,
+		fraction == 0 && biased_exponent > 1
+	};
+}
+
+/* floor(x * log10(2)) for |x| < 2**15 */
+static int32_t floor_log10_pow2(int32_t x) {
+	/* 78913 / 2**18 approximates log10(2) */
+	const int64_t product = (int64_t) x * 78913;
+	return (int32_t) (product >= 0 ? product >> 18 : -((-product + (INT64_C(1) << 18) - 1) >> 18));
+}
+
+static size_t write_exponent(char* buffer, int32_t exponent) {
+	char* position = buffer;
+	*position++ = 'e';
+	*position++ = exponent < 0 ? '-' : '+';
+	const uint32_t magnitude = (uint32_t) (exponent < 0 ? -exponent : exponent);
+	if (magnitude >= 100) {
+		*position++ = (char) ('0' + magnitude / 100);
+	}
+	*position++ = (char) ('0' + magnitude / 10 % 10);
+	*position++ = (char) ('0' + magnitude % 10);
+	*position = '\0';
+	return (size_t) (position - buffer);
+}
+
+/* Inserts the decimal point after the first of the digits and appends the exponent, returns the end of the string */
+static char* finish_scientific(char* first_digit, size_t digits, int32_t exponent) {
+	if (digits > 1) {
+		memmove(first_digit + 2, first_digit + 1, digits - 1);
+		first_digit[1] = '.';
+		digits += 1;
+	}
+	char* position = first_digit + digits;
+	return position + write_exponent(position, exponent);
+}
+
+/*
+ * Fast path for lo = 0: the numbers which round to (hi, 0) are within 2**-1075 of hi.
+ * If hi = m * 2**e with odd m, any decimal with fewer significant digits than the exact expansion of hi is a multiple
+ * of 10**(e+1), at least 10**(e+1) / 2 away from hi, so for e >= -323 the exact expansion is the shortest representation.
+ * Writes the digits of a positive hi, and sets decimal_exponent to k such that 10**(k-1) <= hi < 10**k.
+ * Returns the number of digits, or 0 if hi is too small.
+ */
+static size_t exact_expansion_digits(struct double_parts hi_parts, char digits[restrict static 309],
+	int32_t decimal_exponent[restrict static 1])
+{
+	const uint32_t zeros = (uint32_t) __builtin_ctzll(hi_parts.mantissa);
+	const uint64_t mantissa = hi_parts.mantissa >> zeros;
+	const int32_t exponent = hi_parts.exponent + (int32_t) zeros;
+	if (exponent < -323) {
+		return 0;
+	}
+
+	/* hi = n * 10**min(e, 0) */
+	struct bigint n;
+	bigint_set_u64(&n, mantissa);
+	if (exponent >= 0) {
+		bigint_shift_left(&n, (uint32_t) exponent);
+	} else {
+		bigint_mul_pow5(&n, (uint32_t) -exponent);
+	}
+	/* Groups of 9 digits, from the least significant: hi < 2**1024 has at most 309 digits */
+	uint32_t groups[35];
+	size_t group_count = 0;
+	while (!bigint_is_zero(&n)) {
+		groups[group_count++] = bigint_div_small(&n, 1000000000);
+	}
+
+	/* The most significant group without leading zeros, then the other groups with 9 digits each */
+	size_t length = 0;
+	for (uint32_t group = groups[group_count - 1]; group != 0; group /= 10) {
+		length += 1;
+	}
+	for (size_t g = group_count; g != 0; g--) {
+		const size_t group_length = g == group_count ? length : 9;
+		if (g != group_count) {
+			length += 9;
+		}
+		uint32_t group = groups[g - 1];
+		for (size_t i = 0; i < group_length; i++) {
+			digits[length - 1 - i] = (char) ('0' + group % 10);
+			group /= 10;
+		}
+	}
+	*decimal_exponent = (int32_t) length + (exponent < 0 ? exponent : 0);
+	/* Only integers can have trailing zeros */
+	while (digits[length - 1] == '0') {
+		length -= 1;
+	}
+	return length;
+}
+
+
+struct uint192 {
+	/* Limbs in little-endian order */
+	uint64_t limbs[3];
+};
+
+static inline struct uint192 uint192_from_u64(uint64_t value) {
+	return (struct uint192) { { value, 0, 0 } };
+}
+
+static inline int uint192_compare(struct uint192 a, struct uint192 b) {
+	for (uint32_t i = 3; i != 0; i--) {
+		if (a.limbs[i - 1] != b.limbs[i - 1]) {
+			return a.limbs[i - 1] > b.limbs[i - 1] ? 1 : -1;
+		}
+	}
+	return 0;
+}
+
+/* a + b, the sum must fit into 192 bits */
+static inline struct uint192 uint192_add(struct uint192 a, struct uint192 b) {
+	struct uint192 sum;
+	unsigned __int128 carry = 0;
+	for (uint32_t i = 0; i < 3; i++) {
+		carry += (unsigned __int128) a.limbs[i] + b.limbs[i];
+		sum.limbs[i] = (uint64_t) carry;
+		carry >>= 64;
+	}
+	return sum;
+}
+
+/* a - b, requires a >= b */
+static inline struct uint192 uint192_sub(struct uint192 a, struct uint192 b) {
+	struct uint192 difference;
+	uint64_t borrow = 0;
+	for (uint32_t i = 0; i < 3; i++) {
+		const uint64_t subtrahend = b.limbs[i] + borrow;
+		borrow = (subtrahend < borrow) | (a.limbs[i] < subtrahend);
+		difference.limbs[i] = a.limbs[i] - subtrahend;
+	}
+	return difference;
+}
+
+/* a * multiplier, the product must fit into 192 bits */
+static inline struct uint192 uint192_mul_small(struct uint192 a, uint64_t multiplier) {
+	struct uint192 product;
+	unsigned __int128 carry = 0;
+	for (uint32_t i = 0; i < 3; i++) {
+		carry += (unsigned __int128) a.limbs[i] * multiplier;
+		product.limbs[i] = (uint64_t) carry;
+		carry >>= 64;
+	}
+	return product;
+}
+
+/* a << shift for shift < 192, the result must fit into 192 bits */
+static struct uint192 uint192_shift_left(struct uint192 a, uint32_t shift) {
+	const uint32_t limb_shift = shift / 64, bit_shift = shift % 64;
+	struct uint192 result = { { 0, 0, 0 } };
+	for (uint32_t i = limb_shift; i < 3; i++) {
+		result.limbs[i] = a.limbs[i - limb_shift] << bit_shift;
+		if (bit_shift != 0 && i > limb_shift) {
+			result.limbs[i] |= a.limbs[i - limb_shift - 1] >> (64 - bit_shift);
+		}
+	}
+	return result;
+}
+
+static uint32_t uint192_bit_length(struct uint192 a) {
+	for (uint32_t i = 3; i != 0; i--) {
+		if (a.limbs[i - 1] != 0) {
+			return 64 * i - (uint32_t) __builtin_clzll(a.limbs[i - 1]);
+		}
+	}
+	return 0;
+}
+
+/* floor(a * b / 2**shift), for shift such that the result fits into 192 bits */
+static struct uint192 uint192_mul_shift(struct uint192 a, struct uint192 b, uint32_t shift) {
+	uint64_t product[6] = { 0 };
+	for (uint32_t i = 0; i < 3; i++) {
+		uint64_t carry = 0;
+		for (uint32_t j = 0; j < 3; j++) {
+			const unsigned __int128 term = (unsigned __int128) a.limbs[i] * b.limbs[j] + product[i + j] + carry;
+			product[i + j] = (uint64_t) term;
+			carry = (uint64_t) (term >> 64);
+		}
+		product[i + 3] = carry;
+	}
+	const uint32_t limb_shift = shift / 64, bit_shift = shift % 64;
+	struct uint192 result;
+	for (uint32_t i = 0; i < 3; i++) {
+		const uint64_t low = i + limb_shift < 6 ? product[i + limb_shift] : 0;
+		const uint64_t high = i + limb_shift + 1 < 6 ? product[i + limb_shift + 1] : 0;
+		result.limbs[i] = bit_shift == 0 ? low : (low >> bit_shift) | (high << (64 - bit_shift));
+	}
+	return result;
+}
+
+/* Multiplies a fixed-point number with 188 fractional bits by multiplier <= 10**9, and returns the integer part of the product */
+static inline uint32_t fraction_mul(struct uint192 fraction[restrict static 1], uint32_t multiplier) {
+	unsigned __int128 carry = 0;
+	for (uint32_t i = 0; i < 3; i++) {
+		carry += (unsigned __int128) fraction->limbs[i] * multiplier;
+		fraction->limbs[i] = (uint64_t) carry;
+		carry >>= 64;
+	}
+	const uint32_t integer = (uint32_t) ((carry << 4) | (fraction->limbs[2] >> 60));
+	fraction->limbs[2] &= (UINT64_C(1) << 60) - 1;
+	return integer;
+}
+
+/* 10**(16 * i - 320) = significand * 2**exponent, with the significand in [2**191, 2**192) rounded to nearest */
+static const struct cached_power {
+	struct uint192 significand;
+	int32_t exponent;
+} cached_powers_of_10[41] = {
+	{ { { UINT64_C(0xAB9FAC96B03D8444), UINT64_C(0x8920B098955522B4), UINT64_C(0xFD00B897478238D0) } }, -1255 },
+	{ { { UINT64_C(0x855ABFAA06F9495B), UINT64_C(0x9FF0C08B7F1D0B14), UINT64_C(0x8C71DCD9BA0B4925) } }, -1201 },
+	{ { { UINT64_C(0xBEFA78253027DA9D), UINT64_C(0x4EE367F9430AEC32), UINT64_C(0x9BECCE62836AC577) } }, -1148 },
+	{ { { UINT64_C(0x19DEA11E79A5DFCC), UINT64_C(0xDA3243650005EECF), UINT64_C(0xAD1C8EAB5EE43B66) } }, -1095 },
+	{ { { UINT64_C(0xA23E2ED27766E8CD), UINT64_C(0xFA911155FEFB5308), UINT64_C(0xC0314325637A1939) } }, -1042 },
+	{ { { UINT64_C(0xEB30854F603DA8FC), UINT64_C(0xFB1E4A9A90880A64), UINT64_C(0xD5605FCDCF32E1D6) } }, -989 },
+	{ { { UINT64_C(0x4609AC5C7899CA37), UINT64_C(0xA4F8BF5635246428), UINT64_C(0xECE53CEC4A314EBD) } }, -936 },
+	{ { { UINT64_C(0x78B7AB3AF34A60C3), UINT64_C(0x4247CB9E59F71E6D), UINT64_C(0x8380DEA93DA4BC60) } }, -882 },
+	{ { { UINT64_C(0x1C5A40917D0FA664), UINT64_C(0x7B6306A34627DDCF), UINT64_C(0x91FF83775423CC06) } }, -829 },
+	{ { { UINT64_C(0xF1218F2B86615F64), UINT64_C(0xB8ADA00E5A506A7C), UINT64_C(0xA21727DB38CB002F) } }, -776 },
+	{ { { UINT64_C(0x8FE5B452E6B166CE), UINT64_C(0x59ED216765690F56), UINT64_C(0xB3F4E093DB73A093) } }, -723 },
+	{ { { UINT64_C(0xCBEB481C23D5E711), UINT64_C(0xFE64A52EE96B8FC0), UINT64_C(0xC7CABA6E7C5382C8) } }, -670 },
+	{ { { UINT64_C(0xE26CA6063461FFFA), UINT64_C(0xAC7CB3F6D05DDBDE), UINT64_C(0xDDD0467C64BCE4A0) } }, -617 },
+	{ { { UINT64_C(0xAA09501D5954A55A), UINT64_C(0x4D4617B5FF4A16D5), UINT64_C(0xF64335BCF065D37D) } }, -564 },
+	{ { { UINT64_C(0x690C0DB23E2755EF), UINT64_C(0x11DBCB0218EBB414), UINT64_C(0x88B402F7FD75539B) } }, -510 },
+	{ { { UINT64_C(0x021DA8C6F15375A1), UINT64_C(0xDCCD879FC967D41A), UINT64_C(0x97C560BA6B0919A5) } }, -457 },
+	{ { { UINT64_C(0x2A1FEE40D90AAB31), UINT64_C(0x3F2398D747B36224), UINT64_C(0xA87FEA27A539E9A5) } }, -404 },
+	{ { { UINT64_C(0x3A63263A538DF733), UINT64_C(0x5560C018580D5D52), UINT64_C(0xBB127C53B17EC159) } }, -351 },
+	{ { { UINT64_C(0x0B5B1AA028CCD99E), UINT64_C(0x67DE18EDA5814AF2), UINT64_C(0xCFB11EAD453994BA) } }, -298 },
+	{ { { UINT64_C(0xBF716C1ADD27F085), UINT64_C(0x4C2EBE687989A9B3), UINT64_C(0xE69594BEC44DE15B) } }, -245 },
+	{ { { UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000), UINT64_C(0x8000000000000000) } }, -191 },
+	{ { { UINT64_C(0x0000000000000000), UINT64_C(0x0000000000000000), UINT64_C(0x8E1BC9BF04000000) } }, -138 },
+	{ { { UINT64_C(0x0000000000000000), UINT64_C(0xF020000000000000), UINT64_C(0x9DC5ADA82B70B59D) } }, -85 },
+	{ { { UINT64_C(0x0000000000000000), UINT64_C(0x9670B12B7F410000), UINT64_C(0xAF298D050E4395D6) } }, -32 },
+	{ { { UINT64_C(0x50F8080000000000), UINT64_C(0x3CBF6B71C76B25FB), UINT64_C(0xC2781F49FFCFA6D5) } }, 21 },
+	{ { { UINT64_C(0x3298E889D933B040), UINT64_C(0xDC33745EC97BE906), UINT64_C(0xD7E77A8F87DAF7FB) } }, 74 },
+	{ { { UINT64_C(0x388DA035C8F16478), UINT64_C(0xC5CFE94EF3EA101E), UINT64_C(0xEFB3AB16C59B14A2) } }, 127 },
+	{ { { UINT64_C(0x74A7EF0198791097), UINT64_C(0x03E2CF6BC604DDB0), UINT64_C(0x850FADC09923329E) } }, 181 },
+	{ { { UINT64_C(0x0234F3FD7B08DD39), UINT64_C(0xC66F336C36B10137), UINT64_C(0x93BA47C980E98CDF) } }, 234 },
+	{ { { UINT64_C(0x39CAEF6ED62F905B), UINT64_C(0x5F16206C9C6209A6), UINT64_C(0xA402B9C5A8D3A6E7) } }, 287 },
+	{ { { UINT64_C(0x2381CF8591999D64), UINT64_C(0x577B986B314D6009), UINT64_C(0xB616A12B7FE617AA) } }, 340 },
+	{ { { UINT64_C(0xD11F91FF10629770), UINT64_C(0x7D7B8F7503CFDCFE), UINT64_C(0xCA28A291859BBF93) } }, 393 },
+	{ { { UINT64_C(0x0F118A2758E233B2), UINT64_C(0x85BBE253F47B1417), UINT64_C(0xE070F78D3927556A) } }, 446 },
+	{ { { UINT64_C(0x866CABA98A7E2DAB), UINT64_C(0xA7709A56CCDF8A82), UINT64_C(0xF92E0C3537826145) } }, 499 },
+	{ { { UINT64_C(0xBC10C5C5CDA97C8E), UINT64_C(0x82BD6B70D99AAA6F), UINT64_C(0x8A5296FFE33CC92F) } }, 553 },
+	{ { { UINT64_C(0x036EE4519D59A839), UINT64_C(0xACCA6DA1E0A8EF29), UINT64_C(0x9991A6F3D6BF1765) } }, 606 },
+	{ { { UINT64_C(0x851E4CBF3DE2F98B), UINT64_C(0xDDBB901B98FEEAB7), UINT64_C(0xAA7EEBFB9DF9DE8D) } }, 659 },
+	{ { { UINT64_C(0x902215C04CE2A1A9), UINT64_C(0x4B2D8644D8A74E18), UINT64_C(0xBD49D14AA79DBC82) } }, 712 },
+	{ { { UINT64_C(0xE2228CBF49612182), UINT64_C(0x73832EEC6FFF3111), UINT64_C(0xD226FC195C6A2F8C) } }, 765 },
+	{ { { UINT64_C(0x6DFD4EC02564B6BA), UINT64_C(0x47C6B82EF32A2069), UINT64_C(0xE950DF20247C83FD) } }, 818 },
+	{ { { UINT64_C(0x21CEB9EC7B8C62ED), UINT64_C(0xE6A1158300D46640), UINT64_C(0x81842F29F2CCE375) } }, 872 },
+};
+
+/*
+ * Approximates 10**power, -320 <= power < 336, as significand * 2**exponent with the significand in [2**191, 2**192),
+ * and relative error below 2**-190: the cached power is rounded, and its product with an exact power of 10 is truncated.
+ */
+static struct uint192 power_of_10(int32_t power, int32_t exponent[restrict static 1]) {
+	static const uint64_t small_powers_of_10[16] = {
+		UINT64_C(1), UINT64_C(10), UINT64_C(100), UINT64_C(1000), UINT64_C(10000), UINT64_C(100000),
+		UINT64_C(1000000), UINT64_C(10000000), UINT64_C(100000000), UINT64_C(1000000000), UINT64_C(10000000000),
+		UINT64_C(100000000000), UINT64_C(1000000000000), UINT64_C(10000000000000), UINT64_C(100000000000000),
+		UINT64_C(1000000000000000)
+	};
+	const struct cached_power* cached = &cached_powers_of_10[(uint32_t) (power + 320) / 16];
+	const uint64_t multiplier = small_powers_of_10[(uint32_t) (power + 320) % 16];
+	uint64_t product[4];
+	unsigned __int128 carry = 0;
+	for (uint32_t i = 0; i < 3; i++) {
+		carry += (unsigned __int128) cached->significand.limbs[i] * multiplier;
+		product[i] = (uint64_t) carry;
+		carry >>= 64;
+	}
+	product[3] = (uint64_t) carry;
+	const uint32_t shift = product[3] == 0 ? 0 : 64 - (uint32_t) __builtin_clzll(product[3]);
+	struct uint192 significand;
+	for (uint32_t i = 0; i < 3; i++) {
+		significand.limbs[i] = shift == 0 ? product[i] : (product[i] >> shift) | (product[i + 1] << (64 - shift));
+	}
+	*exponent = cached->exponent + (int32_t) shift;
+	return significand;
+}
+
+/*
+ * The RoundWeed step of Grisu3: moves the last digit towards w while the candidate stays in the unsafe interval,
+ * and returns false if the error of the scaled numbers leaves it unclear which candidate is the closest to w,
+ * or whether the candidate is inside of the interval.
+ * distance is too_high - w, rest is too_high - candidate, and ten_kappa is the weight of the last digit.
+ */
+static bool round_weed(char last_digit[restrict static 1], struct uint192 distance, struct uint192 unsafe_interval,
+	struct uint192 rest, struct uint192 ten_kappa, struct uint192 unit)
+{
+	const struct uint192 small_distance = uint192_sub(distance, unit);
+	const struct uint192 big_distance = uint192_add(distance, unit);
+	while (uint192_compare(rest, small_distance) < 0 &&
+		uint192_compare(uint192_sub(unsafe_interval, rest), ten_kappa) >= 0 &&
+		(uint192_compare(uint192_add(rest, ten_kappa), small_distance) < 0 ||
+			uint192_compare(uint192_sub(small_distance, rest), uint192_sub(uint192_add(rest, ten_kappa), small_distance)) >= 0))
+	{
+		*last_digit -= 1;
+		rest = uint192_add(rest, ten_kappa);
+	}
+	if (uint192_compare(rest, big_distance) < 0 &&
+		uint192_compare(uint192_sub(unsafe_interval, rest), ten_kappa) >= 0 &&
+		(uint192_compare(uint192_add(rest, ten_kappa), big_distance) < 0 ||
+			uint192_compare(uint192_sub(big_distance, rest), uint192_sub(uint192_add(rest, ten_kappa), big_distance)) > 0))
+	{
+		return false;
+	}
+	/* The candidate must be inside of the interval even if the scaled bounds are off by unit */
+	return uint192_compare(uint192_mul_small(unit, 2), rest) <= 0 &&
+		uint192_compare(uint192_add(rest, uint192_mul_small(unit, 4)), unsafe_interval) <= 0;
+}
+
+/*
+ * Fast path for the values hi + lo with hi_exponent - lo_exponent <= 118, which fit into 176-bit integers.
+ * The value and the bounds of its interval are scaled by an approximate power of 10 into 192-bit fixed-point numbers
+ * with 188 fractional bits and error below unit = 2, and the digits are generated with Grisu3.
+ * Writes the digits for positive hi, and sets decimal_exponent to k such that the digits are 0.d1d2... * 10**k.
+ * Returns the number of digits, or 0 if the fast path does not apply or can not guarantee the shortest closest digits.
+ */
+static size_t grisu_digits(struct double_parts hi_parts, struct double_parts lo_parts, bool lo_negative,
+	char digits[restrict static 64], int32_t decimal_exponent[restrict static 1])
+{
+	/* As in the exact algorithm, all quantities are integers in units of 2**unit_exponent */
+	const int32_t unit_exponent = lo_parts.exponent - 2;
+	const uint32_t hi_shift = (uint32_t) (hi_parts.exponent - unit_exponent);
+	if (hi_shift > 120) {
+		return 0;
+	}
+	const struct uint192 lo_units = uint192_from_u64(lo_parts.mantissa << 2);
+	struct uint192 r = uint192_shift_left(uint192_from_u64(hi_parts.mantissa), hi_shift);
+	r = lo_negative ? uint192_sub(r, lo_units) : uint192_add(r, lo_units);
+
+	/* The interval is open: Grisu3 fails when the digits are too close to its bounds, so inclusive bounds do not matter */
+	uint64_t margin_low = 2, margin_high = 2;
+	if (lo_parts.closer_predecessor) {
+		if (lo_negative) {
+			margin_high = 1;
+		} else {
+			margin_low = 1;
+		}
+	}
+	struct uint192 hi_margin_high = uint192_shift_left(uint192_from_u64(1), hi_shift - 1);
+	struct uint192 hi_margin_low = hi_parts.closer_predecessor ?
+		uint192_shift_left(uint192_from_u64(1), hi_shift - 2) : hi_margin_high;
+	if (lo_negative) {
+		hi_margin_high = uint192_add(hi_margin_high, lo_units);
+		hi_margin_low = uint192_sub(hi_margin_low, lo_units);
+	} else {
+		hi_margin_high = uint192_sub(hi_margin_high, lo_units);
+		hi_margin_low = uint192_add(hi_margin_low, lo_units);
+	}
+	if (uint192_compare(hi_margin_low, uint192_from_u64(margin_low)) < 0) {
+		margin_low = hi_margin_low.limbs[0];
+	}
+	if (uint192_compare(hi_margin_high, uint192_from_u64(margin_high)) < 0) {
+		margin_high = hi_margin_high.limbs[0];
+	}
+	const struct uint192 low = uint192_sub(r, uint192_from_u64(margin_low));
+	const struct uint192 high = uint192_add(r, uint192_from_u64(margin_high));
+
+	/*
+	 * Find k such that 10**(k-1) <= too_high < 10**k in the scaled numbers, starting from an estimate.
+	 * high * 2**unit_exponent * 10**-k * 2**188 = high * power * 2**(unit_exponent + power_exponent + 188)
+	 */
+	const struct uint192 one = { { 0, 0, UINT64_C(1) << 60 } };
+	struct uint192 unit = uint192_from_u64(2);
+	int32_t k = floor_log10_pow2((int32_t) uint192_bit_length(high) + unit_exponent) + 1;
+	struct uint192 power, too_high;
+	uint32_t shift;
+	for (uint32_t attempt = 0; ; attempt++) {
+		if (attempt == 2) {
+			return 0;
+		}
+		int32_t power_exponent;
+		power = power_of_10(-k, &power_exponent);
+		shift = (uint32_t) -(unit_exponent + power_exponent + 188);
+		too_high = uint192_add(uint192_mul_shift(high, power, shift), unit);
+		if (uint192_compare(too_high, one) >= 0) {
+			k += 1;
+		} else if (uint192_compare(uint192_mul_small(too_high, 10), one) < 0) {
+			k -= 1;
+		} else {
+			break;
+		}
+	}
+	const struct uint192 too_low = uint192_sub(uint192_mul_shift(low, power, shift), unit);
+	const struct uint192 w = uint192_mul_shift(r, power, shift);
+
+	/*
+	 * Generate the digits of too_high until the rest is in the unsafe interval, at most 57 digits as 4 * 10**57 > 2**188.
+	 * Once rest < unsafe_interval, it holds for all the following digits, so the digits are generated in groups
+	 * of up to 9, as long as unsafe_interval * 10**group_size < one, and the end is found inside of the last group.
+	 */
+	static const uint32_t powers_of_10[10] = {
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+	};
+	struct uint192 unsafe_interval = uint192_sub(too_high, too_low);
+	struct uint192 distance = uint192_sub(too_high, w);
+	struct uint192 rest = too_high;
+	size_t length = 0;
+	for (;;) {
+		/* 10**(3b/10) < 2**b, so unsafe_interval * 10**group_size < one, or < 10 * one for a single digit */
+		uint32_t group_size = (188 - uint192_bit_length(unsafe_interval)) * 3 / 10;
+		group_size = group_size < 1 ? 1 : group_size > 9 ? 9 : group_size;
+		struct uint192 scaled_rest = rest;
+		uint32_t group = fraction_mul(&scaled_rest, powers_of_10[group_size]);
+		const struct uint192 scaled_unsafe_interval = uint192_mul_small(unsafe_interval, powers_of_10[group_size]);
+		if (uint192_compare(scaled_rest, scaled_unsafe_interval) >= 0) {
+			for (uint32_t i = group_size; i != 0; i--) {
+				digits[length + i - 1] = (char) ('0' + group % 10);
+				group /= 10;
+			}
+			length += group_size;
+			rest = scaled_rest;
+			unsafe_interval = scaled_unsafe_interval;
+			unit = uint192_mul_small(unit, powers_of_10[group_size]);
+			distance = uint192_mul_small(distance, powers_of_10[group_size]);
+			continue;
+		}
+
+		/*
+		 * The first j digits of the group end the generation if rest * 10**j mod one < unsafe_interval * 10**j,
+		 * i.e. if scaled_rest + tail * one < scaled_unsafe_interval, where tail is the number of the other digits
+		 */
+		uint32_t end = 1;
+		for (; end < group_size; end++) {
+			const uint32_t tail = group % powers_of_10[group_size - end];
+			if (tail < 16) {
+				struct uint192 tail_rest = scaled_rest;
+				tail_rest.limbs[2] += (uint64_t) tail << 60;
+				if (uint192_compare(tail_rest, scaled_unsafe_interval) < 0) {
+					break;
+				}
+			}
+		}
+		group /= powers_of_10[group_size - end];
+		for (uint32_t i = end; i != 0; i--) {
+			digits[length + i - 1] = (char) ('0' + group % 10);
+			group /= 10;
+		}
+		length += end;
+		fraction_mul(&rest, powers_of_10[end]);
+		unsafe_interval = uint192_mul_small(unsafe_interval, powers_of_10[end]);
+		unit = uint192_mul_small(unit, powers_of_10[end]);
+		distance = uint192_mul_small(distance, powers_of_10[end]);
+		break;
+	}
+	if (!round_weed(&digits[length - 1], distance, unsafe_interval, rest, one, unit)) {
+		return 0;
+	}
+	*decimal_exponent = k;
+	return length;
+}
+
+size_t ddtoa(doubledouble x, char buffer[restrict static DD_DECIMAL_MAX_LENGTH]) {
+	char* position = buffer;
+	double lo;
+	double hi = efadd(x.hi, x.lo, &lo);
+	const uint64_t hi_bits = double_to_bits(hi);
+	if ((hi_bits & UINT64_C(0x7FF0000000000000)) == UINT64_C(0x7FF0000000000000)) {
+		if ((hi_bits & UINT64_C(0x000FFFFFFFFFFFFF)) != 0) {
+			strcpy(position, "nan");
+			return 3;
+		}
+		/* efadd of infinities with opposite signs is NaN, so both parts are infinite with the same sign */
+		if (hi < 0.0) {
+			*position++ = '-';
+		}
+		strcpy(position, "inf");
+		return (size_t) (position - buffer) + 3;
+	}
+	if (hi == 0.0) {
+		/* efadd(-0.0, 0.0) is +0.0 */
+		if (double_to_bits(x.hi) >> 63) {
+			*position++ = '-';
+		}
+		*position++ = '0';
+		return (size_t) (position - buffer) + write_exponent(position, 0);
+	}
+	if (hi_bits >> 63) {
+		*position++ = '-';
+		hi = -hi;
+		lo = -lo;
+	}
+
+	/*
+	 * All quantities are integers in units of 2**unit_exponent, a quarter of the spacing of doubles around lo.
+	 * The value is hi + lo, and the numbers in [value - margin_low, value + margin_high] round to (hi, lo):
+	 * round(y) = hi and round(y - hi) = lo.
+	 */
+	const struct double_parts hi_parts = decompose_double(hi);
+	const struct double_parts lo_parts = decompose_double(lo);
+	const bool lo_negative = lo < 0.0;
+	char* first_digit = position;
+	int32_t k;
+	size_t digits = lo == 0.0 ? exact_expansion_digits(hi_parts, first_digit, &k) : 0;
+	if (digits == 0) {
+		digits = grisu_digits(hi_parts, lo_parts, lo_negative, first_digit, &k);
+	}
+	if (digits != 0) {
+		return (size_t) (finish_scientific(first_digit, digits, k - 1) - buffer);
+	}
+
+	const int32_t unit_exponent = lo_parts.exponent - 2;
+
+	struct bigint r, s, margin_low, margin_high;
+	bigint_set_u64(&r, hi_parts.mantissa);
+	bigint_shift_left(&r, (uint32_t) (hi_parts.exponent - unit_exponent));
+	struct bigint lo_units;
+	bigint_set_u64(&lo_units, lo_parts.mantissa << 2);
+	if (lo_negative) {
+		bigint_sub(&r, &lo_units);
+	} else {
+		bigint_add(&r, &lo_units);
+	}
+
+	/* Half-spacing of doubles around lo: 2 units, or 1 unit towards zero if lo is a power of 2 */
+	uint32_t lo_margin_low = 2, lo_margin_high = 2;
+	if (lo_parts.closer_predecessor) {
+		if (lo_negative) {
+			lo_margin_high = 1;
+		} else {
+			lo_margin_low = 1;
+		}
+	}
+	/* Distances from the value to the bounds of numbers which round to hi: half-spacing of doubles around hi -/+ lo */
+	struct bigint hi_margin_low, hi_margin_high;
+	bigint_set_u64(&hi_margin_high, 1);
+	bigint_shift_left(&hi_margin_high, (uint32_t) (hi_parts.exponent - unit_exponent - 1));
+	bigint_copy(&hi_margin_low, &hi_margin_high);
+	if (hi_parts.closer_predecessor) {
+		bigint_set_u64(&hi_margin_low, 1);
+		bigint_shift_left(&hi_margin_low, (uint32_t) (hi_parts.exponent - unit_exponent - 2));
+	}
+	if (lo_negative) {
+		bigint_add(&hi_margin_high, &lo_units);
+		bigint_sub(&hi_margin_low, &lo_units);
+	} else {
+		bigint_sub(&hi_margin_high, &lo_units);
+		bigint_add(&hi_margin_low, &lo_units);
+	}
+
+	/* Bounds are included if the ties round to hi and lo, i.e. if their mantissas are even */
+	const bool lo_even = (lo_parts.mantissa & 1) == 0;
+	const bool hi_even = (hi_parts.mantissa & 1) == 0;
+	bool low_inclusive, high_inclusive;
+	bigint_set_u64(&margin_low, lo_margin_low);
+	const int low_comparison = bigint_compare(&hi_margin_low, &margin_low);
+	if (low_comparison < 0) {
+		bigint_copy(&margin_low, &hi_margin_low);
+		low_inclusive = hi_even;
+	} else {
+		low_inclusive = low_comparison == 0 ? lo_even && hi_even : lo_even;
+	}
+	bigint_set_u64(&margin_high, lo_margin_high);
+	const int high_comparison = bigint_compare(&hi_margin_high, &margin_high);
+	if (high_comparison < 0) {
+		bigint_copy(&margin_high, &hi_margin_high);
+		high_inclusive = hi_even;
+	} else {
+		high_inclusive = high_comparison == 0 ? lo_even && hi_even : lo_even;
+	}
+
+	/* value = r / s */
+	bigint_set_u64(&s, 1);
+	if (unit_exponent >= 0) {
+		bigint_shift_left(&r, (uint32_t) unit_exponent);
+		bigint_shift_left(&margin_low, (uint32_t) unit_exponent);
+		bigint_shift_left(&margin_high, (uint32_t) unit_exponent);
+	} else {
+		bigint_shift_left(&s, (uint32_t) -unit_exponent);
+	}
+
+	/* Find k such that 10**(k-1) <= value + margin_high < 10**k, starting from an estimate, and scale r / s by 10**-k */
+	k = floor_log10_pow2((int32_t) bigint_bit_length(&r) - (int32_t) bigint_bit_length(&s)) + 1;
+	if (k >= 0) {
+		bigint_mul_pow10(&s, (uint32_t) k);
+	} else {
+		bigint_mul_pow10(&r, (uint32_t) -k);
+		bigint_mul_pow10(&margin_low, (uint32_t) -k);
+		bigint_mul_pow10(&margin_high, (uint32_t) -k);
+	}
+	for (;;) {
+		const int comparison = bigint_compare_sum(&r, &margin_high, &s);
+		if (high_inclusive ? comparison < 0 : comparison <= 0) {
+			break;
+		}
+		bigint_mul_add_small(&s, 10, 0);
+		k += 1;
+	}
+	for (;;) {
+		struct bigint scaled_r;
+		bigint_copy(&scaled_r, &r);
+		bigint_mul_add_small(&scaled_r, 10, 0);
+		struct bigint scaled_margin_high;
+		bigint_copy(&scaled_margin_high, &margin_high);
+		bigint_mul_add_small(&scaled_margin_high, 10, 0);
+		const int scaled_comparison = bigint_compare_sum(&scaled_r, &scaled_margin_high, &s);
+		if (high_inclusive ? scaled_comparison >= 0 : scaled_comparison > 0) {
+			break;
+		}
+		bigint_copy(&r, &scaled_r);
+		bigint_copy(&margin_high, &scaled_margin_high);
+		bigint_mul_add_small(&margin_low, 10, 0);
+		k -= 1;
+	}
+
+	/* Remove the common power of 2 to make the numbers shorter */
+	uint32_t common_zeros = bigint_trailing_zeros(&s);
+	const uint32_t r_zeros = bigint_trailing_zeros(&r);
+	const uint32_t margin_low_zeros = bigint_trailing_zeros(&margin_low);
+	const uint32_t margin_high_zeros = bigint_trailing_zeros(&margin_high);
+	common_zeros = r_zeros < common_zeros ? r_zeros : common_zeros;
+	common_zeros = margin_low_zeros < common_zeros ? margin_low_zeros : common_zeros;
+	common_zeros = margin_high_zeros < common_zeros ? margin_high_zeros : common_zeros;
+	bigint_shift_right(&s, common_zeros);
+	bigint_shift_right(&r, common_zeros);
+	bigint_shift_right(&margin_low, common_zeros);
+	bigint_shift_right(&margin_high, common_zeros);
+
+	/*
+	 * Generate groups of 9 digits while the margins after the group are smaller than s. Then the termination conditions
+	 * in the middle of the group hold only if they hold after the group, and the rest of the group is zeros (r < margin_low)
+	 * or nines (r + margin_high > s), so a group needs one division instead of 9 steps of the digit-by-digit algorithm.
+	 */
+	const uint32_t group_size = 9, group_multiplier = 1000000000;
+	bool done = false;
+	while (!done) {
+		struct bigint group_margin_low, group_margin_high;
+		bigint_copy(&group_margin_low, &margin_low);
+		bigint_mul_add_small(&group_margin_low, group_multiplier, 0);
+		bigint_copy(&group_margin_high, &margin_high);
+		bigint_mul_add_small(&group_margin_high, group_multiplier, 0);
+		if (bigint_compare(&group_margin_low, &s) >= 0 || bigint_compare(&group_margin_high, &s) >= 0) {
+			break;
+		}
+		bigint_mul_add_small(&r, group_multiplier, 0);
+		uint32_t group = (uint32_t) bigint_divide(&r, &s);
+		bigint_copy(&margin_low, &group_margin_low);
+		bigint_copy(&margin_high, &group_margin_high);
+
+		const int low_comparison = bigint_compare(&r, &margin_low);
+		const bool low_done = low_inclusive ? low_comparison <= 0 : low_comparison < 0;
+		const int high_comparison = bigint_compare_sum(&r, &margin_high, &s);
+		const bool high_done = high_inclusive ? high_comparison >= 0 : high_comparison > 0;
+		uint32_t trailing_zeros = 0, trailing_nines = 0;
+		for (uint32_t i = group_size; i != 0; i--) {
+			position[i - 1] = (char) ('0' + group % 10);
+			group /= 10;
+		}
+		while (trailing_zeros < group_size && position[group_size - 1 - trailing_zeros] == '0') {
+			trailing_zeros += 1;
+		}
+		while (trailing_nines < group_size && position[group_size - 1 - trailing_nines] == '9') {
+			trailing_nines += 1;
+		}
+		uint32_t length = group_size;
+		if (low_done && (!high_done || trailing_zeros != 0)) {
+			length = group_size - trailing_zeros;
+			done = true;
+		} else if (high_done && (!low_done || trailing_nines != 0)) {
+			length = group_size - trailing_nines;
+			position[length - 1] += 1;
+			done = true;
+		} else if (low_done && high_done) {
+			/* Both the group and the group + 1 are in the interval: choose the closer one */
+			struct bigint twice_r;
+			bigint_copy(&twice_r, &r);
+			bigint_shift_left(&twice_r, 1);
+			position[group_size - 1] += bigint_compare(&twice_r, &s) >= 0;
+			done = true;
+		}
+		position += length;
+	}
+
+	/* The last digits, when the margins become too large for groups */
+	if (!done) {
+		/* Multiples of s to find each digit with comparisons */
+		struct bigint s_multiples[10];
+		bigint_set_u64(&s_multiples[0], 0);
+		for (uint32_t i = 1; i < 10; i++) {
+			bigint_copy(&s_multiples[i], &s_multiples[i - 1]);
+			bigint_add(&s_multiples[i], &s);
+		}
+		for (;;) {
+			bigint_mul_add_small(&r, 10, 0);
+			bigint_mul_add_small(&margin_low, 10, 0);
+			bigint_mul_add_small(&margin_high, 10, 0);
+			uint32_t digit = 9;
+			while (bigint_compare(&r, &s_multiples[digit]) < 0) {
+				digit -= 1;
+			}
+			bigint_sub(&r, &s_multiples[digit]);
+
+			const int low_comparison = bigint_compare(&r, &margin_low);
+			const bool low_done = low_inclusive ? low_comparison <= 0 : low_comparison < 0;
+			const int high_comparison = bigint_compare_sum(&r, &margin_high, &s);
+			const bool high_done = high_inclusive ? high_comparison >= 0 : high_comparison > 0;
+			if (!low_done && !high_done) {
+				*position++ = (char) ('0' + digit);
+				continue;
+			}
+			if (low_done && high_done) {
+				/* Both digit and digit + 1 are in the interval: choose the closer one */
+				struct bigint twice_r;
+				bigint_copy(&twice_r, &r);
+				bigint_shift_left(&twice_r, 1);
+				digit += bigint_compare(&twice_r, &s) >= 0;
+			} else {
+				digit += high_done;
+			}
+			*position++ = (char) ('0' + digit);
+			break;
+		}
+	}
+
+	return (size_t) (finish_scientific(first_digit, (size_t) (position - first_digit), k - 1) - buffer);
+}
+
+size_t strtodd_array(size_t n, const char* string, char** end, doubledouble values[restrict static n]) {
+	const char* position = string;
+	size_t count = 0;
+	for (; count < n; count++) {
+		char* number_end;
+		values[count] = strtodd(position, &number_end);
+		if (number_end == position) {
+			break;
+		}
+		position = number_end;
+	}
+	if (end != NULL) {
+		*end = (char*) position;
+	}
+	return count;
+}
+
+size_t ddtoa_array(size_t n, const doubledouble values[restrict static n], char* buffer) {
+	char* position = buffer;
+	*position = '\0';
+	for (size_t i = 0; i < n; i++) {
+		position += ddtoa(values[i], position);
+		*position++ = '\n';
+	}
+	*position = '\0';
+	return (size_t) (position - buffer);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Buffer size sufficient for any output of ddtoa, including the terminating null character.
+ * The shortest representation of a double-double number has at most 634 significant digits,
+ * when the exponents of the high and low parts are the furthest apart.
+ */
+#define DD_DECIMAL_MAX_LENGTH 656
+
+/**
+ * @brief Converts a decimal string to the nearest double-double number
+ * @details The result is hi = round(x), lo = round(x - hi), where x is the exact value of the decimal string,
+ *          and round is rounding to the nearest double with ties to even. Conversion is exact for any number of digits,
+ *          and uses only integer arithmetic.
+ *          Accepts leading whitespace, an optional sign, decimal digits with an optional decimal point and exponent,
+ *          and case-insensitive "inf", "infinity", and "nan". Values too large for double precision are converted to infinity.
+ * @param[in] string - the string to convert.
+ * @param[out] end - pointer to the first character after the parsed number, or string if no number was parsed. Can be NULL.
+ * @return The parsed number, or zero if no number was parsed.
+ */
+doubledouble strtodd(const char* string, char** end);
+
+/**
+ * @brief Converts a double-double number to the shortest decimal string which strtodd converts back to the same number
+ * @details The output is in scientific notation, e.g. "-1.2345e-07", "3e+00", "inf", "nan".
+ *          Numbers which are not normalized, i.e. where hi != hi + lo, are normalized before conversion.
+ *          Only integer arithmetic is used.
+ * @param[in] x - the number to convert.
+ * @param[out] buffer - output buffer for a null-terminated string, at least DD_DECIMAL_MAX_LENGTH characters.
+ * @return The length of the string, not including the terminating null character.
+ */
+size_t ddtoa(doubledouble x, char FPPLUS_ARRAY_POINTER(buffer, DD_DECIMAL_MAX_LENGTH));
+
+/**
+ * @brief Parses up to n whitespace-separated double-double numbers with strtodd
+ * @param[out] end - pointer to the first character after the last parsed number. Can be NULL.
+ * @return The number of parsed numbers, smaller than n if the string ends or contains something else than a number.
+ */
+size_t strtodd_array(size_t n, const char* string, char** end, doubledouble FPPLUS_ARRAY_POINTER(values, n));
+
+/**
+ * @brief Converts n double-double numbers with ddtoa into a null-terminated string with one number per line
+ * @param[out] buffer - output buffer of at least n * DD_DECIMAL_MAX_LENGTH characters, or 1 character if n is 0.
+ * @return The length of the string, not including the terminating null character.
+ */
+size_t ddtoa_array(size_t n, const doubledouble FPPLUS_ARRAY_POINTER(values, n), char* buffer);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
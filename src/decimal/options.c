@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <decimal/common.h>
+
+
+static void print_options_help(const char* program_name) {
+	printf(
+"%s [-n count] [-i iterations] [-f format] [-c counters]\n"
+"Optional parameters:\n"
+"  -n   --count        The number of converted double-double numbers (default: 100000)\n"
+"  -i   --iterations   The number of benchmark iterations (default: 10)\n"
+"  -f   --format       Output format: text (default), csv, or json\n"
+"  -c   --counters     Comma-separated list of performance counters to measure, or all:\n"
+"                      cycles, instructions, fp-scalar, fp-128, fp-256, fp-512, l1d-misses, llc-misses\n",
+		program_name);
+}
+
+struct benchmark_options parse_options(int argc, char** argv) {
+	struct benchmark_options options = {
+		.count = 100000,
+		.iterations = 10,
+		.format = report_format_text,
+		.counters = 0,
+	};
+	for (int argi = 1; argi < argc; argi += 1) {
+		if ((strcmp(argv[argi], "--count") == 0) || (strcmp(argv[argi], "-n") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected count value\n");
+				exit(EXIT_FAILURE);
+			}
+			if (sscanf(argv[argi + 1], "%zu", &options.count) != 1) {
+				fprintf(stderr, "Error: can not parse %s as an unsigned integer\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			if (options.count == 0) {
+				fprintf(stderr, "Error: invalid value %s for the count: positive value expected\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--iterations") == 0) || (strcmp(argv[argi], "-i") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected iterations value\n");
+				exit(EXIT_FAILURE);
+			}
+			if (sscanf(argv[argi + 1], "%zu", &options.iterations) != 1) {
+				fprintf(stderr, "Error: can not parse %s as an unsigned integer\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			if (options.iterations == 0) {
+				fprintf(stderr, "Error: invalid value %s for the number of iterations: positive value expected\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--format") == 0) || (strcmp(argv[argi], "-f") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected output format\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_report_format(argv[argi + 1], &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strncmp(argv[argi], "--format=", strlen("--format=")) == 0) {
+			if (!parse_report_format(argv[argi] + strlen("--format="), &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi] + strlen("--format="));
+				exit(EXIT_FAILURE);
+			}
+		} else if ((strcmp(argv[argi], "--counters") == 0) || (strcmp(argv[argi], "-c") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected list of performance counters\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_perf_counters(argv[argi + 1], &options.counters)) {
+				fprintf(stderr, "Error: invalid list of performance counters %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--help") == 0) || (strcmp(argv[argi], "-h") == 0)) {
+			print_options_help(argv[0]);
+			exit(EXIT_SUCCESS);
+		} else {
+			fprintf(stderr, "Error: unknown argument '%s'\n", argv[argi]);
+			print_options_help(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+	return options;
+}
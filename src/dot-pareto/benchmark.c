@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <math.h>
+#include <float.h>
+#include <string.h>
+
+#include <utils.h>
+#include <dot-pareto/common.h>
+
+
+struct kernel_result {
+    /* Median over the generated inputs */
+    double relative_error;
+    /* Median over the timed iterations */
+    double cycles_per_element;
+    /* Median over the timed iterations, per element */
+    double counters[perf_counter_count];
+    bool pareto_optimal;
+};
+
+static double relative_error(mpfr_t error, const mpfr_t exact, double hi, double lo) {
+    mpfr_sub_d(error, exact, hi, MPFR_RNDN);
+    mpfr_sub_d(error, error, lo, MPFR_RNDN);
+    if (!mpfr_zero_p(exact)) {
+        mpfr_div(error, error, exact, MPFR_RNDN);
+    }
+    return fabs(mpfr_get_d(error, MPFR_RNDN));
+}
+
+static struct kernel_result benchmark_kernel(
+    const struct dot_product_kernel kernel[restrict static 1],
+    const char* report_name,
+    const struct benchmark_options options[restrict static 1],
+    const double x[restrict static options->inputs * options->elements],
+    const double y[restrict static options->inputs * options->elements],
+    mpfr_t dots[restrict static options->inputs])
+{
+    const size_t n = options->elements;
+
+    /* Accuracy on each generated input */
+    double input_errors[options->inputs];
+    mpfr_t error;
+    mpfr_init2(error, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+    for (size_t input = 0; input < options->inputs; input++) {
+        doubledouble result = { 0.0, 0.0 };
+        if (kernel->compensated_dot_product != NULL) {
+            result = kernel->compensated_dot_product(n, &x[input * n], &y[input * n]);
+        } else {
+            result.hi = kernel->dot_product(n, &x[input * n], &y[input * n]);
+        }
+        input_errors[input] = relative_error(error, dots[input], result.hi, result.lo);
+    }
+    mpfr_clear(error);
+
+    /* Performance on the first generated input */
+    double iteration_cycles[options->iterations];
+    struct perf_counter_values iteration_counters[options->iterations];
+    for (size_t iteration = 0; iteration < options->iterations; iteration++) {
+        perf_counters_start();
+        const uint64_t start_ticks = cpu_ticks();
+
+        if (kernel->compensated_dot_product != NULL) {
+            kernel->compensated_dot_product(n, x, y);
+        } else {
+            kernel->dot_product(n, x, y);
+        }
+
+        iteration_cycles[iteration] = ((double) (cpu_ticks() - start_ticks)) / ((double) n);
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+    struct kernel_result result;
+    median_perf_counters(options->iterations, iteration_counters, (double) n, result.counters);
+
+    const struct sample_statistics error_statistics = compute_sample_statistics(input_errors, options->inputs);
+    const struct sample_statistics cycles_statistics = compute_sample_statistics(iteration_cycles, options->iterations);
+    if (options->format != report_format_text) {
+        char name[128];
+        snprintf(name, sizeof(name), "%s/error", report_name);
+        report_measurement(name, n, report_unit_relative_error, &error_statistics, result.counters);
+        snprintf(name, sizeof(name), "%s/time", report_name);
+        report_measurement(name, n, report_unit_cycles_per_element, &cycles_statistics, result.counters);
+    }
+    result.relative_error = error_statistics.median;
+    result.cycles_per_element = cycles_statistics.median;
+    return result;
+}
+
+/* Marks kernels which are not dominated by any other kernel in both accuracy and speed */
+static void find_pareto_front(size_t kernels, struct kernel_result results[restrict static kernels]) {
+    for (size_t i = 0; i < kernels; i++) {
+        results[i].pareto_optimal = true;
+        for (size_t j = 0; j < kernels; j++) {
+            const bool no_worse = results[j].relative_error <= results[i].relative_error &&
+                results[j].cycles_per_element <= results[i].cycles_per_element;
+            const bool better = results[j].relative_error < results[i].relative_error ||
+                results[j].cycles_per_element < results[i].cycles_per_element;
+            if (no_worse && better) {
+                results[i].pareto_optimal = false;
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const struct benchmark_options options = parse_options(argc, argv);
+    srand48(options.seed);
+
+    const size_t n = options.elements;
+    double* x = valloc(options.inputs * n * sizeof(double));
+    double* y = valloc(options.inputs * n * sizeof(double));
+    double conditions[options.inputs];
+    mpfr_t dots[options.inputs];
+    for (size_t input = 0; input < options.inputs; input++) {
+        mpfr_init2(dots[input], DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+    }
+
+    perf_counters_open(options.counters);
+    report_begin(options.format, "dot-pareto", argc, argv);
+    for (unsigned int exponent = 0; exponent <= options.exponent_max; exponent += options.exponent_step) {
+        const double condition = pow(10.0, (double) exponent);
+        for (size_t input = 0; input < options.inputs; input++) {
+            conditions[input] = generate_dot(n, condition, &x[input * n], &y[input * n], dots[input]);
+        }
+        const double median_condition = median_double(conditions, options.inputs);
+
+        struct kernel_result results[dot_product_kernels_count];
+        for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+            const struct dot_product_kernel* kernel = &dot_product_kernels[kernel_index];
+            char report_name[96];
+            snprintf(report_name, sizeof(report_name), "%s/unroll%zu/cond1e%u", kernel->name, kernel->unroll_factor, exponent);
+            results[kernel_index] = benchmark_kernel(kernel, report_name, &options, x, y, dots);
+        }
+        find_pareto_front(dot_product_kernels_count, results);
+
+        if (options.format == report_format_text) {
+            for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+                const struct dot_product_kernel* kernel = &dot_product_kernels[kernel_index];
+                printf("%s\t" "%zu\t" "1e%-3u\t" "%.1e\t" "%10zu\t" "%.2e\t" "%.2lf\t" "%s",
+                    kernel->name, kernel->unroll_factor, exponent, median_condition, n,
+                    results[kernel_index].relative_error, results[kernel_index].cycles_per_element,
+                    results[kernel_index].pareto_optimal ? "pareto" : "");
+                report_text_counters(results[kernel_index].counters);
+            }
+        }
+    }
+    report_end();
+    perf_counters_close();
+
+    for (size_t input = 0; input < options.inputs; input++) {
+        mpfr_clear(dots[input]);
+    }
+    free(x);
+    free(y);
+}
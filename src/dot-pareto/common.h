@@ -0,0 +1,40 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mpfr.h>
+#include <report.h>
+#include <dot/dot.h>
+
+
+struct benchmark_options {
+	size_t elements;
+	size_t iterations;
+	size_t inputs;
+	/* Condition numbers 10**0, 10**step, ..., 10**max_exponent */
+	unsigned int exponent_step;
+	unsigned int exponent_max;
+	long seed;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+};
+
+struct benchmark_options parse_options(int argc, char** argv);
+
+/*
+ * Generates vectors x and y with dot product of the prescribed condition number
+ * using the GenDot algorithm of Ogita, Rump, and Oishi ("Accurate sum and dot product", Algorithm 6.1).
+ * Requires n >= 6 and uses drand48 as the source of randomness.
+ * @param[out] dot - the exact dot product of the generated vectors.
+ * @return The actual condition number 2 |x|'|y| / |x'y| of the generated dot product.
+ */
+double generate_dot(size_t n, double condition, double x[restrict static n], double y[restrict static n], mpfr_t dot);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,67 @@
+#include <stdlib.h>
+#include <math.h>
+#include <float.h>
+
+#include <dot-pareto/common.h>
+
+
+/* Uniformly distributed random number in [-1, 1) */
+static double random_sign_magnitude(void) {
+    return 2.0 * drand48() - 1.0;
+}
+
+double generate_dot(size_t n, double condition, double x[restrict static n], double y[restrict static n], mpfr_t dot) {
+    /* With this precision sums of products of doubles are computed without rounding */
+    mpfr_t product;
+    mpfr_init2(product, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+    mpfr_set_prec(dot, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+    mpfr_set_zero(dot, 1);
+
+    const double b = log2(condition);
+    const size_t n2 = (n + 1) / 2;
+
+    /* First half: random numbers with exponents in [0, b/2] */
+    for (size_t i = 0; i < n2; i++) {
+        int exponent = (int) lround(drand48() * b / 2.0);
+        if (i == 0) {
+            exponent = (int) lround(b / 2.0) + 1;
+        } else if (i == n2 - 1) {
+            exponent = 0;
+        }
+        x[i] = ldexp(random_sign_magnitude(), exponent);
+        y[i] = ldexp(random_sign_magnitude(), exponent);
+
+        mpfr_set_d(product, x[i], MPFR_RNDN);
+        mpfr_mul_d(product, product, y[i], MPFR_RNDN);
+        mpfr_add(dot, dot, product, MPFR_RNDN);
+    }
+
+    /* Second half: cancel the partial dot product with exponents decreasing linearly from b/2 to 0 */
+    for (size_t i = n2; i < n; i++) {
+        const double fraction = (n - n2 == 1) ? 0.0 : ((double) (i - n2)) / ((double) (n - n2 - 1));
+        const int exponent = (int) lround(b / 2.0 * (1.0 - fraction));
+        x[i] = ldexp(random_sign_magnitude(), exponent);
+        y[i] = (ldexp(random_sign_magnitude(), exponent) - mpfr_get_d(dot, MPFR_RNDN)) / x[i];
+
+        mpfr_set_d(product, x[i], MPFR_RNDN);
+        mpfr_mul_d(product, product, y[i], MPFR_RNDN);
+        mpfr_add(dot, dot, product, MPFR_RNDN);
+    }
+
+    /* Random permutation (the exact dot product does not change) */
+    for (size_t i = n - 1; i != 0; i--) {
+        const size_t j = (size_t) (drand48() * (double) (i + 1));
+        const double x_i = x[i], y_i = y[i];
+        x[i] = x[j];
+        y[i] = y[j];
+        x[j] = x_i;
+        y[j] = y_i;
+    }
+    mpfr_clear(product);
+
+    double abs_dot = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        abs_dot += fabs(x[i]) * fabs(y[i]);
+    }
+    return 2.0 * abs_dot / fabs(mpfr_get_d(dot, MPFR_RNDN));
+}
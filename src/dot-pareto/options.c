@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dot-pareto/common.h>
+
+
+static void print_options_help(const char* program_name) {
+	printf(
+"%s [-n elements] [-i iterations] [-g inputs] [-e max-exponent] [-d exponent-step] [-f format] [-c counters]\n"
+"Optional parameters:\n"
+"  -n   --elements         The number of elements in dot product (default: 1024)\n"
+"  -i   --iterations       The number of benchmark iterations for timing (default: 100)\n"
+"  -g   --inputs           The number of generated inputs for each condition number (default: 10)\n"
+"  -e   --max-exponent     Decimal exponent of the largest condition number (default: 40)\n"
+"  -d   --exponent-step    Step between decimal exponents of condition numbers (default: 5)\n"
+"       --seed             Seed of the random number generator (default: 0)\n"
+"  -f   --format           Output format: text (default), csv, or json\n"
+"  -c   --counters         Comma-separated list of performance counters to measure, or all:\n"
+"                          cycles, instructions, fp-scalar, fp-128, fp-256, fp-512, l1d-misses, llc-misses\n",
+		program_name);
+}
+
+static size_t parse_positive(int argc, char** argv, int argi, const char* description) {
+	if (argi + 1 == argc) {
+		fprintf(stderr, "Error: expected %s value\n", description);
+		exit(EXIT_FAILURE);
+	}
+	size_t value;
+	if (sscanf(argv[argi + 1], "%zu", &value) != 1) {
+		fprintf(stderr, "Error: can not parse %s as an unsigned integer\n", argv[argi + 1]);
+		exit(EXIT_FAILURE);
+	}
+	if (value == 0) {
+		fprintf(stderr, "Error: invalid value %s for the %s: positive value expected\n", argv[argi + 1], description);
+		exit(EXIT_FAILURE);
+	}
+	return value;
+}
+
+struct benchmark_options parse_options(int argc, char** argv) {
+	struct benchmark_options options = {
+		.elements = 1024,
+		.iterations = 100,
+		.inputs = 10,
+		.exponent_step = 5,
+		.exponent_max = 40,
+		.seed = 0,
+		.format = report_format_text,
+		.counters = 0,
+	};
+	for (int argi = 1; argi < argc; argi += 1) {
+		if ((strcmp(argv[argi], "--elements") == 0) || (strcmp(argv[argi], "-n") == 0)) {
+			options.elements = parse_positive(argc, argv, argi, "number of elements");
+			if (options.elements < 6) {
+				fprintf(stderr, "Error: invalid value %s for the number of elements: at least 6 elements expected\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--iterations") == 0) || (strcmp(argv[argi], "-i") == 0)) {
+			options.iterations = parse_positive(argc, argv, argi, "number of iterations");
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--inputs") == 0) || (strcmp(argv[argi], "-g") == 0)) {
+			options.inputs = parse_positive(argc, argv, argi, "number of inputs");
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--max-exponent") == 0) || (strcmp(argv[argi], "-e") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected maximum exponent value\n");
+				exit(EXIT_FAILURE);
+			}
+			if (sscanf(argv[argi + 1], "%u", &options.exponent_max) != 1) {
+				fprintf(stderr, "Error: can not parse %s as an unsigned integer\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			if (options.exponent_max > 300) {
+				fprintf(stderr, "Error: invalid value %s for the maximum exponent: at most 300 expected\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--exponent-step") == 0) || (strcmp(argv[argi], "-d") == 0)) {
+			options.exponent_step = (unsigned int) parse_positive(argc, argv, argi, "exponent step");
+			argi += 1;
+		} else if (strcmp(argv[argi], "--seed") == 0) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected seed value\n");
+				exit(EXIT_FAILURE);
+			}
+			if (sscanf(argv[argi + 1], "%ld", &options.seed) != 1) {
+				fprintf(stderr, "Error: can not parse %s as an integer\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--format") == 0) || (strcmp(argv[argi], "-f") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected output format\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_report_format(argv[argi + 1], &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strncmp(argv[argi], "--format=", strlen("--format=")) == 0) {
+			if (!parse_report_format(argv[argi] + strlen("--format="), &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi] + strlen("--format="));
+				exit(EXIT_FAILURE);
+			}
+		} else if ((strcmp(argv[argi], "--counters") == 0) || (strcmp(argv[argi], "-c") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected list of performance counters\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_perf_counters(argv[argi + 1], &options.counters)) {
+				fprintf(stderr, "Error: invalid list of performance counters %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if ((strcmp(argv[argi], "--help") == 0) || (strcmp(argv[argi], "-h") == 0)) {
+			print_options_help(argv[0]);
+			exit(EXIT_SUCCESS);
+		} else {
+			fprintf(stderr, "Error: unknown argument '%s'\n", argv[argi]);
+			print_options_help(argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+	return options;
+}
@@ -10,110 +10,536 @@
 #include <dot/common.h>
 
 
-static void benchmark_dot_product(
-    dot_product_function dot,
+static void report_measurement_ticks(
+    const char* full_name,
+    size_t iterations, const uint64_t iteration_ticks[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    size_t elements)
+{
+    double counters[perf_counter_count];
+    median_perf_counters(iterations, iteration_counters, (double) elements, counters);
+    double iteration_cycles[iterations];
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        iteration_cycles[iteration] = ((double) iteration_ticks[iteration]) / ((double) elements);
+    }
+    const struct sample_statistics statistics = compute_sample_statistics(iteration_cycles, iterations);
+    report_measurement(full_name, elements, report_unit_cycles_per_element, &statistics, counters);
+}
+
+/*
+ * If addre_iteration_ticks is not NULL, also reports the kernel compiled with emulated ADDRE:
+ * as two more columns (cycles with ADDRE and projected speedup from ADDRE) in text output, or as a separate "/addre" measurement.
+ */
+static void report_ticks(
+    const char* type,
     const char* name,
     size_t unroll_factor,
+    enum report_format format,
+    size_t iterations, uint64_t iteration_ticks[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    uint64_t addre_iteration_ticks[restrict], const struct perf_counter_values addre_iteration_counters[restrict],
+    size_t elements)
+{
+    if (format == report_format_text) {
+        double counters[perf_counter_count];
+        median_perf_counters(iterations, iteration_counters, (double) elements, counters);
+        const double cycles = ((double) median_uint64(iteration_ticks, iterations)) / ((double) elements);
+        printf("%s\t" "%s\t" "%zu\t" "%10zu\t" "%.2lf",
+            type, name, unroll_factor, elements, cycles);
+        if (addre_iteration_ticks != NULL) {
+            const double addre_cycles = ((double) median_uint64(addre_iteration_ticks, iterations)) / ((double) elements);
+            printf("\t" "%.2lf\t" "%.2lfx", addre_cycles, cycles / addre_cycles);
+        }
+        report_text_counters(counters);
+    } else {
+        char full_name[128];
+        snprintf(full_name, sizeof(full_name), "%s/%s/unroll%zu", type, name, unroll_factor);
+        report_measurement_ticks(full_name, iterations, iteration_ticks, iteration_counters, elements);
+        if (addre_iteration_ticks != NULL) {
+            snprintf(full_name, sizeof(full_name), "%s/%s/unroll%zu/addre", type, name, unroll_factor);
+            report_measurement_ticks(full_name, iterations, addre_iteration_ticks, addre_iteration_counters, elements);
+        }
+    }
+}
+
+static void measure_kernel(
+    const struct dot_product_kernel* kernel,
+    size_t iterations,
+    size_t elements, const double a[restrict static elements], const double b[restrict static elements],
+    uint64_t iteration_ticks[restrict static iterations],
+    struct perf_counter_values iteration_counters[restrict static iterations])
+{
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
+        const uint64_t start_ticks = cpu_ticks();
+
+        if (kernel->compensated_dot_product != NULL) {
+            kernel->compensated_dot_product(elements, a, b);
+        } else {
+            kernel->dot_product(elements, a, b);
+        }
+
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+}
+
+/* addre_kernel is the same kernel compiled with emulated ADDRE, or NULL if the comparison is not requested */
+static void benchmark_kernel(
+    const struct dot_product_kernel* kernel,
+    const struct dot_product_kernel* addre_kernel,
+    enum report_format format,
     size_t iterations,
     size_t elements, const double a[restrict static elements], const double b[restrict static elements])
 {
-    uint64_t iteration_ticks[iterations];
+    uint64_t iteration_ticks[iterations], addre_iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations], addre_iteration_counters[iterations];
+    measure_kernel(kernel, iterations, elements, a, b, iteration_ticks, iteration_counters);
+    if (addre_kernel != NULL) {
+        measure_kernel(addre_kernel, iterations, elements, a, b, addre_iteration_ticks, addre_iteration_counters);
+    }
+    report_ticks(kernel->compensated_dot_product != NULL ? "compensated" : "double",
+        kernel->name, kernel->unroll_factor, format, iterations, iteration_ticks, iteration_counters,
+        addre_kernel != NULL ? addre_iteration_ticks : NULL, addre_iteration_counters, elements);
+}
+
+/* Float-float kernels are measured on arrays with the same number of elements as the double-precision kernels */
+static void measure_float_kernel(
+    const struct float_dot_product_kernel* kernel,
+    size_t iterations,
+    size_t elements, const float a[restrict static elements], const float b[restrict static elements],
+    uint64_t iteration_ticks[restrict static iterations],
+    struct perf_counter_values iteration_counters[restrict static iterations])
+{
     for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
         const uint64_t start_ticks = cpu_ticks();
 
-        dot(elements, a, b);
+        kernel->compensated_dot_product(elements, a, b);
 
         iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
     }
-    const uint64_t median_ticks = median_uint64(iteration_ticks, iterations);
-    printf("double\t" "%s\t" "%zu\t" "%10zu\t" "%.2lf\n",
-        name, unroll_factor, elements, ((double) median_ticks) / ((double) elements));
 }
 
-static void benchmark_compensated_dot_product(
-    compensated_dot_product_function dot,
+static void benchmark_float_kernel(
+    const struct float_dot_product_kernel* kernel,
+    const struct float_dot_product_kernel* addre_kernel,
+    enum report_format format,
+    size_t iterations,
+    size_t elements, const float a[restrict static elements], const float b[restrict static elements])
+{
+    uint64_t iteration_ticks[iterations], addre_iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations], addre_iteration_counters[iterations];
+    measure_float_kernel(kernel, iterations, elements, a, b, iteration_ticks, iteration_counters);
+    if (addre_kernel != NULL) {
+        measure_float_kernel(addre_kernel, iterations, elements, a, b, addre_iteration_ticks, addre_iteration_counters);
+    }
+    report_ticks("float-float", kernel->name, kernel->unroll_factor, format, iterations, iteration_ticks, iteration_counters,
+        addre_kernel != NULL ? addre_iteration_ticks : NULL, addre_iteration_counters, elements);
+}
+
+/* Calls in each timed iteration of the small-n sweep, to amortize the overhead of reading the timestamp counter */
+#define SMALL_N_CALLS 16
+
+static void report_small_n_measurement(
+    const char* type,
     const char* name,
     size_t unroll_factor,
+    size_t iterations, double iteration_cycles[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    size_t elements)
+{
+    double counters[perf_counter_count];
+    median_perf_counters(iterations, iteration_counters, (double) SMALL_N_CALLS, counters);
+    char full_name[128];
+    snprintf(full_name, sizeof(full_name), "%s/%s/unroll%zu/small-n", type, name, unroll_factor);
+    const struct sample_statistics statistics = compute_sample_statistics(iteration_cycles, iterations);
+    report_measurement(full_name, elements, report_unit_cycles_per_call, &statistics, counters);
+}
+
+/*
+ * If scalar_tail_name is not NULL, also reports the kernel with scalar processing of the remainder:
+ * as two more columns (cycles with scalar tail and speedup from masked tail) in text output, or as a separate measurement.
+ */
+static void report_small_n(
+    const char* type,
+    const char* name,
+    size_t unroll_factor,
+    enum report_format format,
+    size_t iterations, const uint64_t iteration_ticks[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    const char* scalar_tail_name,
+    const uint64_t scalar_tail_iteration_ticks[restrict], const struct perf_counter_values scalar_tail_iteration_counters[restrict],
+    size_t elements)
+{
+    double iteration_cycles[iterations], scalar_tail_iteration_cycles[iterations];
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        iteration_cycles[iteration] = ((double) iteration_ticks[iteration]) / ((double) SMALL_N_CALLS);
+    }
+    if (scalar_tail_name != NULL) {
+        for (size_t iteration = 0; iteration < iterations; iteration++) {
+            scalar_tail_iteration_cycles[iteration] = ((double) scalar_tail_iteration_ticks[iteration]) / ((double) SMALL_N_CALLS);
+        }
+    }
+    if (format == report_format_text) {
+        double counters[perf_counter_count];
+        median_perf_counters(iterations, iteration_counters, (double) SMALL_N_CALLS, counters);
+        const double cycles = median_double(iteration_cycles, iterations);
+        printf("%s\t" "%s\t" "%zu\t" "%4zu\t" "%.1lf",
+            type, name, unroll_factor, elements, cycles);
+        if (scalar_tail_name != NULL) {
+            const double scalar_tail_cycles = median_double(scalar_tail_iteration_cycles, iterations);
+            printf("\t" "%.1lf\t" "%.2lfx", scalar_tail_cycles, scalar_tail_cycles / cycles);
+        }
+        report_text_counters(counters);
+    } else {
+        report_small_n_measurement(type, name, unroll_factor, iterations, iteration_cycles, iteration_counters, elements);
+        if (scalar_tail_name != NULL) {
+            report_small_n_measurement(type, scalar_tail_name, unroll_factor,
+                iterations, scalar_tail_iteration_cycles, scalar_tail_iteration_counters, elements);
+        }
+    }
+}
+
+/*
+ * Returns the kernel which differs from the given kernel only in scalar processing of the remainder,
+ * or NULL if there is no such kernel (for kernels on unaligned arrays, kernels with prefetching, or without AVX).
+ */
+static const struct dot_product_kernel* find_scalar_tail_kernel(const struct dot_product_kernel* kernel) {
+    char scalar_tail_name[128];
+    snprintf(scalar_tail_name, sizeof(scalar_tail_name), "%s/scalar-tail", kernel->name);
+    for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+        const struct dot_product_kernel* scalar_tail_kernel = &dot_product_kernels[kernel_index];
+        if (scalar_tail_kernel->scalar_tail && scalar_tail_kernel->unroll_factor == kernel->unroll_factor &&
+            strcmp(scalar_tail_kernel->name, scalar_tail_name) == 0)
+        {
+            return scalar_tail_kernel;
+        }
+    }
+    return NULL;
+}
+
+static const struct float_dot_product_kernel* find_scalar_tail_float_kernel(const struct float_dot_product_kernel* kernel) {
+    char scalar_tail_name[128];
+    snprintf(scalar_tail_name, sizeof(scalar_tail_name), "%s/scalar-tail", kernel->name);
+    for (size_t kernel_index = 0; kernel_index < float_dot_product_kernels_count; kernel_index++) {
+        const struct float_dot_product_kernel* scalar_tail_kernel = &float_dot_product_kernels[kernel_index];
+        if (scalar_tail_kernel->scalar_tail && scalar_tail_kernel->unroll_factor == kernel->unroll_factor &&
+            strcmp(scalar_tail_kernel->name, scalar_tail_name) == 0)
+        {
+            return scalar_tail_kernel;
+        }
+    }
+    return NULL;
+}
+
+static void measure_small_n(
+    const struct dot_product_kernel* kernel,
     size_t iterations,
-    size_t elements, const double a[restrict static elements], const double b[restrict static elements])
+    size_t elements, const double a[restrict static elements], const double b[restrict static elements],
+    uint64_t iteration_ticks[restrict static iterations],
+    struct perf_counter_values iteration_counters[restrict static iterations])
 {
-    uint64_t iteration_ticks[iterations];
     for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
         const uint64_t start_ticks = cpu_ticks();
+        for (size_t call = 0; call < SMALL_N_CALLS; call++) {
+            if (kernel->compensated_dot_product != NULL) {
+                kernel->compensated_dot_product(elements, a, b);
+            } else {
+                kernel->dot_product(elements, a, b);
+            }
+        }
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+}
 
-        dot(elements, a, b);
-
+static void measure_float_small_n(
+    const struct float_dot_product_kernel* kernel,
+    size_t iterations,
+    size_t elements, const float a[restrict static elements], const float b[restrict static elements],
+    uint64_t iteration_ticks[restrict static iterations],
+    struct perf_counter_values iteration_counters[restrict static iterations])
+{
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
+        const uint64_t start_ticks = cpu_ticks();
+        for (size_t call = 0; call < SMALL_N_CALLS; call++) {
+            kernel->compensated_dot_product(elements, a, b);
+        }
         iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+}
+
+/*
+ * Cycles per call on arrays of 1 to max_elements elements, where the remainder after the unrolled loop dominates.
+ * The arrays stay in L1 cache, so the sweep shows the latency of the loop prologue, remainder, and reductions.
+ * Kernels with masked processing of the remainder are reported side by side with the same kernels with scalar tail.
+ */
+static void benchmark_small_n(
+    enum report_format format,
+    size_t iterations,
+    size_t max_elements,
+    const double a[restrict static max_elements], const double b[restrict static max_elements],
+    const float a_float[restrict static max_elements], const float b_float[restrict static max_elements])
+{
+    uint64_t iteration_ticks[iterations], scalar_tail_iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations], scalar_tail_iteration_counters[iterations];
+    for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+        const struct dot_product_kernel* kernel = &dot_product_kernels[kernel_index];
+        if (kernel->scalar_tail) {
+            continue;
+        }
+        const struct dot_product_kernel* scalar_tail_kernel = find_scalar_tail_kernel(kernel);
+        for (size_t elements = 1; elements <= max_elements; elements++) {
+            measure_small_n(kernel, iterations, elements, a, b, iteration_ticks, iteration_counters);
+            if (scalar_tail_kernel != NULL) {
+                measure_small_n(scalar_tail_kernel, iterations, elements, a, b,
+                    scalar_tail_iteration_ticks, scalar_tail_iteration_counters);
+            }
+            report_small_n(kernel->compensated_dot_product != NULL ? "compensated" : "double",
+                kernel->name, kernel->unroll_factor, format, iterations, iteration_ticks, iteration_counters,
+                scalar_tail_kernel != NULL ? scalar_tail_kernel->name : NULL,
+                scalar_tail_iteration_ticks, scalar_tail_iteration_counters, elements);
+        }
+    }
+    for (size_t kernel_index = 0; kernel_index < float_dot_product_kernels_count; kernel_index++) {
+        const struct float_dot_product_kernel* kernel = &float_dot_product_kernels[kernel_index];
+        if (kernel->scalar_tail) {
+            continue;
+        }
+        const struct float_dot_product_kernel* scalar_tail_kernel = find_scalar_tail_float_kernel(kernel);
+        for (size_t elements = 1; elements <= max_elements; elements++) {
+            measure_float_small_n(kernel, iterations, elements, a_float, b_float, iteration_ticks, iteration_counters);
+            if (scalar_tail_kernel != NULL) {
+                measure_float_small_n(scalar_tail_kernel, iterations, elements, a_float, b_float,
+                    scalar_tail_iteration_ticks, scalar_tail_iteration_counters);
+            }
+            report_small_n("float-float", kernel->name, kernel->unroll_factor, format, iterations, iteration_ticks, iteration_counters,
+                scalar_tail_kernel != NULL ? scalar_tail_kernel->name : NULL,
+                scalar_tail_iteration_ticks, scalar_tail_iteration_counters, elements);
+        }
+    }
+}
+
+static void report_misalignment(
+    const char* type,
+    const char* name,
+    size_t unroll_factor,
+    size_t offset_a, size_t offset_b,
+    enum report_format format,
+    size_t iterations, uint64_t iteration_ticks[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    size_t elements)
+{
+    if (format == report_format_text) {
+        double counters[perf_counter_count];
+        median_perf_counters(iterations, iteration_counters, (double) elements, counters);
+        const double cycles = ((double) median_uint64(iteration_ticks, iterations)) / ((double) elements);
+        printf("%s\t" "%s\t" "%zu\t" "a+%zu\t" "b+%zu\t" "%.2lf",
+            type, name, unroll_factor, offset_a, offset_b, cycles);
+        report_text_counters(counters);
+    } else {
+        char full_name[128];
+        snprintf(full_name, sizeof(full_name), "%s/%s/unroll%zu/a+%zu/b+%zu", type, name, unroll_factor, offset_a, offset_b);
+        report_measurement_ticks(full_name, iterations, iteration_ticks, iteration_counters, elements);
+    }
+}
+
+/*
+ * Cycles per element of the kernels for unaligned arrays, for every combination of the offsets of a and b,
+ * in elements, from addresses aligned on DOT_PRODUCT_ALIGNMENT bytes. The arrays must have
+ * DOT_PRODUCT_ALIGNMENT bytes of padding after the elements.
+ */
+static void benchmark_misalignment(
+    enum report_format format,
+    size_t iterations,
+    size_t elements,
+    const double a[restrict static elements], const double b[restrict static elements],
+    const float a_float[restrict static elements], const float b_float[restrict static elements])
+{
+    uint64_t iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations];
+    for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+        const struct dot_product_kernel* kernel = &dot_product_kernels[kernel_index];
+        if (kernel->aligned) {
+            continue;
+        }
+        for (size_t offset_a = 0; offset_a < DOT_PRODUCT_ALIGNMENT / sizeof(double); offset_a++) {
+            for (size_t offset_b = 0; offset_b < DOT_PRODUCT_ALIGNMENT / sizeof(double); offset_b++) {
+                measure_kernel(kernel, iterations, elements, a + offset_a, b + offset_b, iteration_ticks, iteration_counters);
+                report_misalignment(kernel->compensated_dot_product != NULL ? "compensated" : "double",
+                    kernel->name, kernel->unroll_factor, offset_a, offset_b, format, iterations, iteration_ticks, iteration_counters, elements);
+            }
+        }
+    }
+    for (size_t kernel_index = 0; kernel_index < float_dot_product_kernels_count; kernel_index++) {
+        const struct float_dot_product_kernel* kernel = &float_dot_product_kernels[kernel_index];
+        if (kernel->aligned) {
+            continue;
+        }
+        for (size_t offset_a = 0; offset_a < DOT_PRODUCT_ALIGNMENT / sizeof(float); offset_a++) {
+            for (size_t offset_b = 0; offset_b < DOT_PRODUCT_ALIGNMENT / sizeof(float); offset_b++) {
+                measure_float_kernel(kernel, iterations, elements, a_float + offset_a, b_float + offset_b, iteration_ticks, iteration_counters);
+                report_misalignment("float-float", kernel->name, kernel->unroll_factor, offset_a, offset_b,
+                    format, iterations, iteration_ticks, iteration_counters, elements);
+            }
+        }
+    }
+}
+
+/* Smallest array size, in bytes, in the prefetch sweep */
+#define PREFETCH_SWEEP_MIN_SIZE 16384
+
+static void report_bandwidth(
+    const char* type,
+    const char* name,
+    size_t unroll_factor,
+    size_t prefetch_distance,
+    enum report_format format,
+    size_t iterations, double iteration_times[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    size_t elements, size_t array_size)
+{
+    double counters[perf_counter_count];
+    median_perf_counters(iterations, iteration_counters, (double) elements, counters);
+    /* Convert iteration times to GB/s (of both arrays) in-place */
+    double* iteration_bandwidth = iteration_times;
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        iteration_bandwidth[iteration] = ((double) (2 * array_size)) / iteration_times[iteration];
+    }
+    if (format == report_format_text) {
+        printf("%s\t" "%s\t" "%zu\t" "%4zu\t" "%10zu\t" "%.2lf",
+            type, name, unroll_factor, prefetch_distance, array_size, median_double(iteration_bandwidth, iterations));
+        report_text_counters(counters);
+    } else {
+        char full_name[128];
+        snprintf(full_name, sizeof(full_name), "%s/%s/unroll%zu/prefetch%zu", type, name, unroll_factor, prefetch_distance);
+        const struct sample_statistics statistics = compute_sample_statistics(iteration_bandwidth, iterations);
+        report_measurement(full_name, array_size, report_unit_gbytes_per_second, &statistics, counters);
+    }
+}
+
+/*
+ * Bandwidth of the kernels with and without software prefetching, for array sizes from PREFETCH_SWEEP_MIN_SIZE
+ * to max_array_size bytes in powers of 2. Double-precision and single-precision kernels process arrays of the same
+ * size in bytes. Only the kernels with DOT_PRODUCT_PREFETCH_UNROLL unroll factor are measured.
+ */
+static void benchmark_prefetch(
+    enum report_format format,
+    size_t iterations,
+    size_t max_array_size,
+    const double a[restrict static max_array_size / sizeof(double)],
+    const double b[restrict static max_array_size / sizeof(double)],
+    const float a_float[restrict static max_array_size / sizeof(float)],
+    const float b_float[restrict static max_array_size / sizeof(float)])
+{
+    double iteration_times[iterations];
+    struct perf_counter_values iteration_counters[iterations];
+    for (size_t array_size = PREFETCH_SWEEP_MIN_SIZE; array_size <= max_array_size; array_size *= 2) {
+        for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+            const struct dot_product_kernel* kernel = &dot_product_kernels[kernel_index];
+            if (!kernel->aligned || kernel->scalar_tail || kernel->unroll_factor != DOT_PRODUCT_PREFETCH_UNROLL) {
+                continue;
+            }
+            const size_t elements = array_size / sizeof(double);
+            for (size_t iteration = 0; iteration < iterations; iteration++) {
+                perf_counters_start();
+                const double start_time = high_precision_time();
+                if (kernel->compensated_dot_product != NULL) {
+                    kernel->compensated_dot_product(elements, a, b);
+                } else {
+                    kernel->dot_product(elements, a, b);
+                }
+                iteration_times[iteration] = high_precision_time() - start_time;
+                perf_counters_stop(&iteration_counters[iteration]);
+            }
+            report_bandwidth(kernel->compensated_dot_product != NULL ? "compensated" : "double",
+                kernel->name, kernel->unroll_factor, kernel->prefetch_distance,
+                format, iterations, iteration_times, iteration_counters, elements, array_size);
+        }
+        for (size_t kernel_index = 0; kernel_index < float_dot_product_kernels_count; kernel_index++) {
+            const struct float_dot_product_kernel* kernel = &float_dot_product_kernels[kernel_index];
+            if (!kernel->aligned || kernel->scalar_tail || kernel->unroll_factor != DOT_PRODUCT_PREFETCH_UNROLL) {
+                continue;
+            }
+            const size_t elements = array_size / sizeof(float);
+            for (size_t iteration = 0; iteration < iterations; iteration++) {
+                perf_counters_start();
+                const double start_time = high_precision_time();
+                kernel->compensated_dot_product(elements, a_float, b_float);
+                iteration_times[iteration] = high_precision_time() - start_time;
+                perf_counters_stop(&iteration_counters[iteration]);
+            }
+            report_bandwidth("float-float", kernel->name, kernel->unroll_factor, kernel->prefetch_distance,
+                format, iterations, iteration_times, iteration_counters, elements, array_size);
+        }
     }
-    const uint64_t median_ticks = median_uint64(iteration_ticks, iterations);
-    printf("compensated\t" "%s\t" "%zu\t" "%10zu\t" "%.2lf\n",
-        name, unroll_factor, elements, ((double) median_ticks) / ((double) elements));
 }
 
 int main(int argc, char *argv[]) {
     const struct benchmark_options options = parse_options(argc, argv);
 
-    void* a_array = valloc(options.array_size);
-    void* b_array = valloc(options.array_size);
-    for (double* double_array = a_array; double_array != a_array + options.array_size; double_array++) {
-        *double_array = M_PI;
-    }
-    for (double* double_array = b_array; double_array != b_array + options.array_size; double_array++) {
-        *double_array = M_E;
-    }
-    const size_t array_elements = options.array_size / sizeof(double);
-
-    benchmark_dot_product(dot_product_muladd_unroll1, "mul+add", 1,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_muladd_unroll2, "mul+add", 2,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_muladd_unroll3, "mul+add", 3,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_muladd_unroll4, "mul+add", 4,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_muladd_unroll5, "mul+add", 5,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_muladd_unroll6, "mul+add", 6,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_muladd_unroll7, "mul+add", 7,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_muladd_unroll8, "mul+add", 8,
-        options.iterations, array_elements, a_array, b_array);
-
-    benchmark_dot_product(dot_product_fma_unroll1, "fma", 1,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_fma_unroll2, "fma", 2,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_fma_unroll3, "fma", 3,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_fma_unroll4, "fma", 4,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_fma_unroll5, "fma", 5,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_fma_unroll6, "fma", 6,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_fma_unroll7, "fma", 7,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_dot_product(dot_product_fma_unroll8, "fma", 8,
-        options.iterations, array_elements, a_array, b_array);
-
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll1, "efmul+efadd", 1,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll2, "efmul+efadd", 2,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll3, "efmul+efadd", 3,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll4, "efmul+efadd", 4,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll5, "efmul+efadd", 5,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll6, "efmul+efadd", 6,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll7, "efmul+efadd", 7,
-        options.iterations, array_elements, a_array, b_array);
-    benchmark_compensated_dot_product(compensated_dot_product_efmuladd_unroll8, "efmul+efadd", 8,
-        options.iterations, array_elements, a_array, b_array);
+    /* The thread scaling benchmark allocates the arrays in the threads which use them */
+    if (options.threads != 0) {
+        report_begin(options.format, "dot-bench", argc, argv);
+        benchmark_threads(options.format, options.iterations, options.array_size, options.threads, options.shared_arrays);
+        report_end();
+        return EXIT_SUCCESS;
+    }
+
+    const size_t array_elements = options.small_n != 0 ? options.small_n : options.array_size / sizeof(double);
+    /* Padding for the offsets of misaligned arrays */
+    const size_t allocated_elements = array_elements + DOT_PRODUCT_ALIGNMENT / sizeof(float);
+    /* The prefetch sweep processes single-precision arrays of the same size in bytes as double-precision arrays */
+    const size_t allocated_float_elements = options.prefetch ? options.array_size / sizeof(float) : allocated_elements;
+    double* a_array = valloc(allocated_elements * sizeof(double));
+    double* b_array = valloc(allocated_elements * sizeof(double));
+    float* a_float_array = valloc(allocated_float_elements * sizeof(float));
+    float* b_float_array = valloc(allocated_float_elements * sizeof(float));
+    if (a_array == NULL || b_array == NULL || a_float_array == NULL || b_float_array == NULL) {
+        fprintf(stderr, "Error: failed to allocate memory for %zu-element arrays\n", allocated_float_elements);
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < allocated_elements; i++) {
+        a_array[i] = M_PI;
+        b_array[i] = M_E;
+    }
+    for (size_t i = 0; i < allocated_float_elements; i++) {
+        a_float_array[i] = (float) M_PI;
+        b_float_array[i] = (float) M_E;
+    }
+
+    perf_counters_open(options.counters);
+    report_begin(options.format, "dot-bench", argc, argv);
+
+    if (options.small_n != 0) {
+        benchmark_small_n(options.format, options.iterations, array_elements, a_array, b_array, a_float_array, b_float_array);
+    } else if (options.prefetch) {
+        benchmark_prefetch(options.format, options.iterations, options.array_size, a_array, b_array, a_float_array, b_float_array);
+    } else if (options.misalignment) {
+        benchmark_misalignment(options.format, options.iterations, array_elements, a_array, b_array, a_float_array, b_float_array);
+    } else {
+        for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+            benchmark_kernel(&dot_product_kernels[kernel_index],
+                options.addre ? &addre_dot_product_kernels[kernel_index] : NULL,
+                options.format, options.iterations, array_elements, a_array, b_array);
+        }
+        for (size_t kernel_index = 0; kernel_index < float_dot_product_kernels_count; kernel_index++) {
+            benchmark_float_kernel(&float_dot_product_kernels[kernel_index],
+                options.addre ? &addre_float_dot_product_kernels[kernel_index] : NULL,
+                options.format, options.iterations, array_elements, a_float_array, b_float_array);
+        }
+    }
+
+    report_end();
+    perf_counters_close();
 
     free(a_array);
     free(b_array);
+    free(a_float_array);
+    free(b_float_array);
 }
@@ -5,16 +5,41 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <report.h>
 #include <dot/dot.h>
 
 
 struct benchmark_options {
 	size_t iterations;
 	size_t array_size;
+	/* If non-zero, sweep over arrays of 1 to small_n elements instead of benchmarking arrays of array_size bytes */
+	size_t small_n;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+	/* Also benchmark the kernels compiled with emulated ADDRE */
+	bool addre;
+	/* Benchmark the kernels for unaligned arrays with every combination of misalignments of the arrays */
+	bool misalignment;
+	/* Sweep the kernels with software prefetching over array sizes up to array_size, and report bandwidth */
+	bool prefetch;
+	/* If non-zero, benchmark the kernels and STREAM triad on 1 to threads threads */
+	size_t threads;
+	/* In the thread scaling benchmark, partition the same arrays between threads instead of using private arrays */
+	bool shared_arrays;
 };
 
 struct benchmark_options parse_options(int argc, char** argv);
 
+/*
+ * Runs STREAM triad and the kernels with DOT_PRODUCT_PREFETCH_UNROLL unroll factor on 1 to max_threads pinned threads,
+ * and reports aggregate GB/s and GFLOPS. Each thread processes private arrays of array_size bytes,
+ * or, if shared_arrays is true, a partition of arrays of array_size bytes shared by all threads.
+ */
+void benchmark_threads(enum report_format format, size_t iterations, size_t array_size, size_t max_threads, bool shared_arrays);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -15,6 +15,10 @@ parser.add_argument("--unroll-min", dest="unroll_min", required=True, type=int,
 	help="Minimum unroll factor")
 parser.add_argument("--unroll-max", dest="unroll_max", required=True, type=int,
 	help="Maximum unroll factor")
+parser.add_argument("--prefetch-distances", dest="prefetch_distances", default="",
+	help="Comma-separated list of software prefetch distances, in bytes, for kernels with the maximum unroll factor")
+parser.add_argument("--prefetch-hints", dest="prefetch_hints", default="t0",
+	help="Comma-separated list of prefetch hints for kernels with software prefetching: t0 or nta (non-temporal)")
 parser.add_argument("--simd", dest="simd", choices=("scalar", "sse", "avx", "mic", "armv8", "vsx", "qpx"),
 	help="SIMD intrinsics")
 parser.add_argument("--implementation", dest="implementation", required=True,
@@ -25,27 +29,156 @@ parser.add_argument("--unittest", dest="unittest", required=True,
 	help="Output file name for C++ unit test")
 
 
-def generate_dot_product(code, simd, unroll_factor, fma):
+class KernelVariant:
+	"""
+	Unroll factor, alignment requirements, software prefetching, and processing of the remainder of a generated kernel.
+	AVX kernels process the remainder with masked loads (tail="masked"), or, for comparison in the small-n sweep
+	of dot-bench, with a scalar loop (tail="scalar"). Knights Corner kernels always use a scalar loop.
+	"""
+
+	def __init__(self, unroll_factor, aligned=True, prefetch_distance=0, prefetch_hint="t0", tail="masked"):
+		assert prefetch_hint in ["t0", "nta"]
+		assert tail in ["masked", "scalar"]
+		self.unroll_factor = unroll_factor
+		self.aligned = aligned
+		self.prefetch_distance = prefetch_distance
+		self.prefetch_hint = prefetch_hint
+		self.tail = tail
+
+	@property
+	def suffix(self):
+		"""Suffix of the kernel function name before _unroll"""
+		if self.tail == "scalar":
+			return "_scalartail"
+		elif not self.aligned:
+			return "_unaligned"
+		elif self.prefetch_distance != 0:
+			return "_prefetch{hint}{distance}".format(
+				hint="" if self.prefetch_hint == "t0" else self.prefetch_hint, distance=self.prefetch_distance)
+		else:
+			return ""
+
+	@property
+	def name_suffix(self):
+		"""Suffix of the kernel family name in the kernel tables"""
+		if self.tail == "scalar":
+			return "/scalar-tail"
+		elif not self.aligned:
+			return "/unaligned"
+		elif self.prefetch_distance != 0:
+			return "/prefetch" if self.prefetch_hint == "t0" else "/prefetch" + self.prefetch_hint
+		else:
+			return ""
+
+
+def generate_prefetch(code, variant, bytes_per_loop):
+	"""Prefetches the cache lines of a and b which the unrolled loop loads prefetch_distance bytes later"""
+	if variant.prefetch_distance != 0:
+		hint = {"t0": "_MM_HINT_T0", "nta": "_MM_HINT_NTA"}[variant.prefetch_hint]
+		for offset in range(0, bytes_per_loop, 64):
+			for array in ["a", "b"]:
+				code.line("_mm_prefetch((const char*) {array} + {distance}, {hint});"
+					.format(array=array, distance=variant.prefetch_distance + offset, hint=hint))
+
+
+def generate_accumulation(code, simd, implementation):
+	"""Accumulates the products of va and vb into vsum0"""
+	if implementation == "mac":
+		code.line("vsum0 = {dadd}(vsum0, {dmul}(va, vb));".format(dadd=simd._dadd, dmul=simd._dmul))
+	elif implementation == "fma":
+		code.line("vsum0 = {dfma}(va, vb, vsum0);".format(dfma=simd._dfma))
+	else:
+		vec, efmul, efadd, add = {
+			"compensated": (simd.dvec, simd._defmul, simd._defadd, simd._dadd),
+			"compensated_f32": (simd.fvec, simd._fefmul, simd._fefadd, simd._fadd)
+		}[implementation]
+		code.line("{vec} vproduct_error, vsum_error;".format(vec=vec))
+		code.line("const {vec} vproduct = {efmul}(va, vb, &vproduct_error);".format(vec=vec, efmul=efmul))
+		code.line("vsum0.hi = {efadd}(vsum0.hi, vproduct, &vsum_error);".format(efadd=efadd))
+		code.line("vsum0.lo = {add}(vsum0.lo, {add}(vsum_error, vproduct_error));".format(add=add))
+
+
+def generate_remainder(code, simd, unroll_factor, implementation, aligned):
+	"""
+	Processes the elements left after the unrolled loop with a loop over single SIMD vectors, and the last
+	partial vector with masked loads. Masked-out lanes are loaded as zeros, and do not change the sum.
+	"""
+	if implementation == "compensated_f32":
+		width, vec, load, loadu, maskload, mask_table = \
+			simd.fwidth, simd.fvec, simd._fload, simd._floadu, simd._fmaskload, "tail_mask_ps"
+	else:
+		width, vec, load, loadu, maskload, mask_table = \
+			simd.width, simd.dvec, simd._dload, simd._dloadu, simd._dmaskload, "tail_mask_pd"
+	if unroll_factor > 1:
+		code.line("for (; n >= {width}; n -= {width}) {{".format(width=width))
+		with CodeBlock():
+			code.line("const {vec} va = {load}(a);".format(vec=vec, load=load))
+			code.line("const {vec} vb = {load}(b);".format(vec=vec, load=load if aligned else loadu))
+			generate_accumulation(code, simd, implementation)
+			code.line("a += {width};".format(width=width))
+			code.line("b += {width};".format(width=width))
+		code.line("}")
+	code.line("if (n != 0) {")
+	with CodeBlock():
+		code.line("const __m256i vmask = _mm256_loadu_si256((const __m256i*) &{mask_table}[{width} - n]);"
+			.format(mask_table=mask_table, width=width))
+		code.line("const {vec} va = {maskload}(a, vmask);".format(vec=vec, maskload=maskload))
+		code.line("const {vec} vb = {maskload}(b, vmask);".format(vec=vec, maskload=maskload))
+		generate_accumulation(code, simd, implementation)
+	code.line("}")
+
+
+def generate_alignment_peeling(code, simd, implementation):
+	"""
+	Processes the elements before the first SIMD-aligned element of a with masked loads, so that the rest of the kernel
+	loads a with aligned loads. Elements of b are loaded with unaligned loads, because b may have a different misalignment.
+	"""
+	if implementation == "compensated_f32":
+		width, vec, maskload, mask_table = simd.fwidth, simd.fvec, simd._fmaskload, "tail_mask_ps"
+	else:
+		width, vec, maskload, mask_table = simd.width, simd.dvec, simd._dmaskload, "tail_mask_pd"
+	code.line("size_t peel = (-(uintptr_t) a % {alignment}) / sizeof(*a);".format(alignment=simd.alignment))
+	code.line("if (peel > n) {")
+	code.indent_line("peel = n;")
+	code.line("}")
+	code.line("if (peel != 0) {")
+	with CodeBlock():
+		code.line("const __m256i vmask = _mm256_loadu_si256((const __m256i*) &{mask_table}[{width} - peel]);"
+			.format(mask_table=mask_table, width=width))
+		code.line("const {vec} va = {maskload}(a, vmask);".format(vec=vec, maskload=maskload))
+		code.line("const {vec} vb = {maskload}(b, vmask);".format(vec=vec, maskload=maskload))
+		generate_accumulation(code, simd, implementation)
+		code.line("a += peel;")
+		code.line("b += peel;")
+		code.line("n -= peel;")
+	code.line("}")
+
+
+def generate_dot_product(code, simd, variant, fma):
+	unroll_factor, aligned = variant.unroll_factor, variant.aligned
 	code.line("""\
-double dot_product_{fma_or_mac}_unroll{unroll_factor}(
+double dot_product_{fma_or_mac}{suffix}_unroll{unroll_factor}(
 	size_t n,
 	const double a[restrict static n],
 	const double b[restrict static n])
-{{""".format(unroll_factor=unroll_factor, fma_or_mac="fma" if fma else "muladd"))
+{{""".format(unroll_factor=unroll_factor, fma_or_mac="fma" if fma else "muladd", suffix=variant.suffix))
 	with CodeBlock():
 		for i in range(unroll_factor):
 			code.line("{dvec} vsum{i} = {dzero};"
 				.format(dvec=simd.dvec, dzero=simd.dzero(), i=i))
+		if not aligned:
+			generate_alignment_peeling(code, simd, "fma" if fma else "mac")
 		code.line("for (; n >= {elements_per_loop}; n -= {elements_per_loop}) {{"
 			.format(elements_per_loop=simd.width * unroll_factor))
 
 		with CodeBlock() as vector_loop:
+			generate_prefetch(code, variant, simd.width * unroll_factor * 8)
 			for i in range(unroll_factor):
 				code.line("const {dvec} va{i} = {dload}(a+{offset});"
 					.format(dvec=simd.dvec, dload=simd._dload, i=i, offset=i*simd.width))
 			for i in range(unroll_factor):
 				code.line("const {dvec} vb{i} = {dload}(b+{offset});"
-					.format(dvec=simd.dvec, dload=simd._dload, i=i, offset=i*simd.width))
+					.format(dvec=simd.dvec, dload=simd._dload if aligned else simd._dloadu, i=i, offset=i*simd.width))
 			for i in range(unroll_factor):
 				if fma:
 					code.line("vsum{i} = {dfma}(va{i}, vb{i}, vsum{i});"
@@ -69,46 +202,54 @@ double dot_product_{fma_or_mac}_unroll{unroll_factor}(
 		# Reduction of a SIMD vector into a scalar
 		assert simd.name in ["avx", "mic"]
 		if simd.name == "avx":
+			if variant.tail == "masked":
+				generate_remainder(code, simd, unroll_factor, "fma" if fma else "mac", aligned)
 			code.line("double sum = _mm256_reduce_add_pd(vsum0);")
 		elif simd.name == "mic":
+			assert aligned
 			code.line("double sum = _mm512_reduce_add_pd(vsum0);")
 
-		code.line("while (n--) {")
-		with CodeBlock() as scalar_loop:
-			if fma:
-				code.line("#if defined(__GNUC__)")
-				code.indent_line("sum = __builtin_fma(*a++, *b++, sum);")
-				code.line("#else")
-				code.indent_line("sum = fma(*a++, *b++, sum);")
-				code.line("#endif")
-			else:
-				code.line("sum += (*a++) * (*b++);")
-		code.line("}")
+		if simd.name == "mic" or variant.tail == "scalar":
+			code.line("while (n--) {")
+			with CodeBlock() as scalar_loop:
+				if fma:
+					code.line("#if defined(__GNUC__)")
+					code.indent_line("sum = __builtin_fma(*a++, *b++, sum);")
+					code.line("#else")
+					code.indent_line("sum = fma(*a++, *b++, sum);")
+					code.line("#endif")
+				else:
+					code.line("sum += (*a++) * (*b++);")
+			code.line("}")
 		code.line("return sum;");
 
 	code.line("}")
 	code.line()
 
 
-def generate_compensated_dot_product(code, simd, unroll_factor):
+def generate_compensated_dot_product(code, simd, variant):
+	unroll_factor, aligned = variant.unroll_factor, variant.aligned
 	code.line("""
-doubledouble compensated_dot_product_efmuladd_unroll{unroll_factor}(
+doubledouble compensated_dot_product_efmuladd{suffix}_unroll{unroll_factor}(
 	size_t n,
 	const double a[restrict static n],
 	const double b[restrict static n])
-{{""".format(unroll_factor=unroll_factor))
+{{""".format(unroll_factor=unroll_factor, suffix=variant.suffix))
 	with CodeBlock():
 		for i in range(unroll_factor):
 			code.line("{ddvec} vsum{i} = {ddzero}();".format(ddvec=simd.ddvec, ddzero=simd.ddzero, i=i))
+		if not aligned:
+			generate_alignment_peeling(code, simd, "compensated")
 		code.line("for (; n>= {elements_per_loop}; n -= {elements_per_loop}) {{"
 			.format(elements_per_loop=simd.width * unroll_factor))
 		with CodeBlock():
+			generate_prefetch(code, variant, simd.width * unroll_factor * 8)
 			for index in range(unroll_factor):
 				code.line("const {dvec} va{index} = {dload}(a+{offset});"
 					.format(dvec=simd.dvec, dload=simd._dload, index=index, offset=index*simd.width))
 			for index in range(unroll_factor):
 				code.line("const {dvec} vb{index} = {dload}(b+{offset});"
-					.format(dvec=simd.dvec, dload=simd._dload, index=index, offset=index*simd.width))
+					.format(dvec=simd.dvec, dload=simd._dload if aligned else simd._dloadu, index=index, offset=index*simd.width))
 			for index in range(unroll_factor):
 				code.line("{dvec} vproduct{index}_error, vsum{index}_error;"
 					.format(dvec=simd.dvec, index=index))
@@ -136,47 +277,191 @@ doubledouble compensated_dot_product_efmuladd_unroll{unroll_factor}(
 		# Reduction of a SIMD vector into a scalar
 		assert simd.name in ["avx", "mic"]
 		if simd.name == "avx":
+			if variant.tail == "masked":
+				generate_remainder(code, simd, unroll_factor, "compensated", aligned)
 			code.line("doubledouble sum = _mm256_reduce_add_pdd(vsum0);")
 		elif simd.name == "mic":
+			assert aligned
 			code.line("doubledouble sum = _mm512_reduce_add_pdd(vsum0);")
-		code.line("while (n--) {")
+		if simd.name == "mic" or variant.tail == "scalar":
+			code.line("while (n--) {")
+			with CodeBlock():
+				code.line("double product_error, sum_error;")
+				code.line("const double product = efmul(*a++, *b++, &product_error);")
+				code.line("sum.hi = efadd(sum.hi, product, &sum_error);")
+				code.line("sum.lo += (sum_error + product_error);")
+			code.line("}")
+		code.line("/* Normalize */")
+		code.line("sum.hi = efaddord(sum.hi, sum.lo, &sum.lo);")
+		code.line("return sum;");
+
+	code.line("}")
+	code.line()
+
+
+def generate_compensated_dot_product_f32(code, simd, variant):
+	unroll_factor, aligned = variant.unroll_factor, variant.aligned
+	code.line("""
+floatfloat compensated_dot_product_f32_efmuladd{suffix}_unroll{unroll_factor}(
+	size_t n,
+	const float a[restrict static n],
+	const float b[restrict static n])
+{{""".format(unroll_factor=unroll_factor, suffix=variant.suffix))
+	with CodeBlock():
+		for i in range(unroll_factor):
+			code.line("{ffvec} vsum{i} = {ffzero}();".format(ffvec=simd.ffvec, ffzero=simd.ffzero, i=i))
+		if not aligned:
+			generate_alignment_peeling(code, simd, "compensated_f32")
+		code.line("for (; n>= {elements_per_loop}; n -= {elements_per_loop}) {{"
+			.format(elements_per_loop=simd.fwidth * unroll_factor))
 		with CodeBlock():
-			code.line("double product_error, sum_error;")
-			code.line("const double product = efmul(*a++, *b++, &product_error);")
-			code.line("sum.hi = efadd(sum.hi, product, &sum_error);")
-			code.line("sum.lo += (sum_error + product_error);")
+			generate_prefetch(code, variant, simd.fwidth * unroll_factor * 4)
+			for index in range(unroll_factor):
+				code.line("const {fvec} va{index} = {fload}(a+{offset});"
+					.format(fvec=simd.fvec, fload=simd._fload, index=index, offset=index*simd.fwidth))
+			for index in range(unroll_factor):
+				code.line("const {fvec} vb{index} = {fload}(b+{offset});"
+					.format(fvec=simd.fvec, fload=simd._fload if aligned else simd._floadu, index=index, offset=index*simd.fwidth))
+			for index in range(unroll_factor):
+				code.line("{fvec} vproduct{index}_error, vsum{index}_error;"
+					.format(fvec=simd.fvec, index=index))
+			for index in range(unroll_factor):
+				code.line("const {fvec} vproduct{index} = {fefmul}(va{index}, vb{index}, &vproduct{index}_error);"
+					.format(fvec=simd.fvec, fefmul=simd._fefmul, index=index))
+			for index in range(unroll_factor):
+				code.line("vsum{index}.hi = {fefadd}(vsum{index}.hi, vproduct{index}, &vsum{index}_error);"
+					.format(fefadd=simd._fefadd, index=index))
+			for index in range(unroll_factor):
+				code.line("vsum{index}.lo = {fadd}(vsum{index}.lo, {fadd}(vsum{index}_error, vproduct{index}_error));"
+					.format(fadd=simd._fadd, index=index))
+			code.line("a += {elements_per_loop};".format(elements_per_loop=simd.fwidth * unroll_factor))
+			code.line("b += {elements_per_loop};".format(elements_per_loop=simd.fwidth * unroll_factor))
 		code.line("}")
+
+		# Reduction of multiple SIMD vectors into a single SIMD vector
+		reduction_offset = 1
+		while reduction_offset <= unroll_factor:
+			for i in range(0, unroll_factor - reduction_offset, 2 * reduction_offset):
+				code.line("vsum{i} = {ffadd}(vsum{i}, vsum{next_i});"
+					.format(ffadd=simd._ffadd, i=i, next_i=i + reduction_offset))
+			reduction_offset *= 2
+
+		if variant.tail == "masked":
+			generate_remainder(code, simd, unroll_factor, "compensated_f32", aligned)
+
+		# Reduction of a SIMD vector into a scalar
+		code.line("floatfloat sum = {ffreduce}(vsum0);".format(ffreduce=simd._ffreduce))
+		if variant.tail == "scalar":
+			code.line("while (n--) {")
+			with CodeBlock():
+				code.line("float product_error, sum_error;")
+				code.line("const float product = efmulf(*a++, *b++, &product_error);")
+				code.line("sum.hi = efaddf(sum.hi, product, &sum_error);")
+				code.line("sum.lo += (sum_error + product_error);")
+			code.line("}")
 		code.line("/* Normalize */")
-		code.line("sum.hi = efaddord(sum.hi, sum.lo, &sum.lo);")
+		code.line("sum.hi = efaddordf(sum.hi, sum.lo, &sum.lo);")
 		code.line("return sum;");
 
 	code.line("}")
 	code.line()
 
 
-def generate_dot_product_declaration(header, unroll_factor, implementation):
+def generate_dot_product_declaration(header, variant, implementation):
 	header.line({
-		"mac": "double dot_product_muladd_unroll{unroll_factor}(size_t n, const double a[], const double b[]);",
-		"fma": "double dot_product_fma_unroll{unroll_factor}(size_t n, const double a[], const double b[]);",
-		"compensated": "doubledouble compensated_dot_product_efmuladd_unroll{unroll_factor}(size_t n, const double a[], const double b[]);"
-	}[implementation].format(unroll_factor=unroll_factor))
-
+		"mac": "double dot_product_muladd{suffix}_unroll{unroll_factor}(size_t n, const double a[], const double b[]);",
+		"fma": "double dot_product_fma{suffix}_unroll{unroll_factor}(size_t n, const double a[], const double b[]);",
+		"compensated": "doubledouble compensated_dot_product_efmuladd{suffix}_unroll{unroll_factor}(size_t n, const double a[], const double b[]);",
+		"compensated_f32": "floatfloat compensated_dot_product_f32_efmuladd{suffix}_unroll{unroll_factor}(size_t n, const float a[], const float b[]);"
+	}[implementation].format(unroll_factor=variant.unroll_factor, suffix=variant.suffix))
+
+
+def generate_dot_product_kernel_entry(code, variant, implementation):
+	code.line({
+		"mac": "{{ \"mul+add{name_suffix}\", {unroll_factor}, {aligned}, {prefetch_distance}, {scalar_tail}, dot_product_muladd{suffix}_unroll{unroll_factor}, NULL }},",
+		"fma": "{{ \"fma{name_suffix}\", {unroll_factor}, {aligned}, {prefetch_distance}, {scalar_tail}, dot_product_fma{suffix}_unroll{unroll_factor}, NULL }},",
+		"compensated": "{{ \"efmul+efadd{name_suffix}\", {unroll_factor}, {aligned}, {prefetch_distance}, {scalar_tail}, NULL, compensated_dot_product_efmuladd{suffix}_unroll{unroll_factor} }},",
+		"compensated_f32": "{{ \"efmul+efadd{name_suffix}\", {unroll_factor}, {aligned}, {prefetch_distance}, {scalar_tail}, compensated_dot_product_f32_efmuladd{suffix}_unroll{unroll_factor} }},"
+	}[implementation].format(unroll_factor=variant.unroll_factor, suffix=variant.suffix, name_suffix=variant.name_suffix,
+		aligned="true" if variant.aligned else "false", prefetch_distance=variant.prefetch_distance,
+		scalar_tail="true" if variant.tail == "scalar" else "false"))
+
+
+def generate_dot_product_unittest(unittest, simd, variant, implementation):
+	# Small arrays cover all iteration counts of the unrolled loop, single-vector loop, and masked remainder.
+	# Inputs are non-negative, so that cancellation does not amplify the error of the non-compensated kernels.
+	# Kernels for unaligned arrays are also tested with every combination of misalignments of a and b.
+	# Kernels with software prefetching differ only in the prefetch instructions, which do not change the results.
+	# Kernels with scalar processing of the remainder get the same tests as the kernels with masked remainder.
+	unroll_factor, aligned = variant.unroll_factor, variant.aligned
+	width = simd.fwidth if implementation == "compensated_f32" else simd.width
+	if variant.prefetch_distance != 0:
+		template = """\
+TEST({operation}, {implementation}{suffix}_unroll{unroll_factor}) {{
+	DotTester()
+		.test{test_method}({function}{suffix}_unroll{unroll_factor});
+}}
+"""
+	elif aligned:
+		template = """\
+TEST({operation}, {implementation}{suffix}_unroll{unroll_factor}) {{
+	DotTester()
+		.test{test_method}({function}{suffix}_unroll{unroll_factor});
+}}
 
-def generate_dot_product_unittest(unittest, unroll_factor, implementation):
-	unittest.line("""\
-TEST({operation}, {implementation}_unroll{unroll_factor}) {{
+TEST({operation}, {implementation}{suffix}_unroll{unroll_factor}_remainder) {{
+	DotTester tester;
+	tester.inputRange(0.0, 1.0);
+	for (size_t n = 1; n <= {max_elements}; n++) {{
+		tester.arrayElements(n)
+			.test{test_method}({function}{suffix}_unroll{unroll_factor});
+	}}
+}}
+"""
+	else:
+		template = """\
+TEST({operation}, {implementation}_unaligned_unroll{unroll_factor}) {{
 	DotTester()
-		.test{test_method}({function}_unroll{unroll_factor});
+		.arrayOffsets(1, {width} - 1)
+		.test{test_method}({function}_unaligned_unroll{unroll_factor});
+}}
+
+TEST({operation}, {implementation}_unaligned_unroll{unroll_factor}_offsets) {{
+	DotTester tester;
+	tester.inputRange(0.0, 1.0);
+	for (size_t offsetA = 0; offsetA < {width}; offsetA++) {{
+		for (size_t offsetB = 0; offsetB < {width}; offsetB++) {{
+			for (size_t n = 1; n <= {max_elements}; n++) {{
+				tester.arrayOffsets(offsetA, offsetB).arrayElements(n)
+					.test{test_method}({function}_unaligned_unroll{unroll_factor});
+			}}
+		}}
+	}}
 }}
-""".format(
-	operation="compensated_dot_product" if implementation == "compensated" else "dot_product",
-	implementation=implementation,
+"""
+	unittest.line(template.format(
+	width=width,
+	suffix=variant.suffix,
+	max_elements=2 * unroll_factor * width if aligned else (2 * unroll_factor + 1) * width,
+	operation={
+		"mac": "dot_product",
+		"fma": "dot_product",
+		"compensated": "compensated_dot_product",
+		"compensated_f32": "compensated_dot_product_f32"
+	}[implementation],
+	implementation="compensated" if implementation == "compensated_f32" else implementation,
 	unroll_factor=unroll_factor,
-	test_method="CompensatedDotProduct" if implementation == "compensated" else "DotProduct",
+	test_method={
+		"mac": "DotProduct",
+		"fma": "DotProduct",
+		"compensated": "CompensatedDotProduct",
+		"compensated_f32": "CompensatedDotProductF32"
+	}[implementation],
 	function={
 		"mac": "dot_product_muladd",
 		"fma": "dot_product_fma",
-		"compensated": "compensated_dot_product_efmuladd"
+		"compensated": "compensated_dot_product_efmuladd",
+		"compensated_f32": "compensated_dot_product_f32_efmuladd"
 	}[implementation]))
 
 
@@ -186,6 +471,8 @@ def main():
 	from simd import SimdOperations
 	with CodeWriter() as implementation:
 		implementation.line("""\
+#include <stdint.h>
+
 #include <fpplus.h>
 
 #include <dot/dot.h>
@@ -194,6 +481,11 @@ def main():
 		simd = SimdOperations(options.simd)
 		if simd.name == "avx":
 			implementation.line("""
+/* Masks for the remainder of n < width elements start at index width - n: n all-ones lanes followed by zero lanes */
+static const int64_t tail_mask_pd[8] = { -1, -1, -1, -1, 0, 0, 0, 0 };
+static const int32_t tail_mask_ps[16] = { -1, -1, -1, -1, -1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0 };
+""")
+			implementation.line("""
 FPPLUS_STATIC_INLINE double _mm_reduce_add_pd(const __m128d x) {
 	const __m128d x_hi = _mm_unpackhi_pd(x, x);
 	const __m128d sum = _mm_add_sd(x, x_hi);
@@ -207,46 +499,177 @@ FPPLUS_STATIC_INLINE double _mm256_reduce_add_pd(const __m256d x) {
 }
 """)
 
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product(implementation, simd, unroll_factor, fma=False)
+		unroll_factors = range(options.unroll_min, options.unroll_max + 1)
+		variants = [KernelVariant(unroll_factor) for unroll_factor in unroll_factors]
+		# Kernels for unaligned arrays need masked loads, and are implemented only for AVX
+		if simd.name == "avx":
+			variants += [KernelVariant(unroll_factor, aligned=False) for unroll_factor in unroll_factors]
+		# AVX kernels with scalar processing of the remainder are the baseline for the masked remainder in the small-n sweep
+		if simd.name == "avx":
+			variants += [KernelVariant(unroll_factor, tail="scalar") for unroll_factor in unroll_factors]
+		# Software prefetching targets arrays in memory, where the kernels with the maximum unroll factor are the fastest
+		prefetch_distances = [int(distance) for distance in options.prefetch_distances.split(",") if distance]
+		prefetch_hints = [hint for hint in options.prefetch_hints.split(",") if hint]
+		variants += [KernelVariant(options.unroll_max, prefetch_distance=distance, prefetch_hint=hint)
+			for hint in prefetch_hints for distance in prefetch_distances]
+
+		for variant in variants:
+			generate_dot_product(implementation, simd, variant, fma=False)
 
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product(implementation, simd, unroll_factor, fma=True)
+		for variant in variants:
+			generate_dot_product(implementation, simd, variant, fma=True)
 
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_compensated_dot_product(implementation, simd, unroll_factor)
+		for variant in variants:
+			generate_compensated_dot_product(implementation, simd, variant)
+
+		# Float-float arithmetic is implemented only for AVX
+		f32_variants = variants if simd.name == "avx" else []
+		for variant in f32_variants:
+			generate_compensated_dot_product_f32(implementation, simd, variant)
+
+		implementation.line("const struct dot_product_kernel dot_product_kernels[] = {")
+		with CodeBlock():
+			for kernel_implementation in ["mac", "fma", "compensated"]:
+				for variant in variants:
+					generate_dot_product_kernel_entry(implementation, variant, kernel_implementation)
+		implementation.line("};")
+		implementation.line()
+		implementation.line("const size_t dot_product_kernels_count = sizeof(dot_product_kernels) / sizeof(dot_product_kernels[0]);")
+		implementation.line()
+
+		if f32_variants:
+			implementation.line("const struct float_dot_product_kernel float_dot_product_kernels[] = {")
+			with CodeBlock():
+				for variant in f32_variants:
+					generate_dot_product_kernel_entry(implementation, variant, "compensated_f32")
+			implementation.line("};")
+			implementation.line()
+			implementation.line("const size_t float_dot_product_kernels_count = sizeof(float_dot_product_kernels) / sizeof(float_dot_product_kernels[0]);")
+		else:
+			implementation.line("const struct float_dot_product_kernel float_dot_product_kernels[] = { { NULL, 0, false, 0, false, NULL } };")
+			implementation.line("const size_t float_dot_product_kernels_count = 0;")
 
 	with CodeWriter() as header:
 		header.line("""\
 #pragma once
 
 #ifdef __cplusplus
-extern "C" {
+extern "C" {{
 #endif
 
 #include <stddef.h>
+#include <stdbool.h>
 
 #include <fpplus.h>
 
+/*
+ * Kernels without the _unaligned suffix load both arrays with aligned loads, and require arrays aligned on
+ * DOT_PRODUCT_ALIGNMENT bytes. Kernels with the _unaligned suffix accept any arrays of naturally aligned elements:
+ * they process the elements before the first aligned element of a with masked loads, and then load b with unaligned loads.
+ */
+#define DOT_PRODUCT_ALIGNMENT {alignment}
+
+/*
+ * Kernels with _prefetch{{distance}} and _prefetchnta{{distance}} suffixes prefetch the arrays the given number of bytes
+ * ahead of the loads, with temporal or non-temporal hint. They are generated only for this unroll factor.
+ */
+
+/*
+ * Kernels with the _scalartail suffix process the remainder of the unrolled loop with a scalar loop instead of masked loads.
+ * They are generated only for AVX, as the baseline for the small-n sweep of dot-bench.
+ */
+#define DOT_PRODUCT_PREFETCH_UNROLL {prefetch_unroll}
+
 typedef double (*dot_product_function)(size_t, const double*, const double*);
 typedef doubledouble (*compensated_dot_product_function)(size_t, const double*, const double*);
-""")
+typedef floatfloat (*compensated_dot_product_f32_function)(size_t, const float*, const float*);
+""".format(alignment=simd.alignment, prefetch_unroll=options.unroll_max))
+
+		header.line("/* Kernels compiled with -DFPPLUS_BENCHMARK_ADDRE -DFPPLUS_EMULATE_FPADDRE get addre_ prefix */")
+		header.line("#ifdef FPPLUS_BENCHMARK_ADDRE")
+		with CodeBlock():
+			for function in ["dot_product_muladd", "dot_product_fma", "compensated_dot_product_efmuladd"]:
+				for variant in variants:
+					header.line("#define {function}{suffix}_unroll{unroll_factor} addre_{function}{suffix}_unroll{unroll_factor}".format(
+						function=function, suffix=variant.suffix, unroll_factor=variant.unroll_factor))
+			for variant in f32_variants:
+				header.line("#define compensated_dot_product_f32_efmuladd{suffix}_unroll{unroll_factor} addre_compensated_dot_product_f32_efmuladd{suffix}_unroll{unroll_factor}".format(
+					suffix=variant.suffix, unroll_factor=variant.unroll_factor))
+			header.line("#define dot_product_kernels addre_dot_product_kernels")
+			header.line("#define dot_product_kernels_count addre_dot_product_kernels_count")
+			header.line("#define float_dot_product_kernels addre_float_dot_product_kernels")
+			header.line("#define float_dot_product_kernels_count addre_float_dot_product_kernels_count")
+		header.line("#endif")
+		header.line()
 
 		header.line("/* Dot product based on multiplication and addition (with intermediate rounding) */")
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product_declaration(header, unroll_factor, "mac")
+		for variant in variants:
+			generate_dot_product_declaration(header, variant, "mac")
 		header.line()
 
 		header.line("/* Dot product based on fused multiply-add */")
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product_declaration(header, unroll_factor, "fma")
+		for variant in variants:
+			generate_dot_product_declaration(header, variant, "fma")
 		header.line()
 
 		header.line("/* compensated dot product based on error-free multiplication and error-free addition */")
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product_declaration(header, unroll_factor, "compensated")
+		for variant in variants:
+			generate_dot_product_declaration(header, variant, "compensated")
+
+		if f32_variants:
+			header.line()
+			header.line("/* compensated dot product of single-precision arrays in float-float arithmetic */")
+			for variant in f32_variants:
+				generate_dot_product_declaration(header, variant, "compensated_f32")
 
 		header.line("""
+/* Table of all generated dot product kernels, for benchmarks which iterate over the kernels */
+struct dot_product_kernel {
+	/*
+	 * Name of the kernel family: "mul+add", "fma", or "efmul+efadd",
+	 * with "/unaligned", "/prefetch", "/prefetchnta", or "/scalar-tail" suffix for the kernels with the corresponding suffix
+	 */
+	const char* name;
+	size_t unroll_factor;
+	/* Whether the kernel requires arrays aligned on DOT_PRODUCT_ALIGNMENT bytes */
+	bool aligned;
+	/* Software prefetch distance, in bytes, or 0 if the kernel does not prefetch */
+	size_t prefetch_distance;
+	/* Whether the kernel processes the remainder with a scalar loop rather than masked loads */
+	bool scalar_tail;
+	/* Non-NULL for kernels which return the result in double precision */
+	dot_product_function dot_product;
+	/* Non-NULL for compensated kernels which return the result in double-double precision */
+	compensated_dot_product_function compensated_dot_product;
+};
+
+extern const struct dot_product_kernel dot_product_kernels[];
+extern const size_t dot_product_kernels_count;
+
+/* Table of the kernels compiled with emulated ADDRE */
+extern const struct dot_product_kernel addre_dot_product_kernels[];
+extern const size_t addre_dot_product_kernels_count;
+
+/* Table of the float-float kernels, for direct comparison with double-double kernels of the same unroll factor */
+struct float_dot_product_kernel {
+	/* Name of the kernel family: "efmul+efadd", with the same suffixes as in dot_product_kernel */
+	const char* name;
+	size_t unroll_factor;
+	/* Whether the kernel requires arrays aligned on DOT_PRODUCT_ALIGNMENT bytes */
+	bool aligned;
+	/* Software prefetch distance, in bytes, or 0 if the kernel does not prefetch */
+	size_t prefetch_distance;
+	/* Whether the kernel processes the remainder with a scalar loop rather than masked loads */
+	bool scalar_tail;
+	compensated_dot_product_f32_function compensated_dot_product;
+};
+
+extern const struct float_dot_product_kernel float_dot_product_kernels[];
+extern const size_t float_dot_product_kernels_count;
+
+extern const struct float_dot_product_kernel addre_float_dot_product_kernels[];
+extern const size_t addre_float_dot_product_kernels_count;
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif""")
@@ -265,18 +688,24 @@ typedef doubledouble (*compensated_dot_product_function)(size_t, const double*,
 """)
 
 		unittest.line("/* Dot product based on multiplication and addition (with intermediate rounding) */")
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product_unittest(unittest, unroll_factor, "mac")
+		for variant in variants:
+			generate_dot_product_unittest(unittest, simd, variant, "mac")
 		unittest.line()
 
 		unittest.line("/* Dot product based on fused multiply-add */")
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product_unittest(unittest, unroll_factor, "fma")
+		for variant in variants:
+			generate_dot_product_unittest(unittest, simd, variant, "fma")
 		unittest.line()
 
 		unittest.line("/* compensated dot product based on error-free multiplication and error-free addition */")
-		for unroll_factor in range(options.unroll_min, options.unroll_max + 1):
-			generate_dot_product_unittest(unittest, unroll_factor, "compensated")
+		for variant in variants:
+			generate_dot_product_unittest(unittest, simd, variant, "compensated")
+
+		if f32_variants:
+			unittest.line()
+			unittest.line("/* compensated dot product of single-precision arrays in float-float arithmetic */")
+			for variant in f32_variants:
+				generate_dot_product_unittest(unittest, simd, variant, "compensated_f32")
 
 		unittest.line("""\
 int main(int argc, char* argv[]) {
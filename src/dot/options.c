@@ -7,18 +7,40 @@
 
 static void print_options_help(const char* program_name) {
 	printf(
-"%s -s array-size [-i iterations]\n"
-"Required parameters:\n"
+"%s -s array-size [-i iterations] [-f format] [-c counters] [--addre | --misalignment | --prefetch | --threads max-threads [--shared]]\n"
+"%s -n max-elements [-i iterations] [-f format] [-c counters]\n"
+"Required parameters (one of):\n"
 "  -s   --array-size       The size of array, in bytes, processed in micro-kernel (usually half or level-n cache size)\n"
+"  -n   --small-n          Sweep over arrays of 1 to max-elements elements, and report cycles per call\n"
+"                          of the kernels with masked and with scalar processing of the remainder\n"
 "Optional parameters:\n"
-"  -i   --iterations       The number of benchmark iterations (default: 1000)\n",
-		program_name);
+"  -i   --iterations       The number of benchmark iterations (default: 1000)\n"
+"  -f   --format           Output format: text (default), csv, or json\n"
+"  -c   --counters         Comma-separated list of performance counters to measure, or all:\n"
+"                          cycles, instructions, fp-scalar, fp-128, fp-256, fp-512, l1d-misses, llc-misses\n"
+"       --addre            Also benchmark the kernels compiled with emulated ADDRE, and report the speedup\n"
+"  -m   --misalignment     Benchmark the kernels for unaligned arrays with every offset of the arrays, in elements,\n"
+"                          from aligned addresses\n"
+"  -p   --prefetch         Benchmark the kernels with and without software prefetching on arrays from 16 KB\n"
+"                          to array-size (e.g. 4x last-level cache size), and report bandwidth in GB/s\n"
+"  -t   --threads          Benchmark the kernels and STREAM triad on 1 to max-threads pinned threads with private\n"
+"                          arrays of array-size bytes, and report aggregate GB/s and GFLOPS (counters are not supported)\n"
+"       --shared           Partition shared arrays of array-size bytes between the threads instead\n",
+		program_name, program_name);
 }
 
 struct benchmark_options parse_options(int argc, char** argv) {
 	struct benchmark_options options = {
 		.iterations = 1000,
 		.array_size = 0,
+		.small_n = 0,
+		.format = report_format_text,
+		.counters = 0,
+		.addre = false,
+		.misalignment = false,
+		.prefetch = false,
+		.threads = 0,
+		.shared_arrays = false,
 	};
 	for (int argi = 1; argi < argc; argi += 1) {
 		if ((strcmp(argv[argi], "--array-size") == 0) || (strcmp(argv[argi], "-s") == 0)) {
@@ -30,11 +52,25 @@ struct benchmark_options parse_options(int argc, char** argv) {
 				fprintf(stderr, "Error: can not parse %s as an unsigned integer\n", argv[argi + 1]);
 				exit(EXIT_FAILURE);
 			}
-			if (options.array_size == 0) {
+			if (options.array_size == 0 && options.small_n == 0) {
 				fprintf(stderr, "Error: invalid value %s for the array size: positive value expected\n", argv[argi + 1]);
 				exit(EXIT_FAILURE);
 			}
 			argi += 1;
+		} else if ((strcmp(argv[argi], "--small-n") == 0) || (strcmp(argv[argi], "-n") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected maximum number of elements\n");
+				exit(EXIT_FAILURE);
+			}
+			if (sscanf(argv[argi + 1], "%zu", &options.small_n) != 1) {
+				fprintf(stderr, "Error: can not parse %s as an unsigned integer\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			if (options.small_n == 0) {
+				fprintf(stderr, "Error: invalid value %s for the maximum number of elements: positive value expected\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
 		} else if ((strcmp(argv[argi], "--iterations") == 0) || (strcmp(argv[argi], "-i") == 0)) {
 			if (argi + 1 == argc) {
 				fprintf(stderr, "Error: expected iterations value\n");
@@ -49,6 +85,53 @@ struct benchmark_options parse_options(int argc, char** argv) {
 				exit(EXIT_FAILURE);
 			}
 			argi += 1;
+		} else if ((strcmp(argv[argi], "--format") == 0) || (strcmp(argv[argi], "-f") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected output format\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_report_format(argv[argi + 1], &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strncmp(argv[argi], "--format=", strlen("--format=")) == 0) {
+			if (!parse_report_format(argv[argi] + strlen("--format="), &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi] + strlen("--format="));
+				exit(EXIT_FAILURE);
+			}
+		} else if ((strcmp(argv[argi], "--counters") == 0) || (strcmp(argv[argi], "-c") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected list of performance counters\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_perf_counters(argv[argi + 1], &options.counters)) {
+				fprintf(stderr, "Error: invalid list of performance counters %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strcmp(argv[argi], "--addre") == 0) {
+			options.addre = true;
+		} else if ((strcmp(argv[argi], "--misalignment") == 0) || (strcmp(argv[argi], "-m") == 0)) {
+			options.misalignment = true;
+		} else if ((strcmp(argv[argi], "--prefetch") == 0) || (strcmp(argv[argi], "-p") == 0)) {
+			options.prefetch = true;
+		} else if ((strcmp(argv[argi], "--threads") == 0) || (strcmp(argv[argi], "-t") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected maximum number of threads\n");
+				exit(EXIT_FAILURE);
+			}
+			if (sscanf(argv[argi + 1], "%zu", &options.threads) != 1) {
+				fprintf(stderr, "Error: can not parse %s as an unsigned integer\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			if (options.threads == 0) {
+				fprintf(stderr, "Error: invalid value %s for the maximum number of threads: positive value expected\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strcmp(argv[argi], "--shared") == 0) {
+			options.shared_arrays = true;
 		} else if ((strcmp(argv[argi], "--help") == 0) || (strcmp(argv[argi], "-h") == 0)) {
 			print_options_help(argv[0]);
 			exit(EXIT_SUCCESS);
@@ -58,10 +141,14 @@ struct benchmark_options parse_options(int argc, char** argv) {
 			exit(EXIT_FAILURE);
 		}
 	}
-	if (options.array_size == 0) {
+	if (options.array_size == 0 && options.small_n == 0) {
 		fprintf(stderr, "Error: the block size is not specified\n");
 		print_options_help(argv[0]);
 		exit(EXIT_FAILURE);
 	}
+	if (options.threads != 0 && options.counters != 0) {
+		fprintf(stderr, "Error: performance counters are not supported in the thread scaling benchmark\n");
+		exit(EXIT_FAILURE);
+	}
 	return options;
 }
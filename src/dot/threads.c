@@ -0,0 +1,278 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <utils.h>
+#include <dot/common.h>
+
+
+/* Partitions of shared arrays start on cache line boundaries, which keeps them aligned for the aligned kernels */
+#define CACHE_LINE_SIZE 64
+
+/* Work which all active threads do in each iteration: a dot product kernel, or STREAM triad */
+struct thread_task {
+    /* Exactly one of the kernels is non-NULL, or none for STREAM triad */
+    dot_product_function dot_product;
+    compensated_dot_product_function compensated_dot_product;
+    compensated_dot_product_f32_function compensated_dot_product_f32;
+    /* The number of threads which do the work, other threads only wait on the barriers */
+    size_t active_threads;
+    /* The last task, which stops the threads */
+    bool exit;
+};
+
+struct thread_pool {
+    size_t threads;
+    /* All threads process the same arrays, partitioned between the active threads */
+    bool shared_arrays;
+    /* Size of each array, in bytes: per thread for private arrays, or in total for shared arrays */
+    size_t array_size;
+    struct thread_task task;
+    /* Each iteration is delimited by two barriers for the pool threads and the main thread */
+    pthread_barrier_t start_barrier;
+    pthread_barrier_t end_barrier;
+    /* Shared arrays, or NULL for private arrays */
+    double* shared_a;
+    double* shared_b;
+    double* shared_c;
+};
+
+struct thread_context {
+    pthread_t thread;
+    size_t index;
+    struct thread_pool* pool;
+};
+
+/* a = b + scalar * c: the triad kernel of the STREAM benchmark, which moves 24 bytes per element */
+static void stream_triad(size_t n, double a[restrict static n], const double b[restrict static n], const double c[restrict static n], double scalar) {
+    for (size_t i = 0; i < n; i++) {
+        a[i] = b[i] + scalar * c[i];
+    }
+}
+
+/* The range of bytes of each array processed by the thread: the whole private arrays, or a partition of shared arrays */
+static void thread_partition(const struct thread_pool* pool, size_t index, size_t active_threads,
+    size_t offset[restrict static 1], size_t size[restrict static 1])
+{
+    if (!pool->shared_arrays) {
+        *offset = 0;
+        *size = pool->array_size;
+    } else {
+        const size_t lines = pool->array_size / CACHE_LINE_SIZE;
+        const size_t lines_per_thread = (lines + active_threads - 1) / active_threads;
+        const size_t first_line = index * lines_per_thread < lines ? index * lines_per_thread : lines;
+        const size_t last_line = first_line + lines_per_thread < lines ? first_line + lines_per_thread : lines;
+        *offset = first_line * CACHE_LINE_SIZE;
+        *size = (last_line - first_line) * CACHE_LINE_SIZE;
+    }
+}
+
+static void* thread_function(void* argument) {
+    struct thread_context* context = argument;
+    struct thread_pool* pool = context->pool;
+
+    /* Private arrays are allocated and initialized by the thread, so that they are local to its memory node */
+    double *a, *b, *c;
+    if (pool->shared_arrays) {
+        a = pool->shared_a;
+        b = pool->shared_b;
+        c = pool->shared_c;
+    } else {
+        a = valloc(pool->array_size);
+        b = valloc(pool->array_size);
+        c = valloc(pool->array_size);
+        if (a == NULL || b == NULL || c == NULL) {
+            fprintf(stderr, "Error: failed to allocate memory for %zu-byte arrays in thread %zu\n", pool->array_size, context->index);
+            exit(EXIT_FAILURE);
+        }
+    }
+    size_t offset, size;
+    thread_partition(pool, context->index, pool->threads, &offset, &size);
+    /* Single-precision kernels reinterpret the arrays as floats: both halves of these doubles are normal floats */
+    for (size_t i = offset / sizeof(double); i < (offset + size) / sizeof(double); i++) {
+        a[i] = M_PI;
+        b[i] = M_E;
+        c[i] = M_SQRT2;
+    }
+
+    for (;;) {
+        pthread_barrier_wait(&pool->start_barrier);
+        const struct thread_task task = pool->task;
+        if (task.exit) {
+            break;
+        }
+        if (context->index < task.active_threads) {
+            thread_partition(pool, context->index, task.active_threads, &offset, &size);
+            if (task.dot_product != NULL) {
+                task.dot_product(size / sizeof(double), a + offset / sizeof(double), b + offset / sizeof(double));
+            } else if (task.compensated_dot_product != NULL) {
+                task.compensated_dot_product(size / sizeof(double), a + offset / sizeof(double), b + offset / sizeof(double));
+            } else if (task.compensated_dot_product_f32 != NULL) {
+                task.compensated_dot_product_f32(size / sizeof(float),
+                    (const float*) a + offset / sizeof(float), (const float*) b + offset / sizeof(float));
+            } else {
+                stream_triad(size / sizeof(double), a + offset / sizeof(double),
+                    b + offset / sizeof(double), c + offset / sizeof(double), M_E);
+            }
+        }
+        pthread_barrier_wait(&pool->end_barrier);
+    }
+
+    if (!pool->shared_arrays) {
+        free(a);
+        free(b);
+        free(c);
+    }
+    return NULL;
+}
+
+/* Runs the task on the pool threads, and returns the wall time of each iteration in nanoseconds */
+static void measure_task(struct thread_pool* pool, const struct thread_task* task,
+    size_t iterations, double iteration_times[restrict static iterations])
+{
+    pool->task = *task;
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        const double start_time = high_precision_time();
+        pthread_barrier_wait(&pool->start_barrier);
+        pthread_barrier_wait(&pool->end_barrier);
+        iteration_times[iteration] = high_precision_time() - start_time;
+    }
+}
+
+/*
+ * Prints aggregate GB/s, GFLOPS, and the fraction of the STREAM triad bandwidth with the same number of threads,
+ * or reports GB/s and GFLOPS as separate measurements.
+ */
+static void report_scaling(
+    const char* type,
+    const char* name,
+    size_t unroll_factor,
+    size_t threads,
+    enum report_format format,
+    size_t iterations, const double iteration_times[restrict static iterations],
+    size_t bytes, size_t flops, double triad_bandwidth)
+{
+    double iteration_bandwidth[iterations], iteration_gflops[iterations];
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        iteration_bandwidth[iteration] = ((double) bytes) / iteration_times[iteration];
+        iteration_gflops[iteration] = ((double) flops) / iteration_times[iteration];
+    }
+    /* Counters are not measured: they would count only the events of the main thread */
+    const double counters[perf_counter_count] = { 0.0 };
+    if (format == report_format_text) {
+        const double bandwidth = median_double(iteration_bandwidth, iterations);
+        printf("%s\t" "%s\t" "%zu\t" "%3zu\t" "%.2lf\t" "%.2lf\t" "%.0lf%%\n",
+            type, name, unroll_factor, threads, bandwidth,
+            median_double(iteration_gflops, iterations), 100.0 * bandwidth / triad_bandwidth);
+    } else {
+        char full_name[128];
+        snprintf(full_name, sizeof(full_name), "%s/%s/unroll%zu/threads%zu", type, name, unroll_factor, threads);
+        const struct sample_statistics bandwidth_statistics = compute_sample_statistics(iteration_bandwidth, iterations);
+        report_measurement(full_name, bytes, report_unit_gbytes_per_second, &bandwidth_statistics, counters);
+        const struct sample_statistics gflops_statistics = compute_sample_statistics(iteration_gflops, iterations);
+        report_measurement(full_name, bytes, report_unit_gflops, &gflops_statistics, counters);
+    }
+}
+
+void benchmark_threads(enum report_format format, size_t iterations, size_t array_size, size_t max_threads, bool shared_arrays) {
+    struct thread_pool pool = {
+        .threads = max_threads,
+        .shared_arrays = shared_arrays,
+        .array_size = array_size / CACHE_LINE_SIZE * CACHE_LINE_SIZE,
+    };
+    if (shared_arrays) {
+        pool.shared_a = valloc(pool.array_size);
+        pool.shared_b = valloc(pool.array_size);
+        pool.shared_c = valloc(pool.array_size);
+        if (pool.shared_a == NULL || pool.shared_b == NULL || pool.shared_c == NULL) {
+            fprintf(stderr, "Error: failed to allocate memory for %zu-byte arrays\n", pool.array_size);
+            exit(EXIT_FAILURE);
+        }
+    }
+    pthread_barrier_init(&pool.start_barrier, NULL, (unsigned) max_threads + 1);
+    pthread_barrier_init(&pool.end_barrier, NULL, (unsigned) max_threads + 1);
+
+    /* Thread i is pinned to the i-th online processor */
+    const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    struct thread_context* contexts = calloc(max_threads, sizeof(struct thread_context));
+    for (size_t index = 0; index < max_threads; index++) {
+        contexts[index].index = index;
+        contexts[index].pool = &pool;
+        pthread_attr_t attributes;
+        pthread_attr_init(&attributes);
+#if defined(__linux__)
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(index % (size_t) processors, &cpu_set);
+        pthread_attr_setaffinity_np(&attributes, sizeof(cpu_set), &cpu_set);
+#endif
+        if (pthread_create(&contexts[index].thread, &attributes, thread_function, &contexts[index]) != 0) {
+            fprintf(stderr, "Error: failed to create thread %zu\n", index);
+            exit(EXIT_FAILURE);
+        }
+        pthread_attr_destroy(&attributes);
+    }
+
+    double iteration_times[iterations];
+    for (size_t threads = 1; threads <= max_threads; threads++) {
+        /* Bytes read (and written by triad) in one iteration by all active threads */
+        const size_t bytes_per_array = shared_arrays ? pool.array_size : threads * pool.array_size;
+
+        const struct thread_task triad_task = { .active_threads = threads };
+        measure_task(&pool, &triad_task, iterations, iteration_times);
+        const double triad_bandwidth = ((double) (3 * bytes_per_array)) / median_double(iteration_times, iterations);
+        report_scaling("stream", "triad", 1, threads, format, iterations, iteration_times,
+            3 * bytes_per_array, 2 * (bytes_per_array / sizeof(double)), triad_bandwidth);
+
+        /* Dot products are counted as 2 FLOPs per element, whether compensated or not */
+        for (size_t kernel_index = 0; kernel_index < dot_product_kernels_count; kernel_index++) {
+            const struct dot_product_kernel* kernel = &dot_product_kernels[kernel_index];
+            if (!kernel->aligned || kernel->scalar_tail || kernel->prefetch_distance != 0 || kernel->unroll_factor != DOT_PRODUCT_PREFETCH_UNROLL) {
+                continue;
+            }
+            const struct thread_task task = {
+                .dot_product = kernel->dot_product,
+                .compensated_dot_product = kernel->compensated_dot_product,
+                .active_threads = threads,
+            };
+            measure_task(&pool, &task, iterations, iteration_times);
+            report_scaling(kernel->compensated_dot_product != NULL ? "compensated" : "double",
+                kernel->name, kernel->unroll_factor, threads, format, iterations, iteration_times,
+                2 * bytes_per_array, 2 * (bytes_per_array / sizeof(double)), triad_bandwidth);
+        }
+        for (size_t kernel_index = 0; kernel_index < float_dot_product_kernels_count; kernel_index++) {
+            const struct float_dot_product_kernel* kernel = &float_dot_product_kernels[kernel_index];
+            if (!kernel->aligned || kernel->scalar_tail || kernel->prefetch_distance != 0 || kernel->unroll_factor != DOT_PRODUCT_PREFETCH_UNROLL) {
+                continue;
+            }
+            const struct thread_task task = {
+                .compensated_dot_product_f32 = kernel->compensated_dot_product,
+                .active_threads = threads,
+            };
+            measure_task(&pool, &task, iterations, iteration_times);
+            report_scaling("float-float", kernel->name, kernel->unroll_factor, threads, format, iterations, iteration_times,
+                2 * bytes_per_array, 2 * (bytes_per_array / sizeof(float)), triad_bandwidth);
+        }
+    }
+
+    const struct thread_task exit_task = { .exit = true };
+    pool.task = exit_task;
+    pthread_barrier_wait(&pool.start_barrier);
+    for (size_t index = 0; index < max_threads; index++) {
+        pthread_join(contexts[index].thread, NULL);
+    }
+    free(contexts);
+    pthread_barrier_destroy(&pool.start_barrier);
+    pthread_barrier_destroy(&pool.end_barrier);
+    free(pool.shared_a);
+    free(pool.shared_b);
+    free(pool.shared_c);
+}
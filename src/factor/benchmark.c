@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+#include <utils.h>
+#include <arena.h>
+#include <factor/common.h>
+
+
+static doubledouble random_dd(uint64_t state[restrict static 1]) {
+	const double hi = random_uniform(state);
+	const double lo = random_uniform(state);
+	return ddaddl(hi, ldexp(lo, -53));
+}
+
+/* Random matrix for LU, and symmetric diagonally dominant (hence positive definite) matrix for Cholesky */
+static void generate_matrices(size_t n, doubledouble a[restrict static n * n], doubledouble s[restrict static n * n],
+	doubledouble b[restrict static n], uint64_t state[restrict static 1])
+{
+	for (size_t i = 0; i < n * n; i++) {
+		a[i] = random_dd(state);
+	}
+	for (size_t j = 0; j < n; j++) {
+		for (size_t i = j; i < n; i++) {
+			s[i + j * n] = s[j + i * n] = i == j ? ddaddw(random_dd(state), (double) n) : random_dd(state);
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		b[i] = random_dd(state);
+	}
+}
+
+/* max |b - A x| / (|||A|||_inf max |x| n 2**-104), computed in double-double precision */
+static double scaled_residual(size_t n, const doubledouble a[restrict static n * n], const doubledouble b[restrict static n],
+	const doubledouble x[restrict static n])
+{
+	double max_residual = 0.0, max_row_norm = 0.0, max_x = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		doubledouble residual = b[i];
+		double row_norm = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			const doubledouble product = ddmul(a[i + j * n], x[j]);
+			residual = ddadd(residual, (doubledouble) { -product.hi, -product.lo });
+			row_norm += fabs(a[i + j * n].hi);
+		}
+		max_residual = fmax(max_residual, fabs(residual.hi));
+		max_row_norm = fmax(max_row_norm, row_norm);
+		max_x = fmax(max_x, fabs(x[i].hi));
+	}
+	return max_residual / (max_row_norm * max_x * (double) n * 0x1.0p-104);
+}
+
+struct factorization_result {
+	double gflops;
+	double scaled_residual;
+	double counters[perf_counter_count];
+};
+
+static struct factorization_result benchmark_factorization(
+	bool cholesky, const char* name,
+	size_t n, size_t block_size,
+	enum report_format format, size_t iterations,
+	const doubledouble a[restrict static n * n], const doubledouble b[restrict static n],
+	doubledouble factors[restrict static n * n], doubledouble x[restrict static n], size_t pivots[restrict static n],
+	struct arena scratch_arena[restrict static 1])
+{
+	/* 2/3 n**3 flops for LU and 1/3 n**3 flops for Cholesky */
+	const double flops = (cholesky ? 1.0 : 2.0) / 3.0 * (double) n * (double) n * (double) n;
+	double iteration_gflops[iterations];
+	struct perf_counter_values iteration_counters[iterations];
+	bool success = true;
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		memcpy(factors, a, n * n * sizeof(doubledouble));
+		arena_reset(scratch_arena);
+		void* workspace = arena_alloc(scratch_arena, ddfactor_workspace_size(n, block_size));
+
+		perf_counters_start();
+		const double start_time = high_precision_time();
+
+		if (cholesky) {
+			success &= ddcholesky_factor(n, factors, n, block_size, workspace);
+		} else {
+			success &= ddlu_factor(n, factors, n, pivots, block_size, workspace);
+		}
+
+		iteration_gflops[iteration] = flops / (high_precision_time() - start_time);
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	if (!success) {
+		fprintf(stderr, "Error: %s factorization of the generated %zux%zu matrix failed\n", name, n, n);
+		exit(EXIT_FAILURE);
+	}
+	memcpy(x, b, n * sizeof(doubledouble));
+	if (cholesky) {
+		ddcholesky_solve(n, factors, n, x);
+	} else {
+		ddlu_solve(n, factors, n, pivots, x);
+	}
+
+	struct factorization_result result;
+	/* Counters are normalized per matrix element */
+	median_perf_counters(iterations, iteration_counters, (double) (n * n), result.counters);
+	result.gflops = median_double(iteration_gflops, iterations);
+	result.scaled_residual = scaled_residual(n, a, b, x);
+	if (format != report_format_text) {
+		const struct sample_statistics statistics = compute_sample_statistics(iteration_gflops, iterations);
+		report_measurement(name, n, report_unit_gflops, &statistics, result.counters);
+	}
+	return result;
+}
+
+/* n**3 flops for TRSM with n x n A and B, and n**2 flops for TRSV, measured on the well-conditioned triangles of s */
+static void benchmark_triangular_solve(
+	enum ddtriangular_side side, enum ddtriangular_uplo uplo, const char* name,
+	size_t n, size_t block_size,
+	enum report_format format, size_t iterations,
+	const doubledouble s[restrict static n * n], const doubledouble b[restrict static n * n],
+	doubledouble x[restrict static n * n],
+	struct arena scratch_arena[restrict static 1])
+{
+	const double trsm_flops = (double) n * (double) n * (double) n;
+	const double trsv_flops = (double) n * (double) n;
+	double trsm_gflops[iterations], trsv_gflops[iterations];
+	struct perf_counter_values trsm_counters[iterations], trsv_counters[iterations];
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		memcpy(x, b, n * n * sizeof(doubledouble));
+		arena_reset(scratch_arena);
+		void* workspace = arena_alloc(scratch_arena, ddtrsm_workspace_size(n, n, block_size));
+
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		ddtrsm(side, uplo, false, n, n, s, n, x, n, block_size, workspace);
+		trsm_gflops[iteration] = trsm_flops / (high_precision_time() - start_time);
+		perf_counters_stop(&trsm_counters[iteration]);
+	}
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		memcpy(x, b, n * sizeof(doubledouble));
+
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		ddtrsv(side, uplo, false, n, s, n, x);
+		trsv_gflops[iteration] = trsv_flops / (high_precision_time() - start_time);
+		perf_counters_stop(&trsv_counters[iteration]);
+	}
+
+	/* Counters are normalized per element of B */
+	double counters[perf_counter_count];
+	median_perf_counters(iterations, trsm_counters, (double) (n * n), counters);
+	if (format == report_format_text) {
+		printf("%zu\t" "%zu\t" "TRSM %s\t" "%.3lf\t" "%.3lf", n, block_size, name,
+			median_double(trsm_gflops, iterations), median_double(trsv_gflops, iterations));
+		report_text_counters(counters);
+	} else {
+		char measurement_name[64];
+		snprintf(measurement_name, sizeof(measurement_name), "trsm/%s", name);
+		const struct sample_statistics trsm_statistics = compute_sample_statistics(trsm_gflops, iterations);
+		report_measurement(measurement_name, n, report_unit_gflops, &trsm_statistics, counters);
+
+		double trsv_counter_values[perf_counter_count];
+		median_perf_counters(iterations, trsv_counters, (double) n, trsv_counter_values);
+		snprintf(measurement_name, sizeof(measurement_name), "trsv/%s", name);
+		const struct sample_statistics trsv_statistics = compute_sample_statistics(trsv_gflops, iterations);
+		report_measurement(measurement_name, n, report_unit_gflops, &trsv_statistics, trsv_counter_values);
+	}
+}
+
+static bool identical_triangle(size_t n, const doubledouble x[restrict static n * n], const doubledouble y[restrict static n * n]) {
+	for (size_t j = 0; j < n; j++) {
+		for (size_t i = j; i < n; i++) {
+			if (x[i + j * n].hi != y[i + j * n].hi || x[i + j * n].lo != y[i + j * n].lo) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+ * Gram matrix C = A' A of the random n x n matrix a: lower triangle with ddsyrk, with ddsyrk_mixed on the high parts of a,
+ * and the full matrix with ddgemm_blocked. All versions are rated with the n (n + 1) n flops of the triangle.
+ */
+static void benchmark_syrk(size_t n, size_t block_size, enum report_format format, size_t iterations,
+	const doubledouble a[restrict static n * n], double a_double[restrict static n * n],
+	doubledouble c[restrict static n * n], doubledouble c_gemm[restrict static n * n],
+	struct arena scratch_arena[restrict static 1])
+{
+	enum syrk_variant {
+		syrk_variant_dd,
+		syrk_variant_mixed,
+		syrk_variant_gemm,
+		syrk_variant_count,
+	};
+	const char* names[syrk_variant_count] = { "syrk/lower", "syrk/mixed", "syrk/gemm" };
+	for (size_t i = 0; i < n * n; i++) {
+		a_double[i] = a[i].hi;
+	}
+	const double flops = (double) n * (double) (n + 1) * (double) n;
+	double gflops[syrk_variant_count];
+	double counters[perf_counter_count];
+	for (enum syrk_variant variant = 0; variant < syrk_variant_count; variant++) {
+		doubledouble* result = variant == syrk_variant_gemm ? c_gemm : c;
+		double iteration_gflops[iterations];
+		struct perf_counter_values iteration_counters[iterations];
+		for (size_t iteration = 0; iteration < iterations; iteration++) {
+			memset(result, 0, n * n * sizeof(doubledouble));
+			arena_reset(scratch_arena);
+			void* workspace = arena_alloc(scratch_arena, ddsyrk_workspace_size(n, n, block_size));
+
+			perf_counters_start();
+			const double start_time = high_precision_time();
+			switch (variant) {
+				case syrk_variant_dd:
+					ddsyrk(ddtriangular_lower, true, n, n, a, n, result, n, block_size, workspace);
+					break;
+				case syrk_variant_mixed:
+					ddsyrk_mixed(ddtriangular_lower, true, n, n, a_double, n, result, n, block_size, workspace);
+					break;
+				case syrk_variant_gemm:
+				case syrk_variant_count:
+					ddgemm_blocked(true, false, n, n, n, a, n, a, n, result, n, block_size, workspace);
+					break;
+			}
+			iteration_gflops[iteration] = flops / (high_precision_time() - start_time);
+			perf_counters_stop(&iteration_counters[iteration]);
+		}
+
+		/* Counters are normalized per element of the triangle */
+		median_perf_counters(iterations, iteration_counters, 0.5 * (double) (n * (n + 1)), counters);
+		gflops[variant] = median_double(iteration_gflops, iterations);
+		if (format != report_format_text) {
+			const struct sample_statistics statistics = compute_sample_statistics(iteration_gflops, iterations);
+			report_measurement(names[variant], n, report_unit_gflops, &statistics, counters);
+		}
+	}
+
+	/* ddsyrk computes the tiles of the triangle with the same packed panels and micro-kernels as ddgemm_blocked */
+	memset(c, 0, n * n * sizeof(doubledouble));
+	arena_reset(scratch_arena);
+	ddsyrk(ddtriangular_lower, true, n, n, a, n, c, n, block_size, arena_alloc(scratch_arena, ddsyrk_workspace_size(n, n, block_size)));
+	if (!identical_triangle(n, c, c_gemm)) {
+		fprintf(stderr, "Error: SYRK and GEMM results for %zux%zu matrix do not match\n", n, n);
+		exit(EXIT_FAILURE);
+	}
+
+	if (format == report_format_text) {
+		printf("%zu\t" "%zu\t" "SYRK\t" "%.3lf\t" "%.3lf\t" "%.3lf", n, block_size,
+			gflops[syrk_variant_dd], gflops[syrk_variant_mixed], gflops[syrk_variant_gemm]);
+		report_text_counters(counters);
+	}
+}
+
+static void benchmark(size_t n, size_t block_size, enum report_format format, size_t iterations,
+	struct arena scratch_arena[restrict static 1])
+{
+	doubledouble* a = valloc(n * n * sizeof(doubledouble));
+	doubledouble* s = valloc(n * n * sizeof(doubledouble));
+	doubledouble* factors = valloc(n * n * sizeof(doubledouble));
+	doubledouble* products = valloc(n * n * sizeof(doubledouble));
+	double* a_double = valloc(n * n * sizeof(double));
+	doubledouble* b = valloc(n * sizeof(doubledouble));
+	doubledouble* x = valloc(n * sizeof(doubledouble));
+	size_t* pivots = valloc(n * sizeof(size_t));
+	if (a == NULL || s == NULL || factors == NULL || products == NULL || a_double == NULL || b == NULL || x == NULL || pivots == NULL) {
+		fprintf(stderr, "Error: failed to allocate memory for the benchmark\n");
+		exit(EXIT_FAILURE);
+	}
+	uint64_t state = UINT64_C(0x853C49E6748FEA9B) + n;
+	generate_matrices(n, a, s, b, &state);
+
+	/* Unblocked factorizations for reference: a single panel of n columns and no trailing updates */
+	const struct factorization_result lu = benchmark_factorization(false, "lu/blocked",
+		n, block_size, format, iterations, a, b, factors, x, pivots, scratch_arena);
+	const struct factorization_result lu_unblocked = benchmark_factorization(false, "lu/unblocked",
+		n, n, format, iterations, a, b, factors, x, pivots, scratch_arena);
+	const struct factorization_result cholesky = benchmark_factorization(true, "cholesky/blocked",
+		n, block_size, format, iterations, s, b, factors, x, pivots, scratch_arena);
+	const struct factorization_result cholesky_unblocked = benchmark_factorization(true, "cholesky/unblocked",
+		n, n, format, iterations, s, b, factors, x, pivots, scratch_arena);
+
+	if (format == report_format_text) {
+		printf("%zu\t" "%zu\t" "LU\t" "%.3lf\t" "%.3lf\t" "%.2lf\n", n, block_size, lu.gflops, lu_unblocked.gflops, lu.scaled_residual);
+		printf("%zu\t" "%zu\t" "Cholesky\t" "%.3lf\t" "%.3lf\t" "%.2lf",
+			n, block_size, cholesky.gflops, cholesky_unblocked.gflops, cholesky.scaled_residual);
+		report_text_counters(cholesky.counters);
+	} else {
+		const struct sample_statistics lu_residual = compute_sample_statistics((double[1]) { lu.scaled_residual }, 1);
+		report_measurement("lu/blocked/residual", n, report_unit_relative_error, &lu_residual, lu.counters);
+		const struct sample_statistics cholesky_residual = compute_sample_statistics((double[1]) { cholesky.scaled_residual }, 1);
+		report_measurement("cholesky/blocked/residual", n, report_unit_relative_error, &cholesky_residual, cholesky.counters);
+	}
+
+	/* Triangular solves with the triangles of s, and the random matrix a as the right-hand sides */
+	const struct {
+		enum ddtriangular_side side;
+		enum ddtriangular_uplo uplo;
+		const char* name;
+	} triangular_solves[] = {
+		{ ddtriangular_left, ddtriangular_lower, "left-lower" },
+		{ ddtriangular_left, ddtriangular_upper, "left-upper" },
+		{ ddtriangular_right, ddtriangular_lower, "right-lower" },
+		{ ddtriangular_right, ddtriangular_upper, "right-upper" },
+	};
+	for (size_t i = 0; i < sizeof(triangular_solves) / sizeof(triangular_solves[0]); i++) {
+		benchmark_triangular_solve(triangular_solves[i].side, triangular_solves[i].uplo, triangular_solves[i].name,
+			n, block_size, format, iterations, s, a, factors, scratch_arena);
+	}
+
+	benchmark_syrk(n, block_size, format, iterations, a, a_double, factors, products, scratch_arena);
+
+	free(a);
+	free(s);
+	free(factors);
+	free(products);
+	free(a_double);
+	free(b);
+	free(x);
+	free(pivots);
+}
+
+int main(int argc, char *argv[]) {
+	const struct benchmark_options options = parse_options(argc, argv);
+
+	/* Packing buffers for the trailing updates and triangular solves come from a scratch arena, as in ddgemm-bench */
+	struct arena scratch_arena;
+	const size_t max_block_size = options.block_size > options.max_size ? options.block_size : options.max_size;
+	/* The workspace of triangular solves includes the workspace of the trailing updates */
+	if (!arena_init(&scratch_arena, ddtrsm_workspace_size(options.max_size, options.max_size, max_block_size) + ARENA_ALIGNMENT, 0)) {
+		fprintf(stderr, "Error: failed to allocate memory for the benchmark\n");
+		exit(EXIT_FAILURE);
+	}
+
+	perf_counters_open(options.counters);
+	report_begin(options.format, "factor-bench", argc, argv);
+	for (size_t n = 16; n <= options.max_size; n *= 2) {
+		benchmark(n, options.block_size, options.format, options.iterations, &scratch_arena);
+	}
+	report_end();
+	perf_counters_close();
+
+	arena_release(&scratch_arena);
+}
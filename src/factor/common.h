@@ -0,0 +1,29 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <report.h>
+#include <factor/factor.h>
+
+
+struct benchmark_options {
+	size_t iterations;
+	/* The largest matrix size */
+	size_t max_size;
+	/* The number of columns in a panel of the blocked factorizations */
+	size_t block_size;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+};
+
+struct benchmark_options parse_options(int argc, char** argv);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
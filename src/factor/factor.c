@@ -0,0 +1,740 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+
+#include <ddgemm/ddgemm.h>
+#include <ddgemm/pack.h>
+#include <factor/factor.h>
+
+
+/* Micro-kernel for trailing updates: 8x5 and 8x4 are the fastest ddgemm kernels on Haswell */
+#define FACTOR_MR (2 * DDGEMM_MR_STEP)
+#define FACTOR_NR 4
+
+#define WORKSPACE_ALIGNMENT 64
+
+static size_t align_size(size_t size) {
+	return (size + WORKSPACE_ALIGNMENT - 1) / WORKSPACE_ALIGNMENT * WORKSPACE_ALIGNMENT;
+}
+
+static size_t round_up(size_t n, size_t multiple) {
+	return (n + multiple - 1) / multiple * multiple;
+}
+
+/* Workspace of ddgemm_update for m x n matrix C and inner dimension k */
+static size_t update_workspace_size(size_t m, size_t n, size_t k) {
+	return align_size(2 * round_up(m, FACTOR_MR) * k * sizeof(double)) +
+		align_size(round_up(n, FACTOR_NR) * k * sizeof(doubledouble)) +
+		align_size(FACTOR_MR * FACTOR_NR * sizeof(doubledouble));
+}
+
+size_t ddfactor_workspace_size(size_t n, size_t block_size) {
+	const size_t k = block_size < n ? block_size : n;
+	return update_workspace_size(n, n, k);
+}
+
+
+/* Vectorized level-1 operations on contiguous columns */
+
+/* y[i] -= alpha * x[i] */
+static void ddaxpy_minus(size_t m, doubledouble alpha, const doubledouble x[restrict static m], doubledouble y[restrict static m]) {
+	const doubledouble minus_alpha = { -alpha.hi, -alpha.lo };
+	size_t i = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	const __m256dd minus_alpha_vector = _mm256_broadcast_sdd(&minus_alpha);
+	for (; i + 4 <= m; i += 4) {
+		const __m256dd product = _mm256_mul_pdd(minus_alpha_vector, _mm256_loaddeinterleaveu_pdd(&x[i]));
+		_mm256_interleavestoreu_pdd(&y[i], _mm256_add_pdd(_mm256_loaddeinterleaveu_pdd(&y[i]), product));
+	}
+#endif
+	for (; i < m; i++) {
+		y[i] = ddadd(y[i], ddmul(minus_alpha, x[i]));
+	}
+}
+
+/* x[i] /= alpha */
+static void dddiv_scalar(size_t m, doubledouble alpha, doubledouble x[restrict static m]) {
+	size_t i = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	const __m256dd alpha_vector = _mm256_broadcast_sdd(&alpha);
+	for (; i + 4 <= m; i += 4) {
+		_mm256_interleavestoreu_pdd(&x[i], _mm256_div_pdd(_mm256_loaddeinterleaveu_pdd(&x[i]), alpha_vector));
+	}
+#endif
+	for (; i < m; i++) {
+		x[i] = dddiv(x[i], alpha);
+	}
+}
+
+/* sum of x[i] * y[i] */
+static doubledouble dddot(size_t m, const doubledouble x[restrict static m], const doubledouble y[restrict static m]) {
+	doubledouble sum = { 0.0, 0.0 };
+	size_t i = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	__m256dd sum_vector = _mm256_setzero_pdd();
+	for (; i + 4 <= m; i += 4) {
+		sum_vector = _mm256_add_pdd(sum_vector,
+			_mm256_mul_pdd(_mm256_loaddeinterleaveu_pdd(&x[i]), _mm256_loaddeinterleaveu_pdd(&y[i])));
+	}
+	sum = _mm256_reduce_add_pdd(sum_vector);
+#endif
+	for (; i < m; i++) {
+		sum = ddadd(sum, ddmul(x[i], y[i]));
+	}
+	return sum;
+}
+
+
+enum update_triangle {
+	update_full,
+	/* Only the lower triangle of C, including the diagonal, is updated */
+	update_lower,
+	/* Only the upper triangle of C, including the diagonal, is updated */
+	update_upper,
+};
+
+/*
+ * Range [start, end) of the groups of group_size rows of a tile column which intersect the lower (or upper) triangle.
+ * offset is the index of the column in the matrix minus the index of the first row of the tile.
+ */
+static void triangle_groups(bool lower, ptrdiff_t offset, size_t group_size, size_t groups,
+	size_t start[restrict static 1], size_t end[restrict static 1])
+{
+	if (lower) {
+		/* Group v intersects the lower triangle if its last row, group_size * v + group_size - 1, is not above the diagonal */
+		const size_t first = offset > 0 ? (size_t) offset / group_size : 0;
+		*start = first < groups ? first : groups;
+		*end = groups;
+	} else {
+		/* Group v intersects the upper triangle if its first row, group_size * v, is not below the diagonal */
+		const size_t last = offset >= 0 ? (size_t) offset / group_size + 1 : 0;
+		*start = 0;
+		*end = last < groups ? last : groups;
+	}
+}
+
+/*
+ * Triangular micro-kernel for the tiles of a triangular update which intersect the diagonal.
+ * Computes c += A B for a FACTOR_MR x nr tile from the panels packed for the ddgemm kernels, but only for the groups of
+ * DDGEMM_MR_STEP rows of each column which intersect the triangle; the other rows of the tile are left unchanged.
+ * offset is the index of the first column of the tile minus the index of its first row.
+ */
+static void ddgemm_diagonal_kernel(size_t k, size_t nr, ptrdiff_t offset, bool lower,
+	const double a[restrict static 2 * FACTOR_MR * k],
+	const doubledouble b[restrict static nr * k],
+	doubledouble c[restrict static FACTOR_MR * FACTOR_NR])
+{
+	enum { groups = FACTOR_MR / DDGEMM_MR_STEP };
+	size_t group_start[FACTOR_NR], group_end[FACTOR_NR];
+	for (size_t jj = 0; jj < nr; jj++) {
+		triangle_groups(lower, offset + (ptrdiff_t) jj, DDGEMM_MR_STEP, groups, &group_start[jj], &group_end[jj]);
+	}
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	__m256dd sum[FACTOR_NR][groups];
+	for (size_t jj = 0; jj < nr; jj++) {
+		for (size_t v = 0; v < groups; v++) {
+			sum[jj][v] = _mm256_setzero_pdd();
+		}
+	}
+	for (size_t kk = 0; kk < k; kk++) {
+		const double* a_kk = &a[2 * kk * FACTOR_MR];
+		for (size_t jj = 0; jj < nr; jj++) {
+			const __m256dd vb = _mm256_broadcast_sdd(&b[kk * nr + jj]);
+			for (size_t v = group_start[jj]; v < group_end[jj]; v++) {
+				const __m256dd va = {
+					_mm256_load_pd(a_kk + 2 * DDGEMM_MR_STEP * v),
+					_mm256_load_pd(a_kk + 2 * DDGEMM_MR_STEP * v + DDGEMM_MR_STEP)
+				};
+				sum[jj][v] = _mm256_add_pdd(sum[jj][v], _mm256_mul_pdd(va, vb));
+			}
+		}
+	}
+	for (size_t jj = 0; jj < nr; jj++) {
+		for (size_t v = group_start[jj]; v < group_end[jj]; v++) {
+			doubledouble* c_group = &c[jj * FACTOR_MR + DDGEMM_MR_STEP * v];
+			_mm256_interleavestore_pdd(c_group, _mm256_add_pdd(_mm256_loaddeinterleave_pdd(c_group), sum[jj][v]));
+		}
+	}
+#else
+	for (size_t jj = 0; jj < nr; jj++) {
+		for (size_t ii = DDGEMM_MR_STEP * group_start[jj]; ii < DDGEMM_MR_STEP * group_end[jj]; ii++) {
+			const size_t a_offset = 2 * DDGEMM_MR_STEP * (ii / DDGEMM_MR_STEP) + ii % DDGEMM_MR_STEP;
+			doubledouble sum = { 0.0, 0.0 };
+			for (size_t kk = 0; kk < k; kk++) {
+				const double* a_kk = &a[2 * kk * FACTOR_MR + a_offset];
+				const doubledouble a_element = { a_kk[0], a_kk[DDGEMM_MR_STEP] };
+				sum = ddadd(sum, ddmul(a_element, b[kk * nr + jj]));
+			}
+			c[jj * FACTOR_MR + ii] = ddadd(c[jj * FACTOR_MR + ii], sum);
+		}
+	}
+#endif
+}
+
+/*
+ * Update C += alpha A B with ddgemm micro-kernels
+ *
+ * A is an m x k matrix, stored as a[i + kk * lda], or, if transpose_a, as a[kk + i * lda].
+ * B is a k x n matrix, stored as b[kk + j * ldb], or, if transpose_b, as b[j + kk * ldb]
+ * (then A B' is computed, as in the Cholesky update A22 -= L21 L21').
+ * alpha must be 1 or -1, so that A can be scaled exactly during packing. Trailing updates use alpha = -1.
+ * In a triangular update C is square, and only the tiles of C which intersect the triangle are computed:
+ * tiles on the diagonal are computed with a triangular micro-kernel, which skips the groups of rows outside of the triangle,
+ * and only their elements in the triangle are stored back.
+ */
+static void ddgemm_update(size_t m, size_t n, size_t k, double alpha,
+	const doubledouble a[restrict], size_t lda, bool transpose_a,
+	const doubledouble b[restrict], size_t ldb, bool transpose_b,
+	doubledouble c[restrict], size_t ldc, enum update_triangle triangle,
+	void* workspace)
+{
+	if (m == 0 || n == 0 || k == 0) {
+		return;
+	}
+	const size_t m_padded = round_up(m, FACTOR_MR);
+	char* workspace_bytes = workspace;
+	double* packed_a = (double*) workspace_bytes;
+	workspace_bytes += align_size(2 * m_padded * k * sizeof(double));
+	doubledouble* packed_b = (doubledouble*) workspace_bytes;
+	workspace_bytes += align_size(round_up(n, FACTOR_NR) * k * sizeof(doubledouble));
+	doubledouble* c_tile = (doubledouble*) workspace_bytes;
+
+	/* Pack all row panels of A; rows of the last panel beyond m are zero */
+	for (size_t i = 0; i < m_padded; i += FACTOR_MR) {
+		double* panel = packed_a + 2 * i * k;
+		if (i + FACTOR_MR <= m && !transpose_a) {
+			ddgemm_pack_a(FACTOR_MR, DDGEMM_MR_STEP, k, &a[i], lda, panel);
+		} else {
+			memset(panel, 0, 2 * FACTOR_MR * k * sizeof(double));
+			for (size_t kk = 0; kk < k; kk++) {
+				for (size_t ii = 0; ii < FACTOR_MR && i + ii < m; ii++) {
+					const doubledouble element = transpose_a ? a[kk + (i + ii) * lda] : a[i + ii + kk * lda];
+					double* group = panel + 2 * kk * FACTOR_MR + (ii / DDGEMM_MR_STEP) * (2 * DDGEMM_MR_STEP);
+					group[ii % DDGEMM_MR_STEP] = element.hi;
+					group[DDGEMM_MR_STEP + ii % DDGEMM_MR_STEP] = element.lo;
+				}
+			}
+		}
+	}
+	if (alpha != 1.0) {
+		for (size_t i = 0; i < 2 * m_padded * k; i++) {
+			packed_a[i] *= alpha;
+		}
+	}
+
+	/* Pack all column panels of B; the last panel may be narrower and uses a kernel with smaller nr */
+	for (size_t j = 0; j < n; j += FACTOR_NR) {
+		const size_t nr = n - j < FACTOR_NR ? n - j : FACTOR_NR;
+		doubledouble* panel = packed_b + j * k;
+		if (transpose_b) {
+			for (size_t kk = 0; kk < k; kk++) {
+				for (size_t jj = 0; jj < nr; jj++) {
+					panel[kk * nr + jj] = b[j + jj + kk * ldb];
+				}
+			}
+		} else {
+			ddgemm_pack_b(nr, k, &b[j * ldb], ldb, panel);
+		}
+	}
+
+	for (size_t j = 0; j < n; j += FACTOR_NR) {
+		const size_t nr = n - j < FACTOR_NR ? n - j : FACTOR_NR;
+		const ddgemm_function kernel = select_ddgemm_kernel(FACTOR_MR, nr);
+		/* Tiles entirely above the diagonal are skipped in the lower-triangular update, and below it in the upper-triangular update */
+		const size_t i_start = triangle == update_lower ? j / FACTOR_MR * FACTOR_MR : 0;
+		const size_t i_end = triangle == update_upper && j + nr < m ? j + nr : m;
+		for (size_t i = i_start; i < i_end; i += FACTOR_MR) {
+			const size_t mr = m - i < FACTOR_MR ? m - i : FACTOR_MR;
+			for (size_t jj = 0; jj < nr; jj++) {
+				memcpy(&c_tile[jj * FACTOR_MR], &c[i + (j + jj) * ldc], mr * sizeof(doubledouble));
+				memset(&c_tile[jj * FACTOR_MR + mr], 0, (FACTOR_MR - mr) * sizeof(doubledouble));
+			}
+			/* Tiles with elements on both sides of the diagonal use the triangular kernel */
+			if ((triangle == update_lower && j + nr > i + 1) || (triangle == update_upper && i + mr > j + 1)) {
+				ddgemm_diagonal_kernel(k, nr, (ptrdiff_t) j - (ptrdiff_t) i, triangle == update_lower,
+					packed_a + 2 * i * k, packed_b + j * k, c_tile);
+			} else {
+				kernel(k, packed_a + 2 * i * k, packed_b + j * k, c_tile);
+			}
+			for (size_t jj = 0; jj < nr; jj++) {
+				/* In a triangular update, rows of column j + jj outside of the triangle are not stored back */
+				size_t ii_start = 0, ii_end = mr;
+				if (triangle == update_lower && j + jj > i) {
+					ii_start = j + jj - i;
+				} else if (triangle == update_upper && j + jj + 1 < i + mr) {
+					ii_end = j + jj + 1 > i ? j + jj + 1 - i : 0;
+				}
+				if (ii_start < ii_end) {
+					memcpy(&c[i + ii_start + (j + jj) * ldc], &c_tile[jj * FACTOR_MR + ii_start], (ii_end - ii_start) * sizeof(doubledouble));
+				}
+			}
+		}
+	}
+}
+
+
+static void swap_rows(size_t n, doubledouble a[restrict], size_t lda, size_t row0, size_t row1) {
+	for (size_t j = 0; j < n; j++) {
+		const doubledouble t = a[row0 + j * lda];
+		a[row0 + j * lda] = a[row1 + j * lda];
+		a[row1 + j * lda] = t;
+	}
+}
+
+bool ddlu_factor(size_t n, doubledouble a[restrict], size_t lda, size_t pivots[restrict static n],
+	size_t block_size, void* restrict workspace)
+{
+	for (size_t k = 0; k < n; k += block_size) {
+		const size_t kb = n - k < block_size ? n - k : block_size;
+
+		/* Unblocked LU of the panel of columns k...k+kb-1, with row interchanges applied to the whole matrix */
+		for (size_t p = k; p < k + kb; p++) {
+			doubledouble* column_p = &a[p * lda];
+			/* The high part decides the magnitude of a normalized double-double number */
+			size_t pivot = p;
+			for (size_t i = p + 1; i < n; i++) {
+				if (fabs(column_p[i].hi) > fabs(column_p[pivot].hi)) {
+					pivot = i;
+				}
+			}
+			pivots[p] = pivot;
+			if (column_p[pivot].hi == 0.0) {
+				return false;
+			}
+			if (pivot != p) {
+				swap_rows(n, a, lda, p, pivot);
+			}
+			dddiv_scalar(n - p - 1, column_p[p], &column_p[p + 1]);
+			for (size_t q = p + 1; q < k + kb; q++) {
+				ddaxpy_minus(n - p - 1, a[p + q * lda], &column_p[p + 1], &a[p + 1 + q * lda]);
+			}
+		}
+
+		/* U12 = inv(L11) A12 */
+		for (size_t j = k + kb; j < n; j++) {
+			for (size_t p = k; p < k + kb; p++) {
+				ddaxpy_minus(k + kb - p - 1, a[p + j * lda], &a[p + 1 + p * lda], &a[p + 1 + j * lda]);
+			}
+		}
+
+		/* A22 -= L21 U12 */
+		const size_t m = n - k - kb;
+		ddgemm_update(m, m, kb, -1.0,
+			&a[(k + kb) + k * lda], lda, false,
+			&a[k + (k + kb) * lda], lda, false,
+			&a[(k + kb) + (k + kb) * lda], lda, update_full,
+			workspace);
+	}
+	return true;
+}
+
+void ddlu_solve(size_t n, const doubledouble lu[restrict], size_t lda, const size_t pivots[restrict static n],
+	doubledouble b[restrict static n])
+{
+	for (size_t p = 0; p < n; p++) {
+		const doubledouble t = b[p];
+		b[p] = b[pivots[p]];
+		b[pivots[p]] = t;
+	}
+	/* L y = P b, then U x = y */
+	ddtrsv(ddtriangular_left, ddtriangular_lower, true, n, lu, lda, b);
+	ddtrsv(ddtriangular_left, ddtriangular_upper, false, n, lu, lda, b);
+}
+
+bool ddcholesky_factor(size_t n, doubledouble a[restrict], size_t lda,
+	size_t block_size, void* restrict workspace)
+{
+	for (size_t k = 0; k < n; k += block_size) {
+		const size_t kb = n - k < block_size ? n - k : block_size;
+
+		/* Unblocked Cholesky of the diagonal block, and L21 = A21 inv(L11') for the columns k...k+kb-1 */
+		for (size_t p = k; p < k + kb; p++) {
+			doubledouble* column_p = &a[p * lda];
+			/* Also rejects NaN */
+			if (!(column_p[p].hi > 0.0)) {
+				return false;
+			}
+			column_p[p] = ddsqrt(column_p[p]);
+			dddiv_scalar(n - p - 1, column_p[p], &column_p[p + 1]);
+			for (size_t q = p + 1; q < k + kb; q++) {
+				ddaxpy_minus(n - q, column_p[q], &column_p[q], &a[q + q * lda]);
+			}
+		}
+
+		/* A22 -= L21 L21', lower triangle only */
+		const size_t m = n - k - kb;
+		ddgemm_update(m, m, kb, -1.0,
+			&a[(k + kb) + k * lda], lda, false,
+			&a[(k + kb) + k * lda], lda, true,
+			&a[(k + kb) + (k + kb) * lda], lda, update_lower,
+			workspace);
+	}
+	return true;
+}
+
+void ddcholesky_solve(size_t n, const doubledouble l[restrict], size_t lda,
+	doubledouble b[restrict static n])
+{
+	/* L y = b, then L' x = y, which is x' L = y' */
+	ddtrsv(ddtriangular_left, ddtriangular_lower, false, n, l, lda, b);
+	ddtrsv(ddtriangular_right, ddtriangular_lower, false, n, l, lda, b);
+}
+
+void ddtrsv(enum ddtriangular_side side, enum ddtriangular_uplo uplo, bool unit_diagonal,
+	size_t n, const doubledouble a[restrict], size_t lda, doubledouble x[restrict static n])
+{
+	if (side == ddtriangular_left) {
+		/* Column-oriented substitution: subtract each solved component times its column from the rest of x */
+		if (uplo == ddtriangular_lower) {
+			for (size_t p = 0; p < n; p++) {
+				if (!unit_diagonal) {
+					x[p] = dddiv(x[p], a[p + p * lda]);
+				}
+				ddaxpy_minus(n - p - 1, x[p], &a[p + 1 + p * lda], &x[p + 1]);
+			}
+		} else {
+			for (size_t p = n; p-- != 0;) {
+				if (!unit_diagonal) {
+					x[p] = dddiv(x[p], a[p + p * lda]);
+				}
+				ddaxpy_minus(p, x[p], &a[p * lda], x);
+			}
+		}
+	} else {
+		/* Row-oriented substitution on A': row p of A' is column p of A, and is contiguous */
+		if (uplo == ddtriangular_lower) {
+			for (size_t p = n; p-- != 0;) {
+				const doubledouble sum = dddot(n - p - 1, &a[p + 1 + p * lda], &x[p + 1]);
+				x[p] = ddadd(x[p], (doubledouble) { -sum.hi, -sum.lo });
+				if (!unit_diagonal) {
+					x[p] = dddiv(x[p], a[p + p * lda]);
+				}
+			}
+		} else {
+			for (size_t p = 0; p < n; p++) {
+				const doubledouble sum = dddot(p, &a[p * lda], x);
+				x[p] = ddadd(x[p], (doubledouble) { -sum.hi, -sum.lo });
+				if (!unit_diagonal) {
+					x[p] = dddiv(x[p], a[p + p * lda]);
+				}
+			}
+		}
+	}
+}
+
+size_t ddtrsm_workspace_size(size_t m, size_t n, size_t block_size) {
+	const size_t d = m > n ? m : n;
+	const size_t k = block_size < d ? block_size : d;
+	return ddfactor_workspace_size(d, block_size) +
+		align_size(k * k * sizeof(doubledouble)) +
+		align_size(d * k * sizeof(doubledouble));
+}
+
+/* -inv(A), for a kb x kb triangular diagonal block of A, as a full column-major matrix with leading dimension kb */
+static void invert_diagonal_block(enum ddtriangular_uplo uplo, bool unit_diagonal,
+	size_t kb, const doubledouble a[restrict], size_t lda,
+	doubledouble minus_inverse[restrict static kb * kb])
+{
+	memset(minus_inverse, 0, kb * kb * sizeof(doubledouble));
+	for (size_t j = 0; j < kb; j++) {
+		/* Column j of the inverse solves A y = e_j, and is zero above (lower) or below (upper) row j */
+		doubledouble* column = &minus_inverse[j * kb];
+		column[j] = (doubledouble) { 1.0, 0.0 };
+		if (uplo == ddtriangular_lower) {
+			ddtrsv(ddtriangular_left, uplo, unit_diagonal, kb - j, &a[j + j * lda], lda, &column[j]);
+		} else {
+			ddtrsv(ddtriangular_left, uplo, unit_diagonal, j + 1, a, lda, column);
+		}
+	}
+	for (size_t i = 0; i < kb * kb; i++) {
+		minus_inverse[i] = (doubledouble) { -minus_inverse[i].hi, -minus_inverse[i].lo };
+	}
+}
+
+void ddtrsm(enum ddtriangular_side side, enum ddtriangular_uplo uplo, bool unit_diagonal,
+	size_t m, size_t n, const doubledouble a[restrict], size_t lda, doubledouble b[restrict], size_t ldb,
+	size_t block_size, void* restrict workspace)
+{
+	if (m == 0 || n == 0) {
+		return;
+	}
+	const size_t d = m > n ? m : n;
+	const size_t k_max = block_size < d ? block_size : d;
+	char* workspace_bytes = workspace;
+	void* update_workspace = workspace_bytes;
+	workspace_bytes += ddfactor_workspace_size(d, block_size);
+	doubledouble* minus_inverse = (doubledouble*) workspace_bytes;
+	workspace_bytes += align_size(k_max * k_max * sizeof(doubledouble));
+	doubledouble* b_block = (doubledouble*) workspace_bytes;
+
+	/* Diagonal blocks of A are processed from the top-left corner for left lower and right upper solves, and from the bottom-right corner otherwise */
+	const size_t size = side == ddtriangular_left ? m : n;
+	const bool forward = (side == ddtriangular_left) == (uplo == ddtriangular_lower);
+	for (size_t step = 0; step < size; step += block_size) {
+		const size_t kb = size - step < block_size ? size - step : block_size;
+		const size_t k = forward ? step : size - step - kb;
+		invert_diagonal_block(uplo, unit_diagonal, kb, &a[k + k * lda], lda, minus_inverse);
+
+		if (side == ddtriangular_left) {
+			/* X_k = inv(A_kk) B_k: B_k is moved to the workspace and overwritten by the product */
+			for (size_t j = 0; j < n; j++) {
+				memcpy(&b_block[j * kb], &b[k + j * ldb], kb * sizeof(doubledouble));
+				memset(&b[k + j * ldb], 0, kb * sizeof(doubledouble));
+			}
+			ddgemm_update(kb, n, kb, -1.0, minus_inverse, kb, false, b_block, kb, false, &b[k], ldb, update_full, update_workspace);
+
+			/* B_i -= A_ik X_k for the blocks of B which are not solved yet */
+			if (forward) {
+				ddgemm_update(m - k - kb, n, kb, -1.0, &a[k + kb + k * lda], lda, false, &b[k], ldb, false,
+					&b[k + kb], ldb, update_full, update_workspace);
+			} else {
+				ddgemm_update(k, n, kb, -1.0, &a[k * lda], lda, false, &b[k], ldb, false, b, ldb, update_full, update_workspace);
+			}
+		} else {
+			/* X_k = B_k inv(A_kk) for the block of columns k...k+kb-1 */
+			for (size_t j = 0; j < kb; j++) {
+				memcpy(&b_block[j * m], &b[(k + j) * ldb], m * sizeof(doubledouble));
+				memset(&b[(k + j) * ldb], 0, m * sizeof(doubledouble));
+			}
+			ddgemm_update(m, kb, kb, -1.0, b_block, m, false, minus_inverse, kb, false, &b[k * ldb], ldb, update_full, update_workspace);
+
+			/* B_j -= X_k A_kj for the blocks of columns of B which are not solved yet */
+			if (forward) {
+				ddgemm_update(m, n - k - kb, kb, -1.0, &b[k * ldb], ldb, false, &a[k + (k + kb) * lda], lda, false,
+					&b[(k + kb) * ldb], ldb, update_full, update_workspace);
+			} else {
+				ddgemm_update(m, k, kb, -1.0, &b[k * ldb], ldb, false, &a[k], lda, false, b, ldb, update_full, update_workspace);
+			}
+		}
+	}
+}
+
+size_t ddgemm_blocked_workspace_size(size_t m, size_t n, size_t k, size_t block_size) {
+	return update_workspace_size(m, n, block_size < k ? block_size : k);
+}
+
+void ddgemm_blocked(bool transpose_a, bool transpose_b, size_t m, size_t n, size_t k,
+	const doubledouble a[restrict], size_t lda, const doubledouble b[restrict], size_t ldb,
+	doubledouble c[restrict], size_t ldc, size_t block_size, void* restrict workspace)
+{
+	for (size_t p = 0; p < k; p += block_size) {
+		const size_t kb = k - p < block_size ? k - p : block_size;
+		ddgemm_update(m, n, kb, 1.0,
+			transpose_a ? &a[p] : &a[p * lda], lda, transpose_a,
+			transpose_b ? &b[p * ldb] : &b[p], ldb, transpose_b,
+			c, ldc, update_full, workspace);
+	}
+}
+
+
+void ddsyrk(enum ddtriangular_uplo uplo, bool transpose, size_t n, size_t k,
+	const doubledouble a[restrict], size_t lda, doubledouble c[restrict], size_t ldc,
+	size_t block_size, void* restrict workspace)
+{
+	const enum update_triangle triangle = uplo == ddtriangular_lower ? update_lower : update_upper;
+	for (size_t p = 0; p < k; p += block_size) {
+		const size_t kb = k - p < block_size ? k - p : block_size;
+		if (transpose) {
+			/* C += A' A: the block of columns p...p+kb-1 of A' is the block of rows p...p+kb-1 of A */
+			ddgemm_update(n, n, kb, 1.0, &a[p], lda, true, &a[p], lda, false, c, ldc, triangle, workspace);
+		} else {
+			/* C += A A' */
+			ddgemm_update(n, n, kb, 1.0, &a[p * lda], lda, false, &a[p * lda], lda, true, c, ldc, triangle, workspace);
+		}
+	}
+}
+
+
+/*
+ * Micro-kernel of the mixed-precision SYRK: products of doubles are exact double-double numbers, so the tile
+ * accumulates them with error-free multiplication and compensated summation, without double-double multiplications.
+ * The panels hold MIXED_MR and MIXED_NR doubles for each kk, and the normalized sums overwrite the column-major tile.
+ */
+/* 8x3 tiles keep 12 accumulator registers with AVX, and are faster than 8x2 and 8x4 on Haswell */
+#define MIXED_MR 8
+#define MIXED_NR 3
+
+size_t ddsyrk_workspace_size(size_t n, size_t k, size_t block_size) {
+	const size_t k_max = block_size < k ? block_size : k;
+	const size_t mixed_size = align_size(round_up(n, MIXED_MR) * k_max * sizeof(double)) +
+		align_size(round_up(n, MIXED_NR) * k_max * sizeof(double)) +
+		align_size(MIXED_MR * MIXED_NR * sizeof(doubledouble));
+	const size_t size = update_workspace_size(n, n, k_max);
+	return size > mixed_size ? size : mixed_size;
+}
+
+static void dsyrk_kernel(size_t k,
+	const double a[restrict static MIXED_MR * k],
+	const double b[restrict static MIXED_NR * k],
+	doubledouble tile[restrict static MIXED_MR * MIXED_NR])
+{
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	__m256dd sum[MIXED_NR][MIXED_MR / 4];
+	for (size_t jj = 0; jj < MIXED_NR; jj++) {
+		for (size_t v = 0; v < MIXED_MR / 4; v++) {
+			sum[jj][v] = _mm256_setzero_pdd();
+		}
+	}
+	for (size_t kk = 0; kk < k; kk++) {
+		__m256d va[MIXED_MR / 4];
+		for (size_t v = 0; v < MIXED_MR / 4; v++) {
+			va[v] = _mm256_load_pd(&a[kk * MIXED_MR + 4 * v]);
+		}
+		for (size_t jj = 0; jj < MIXED_NR; jj++) {
+			const __m256d vb = _mm256_broadcast_sd(&b[kk * MIXED_NR + jj]);
+			for (size_t v = 0; v < MIXED_MR / 4; v++) {
+				__m256d product_error, sum_error;
+				const __m256d product = _mm256_efmul_pd(va[v], vb, &product_error);
+				sum[jj][v].hi = _mm256_efadd_pd(sum[jj][v].hi, product, &sum_error);
+				sum[jj][v].lo = _mm256_add_pd(sum[jj][v].lo, _mm256_add_pd(sum_error, product_error));
+			}
+		}
+	}
+	for (size_t jj = 0; jj < MIXED_NR; jj++) {
+		for (size_t v = 0; v < MIXED_MR / 4; v++) {
+			sum[jj][v].hi = _mm256_efaddord_pd(sum[jj][v].hi, sum[jj][v].lo, &sum[jj][v].lo);
+			_mm256_interleavestore_pdd(&tile[jj * MIXED_MR + 4 * v], sum[jj][v]);
+		}
+	}
+#else
+	for (size_t jj = 0; jj < MIXED_NR; jj++) {
+		for (size_t ii = 0; ii < MIXED_MR; ii++) {
+			doubledouble sum = { 0.0, 0.0 };
+			for (size_t kk = 0; kk < k; kk++) {
+				double product_error, sum_error;
+				const double product = efmul(a[kk * MIXED_MR + ii], b[kk * MIXED_NR + jj], &product_error);
+				sum.hi = efadd(sum.hi, product, &sum_error);
+				sum.lo += sum_error + product_error;
+			}
+			sum.hi = efaddord(sum.hi, sum.lo, &sum.lo);
+			tile[jj * MIXED_MR + ii] = sum;
+		}
+	}
+#endif
+}
+
+/*
+ * Triangular variant of dsyrk_kernel for the tiles which intersect the diagonal: only the groups of 4 rows of each column
+ * which intersect the triangle are computed, and the other elements of the tile are left undefined.
+ * offset is the index of the first column of the tile minus the index of its first row.
+ */
+static void dsyrk_diagonal_kernel(size_t k, ptrdiff_t offset, bool lower,
+	const double a[restrict static MIXED_MR * k],
+	const double b[restrict static MIXED_NR * k],
+	doubledouble tile[restrict static MIXED_MR * MIXED_NR])
+{
+	size_t group_start[MIXED_NR], group_end[MIXED_NR];
+	for (size_t jj = 0; jj < MIXED_NR; jj++) {
+		triangle_groups(lower, offset + (ptrdiff_t) jj, 4, MIXED_MR / 4, &group_start[jj], &group_end[jj]);
+	}
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	__m256dd sum[MIXED_NR][MIXED_MR / 4];
+	for (size_t jj = 0; jj < MIXED_NR; jj++) {
+		for (size_t v = 0; v < MIXED_MR / 4; v++) {
+			sum[jj][v] = _mm256_setzero_pdd();
+		}
+	}
+	for (size_t kk = 0; kk < k; kk++) {
+		for (size_t jj = 0; jj < MIXED_NR; jj++) {
+			const __m256d vb = _mm256_broadcast_sd(&b[kk * MIXED_NR + jj]);
+			for (size_t v = group_start[jj]; v < group_end[jj]; v++) {
+				__m256d product_error, sum_error;
+				const __m256d product = _mm256_efmul_pd(_mm256_load_pd(&a[kk * MIXED_MR + 4 * v]), vb, &product_error);
+				sum[jj][v].hi = _mm256_efadd_pd(sum[jj][v].hi, product, &sum_error);
+				sum[jj][v].lo = _mm256_add_pd(sum[jj][v].lo, _mm256_add_pd(sum_error, product_error));
+			}
+		}
+	}
+	for (size_t jj = 0; jj < MIXED_NR; jj++) {
+		for (size_t v = group_start[jj]; v < group_end[jj]; v++) {
+			sum[jj][v].hi = _mm256_efaddord_pd(sum[jj][v].hi, sum[jj][v].lo, &sum[jj][v].lo);
+			_mm256_interleavestore_pdd(&tile[jj * MIXED_MR + 4 * v], sum[jj][v]);
+		}
+	}
+#else
+	for (size_t jj = 0; jj < MIXED_NR; jj++) {
+		for (size_t ii = 4 * group_start[jj]; ii < 4 * group_end[jj]; ii++) {
+			doubledouble sum = { 0.0, 0.0 };
+			for (size_t kk = 0; kk < k; kk++) {
+				double product_error, sum_error;
+				const double product = efmul(a[kk * MIXED_MR + ii], b[kk * MIXED_NR + jj], &product_error);
+				sum.hi = efadd(sum.hi, product, &sum_error);
+				sum.lo += sum_error + product_error;
+			}
+			sum.hi = efaddord(sum.hi, sum.lo, &sum.lo);
+			tile[jj * MIXED_MR + ii] = sum;
+		}
+	}
+#endif
+}
+
+/* Packs rows row...row+rows-1 of the n x k matrix A (A' if transpose) for kk = 0...k-1, padded with zeros to width rows */
+static void pack_mixed_panel(size_t width, size_t rows, size_t k, const double a[restrict], size_t lda, bool transpose,
+	double panel[restrict static width * k])
+{
+	for (size_t kk = 0; kk < k; kk++) {
+		for (size_t ii = 0; ii < width; ii++) {
+			panel[kk * width + ii] = ii < rows ? (transpose ? a[kk + ii * lda] : a[ii + kk * lda]) : 0.0;
+		}
+	}
+}
+
+void ddsyrk_mixed(enum ddtriangular_uplo uplo, bool transpose, size_t n, size_t k,
+	const double a[restrict], size_t lda, doubledouble c[restrict], size_t ldc,
+	size_t block_size, void* restrict workspace)
+{
+	if (n == 0 || k == 0) {
+		return;
+	}
+	const size_t k_max = block_size < k ? block_size : k;
+	char* workspace_bytes = workspace;
+	double* packed_a = (double*) workspace_bytes;
+	workspace_bytes += align_size(round_up(n, MIXED_MR) * k_max * sizeof(double));
+	double* packed_b = (double*) workspace_bytes;
+	workspace_bytes += align_size(round_up(n, MIXED_NR) * k_max * sizeof(double));
+	doubledouble* tile = (doubledouble*) workspace_bytes;
+
+	for (size_t p = 0; p < k; p += block_size) {
+		const size_t kb = k - p < block_size ? k - p : block_size;
+		/* Element (i, kk) of the block of A, or of A' if transpose, starts at a_block + i * row_stride */
+		const double* a_block = transpose ? &a[p] : &a[p * lda];
+		const size_t row_stride = transpose ? lda : 1;
+		for (size_t i = 0; i < n; i += MIXED_MR) {
+			const size_t mr = n - i < MIXED_MR ? n - i : MIXED_MR;
+			pack_mixed_panel(MIXED_MR, mr, kb, a_block + i * row_stride, lda, transpose, packed_a + i * kb);
+		}
+		for (size_t j = 0; j < n; j += MIXED_NR) {
+			const size_t nr = n - j < MIXED_NR ? n - j : MIXED_NR;
+			pack_mixed_panel(MIXED_NR, nr, kb, a_block + j * row_stride, lda, transpose, packed_b + j * kb);
+		}
+
+		for (size_t j = 0; j < n; j += MIXED_NR) {
+			const size_t nr = n - j < MIXED_NR ? n - j : MIXED_NR;
+			/* Only the tiles which intersect the triangle are computed, as in ddsyrk */
+			const size_t i_start = uplo == ddtriangular_lower ? j / MIXED_MR * MIXED_MR : 0;
+			const size_t i_end = uplo == ddtriangular_upper && j + nr < n ? j + nr : n;
+			for (size_t i = i_start; i < i_end; i += MIXED_MR) {
+				const size_t mr = n - i < MIXED_MR ? n - i : MIXED_MR;
+				if ((uplo == ddtriangular_lower && j + nr > i + 1) || (uplo == ddtriangular_upper && i + mr > j + 1)) {
+					dsyrk_diagonal_kernel(kb, (ptrdiff_t) j - (ptrdiff_t) i, uplo == ddtriangular_lower,
+						packed_a + i * kb, packed_b + j * kb, tile);
+				} else {
+					dsyrk_kernel(kb, packed_a + i * kb, packed_b + j * kb, tile);
+				}
+				for (size_t jj = 0; jj < nr; jj++) {
+					size_t ii_start = 0, ii_end = mr;
+					if (uplo == ddtriangular_lower && j + jj > i) {
+						ii_start = j + jj - i;
+					} else if (uplo == ddtriangular_upper && j + jj + 1 < i + mr) {
+						ii_end = j + jj + 1 > i ? j + jj + 1 - i : 0;
+					}
+					for (size_t ii = ii_start; ii < ii_end; ii++) {
+						doubledouble* element = &c[i + ii + (j + jj) * ldc];
+						*element = ddadd(*element, tile[jj * MIXED_MR + ii]);
+					}
+				}
+			}
+		}
+	}
+}
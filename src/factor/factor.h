@@ -0,0 +1,130 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Blocked factorizations in double-double precision. Matrices are stored in column-major order, as in LAPACK
+ * and the ddgemm packing routines: a[i + j * lda] is the element in row i and column j.
+ *
+ * Each step factors a panel of block_size columns with vectorized unblocked code, and updates the trailing matrix
+ * with the generated ddgemm micro-kernels on packed panels. The workspace holds the packed panels,
+ * and must be aligned on 64 bytes.
+ */
+
+/**
+ * @brief Size, in bytes, of the workspace for the factorizations of matrices up to n x n with the given block size
+ */
+size_t ddfactor_workspace_size(size_t n, size_t block_size);
+
+/**
+ * @brief Right-looking blocked LU factorization with partial pivoting, P A = L U, in-place
+ * @details On return, the strictly lower part of a contains L (with implicit unit diagonal), and the upper part contains U.
+ * @param pivots - row i was interchanged with row pivots[i] at step i.
+ * @return true on success, false if the matrix is exactly singular.
+ */
+bool ddlu_factor(size_t n, doubledouble *FPPLUS_RESTRICT a, size_t lda, size_t FPPLUS_ARRAY_POINTER(pivots, n),
+	size_t block_size, void *FPPLUS_RESTRICT workspace);
+
+/**
+ * @brief Solves A x = b with the factorization from ddlu_factor, in-place: b is overwritten with x
+ */
+void ddlu_solve(size_t n, const doubledouble *FPPLUS_RESTRICT lu, size_t lda, const size_t FPPLUS_ARRAY_POINTER(pivots, n),
+	doubledouble FPPLUS_ARRAY_POINTER(b, n));
+
+/**
+ * @brief Right-looking blocked Cholesky factorization of a symmetric positive definite matrix, A = L L', in-place
+ * @details Only the lower triangle of a is referenced, and it is overwritten with L.
+ * @return true on success, false if the matrix is not positive definite in working precision.
+ */
+bool ddcholesky_factor(size_t n, doubledouble *FPPLUS_RESTRICT a, size_t lda,
+	size_t block_size, void *FPPLUS_RESTRICT workspace);
+
+/**
+ * @brief Solves A x = b with the factorization from ddcholesky_factor, in-place: b is overwritten with x
+ */
+void ddcholesky_solve(size_t n, const doubledouble *FPPLUS_RESTRICT l, size_t lda,
+	doubledouble FPPLUS_ARRAY_POINTER(b, n));
+
+enum ddtriangular_side {
+	/* Solve A X = B */
+	ddtriangular_left,
+	/* Solve X A = B */
+	ddtriangular_right,
+};
+
+enum ddtriangular_uplo {
+	/* A is lower triangular, and its strictly upper triangle is not referenced */
+	ddtriangular_lower,
+	/* A is upper triangular, and its strictly lower triangle is not referenced */
+	ddtriangular_upper,
+};
+
+/**
+ * @brief Size, in bytes, of the workspace for triangular solves with m x n right-hand side B and the given block size
+ */
+size_t ddtrsm_workspace_size(size_t m, size_t n, size_t block_size);
+
+/**
+ * @brief Blocked triangular solve with multiple right-hand sides, A X = B or X A = B, in-place: B is overwritten with X
+ * @details B is m x n, and A is m x m for the left side or n x n for the right side.
+ *          Each diagonal block of A is inverted once with double-double divisions, then the block of X is computed
+ *          as the product of the inverse and the block of B, and the rest of B is updated, with the ddgemm micro-kernels.
+ * @param unit_diagonal - whether the diagonal elements of A are assumed to be 1 and are not referenced.
+ */
+void ddtrsm(enum ddtriangular_side side, enum ddtriangular_uplo uplo, bool unit_diagonal,
+	size_t m, size_t n, const doubledouble *FPPLUS_RESTRICT a, size_t lda, doubledouble *FPPLUS_RESTRICT b, size_t ldb,
+	size_t block_size, void *FPPLUS_RESTRICT workspace);
+
+/**
+ * @brief Triangular solve with a single right-hand side, A x = b or x' A = b', in-place: b is overwritten with x
+ */
+void ddtrsv(enum ddtriangular_side side, enum ddtriangular_uplo uplo, bool unit_diagonal,
+	size_t n, const doubledouble *FPPLUS_RESTRICT a, size_t lda, doubledouble FPPLUS_ARRAY_POINTER(x, n));
+
+/**
+ * @brief Size, in bytes, of the workspace for ddgemm_blocked with m x n matrix C, inner dimension k, and the given block size
+ */
+size_t ddgemm_blocked_workspace_size(size_t m, size_t n, size_t k, size_t block_size);
+
+/**
+ * @brief Blocked matrix multiplication C += op(A) op(B), where op(X) is X or X'
+ * @details op(A) is m x k and op(B) is k x n. The inner dimension is processed in blocks of block_size,
+ *          and each block is packed and multiplied with the ddgemm micro-kernels.
+ */
+void ddgemm_blocked(bool transpose_a, bool transpose_b, size_t m, size_t n, size_t k,
+	const doubledouble *FPPLUS_RESTRICT a, size_t lda, const doubledouble *FPPLUS_RESTRICT b, size_t ldb,
+	doubledouble *FPPLUS_RESTRICT c, size_t ldc, size_t block_size, void *FPPLUS_RESTRICT workspace);
+
+/**
+ * @brief Size, in bytes, of the workspace for ddsyrk and ddsyrk_mixed with n x n matrix C, inner dimension k, and the given block size
+ */
+size_t ddsyrk_workspace_size(size_t n, size_t k, size_t block_size);
+
+/**
+ * @brief Symmetric rank-k update C += A A', or, if transpose, the Gram matrix update C += A' A
+ * @details A is n x k, or k x n if transpose. Only the lower or upper triangle of C (including the diagonal)
+ *          is computed and referenced: tiles of C outside of the triangle are skipped, which halves the work of ddgemm_blocked.
+ */
+void ddsyrk(enum ddtriangular_uplo uplo, bool transpose, size_t n, size_t k,
+	const doubledouble *FPPLUS_RESTRICT a, size_t lda, doubledouble *FPPLUS_RESTRICT c, size_t ldc,
+	size_t block_size, void *FPPLUS_RESTRICT workspace);
+
+/**
+ * @brief Symmetric rank-k update as in ddsyrk, for a matrix A of doubles, e.g. to form the normal equations A' A x = A' b
+ * @details Products of doubles are computed exactly, and each element of a block of block_size products is accumulated
+ *          with compensated summation before it is added to C, so the error of each block is about k**2 2**-106 sum |a_ik a_jk|.
+ */
+void ddsyrk_mixed(enum ddtriangular_uplo uplo, bool transpose, size_t n, size_t k,
+	const double *FPPLUS_RESTRICT a, size_t lda, doubledouble *FPPLUS_RESTRICT c, size_t ldc,
+	size_t block_size, void *FPPLUS_RESTRICT workspace);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+#include <utils.h>
+#include <fft/common.h>
+
+
+/* Deterministic input in [-1, 1), the same for all sizes and runs */
+static void generate_input(size_t n, ddcomplex dd_input[restrict static n], dcomplex d_input[restrict static n]) {
+	uint64_t state = UINT64_C(0x853C49E6748FEA9B);
+	for (size_t j = 0; j < n; j++) {
+		const double re = random_uniform(&state);
+		const double im = random_uniform(&state);
+		dd_input[j] = (ddcomplex) { { re, 0.0 }, { im, 0.0 } };
+		d_input[j] = (dcomplex) { re, im };
+	}
+}
+
+static double ddcomplex_max_abs(size_t n, const ddcomplex x[restrict static n]) {
+	double max_abs = 0.0;
+	for (size_t j = 0; j < n; j++) {
+		max_abs = fmax(max_abs, fmax(fabs(x[j].re.hi), fabs(x[j].im.hi)));
+	}
+	return max_abs;
+}
+
+/* max |x - y| / max |y| over real and imaginary parts, with the difference computed in double-double precision */
+static double ddcomplex_relative_error(size_t n, const ddcomplex x[restrict static n], const ddcomplex y[restrict static n]) {
+	double max_error = 0.0;
+	for (size_t j = 0; j < n; j++) {
+		const ddcomplex difference = ddcsub(x[j], y[j]);
+		max_error = fmax(max_error, fmax(fabs(difference.re.hi), fabs(difference.im.hi)));
+	}
+	return max_error / ddcomplex_max_abs(n, y);
+}
+
+static double dcomplex_relative_error(size_t n, const dcomplex x[restrict static n], const ddcomplex y[restrict static n]) {
+	double max_error = 0.0;
+	for (size_t j = 0; j < n; j++) {
+		const doubledouble re_error = ddaddw(y[j].re, -x[j].re);
+		const doubledouble im_error = ddaddw(y[j].im, -x[j].im);
+		max_error = fmax(max_error, fmax(fabs(re_error.hi), fabs(im_error.hi)));
+	}
+	return max_error / ddcomplex_max_abs(n, y);
+}
+
+static void report_mflops(const char* name, size_t n, size_t iterations, double iteration_times[restrict static iterations],
+	const double counters[restrict static perf_counter_count])
+{
+	/* 5 n log2(n) is the conventional flop count of a complex FFT */
+	const double flops = 5.0 * (double) n * log2((double) n);
+	/* Convert iteration times to MFLOPS in-place */
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		iteration_times[iteration] = 1.0e+3 * flops / iteration_times[iteration];
+	}
+	const struct sample_statistics statistics = compute_sample_statistics(iteration_times, iterations);
+	report_measurement(name, n, report_unit_mflops, &statistics, counters);
+}
+
+static void report_error(const char* name, size_t n, double error, const double counters[restrict static perf_counter_count]) {
+	const struct sample_statistics statistics = compute_sample_statistics(&error, 1);
+	report_measurement(name, n, report_unit_relative_error, &statistics, counters);
+}
+
+static void benchmark(size_t n, enum report_format format, size_t iterations) {
+	struct fft_plan plan;
+	ddcomplex* dd_input = valloc(n * sizeof(ddcomplex));
+	ddcomplex* dd_data = valloc(n * sizeof(ddcomplex));
+	ddcomplex* dd_spectrum = valloc(n * sizeof(ddcomplex));
+	dcomplex* d_input = valloc(n * sizeof(dcomplex));
+	dcomplex* d_data = valloc(n * sizeof(dcomplex));
+	if (!fft_plan_init(&plan, n) || dd_input == NULL || dd_data == NULL || dd_spectrum == NULL || d_input == NULL || d_data == NULL) {
+		fprintf(stderr, "Error: failed to allocate memory for the benchmark\n");
+		exit(EXIT_FAILURE);
+	}
+	generate_input(n, dd_input, d_input);
+
+	/* The input is restored before each iteration, outside of the measured time */
+	double dd_times[iterations], d_times[iterations];
+	struct perf_counter_values dd_iteration_counters[iterations], d_iteration_counters[iterations];
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		memcpy(dd_data, dd_input, n * sizeof(ddcomplex));
+		perf_counters_start();
+		const double start_time = high_precision_time();
+
+		ddfft_forward(&plan, dd_data);
+
+		dd_times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&dd_iteration_counters[iteration]);
+	}
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		memcpy(d_data, d_input, n * sizeof(dcomplex));
+		perf_counters_start();
+		const double start_time = high_precision_time();
+
+		dfft_forward(&plan, d_data);
+
+		d_times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&d_iteration_counters[iteration]);
+	}
+
+	/* Counters are normalized per complex element */
+	double dd_counters[perf_counter_count], d_counters[perf_counter_count];
+	median_perf_counters(iterations, dd_iteration_counters, (double) n, dd_counters);
+	median_perf_counters(iterations, d_iteration_counters, (double) n, d_counters);
+
+	/* Accuracy of the double-precision FFT relative to the double-double FFT, and of forward + inverse round trips */
+	memcpy(dd_spectrum, dd_data, n * sizeof(ddcomplex));
+	const double d_spectrum_error = dcomplex_relative_error(n, d_data, dd_spectrum);
+	ddfft_inverse(&plan, dd_data);
+	const double dd_roundtrip_error = ddcomplex_relative_error(n, dd_data, dd_input);
+	dfft_inverse(&plan, d_data);
+	for (size_t j = 0; j < n; j++) {
+		dd_data[j] = (ddcomplex) { { d_data[j].re, 0.0 }, { d_data[j].im, 0.0 } };
+	}
+	const double d_roundtrip_error = ddcomplex_relative_error(n, dd_data, dd_input);
+
+	if (format == report_format_text) {
+		const double flops = 5.0 * (double) n * log2((double) n);
+		const double dd_time_ns = median_double(dd_times, iterations);
+		const double d_time_ns = median_double(d_times, iterations);
+		printf("%zu\t" "%.1lf\t" "%.1lf\t" "%.2lfx\t" "%.2le\t" "%.2le\t" "%.2le",
+			n, 1.0e+3 * flops / dd_time_ns, 1.0e+3 * flops / d_time_ns, dd_time_ns / d_time_ns,
+			dd_roundtrip_error, d_roundtrip_error, d_spectrum_error);
+		report_text_counters(dd_counters);
+	} else {
+		report_mflops("fft/dd", n, iterations, dd_times, dd_counters);
+		report_mflops("fft/double", n, iterations, d_times, d_counters);
+		report_error("fft/dd/roundtrip", n, dd_roundtrip_error, dd_counters);
+		report_error("fft/double/roundtrip", n, d_roundtrip_error, d_counters);
+		report_error("fft/double/spectrum", n, d_spectrum_error, d_counters);
+	}
+
+	fft_plan_release(&plan);
+	free(dd_input);
+	free(dd_data);
+	free(dd_spectrum);
+	free(d_input);
+	free(d_data);
+}
+
+int main(int argc, char *argv[]) {
+	const struct benchmark_options options = parse_options(argc, argv);
+
+	perf_counters_open(options.counters);
+	report_begin(options.format, "fft-bench", argc, argv);
+	for (size_t n = 4; n <= options.max_size; n *= 2) {
+		benchmark(n, options.format, options.iterations);
+	}
+	report_end();
+	perf_counters_close();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <report.h>
+#include <fft/fft.h>
+
+
+struct benchmark_options {
+	size_t iterations;
+	/* The largest transform size, a power of 2 */
+	size_t max_size;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+};
+
+struct benchmark_options parse_options(int argc, char** argv);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,667 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <fft/fft.h>
+
+/*
+ * Radix-4 Stockham autosort FFT (with a radix-2 pass if log2(n) is odd), in double-double and double precision.
+ *
+ * Unblocked transforms make log4(n) passes over the whole array, alternating between the data and a work buffer.
+ * Blocked transforms use the four-step algorithm, which splits them into FFTs of the columns and of the rows of a matrix.
+ * FFT_BLOCK columns (or rows) at a time are copied into a small buffer and transformed there with the same Stockham passes,
+ * so every element is read from and written to memory twice instead of log4(n) times, at the cost of copies with large
+ * strides and n extra complex multiplications by twiddle factors between the two steps.
+ */
+
+/*
+ * Twiddle factors
+ *
+ * cos and sin of angles in [0, pi/2] are computed with Taylor series in double-double arithmetic,
+ * and the other quadrants are obtained by exact rotations by multiples of pi/2.
+ */
+
+static const doubledouble two_pi = { 6.283185307179586232, 2.4492935982947064e-16 };
+
+static void ddcossin(doubledouble x, doubledouble cos_x[restrict static 1], doubledouble sin_x[restrict static 1]) {
+	const doubledouble x2 = ddmul(x, x);
+	doubledouble cos_term = { 1.0, 0.0 }, sin_term = x;
+	doubledouble cos_sum = cos_term, sin_sum = sin_term;
+	/* For |x| <= pi/2, the terms drop below 2**-110 of the sum after 2 * 30 factors */
+	for (int i = 1; i <= 30; i++) {
+		const doubledouble minus_x2 = { -x2.hi, -x2.lo };
+		cos_term = dddiv(ddmul(cos_term, minus_x2), (doubledouble) { (double) ((2 * i - 1) * (2 * i)), 0.0 });
+		sin_term = dddiv(ddmul(sin_term, minus_x2), (doubledouble) { (double) ((2 * i) * (2 * i + 1)), 0.0 });
+		cos_sum = ddadd(cos_sum, cos_term);
+		sin_sum = ddadd(sin_sum, sin_term);
+	}
+	*cos_x = cos_sum;
+	*sin_x = sin_sum;
+}
+
+static void compute_twiddles(size_t n, ddcomplex twiddles[restrict static n]) {
+	if (n < 4) {
+		/* exp(-2 pi i k / n) for n = 1 and n = 2 */
+		twiddles[0] = (ddcomplex) { { 1.0, 0.0 }, { 0.0, 0.0 } };
+		if (n == 2) {
+			twiddles[1] = (ddcomplex) { { -1.0, 0.0 }, { 0.0, 0.0 } };
+		}
+		return;
+	}
+	const size_t quadrant = n / 4;
+	for (size_t k = 0; k < quadrant; k++) {
+		/* k / n is exact, because n is a power of 2 */
+		const doubledouble angle = ddmulw(two_pi, (double) k / (double) n);
+		doubledouble c, s;
+		ddcossin(angle, &c, &s);
+		const doubledouble minus_c = { -c.hi, -c.lo }, minus_s = { -s.hi, -s.lo };
+		/* exp(-i (angle + q pi / 2)) = exp(-i angle) * (-i)^q */
+		twiddles[k] = (ddcomplex) { c, minus_s };
+		twiddles[k + quadrant] = (ddcomplex) { minus_s, minus_c };
+		twiddles[k + 2 * quadrant] = (ddcomplex) { minus_c, s };
+		twiddles[k + 3 * quadrant] = (ddcomplex) { s, c };
+	}
+}
+
+static size_t max_size(size_t a, size_t b) {
+	return a > b ? a : b;
+}
+
+static bool is_power_of_2(size_t n) {
+	return n != 0 && (n & (n - 1)) == 0;
+}
+
+bool fft_plan_init(struct fft_plan plan[restrict static 1], size_t n) {
+	/* rows = 2**floor(log2(n) / 2) <= n / rows */
+	size_t rows = 0;
+	if (n >= FFT_BLOCKED_MIN_SIZE) {
+		rows = 1;
+		while (rows * rows * 4 <= n) {
+			rows *= 2;
+		}
+	}
+	return fft_plan_init_blocked(plan, n, rows);
+}
+
+bool fft_plan_init_blocked(struct fft_plan plan[restrict static 1], size_t n, size_t rows) {
+	memset(plan, 0, sizeof(struct fft_plan));
+	if (!is_power_of_2(n)) {
+		return false;
+	}
+	if (rows != 0 && !(is_power_of_2(rows) && rows >= FFT_BLOCK && rows <= n / FFT_BLOCK)) {
+		return false;
+	}
+	plan->n = n;
+	plan->rows = rows;
+	plan->dd_twiddles = valloc(n * sizeof(ddcomplex));
+	plan->d_twiddles = valloc(n * sizeof(dcomplex));
+	plan->dd_work = valloc(n * sizeof(ddcomplex));
+	plan->d_work = valloc(n * sizeof(dcomplex));
+	if (plan->dd_twiddles == NULL || plan->d_twiddles == NULL || plan->dd_work == NULL || plan->d_work == NULL) {
+		fft_plan_release(plan);
+		return false;
+	}
+	if (rows != 0) {
+		/* A block of columns or rows, and the second buffer for the passes over it */
+		const size_t block_size = 2 * FFT_BLOCK * max_size(rows, n / rows);
+		plan->dd_block = valloc(block_size * sizeof(ddcomplex));
+		plan->d_block = valloc(block_size * sizeof(dcomplex));
+		plan->dd_block_twiddles = valloc(n * sizeof(ddcomplex));
+		plan->d_block_twiddles = valloc(n * sizeof(dcomplex));
+		if (plan->dd_block == NULL || plan->d_block == NULL || plan->dd_block_twiddles == NULL || plan->d_block_twiddles == NULL) {
+			fft_plan_release(plan);
+			return false;
+		}
+	}
+	compute_twiddles(n, plan->dd_twiddles);
+	for (size_t k = 0; k < n; k++) {
+		plan->d_twiddles[k] = (dcomplex) { plan->dd_twiddles[k].re.hi, plan->dd_twiddles[k].im.hi };
+	}
+	if (rows != 0) {
+		/* exp(-2 pi i j2 k1 / n) in the order of use by the first step of the four-step algorithm */
+		const size_t columns = n / rows;
+		for (size_t j2 = 0; j2 < columns; j2 += FFT_BLOCK) {
+			for (size_t k1 = 0; k1 < rows; k1++) {
+				for (size_t b = 0; b < FFT_BLOCK; b++) {
+					const size_t index = j2 * rows + k1 * FFT_BLOCK + b;
+					plan->dd_block_twiddles[index] = plan->dd_twiddles[(j2 + b) * k1];
+					plan->d_block_twiddles[index] = plan->d_twiddles[(j2 + b) * k1];
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void fft_plan_release(struct fft_plan plan[restrict static 1]) {
+	free(plan->dd_twiddles);
+	free(plan->d_twiddles);
+	free(plan->dd_work);
+	free(plan->d_work);
+	free(plan->dd_block);
+	free(plan->d_block);
+	free(plan->dd_block_twiddles);
+	free(plan->d_block_twiddles);
+	memset(plan, 0, sizeof(struct fft_plan));
+}
+
+
+/*
+ * Stockham passes
+ *
+ * A pass of radix r transforms s interleaved subsequences of length m, x[q + s * j] for q = 0...s-1, and writes the results
+ * for the next pass as r * s interleaved subsequences of length m / r. The twiddle factors of length-m transforms are
+ * every (n / m)-th element of the length-n table. Passes with s >= 4 are vectorized over 4 consecutive subsequences q,
+ * and the first pass of an unblocked transform (s = 1) over 4 consecutive butterflies. Radix-4 passes precede the
+ * radix-2 pass, so s is either 1 or a multiple of 4.
+ */
+
+static ddcomplex ddcmul_minus_i(const ddcomplex a) {
+	return (ddcomplex) { a.im, ddneg(a.re) };
+}
+
+/* Length-4 DFT: y[r] = sum_j x_j (-i)^(j r), where x_0, x_1, x_2, x_3 are a, b, c, d */
+static inline void ddfft_butterfly4(const ddcomplex a, const ddcomplex b, const ddcomplex c, const ddcomplex d,
+	ddcomplex y[restrict static 4])
+{
+	const ddcomplex apc = ddcadd(a, c);
+	const ddcomplex amc = ddcsub(a, c);
+	const ddcomplex bpd = ddcadd(b, d);
+	const ddcomplex jbmd = ddcmul_minus_i(ddcsub(b, d));
+	y[0] = ddcadd(apc, bpd);
+	y[1] = ddcadd(amc, jbmd);
+	y[2] = ddcsub(apc, bpd);
+	y[3] = ddcsub(amc, jbmd);
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+static inline void _mm256_fft_butterfly4_pddc(const __m256ddc a, const __m256ddc b, const __m256ddc c, const __m256ddc d,
+	__m256ddc y[restrict static 4])
+{
+	const __m256ddc apc = _mm256_add_pddc(a, c);
+	const __m256ddc amc = _mm256_sub_pddc(a, c);
+	const __m256ddc bpd = _mm256_add_pddc(b, d);
+	const __m256ddc bmd = _mm256_sub_pddc(b, d);
+	const __m256ddc jbmd = { bmd.im, _mm256_neg_pdd(bmd.re) };
+	y[0] = _mm256_add_pddc(apc, bpd);
+	y[1] = _mm256_add_pddc(amc, jbmd);
+	y[2] = _mm256_sub_pddc(apc, bpd);
+	y[3] = _mm256_sub_pddc(amc, jbmd);
+}
+#endif
+
+/* The first pass of radix 4 (s = 1): y[4 p + r] is the output r of the butterfly p */
+static void ddfft_radix4_first_pass(size_t n, size_t m,
+	const ddcomplex twiddles[restrict static n],
+	const ddcomplex x[restrict static m],
+	ddcomplex y[restrict static m])
+{
+	const size_t m4 = m / 4, twiddle_stride = n / m;
+	size_t p = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	for (; p + 4 <= m4; p += 4) {
+		ddcomplex w[3][4];
+		for (size_t i = 0; i < 4; i++) {
+			for (size_t r = 1; r <= 3; r++) {
+				w[r - 1][i] = twiddles[r * (p + i) * twiddle_stride];
+			}
+		}
+		__m256ddc z[4];
+		_mm256_fft_butterfly4_pddc(
+			_mm256_loaddeinterleaveu_pddc(&x[p]), _mm256_loaddeinterleaveu_pddc(&x[p + m4]),
+			_mm256_loaddeinterleaveu_pddc(&x[p + 2 * m4]), _mm256_loaddeinterleaveu_pddc(&x[p + 3 * m4]),
+			z);
+		/* Transpose 4 outputs of 4 butterflies into 16 consecutive elements */
+		ddcomplex outputs[4][4];
+		_mm256_interleavestoreu_pddc(outputs[0], z[0]);
+		for (size_t r = 1; r < 4; r++) {
+			_mm256_interleavestoreu_pddc(outputs[r], _mm256_mul_pddc(_mm256_loaddeinterleaveu_pddc(w[r - 1]), z[r]));
+		}
+		for (size_t i = 0; i < 4; i++) {
+			for (size_t r = 0; r < 4; r++) {
+				y[4 * (p + i) + r] = outputs[r][i];
+			}
+		}
+	}
+#endif
+	for (; p < m4; p++) {
+		ddcomplex z[4];
+		ddfft_butterfly4(x[p], x[p + m4], x[p + 2 * m4], x[p + 3 * m4], z);
+		y[4 * p] = z[0];
+		for (size_t r = 1; r < 4; r++) {
+			y[4 * p + r] = p == 0 ? z[r] : ddcmul(twiddles[r * p * twiddle_stride], z[r]);
+		}
+	}
+}
+
+static void ddfft_radix4_pass(size_t n, size_t m, size_t s,
+	const ddcomplex twiddles[restrict static n],
+	const ddcomplex x[restrict static m * s],
+	ddcomplex y[restrict static m * s])
+{
+	const size_t m4 = m / 4, twiddle_stride = n / m;
+	for (size_t p = 0; p < m4; p++) {
+		/* exp(-2 pi i r p / m) = exp(-2 pi i r p (n / m) / n), and the butterfly p = 0 needs no multiplications */
+		const ddcomplex w[3] = { twiddles[p * twiddle_stride], twiddles[2 * p * twiddle_stride], twiddles[3 * p * twiddle_stride] };
+		size_t q = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+		const __m256ddc vw[3] = { _mm256_broadcast_sddc(&w[0]), _mm256_broadcast_sddc(&w[1]), _mm256_broadcast_sddc(&w[2]) };
+		for (; q + 4 <= s; q += 4) {
+			__m256ddc z[4];
+			_mm256_fft_butterfly4_pddc(
+				_mm256_loaddeinterleaveu_pddc(&x[q + s * p]), _mm256_loaddeinterleaveu_pddc(&x[q + s * (p + m4)]),
+				_mm256_loaddeinterleaveu_pddc(&x[q + s * (p + 2 * m4)]), _mm256_loaddeinterleaveu_pddc(&x[q + s * (p + 3 * m4)]),
+				z);
+			_mm256_interleavestoreu_pddc(&y[q + s * (4 * p)], z[0]);
+			for (size_t r = 1; r < 4; r++) {
+				_mm256_interleavestoreu_pddc(&y[q + s * (4 * p + r)], p == 0 ? z[r] : _mm256_mul_pddc(vw[r - 1], z[r]));
+			}
+		}
+#endif
+		for (; q < s; q++) {
+			ddcomplex z[4];
+			ddfft_butterfly4(x[q + s * p], x[q + s * (p + m4)], x[q + s * (p + 2 * m4)], x[q + s * (p + 3 * m4)], z);
+			y[q + s * (4 * p)] = z[0];
+			for (size_t r = 1; r < 4; r++) {
+				y[q + s * (4 * p + r)] = p == 0 ? z[r] : ddcmul(w[r - 1], z[r]);
+			}
+		}
+	}
+}
+
+/* The last pass of radix 2 (m = 2), where all twiddle factors are 1 */
+static void ddfft_radix2_pass(size_t s,
+	const ddcomplex x[restrict static 2 * s],
+	ddcomplex y[restrict static 2 * s])
+{
+	size_t q = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	for (; q + 4 <= s; q += 4) {
+		const __m256ddc a = _mm256_loaddeinterleaveu_pddc(&x[q]);
+		const __m256ddc b = _mm256_loaddeinterleaveu_pddc(&x[q + s]);
+		_mm256_interleavestoreu_pddc(&y[q], _mm256_add_pddc(a, b));
+		_mm256_interleavestoreu_pddc(&y[q + s], _mm256_sub_pddc(a, b));
+	}
+#endif
+	for (; q < s; q++) {
+		const ddcomplex a = x[q];
+		const ddcomplex b = x[q + s];
+		y[q] = ddcadd(a, b);
+		y[q + s] = ddcsub(a, b);
+	}
+}
+
+/*
+ * Transforms s interleaved subsequences of length m in x, using y as the second buffer of the passes.
+ * Returns the buffer with the results, x or y, where the transform of x[q + s * j] is at [q + s * k].
+ */
+static ddcomplex* ddfft_passes(size_t n, size_t m, size_t s,
+	const ddcomplex twiddles[restrict static n],
+	ddcomplex x[restrict static m * s],
+	ddcomplex y[restrict static m * s])
+{
+	for (; m >= 4; m /= 4, s *= 4) {
+		if (s == 1) {
+			ddfft_radix4_first_pass(n, m, twiddles, x, y);
+		} else {
+			ddfft_radix4_pass(n, m, s, twiddles, x, y);
+		}
+		ddcomplex* t = x; x = y; y = t;
+	}
+	if (m == 2) {
+		ddfft_radix2_pass(s, x, y);
+		ddcomplex* t = x; x = y; y = t;
+	}
+	return x;
+}
+
+/*
+ * Four-step algorithm
+ *
+ * The data is a rows x columns matrix, x[j1 * columns + j2], and with j = j1 * columns + j2, k = k1 + rows * k2,
+ *   X[k] = sum_j2 exp(-2 pi i j2 k2 / columns) exp(-2 pi i j2 k1 / n) sum_j1 x[j1 * columns + j2] exp(-2 pi i j1 k1 / rows)
+ * 1. FFTs of length rows of the columns, multiplied by exp(-2 pi i j2 k1 / n), are written to work[k1 * columns + j2].
+ * 2. FFTs of length columns of the rows of work are written to data[k1 + rows * k2].
+ * Each step copies FFT_BLOCK columns or rows into the block buffer as FFT_BLOCK interleaved sequences.
+ */
+
+static void ddfft_blocked(const struct fft_plan plan[restrict static 1], ddcomplex data[restrict static 1]) {
+	const size_t n = plan->n, rows = plan->rows, columns = n / rows;
+	const ddcomplex* twiddles = plan->dd_twiddles;
+	ddcomplex* work = plan->dd_work;
+	ddcomplex* block = plan->dd_block;
+	ddcomplex* block_work = plan->dd_block + FFT_BLOCK * max_size(rows, columns);
+
+	for (size_t j2 = 0; j2 < columns; j2 += FFT_BLOCK) {
+		for (size_t j1 = 0; j1 < rows; j1++) {
+			memcpy(&block[FFT_BLOCK * j1], &data[j1 * columns + j2], FFT_BLOCK * sizeof(ddcomplex));
+		}
+		const ddcomplex* spectrum = ddfft_passes(n, rows, FFT_BLOCK, twiddles, block, block_work);
+		const ddcomplex* block_twiddles = &plan->dd_block_twiddles[j2 * rows];
+		for (size_t k1 = 0; k1 < rows; k1++) {
+			size_t b = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+			for (; b + 4 <= FFT_BLOCK; b += 4) {
+				_mm256_interleavestoreu_pddc(&work[k1 * columns + j2 + b],
+					_mm256_mul_pddc(_mm256_loaddeinterleaveu_pddc(&block_twiddles[FFT_BLOCK * k1 + b]), _mm256_loaddeinterleaveu_pddc(&spectrum[FFT_BLOCK * k1 + b])));
+			}
+#endif
+			for (; b < FFT_BLOCK; b++) {
+				work[k1 * columns + j2 + b] = ddcmul(block_twiddles[FFT_BLOCK * k1 + b], spectrum[FFT_BLOCK * k1 + b]);
+			}
+		}
+	}
+
+	for (size_t k1 = 0; k1 < rows; k1 += FFT_BLOCK) {
+		for (size_t j2 = 0; j2 < columns; j2++) {
+			for (size_t b = 0; b < FFT_BLOCK; b++) {
+				block[FFT_BLOCK * j2 + b] = work[(k1 + b) * columns + j2];
+			}
+		}
+		const ddcomplex* spectrum = ddfft_passes(n, columns, FFT_BLOCK, twiddles, block, block_work);
+		for (size_t k2 = 0; k2 < columns; k2++) {
+			memcpy(&data[k1 + rows * k2], &spectrum[FFT_BLOCK * k2], FFT_BLOCK * sizeof(ddcomplex));
+		}
+	}
+}
+
+void ddfft_forward(const struct fft_plan plan[restrict static 1], ddcomplex data[restrict static 1]) {
+	const size_t n = plan->n;
+	if (plan->rows != 0) {
+		ddfft_blocked(plan, data);
+	} else {
+		const ddcomplex* spectrum = ddfft_passes(n, n, 1, plan->dd_twiddles, data, plan->dd_work);
+		if (spectrum != data) {
+			memcpy(data, spectrum, n * sizeof(ddcomplex));
+		}
+	}
+}
+
+void ddfft_inverse(const struct fft_plan plan[restrict static 1], ddcomplex data[restrict static 1]) {
+	/* ifft(X) = conj(fft(conj(X))) / n, and division by a power of 2 is exact */
+	const size_t n = plan->n;
+	for (size_t k = 0; k < n; k++) {
+		data[k].im = ddneg(data[k].im);
+	}
+	ddfft_forward(plan, data);
+	const double scale = 1.0 / (double) n;
+	for (size_t j = 0; j < n; j++) {
+		data[j].re.hi *= scale;
+		data[j].re.lo *= scale;
+		data[j].im.hi *= -scale;
+		data[j].im.lo *= -scale;
+	}
+}
+
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+/* 4 complex numbers with double-precision parts in AVX registers */
+typedef struct {
+	__m256d re;
+	__m256d im;
+} __m256dc;
+
+static inline __m256dc _mm256_loaddeinterleaveu_pdc(const dcomplex pointer[restrict static 4]) {
+	const __m256d numbers01 = _mm256_loadu_pd(&pointer[0].re);
+	const __m256d numbers23 = _mm256_loadu_pd(&pointer[2].re);
+	const __m256d numbers02 = _mm256_permute2f128_pd(numbers01, numbers23, 0x20);
+	const __m256d numbers13 = _mm256_permute2f128_pd(numbers01, numbers23, 0x31);
+	return (__m256dc) { _mm256_unpacklo_pd(numbers02, numbers13), _mm256_unpackhi_pd(numbers02, numbers13) };
+}
+
+static inline void _mm256_interleavestoreu_pdc(dcomplex pointer[restrict static 4], const __m256dc numbers) {
+	const __m256d numbers02 = _mm256_unpacklo_pd(numbers.re, numbers.im);
+	const __m256d numbers13 = _mm256_unpackhi_pd(numbers.re, numbers.im);
+	_mm256_storeu_pd(&pointer[0].re, _mm256_permute2f128_pd(numbers02, numbers13, 0x20));
+	_mm256_storeu_pd(&pointer[2].re, _mm256_permute2f128_pd(numbers02, numbers13, 0x31));
+}
+
+static inline __m256dc _mm256_add_pdc(const __m256dc a, const __m256dc b) {
+	return (__m256dc) { _mm256_add_pd(a.re, b.re), _mm256_add_pd(a.im, b.im) };
+}
+
+static inline __m256dc _mm256_sub_pdc(const __m256dc a, const __m256dc b) {
+	return (__m256dc) { _mm256_sub_pd(a.re, b.re), _mm256_sub_pd(a.im, b.im) };
+}
+
+static inline __m256dc _mm256_mul_pdc(const __m256dc a, const __m256dc b) {
+	return (__m256dc) {
+		_mm256_fmsub_pd(a.re, b.re, _mm256_mul_pd(a.im, b.im)),
+		_mm256_fmadd_pd(a.re, b.im, _mm256_mul_pd(a.im, b.re))
+	};
+}
+#endif
+
+static inline dcomplex dcadd(const dcomplex a, const dcomplex b) {
+	return (dcomplex) { a.re + b.re, a.im + b.im };
+}
+
+static inline dcomplex dcsub(const dcomplex a, const dcomplex b) {
+	return (dcomplex) { a.re - b.re, a.im - b.im };
+}
+
+static inline dcomplex dcmul(const dcomplex a, const dcomplex b) {
+	/* Same operations as in _mm256_mul_pdc */
+	return (dcomplex) {
+		__builtin_fma(a.re, b.re, -(a.im * b.im)),
+		__builtin_fma(a.re, b.im, a.im * b.re)
+	};
+}
+
+
+static inline void dfft_butterfly4(const dcomplex a, const dcomplex b, const dcomplex c, const dcomplex d,
+	dcomplex y[restrict static 4])
+{
+	const dcomplex apc = dcadd(a, c);
+	const dcomplex amc = dcsub(a, c);
+	const dcomplex bpd = dcadd(b, d);
+	const dcomplex bmd = dcsub(b, d);
+	const dcomplex jbmd = { bmd.im, -bmd.re };
+	y[0] = dcadd(apc, bpd);
+	y[1] = dcadd(amc, jbmd);
+	y[2] = dcsub(apc, bpd);
+	y[3] = dcsub(amc, jbmd);
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+static inline void _mm256_fft_butterfly4_pdc(const __m256dc a, const __m256dc b, const __m256dc c, const __m256dc d,
+	__m256dc y[restrict static 4])
+{
+	const __m256dc apc = _mm256_add_pdc(a, c);
+	const __m256dc amc = _mm256_sub_pdc(a, c);
+	const __m256dc bpd = _mm256_add_pdc(b, d);
+	const __m256dc bmd = _mm256_sub_pdc(b, d);
+	const __m256dc jbmd = { bmd.im, _mm256_xor_pd(bmd.re, _mm256_set1_pd(-0.0)) };
+	y[0] = _mm256_add_pdc(apc, bpd);
+	y[1] = _mm256_add_pdc(amc, jbmd);
+	y[2] = _mm256_sub_pdc(apc, bpd);
+	y[3] = _mm256_sub_pdc(amc, jbmd);
+}
+#endif
+
+static void dfft_radix4_first_pass(size_t n, size_t m,
+	const dcomplex twiddles[restrict static n],
+	const dcomplex x[restrict static m],
+	dcomplex y[restrict static m])
+{
+	const size_t m4 = m / 4, twiddle_stride = n / m;
+	size_t p = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	for (; p + 4 <= m4; p += 4) {
+		dcomplex w[3][4];
+		for (size_t i = 0; i < 4; i++) {
+			for (size_t r = 1; r <= 3; r++) {
+				w[r - 1][i] = twiddles[r * (p + i) * twiddle_stride];
+			}
+		}
+		__m256dc z[4];
+		_mm256_fft_butterfly4_pdc(
+			_mm256_loaddeinterleaveu_pdc(&x[p]), _mm256_loaddeinterleaveu_pdc(&x[p + m4]),
+			_mm256_loaddeinterleaveu_pdc(&x[p + 2 * m4]), _mm256_loaddeinterleaveu_pdc(&x[p + 3 * m4]),
+			z);
+		/* Transpose 4 outputs of 4 butterflies into 16 consecutive elements */
+		dcomplex outputs[4][4];
+		_mm256_interleavestoreu_pdc(outputs[0], z[0]);
+		for (size_t r = 1; r < 4; r++) {
+			_mm256_interleavestoreu_pdc(outputs[r], _mm256_mul_pdc(_mm256_loaddeinterleaveu_pdc(w[r - 1]), z[r]));
+		}
+		for (size_t i = 0; i < 4; i++) {
+			for (size_t r = 0; r < 4; r++) {
+				y[4 * (p + i) + r] = outputs[r][i];
+			}
+		}
+	}
+#endif
+	for (; p < m4; p++) {
+		dcomplex z[4];
+		dfft_butterfly4(x[p], x[p + m4], x[p + 2 * m4], x[p + 3 * m4], z);
+		y[4 * p] = z[0];
+		for (size_t r = 1; r < 4; r++) {
+			y[4 * p + r] = p == 0 ? z[r] : dcmul(twiddles[r * p * twiddle_stride], z[r]);
+		}
+	}
+}
+
+static void dfft_radix4_pass(size_t n, size_t m, size_t s,
+	const dcomplex twiddles[restrict static n],
+	const dcomplex x[restrict static m * s],
+	dcomplex y[restrict static m * s])
+{
+	const size_t m4 = m / 4, twiddle_stride = n / m;
+	for (size_t p = 0; p < m4; p++) {
+		/* exp(-2 pi i r p / m) = exp(-2 pi i r p (n / m) / n), and the butterfly p = 0 needs no multiplications */
+		const dcomplex w[3] = { twiddles[p * twiddle_stride], twiddles[2 * p * twiddle_stride], twiddles[3 * p * twiddle_stride] };
+		size_t q = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+		const __m256dc vw[3] = {
+			{ _mm256_set1_pd(w[0].re), _mm256_set1_pd(w[0].im) },
+			{ _mm256_set1_pd(w[1].re), _mm256_set1_pd(w[1].im) },
+			{ _mm256_set1_pd(w[2].re), _mm256_set1_pd(w[2].im) }
+		};
+		for (; q + 4 <= s; q += 4) {
+			__m256dc z[4];
+			_mm256_fft_butterfly4_pdc(
+				_mm256_loaddeinterleaveu_pdc(&x[q + s * p]), _mm256_loaddeinterleaveu_pdc(&x[q + s * (p + m4)]),
+				_mm256_loaddeinterleaveu_pdc(&x[q + s * (p + 2 * m4)]), _mm256_loaddeinterleaveu_pdc(&x[q + s * (p + 3 * m4)]),
+				z);
+			_mm256_interleavestoreu_pdc(&y[q + s * (4 * p)], z[0]);
+			for (size_t r = 1; r < 4; r++) {
+				_mm256_interleavestoreu_pdc(&y[q + s * (4 * p + r)], p == 0 ? z[r] : _mm256_mul_pdc(vw[r - 1], z[r]));
+			}
+		}
+#endif
+		for (; q < s; q++) {
+			dcomplex z[4];
+			dfft_butterfly4(x[q + s * p], x[q + s * (p + m4)], x[q + s * (p + 2 * m4)], x[q + s * (p + 3 * m4)], z);
+			y[q + s * (4 * p)] = z[0];
+			for (size_t r = 1; r < 4; r++) {
+				y[q + s * (4 * p + r)] = p == 0 ? z[r] : dcmul(w[r - 1], z[r]);
+			}
+		}
+	}
+}
+
+static void dfft_radix2_pass(size_t s,
+	const dcomplex x[restrict static 2 * s],
+	dcomplex y[restrict static 2 * s])
+{
+	size_t q = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	for (; q + 4 <= s; q += 4) {
+		const __m256dc a = _mm256_loaddeinterleaveu_pdc(&x[q]);
+		const __m256dc b = _mm256_loaddeinterleaveu_pdc(&x[q + s]);
+		_mm256_interleavestoreu_pdc(&y[q], _mm256_add_pdc(a, b));
+		_mm256_interleavestoreu_pdc(&y[q + s], _mm256_sub_pdc(a, b));
+	}
+#endif
+	for (; q < s; q++) {
+		const dcomplex a = x[q];
+		const dcomplex b = x[q + s];
+		y[q] = dcadd(a, b);
+		y[q + s] = dcsub(a, b);
+	}
+}
+
+static dcomplex* dfft_passes(size_t n, size_t m, size_t s,
+	const dcomplex twiddles[restrict static n],
+	dcomplex x[restrict static m * s],
+	dcomplex y[restrict static m * s])
+{
+	for (; m >= 4; m /= 4, s *= 4) {
+		if (s == 1) {
+			dfft_radix4_first_pass(n, m, twiddles, x, y);
+		} else {
+			dfft_radix4_pass(n, m, s, twiddles, x, y);
+		}
+		dcomplex* t = x; x = y; y = t;
+	}
+	if (m == 2) {
+		dfft_radix2_pass(s, x, y);
+		dcomplex* t = x; x = y; y = t;
+	}
+	return x;
+}
+
+static void dfft_blocked(const struct fft_plan plan[restrict static 1], dcomplex data[restrict static 1]) {
+	const size_t n = plan->n, rows = plan->rows, columns = n / rows;
+	const dcomplex* twiddles = plan->d_twiddles;
+	dcomplex* work = plan->d_work;
+	dcomplex* block = plan->d_block;
+	dcomplex* block_work = plan->d_block + FFT_BLOCK * max_size(rows, columns);
+
+	for (size_t j2 = 0; j2 < columns; j2 += FFT_BLOCK) {
+		for (size_t j1 = 0; j1 < rows; j1++) {
+			memcpy(&block[FFT_BLOCK * j1], &data[j1 * columns + j2], FFT_BLOCK * sizeof(dcomplex));
+		}
+		const dcomplex* spectrum = dfft_passes(n, rows, FFT_BLOCK, twiddles, block, block_work);
+		const dcomplex* block_twiddles = &plan->d_block_twiddles[j2 * rows];
+		for (size_t k1 = 0; k1 < rows; k1++) {
+			size_t b = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+			for (; b + 4 <= FFT_BLOCK; b += 4) {
+				_mm256_interleavestoreu_pdc(&work[k1 * columns + j2 + b],
+					_mm256_mul_pdc(_mm256_loaddeinterleaveu_pdc(&block_twiddles[FFT_BLOCK * k1 + b]), _mm256_loaddeinterleaveu_pdc(&spectrum[FFT_BLOCK * k1 + b])));
+			}
+#endif
+			for (; b < FFT_BLOCK; b++) {
+				work[k1 * columns + j2 + b] = dcmul(block_twiddles[FFT_BLOCK * k1 + b], spectrum[FFT_BLOCK * k1 + b]);
+			}
+		}
+	}
+
+	for (size_t k1 = 0; k1 < rows; k1 += FFT_BLOCK) {
+		for (size_t j2 = 0; j2 < columns; j2++) {
+			for (size_t b = 0; b < FFT_BLOCK; b++) {
+				block[FFT_BLOCK * j2 + b] = work[(k1 + b) * columns + j2];
+			}
+		}
+		const dcomplex* spectrum = dfft_passes(n, columns, FFT_BLOCK, twiddles, block, block_work);
+		for (size_t k2 = 0; k2 < columns; k2++) {
+			memcpy(&data[k1 + rows * k2], &spectrum[FFT_BLOCK * k2], FFT_BLOCK * sizeof(dcomplex));
+		}
+	}
+}
+
+void dfft_forward(const struct fft_plan plan[restrict static 1], dcomplex data[restrict static 1]) {
+	const size_t n = plan->n;
+	if (plan->rows != 0) {
+		dfft_blocked(plan, data);
+	} else {
+		const dcomplex* spectrum = dfft_passes(n, n, 1, plan->d_twiddles, data, plan->d_work);
+		if (spectrum != data) {
+			memcpy(data, spectrum, n * sizeof(dcomplex));
+		}
+	}
+}
+
+void dfft_inverse(const struct fft_plan plan[restrict static 1], dcomplex data[restrict static 1]) {
+	const size_t n = plan->n;
+	for (size_t k = 0; k < n; k++) {
+		data[k].im = -data[k].im;
+	}
+	dfft_forward(plan, data);
+	const double scale = 1.0 / (double) n;
+	for (size_t j = 0; j < n; j++) {
+		data[j].re *= scale;
+		data[j].im *= -scale;
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The smallest transform for which fft_plan_init selects the blocked (four-step) algorithm
+ * @details Blocking pays off only when the unblocked passes are limited by memory bandwidth. The double-precision FFT
+ *          reaches this point when the data no longer fits in the caches, while the double-double FFT is compute-bound
+ *          and gains little from blocking at any size.
+ */
+#define FFT_BLOCKED_MIN_SIZE 2097152
+
+/**
+ * @brief The number of columns or rows transformed together in the four-step algorithm
+ */
+#define FFT_BLOCK 16
+
+/**
+ * @brief Complex number with double-precision real and imaginary parts
+ */
+typedef struct {
+	double re;
+	double im;
+} dcomplex;
+
+/**
+ * @brief Precomputed data for FFTs of one size, in double-double and double precision
+ * @details Both transforms use the same algorithm: radix-4 Stockham autosort FFT, with a radix-2 pass if log2(n) is odd.
+ *          Stockham passes read and write the data with unit stride, and do not need a bit-reversal permutation.
+ *          The four-step algorithm computes FFTs of the columns and then of the rows of a rows x (n / rows) matrix,
+ *          FFT_BLOCK columns or rows at a time in a cache-resident buffer.
+ */
+struct fft_plan {
+	/* Size of the transform, a power of 2 */
+	size_t n;
+	/* exp(-2 pi i k / n) for k = 0...n-1, accurate to double-double precision */
+	ddcomplex* dd_twiddles;
+	/* dd_twiddles rounded to double precision */
+	dcomplex* d_twiddles;
+	/* Buffer for intermediate results of Stockham passes, or of the four-step algorithm */
+	ddcomplex* dd_work;
+	dcomplex* d_work;
+	/* Number of rows in the four-step algorithm, or 0 if the transform is not blocked */
+	size_t rows;
+	/* Buffers for a block of columns or rows in the four-step algorithm, NULL if the transform is not blocked */
+	ddcomplex* dd_block;
+	dcomplex* d_block;
+	/* exp(-2 pi i j2 k1 / n) for the columns j2 and rows k1 of the four-step algorithm, in the order of use */
+	ddcomplex* dd_block_twiddles;
+	dcomplex* d_block_twiddles;
+};
+
+/**
+ * @brief Allocates buffers and computes twiddle factors for FFTs of size n
+ * @details Transforms of at least FFT_BLOCKED_MIN_SIZE elements use the four-step algorithm with rows = 2**floor(log2(n) / 2).
+ * @return true on success, false if n is not a power of 2 or the memory can not be allocated.
+ */
+bool fft_plan_init(struct fft_plan FPPLUS_NONNULL_POINTER(plan), size_t n);
+
+/**
+ * @brief Allocates buffers and computes twiddle factors for FFTs of size n with the specified algorithm
+ * @param rows - 0 for the unblocked algorithm, or the number of rows of the matrix in the four-step algorithm.
+ *               Both rows and n / rows must be powers of 2 not smaller than FFT_BLOCK.
+ * @return true on success, false if n or rows are invalid or the memory can not be allocated.
+ */
+bool fft_plan_init_blocked(struct fft_plan FPPLUS_NONNULL_POINTER(plan), size_t n, size_t rows);
+
+/**
+ * @brief Releases the buffers of the plan
+ */
+void fft_plan_release(struct fft_plan FPPLUS_NONNULL_POINTER(plan));
+
+/**
+ * @brief Forward FFT in double-double precision, X[k] = sum x[j] exp(-2 pi i j k / n), in-place
+ */
+void ddfft_forward(const struct fft_plan FPPLUS_NONNULL_POINTER(plan), ddcomplex FPPLUS_NONNULL_POINTER(data));
+
+/**
+ * @brief Inverse FFT in double-double precision, x[j] = 1/n sum X[k] exp(2 pi i j k / n), in-place
+ */
+void ddfft_inverse(const struct fft_plan FPPLUS_NONNULL_POINTER(plan), ddcomplex FPPLUS_NONNULL_POINTER(data));
+
+/**
+ * @brief Forward FFT in double precision, with the same algorithm as ddfft_forward
+ */
+void dfft_forward(const struct fft_plan FPPLUS_NONNULL_POINTER(plan), dcomplex FPPLUS_NONNULL_POINTER(data));
+
+/**
+ * @brief Inverse FFT in double precision, with the same algorithm as ddfft_inverse
+ */
+void dfft_inverse(const struct fft_plan FPPLUS_NONNULL_POINTER(plan), dcomplex FPPLUS_NONNULL_POINTER(data));
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
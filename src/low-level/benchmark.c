@@ -28,57 +28,194 @@ static void warmup(size_t elements, const doubledouble array[restrict static ele
     }
 }
 
+static uint64_t min_ticks(size_t iterations, const uint64_t iteration_ticks[restrict static iterations]) {
+    uint64_t min_ticks = UINT64_MAX;
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        if (iteration_ticks[iteration] < min_ticks)
+            min_ticks = iteration_ticks[iteration];
+    }
+    return min_ticks;
+}
+
+static void report_measurement_ticks(
+    const char* operation_name, const char* suffix,
+    size_t iterations, const uint64_t iteration_ticks[restrict static iterations],
+    const double counters[restrict static perf_counter_count],
+    size_t size, size_t operations)
+{
+    double iteration_cycles[iterations];
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        iteration_cycles[iteration] = ((double) iteration_ticks[iteration]) / ((double) operations);
+    }
+    const struct sample_statistics statistics = compute_sample_statistics(iteration_cycles, iterations);
+
+    /* Operation names are tab-separated for text output, e.g. "DDADD\tLatency" -> "DDADD/Latency" */
+    char name[64];
+    snprintf(name, sizeof(name), "%s%s", operation_name, suffix);
+    for (char* tab = strchr(name, '\t'); tab != NULL; tab = strchr(tab, '\t')) {
+        *tab = '/';
+    }
+    report_measurement(name, size, report_unit_cycles_per_element, &statistics, counters);
+}
+
+/*
+ * Prints the minimum over iterations as text, or summary statistics in a machine-readable report.
+ * If addre_iteration_ticks is not NULL, also reports the kernel compiled with emulated ADDRE:
+ * as two more columns (cycles with ADDRE and projected speedup from ADDRE) in text output, or as a separate "/addre" measurement.
+ */
+static void report_ticks(
+    const char* operation_name, enum report_format format,
+    size_t iterations, const uint64_t iteration_ticks[restrict static iterations],
+    const struct perf_counter_values iteration_counters[restrict static iterations],
+    const uint64_t addre_iteration_ticks[restrict], const struct perf_counter_values addre_iteration_counters[restrict],
+    size_t size, size_t operations)
+{
+    double counters[perf_counter_count];
+    median_perf_counters(iterations, iteration_counters, (double) operations, counters);
+    if (format == report_format_text) {
+        const double cycles = ((double) min_ticks(iterations, iteration_ticks)) / ((double) operations);
+        printf("%s\t" "%10zu\t" "%.2lf", operation_name, size, cycles);
+        if (addre_iteration_ticks != NULL) {
+            const double addre_cycles = ((double) min_ticks(iterations, addre_iteration_ticks)) / ((double) operations);
+            printf("\t" "%.2lf\t" "%.2lfx", addre_cycles, cycles / addre_cycles);
+        }
+        report_text_counters(counters);
+    } else {
+        report_measurement_ticks(operation_name, "", iterations, iteration_ticks, counters, size, operations);
+        if (addre_iteration_ticks != NULL) {
+            double addre_counters[perf_counter_count];
+            median_perf_counters(iterations, addre_iteration_counters, (double) operations, addre_counters);
+            report_measurement_ticks(operation_name, "/addre", iterations, addre_iteration_ticks, addre_counters, size, operations);
+        }
+    }
+}
+
 #ifdef FPPLUS_HAVE_FLOAT128
 static void benchmark_quad(
-    benchmark_quad_function function, const char* operation_name,
+    benchmark_quad_function function, const char* operation_name, enum report_format format,
     size_t iterations, size_t elements, __float128 array[restrict static elements])
 {
-    uint64_t min_ticks = UINT64_MAX;
+    uint64_t iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations];
     for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
         const uint64_t start_ticks = cpu_ticks();
         function(elements, array);
-        const uint64_t total_ticks = cpu_ticks() - start_ticks;
-        if (total_ticks < min_ticks)
-            min_ticks = total_ticks;
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
     }
-    printf("%s\t" "%10zu\t" "%.2lf\n", operation_name, elements, ((double) min_ticks) / ((double) elements));
+    report_ticks(operation_name, format, iterations, iteration_ticks, iteration_counters, NULL, NULL, elements, elements);
 }
 #endif
 
-static void benchmark_doubledouble(
-    benchmark_doubledouble_function function, const char* operation_name,
+static void measure_doubledouble(
+    benchmark_doubledouble_function function,
     size_t iterations, size_t elements,
-    TUPLE array[restrict static elements / ELEMENTS_PER_TUPLE])
+    TUPLE array[restrict static elements / ELEMENTS_PER_TUPLE],
+    uint64_t iteration_ticks[restrict static iterations],
+    struct perf_counter_values iteration_counters[restrict static iterations])
 {
-    uint64_t min_ticks = UINT64_MAX;
     for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
         const uint64_t start_ticks = cpu_ticks();
         function(elements / ELEMENTS_PER_TUPLE, (TUPLE*) array);
-        const uint64_t total_ticks = cpu_ticks() - start_ticks;
-        if (total_ticks < min_ticks)
-            min_ticks = total_ticks;
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
     }
-    printf("%s\t" "%10zu\t" "%.2lf\n", operation_name, elements, ((double) min_ticks) / ((double) (elements / ELEMENTS_PER_TUPLE)));
 }
 
-static void benchmark_polevl(
-    benchmark_polevl_function function, const char* operation_name, size_t iterations, size_t repeats)
+/* addre_function is the same kernel compiled with emulated ADDRE, or NULL if the comparison is not requested */
+static void benchmark_doubledouble(
+    benchmark_doubledouble_function function, benchmark_doubledouble_function addre_function,
+    const char* operation_name, enum report_format format,
+    size_t iterations, size_t elements,
+    TUPLE array[restrict static elements / ELEMENTS_PER_TUPLE])
+{
+    uint64_t iteration_ticks[iterations], addre_iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations], addre_iteration_counters[iterations];
+    measure_doubledouble(function, iterations, elements, array, iteration_ticks, iteration_counters);
+    if (addre_function != NULL) {
+        measure_doubledouble(addre_function, iterations, elements, array, addre_iteration_ticks, addre_iteration_counters);
+    }
+    report_ticks(operation_name, format, iterations, iteration_ticks, iteration_counters,
+        addre_function != NULL ? addre_iteration_ticks : NULL, addre_iteration_counters,
+        elements, elements / ELEMENTS_PER_TUPLE);
+}
+
+static void measure_polevl(
+    benchmark_polevl_function function,
+    size_t iterations, size_t repeats,
+    uint64_t iteration_ticks[restrict static iterations],
+    struct perf_counter_values iteration_counters[restrict static iterations])
 {
-    uint64_t min_ticks = UINT64_MAX;
     for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
         const uint64_t start_ticks = cpu_ticks();
         #ifndef __KNC__
             function(M_PI, repeats);
         #else
             function(_mm512_set1_pd(M_PI), repeats);
         #endif
-        const uint64_t total_ticks = cpu_ticks() - start_ticks;
-        if (total_ticks < min_ticks)
-            min_ticks = total_ticks;
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+}
+
+static void benchmark_polevl(
+    benchmark_polevl_function function, benchmark_polevl_function addre_function,
+    const char* operation_name, enum report_format format,
+    size_t iterations, size_t repeats)
+{
+    uint64_t iteration_ticks[iterations], addre_iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations], addre_iteration_counters[iterations];
+    measure_polevl(function, iterations, repeats, iteration_ticks, iteration_counters);
+    if (addre_function != NULL) {
+        measure_polevl(addre_function, iterations, repeats, addre_iteration_ticks, addre_iteration_counters);
     }
-    printf("%s\t" "%10zu\t" "%.2lf\n", operation_name, repeats, ((double) min_ticks) / ((double) repeats));
+    report_ticks(operation_name, format, iterations, iteration_ticks, iteration_counters,
+        addre_function != NULL ? addre_iteration_ticks : NULL, addre_iteration_counters,
+        repeats, repeats);
 }
 
+#ifndef __KNC__
+static void measure_operation(
+    benchmark_operation_function function,
+    size_t iterations, size_t repeats, double array[restrict static 16 * repeats],
+    uint64_t iteration_ticks[restrict static iterations],
+    struct perf_counter_values iteration_counters[restrict static iterations])
+{
+    /* Throughput benchmarks modify the array: restart each operation from the same data */
+    for (size_t i = 0; i < 16 * repeats; i++) {
+        array[i] = 1.0;
+    }
+    function(repeats, array);
+
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        perf_counters_start();
+        const uint64_t start_ticks = cpu_ticks();
+        function(repeats, array);
+        iteration_ticks[iteration] = cpu_ticks() - start_ticks;
+        perf_counters_stop(&iteration_counters[iteration]);
+    }
+}
+
+static void benchmark_operation(
+    benchmark_operation_function function, benchmark_operation_function addre_function,
+    const char* operation_name, enum report_format format,
+    size_t iterations, size_t repeats, double array[restrict static 16 * repeats])
+{
+    uint64_t iteration_ticks[iterations], addre_iteration_ticks[iterations];
+    struct perf_counter_values iteration_counters[iterations], addre_iteration_counters[iterations];
+    measure_operation(function, iterations, repeats, array, iteration_ticks, iteration_counters);
+    if (addre_function != NULL) {
+        measure_operation(addre_function, iterations, repeats, array, addre_iteration_ticks, addre_iteration_counters);
+    }
+    report_ticks(operation_name, format, iterations, iteration_ticks, iteration_counters,
+        addre_function != NULL ? addre_iteration_ticks : NULL, addre_iteration_counters,
+        repeats, repeats);
+}
+#endif
+
 int main(int argc, char *argv[]) {
     const struct benchmark_options options = parse_options(argc, argv);
 
@@ -87,6 +224,9 @@ int main(int argc, char *argv[]) {
     switch (options.type) {
         case benchmark_type_doubledouble_latency:
         case benchmark_type_doubledouble_throughput:
+#ifndef __KNC__
+        case benchmark_type_doubledouble_cxx:
+#endif
 #ifdef FPPLUS_HAVE_FLOAT128
         case benchmark_type_quad_latency:
 #endif
@@ -98,41 +238,195 @@ int main(int argc, char *argv[]) {
             break;
         case benchmark_type_polevl_latency:
             break;
+#ifndef __KNC__
+        case benchmark_type_eft_latency:
+        case benchmark_type_eft_throughput:
+        case benchmark_type_simd_latency:
+        case benchmark_type_simd_throughput:
+        case benchmark_type_layout_throughput:
+        case benchmark_type_complex_latency:
+        case benchmark_type_complex_throughput:
+        case benchmark_type_interval_latency:
+        case benchmark_type_interval_throughput:
+            v_array = valloc(options.repeats * 16 * sizeof(double));
+            break;
+#endif
         case benchmark_type_none:
             __builtin_unreachable();
     }
 
+    /* Expands to the kernel and its version compiled with emulated ADDRE, or NULL if the comparison is not requested */
+    #define KERNELS(kernel) kernel, (options.addre ? addre_##kernel : NULL)
+    #define DOUBLEDOUBLE_KERNELS(kernel) \
+        (benchmark_doubledouble_function) kernel, \
+        (options.addre ? (benchmark_doubledouble_function) addre_##kernel : NULL)
+
+    perf_counters_open(options.counters);
+    report_begin(options.format, "ubench", argc, argv);
     switch (options.type) {
         case benchmark_type_doubledouble_latency:
-            benchmark_doubledouble((benchmark_doubledouble_function) vsum,
-                "DDADD\tLatency", options.iterations, options.repeats, v_array);
-            benchmark_doubledouble((benchmark_doubledouble_function) vprod,
-                "DDMUL\tLatency", options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(DOUBLEDOUBLE_KERNELS(vsum),
+                "DDADD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(DOUBLEDOUBLE_KERNELS(vprod),
+                "DDMUL\tLatency", options.format, options.iterations, options.repeats, v_array);
             break;
         case benchmark_type_doubledouble_throughput:
-            benchmark_doubledouble(vaddc_helper,
-                "DDADD\tThroughput", options.iterations, options.repeats, v_array);
-            benchmark_doubledouble(vmulc_helper,
-                "DDMUL\tThroughput", options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(DOUBLEDOUBLE_KERNELS(vaddc_helper),
+                "DDADD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(DOUBLEDOUBLE_KERNELS(vmulc_helper),
+                "DDMUL\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            break;
+#ifndef __KNC__
+        case benchmark_type_doubledouble_cxx:
+            /* Codegen check: fpplus::dd C++ class should be as fast as C API */
+            benchmark_doubledouble((benchmark_doubledouble_function) vsum, NULL,
+                "DDADD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble((benchmark_doubledouble_function) cxx_vsum, NULL,
+                "DDADD/C++\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble((benchmark_doubledouble_function) vprod, NULL,
+                "DDMUL\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble((benchmark_doubledouble_function) cxx_vprod, NULL,
+                "DDMUL/C++\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(vaddc_helper, NULL,
+                "DDADD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(cxx_vaddc_helper, NULL,
+                "DDADD/C++\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(vmulc_helper, NULL,
+                "DDMUL\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_doubledouble(cxx_vmulc_helper, NULL,
+                "DDMUL/C++\tThroughput", options.format, options.iterations, options.repeats, v_array);
             break;
+#endif
 #ifdef FPPLUS_HAVE_FLOAT128
         case benchmark_type_quad_latency:
             for (__float128* q_array = v_array; q_array != v_array + array_size; q_array++) {
                 *q_array = 1.235412347891354098213343278Q;
             }
             benchmark_quad(qsum,
-                "QADD\tLatency", options.iterations, options.repeats, v_array);
+                "QADD\tLatency", options.format, options.iterations, options.repeats, v_array);
             benchmark_quad(qprod,
-                "QMUL\tLatency", options.iterations, options.repeats, v_array);
+                "QMUL\tLatency", options.format, options.iterations, options.repeats, v_array);
             break;
 #endif
         case benchmark_type_polevl_latency:
-            benchmark_polevl(benchmark_compensated_horner15, "HORNER/COMP\tLatency", options.iterations, options.repeats);
-            benchmark_polevl(benchmark_fma_horner15, "HORNER/FMA\tLatency", options.iterations, options.repeats);
-            benchmark_polevl(benchmark_muladd_horner15, "HORNER/MAC\tLatency", options.iterations, options.repeats);
+            benchmark_polevl(KERNELS(benchmark_compensated_horner15), "HORNER/COMP\tLatency", options.format, options.iterations, options.repeats);
+            benchmark_polevl(KERNELS(benchmark_fma_horner15), "HORNER/FMA\tLatency", options.format, options.iterations, options.repeats);
+            benchmark_polevl(KERNELS(benchmark_muladd_horner15), "HORNER/MAC\tLatency", options.format, options.iterations, options.repeats);
+            break;
+#ifndef __KNC__
+        case benchmark_type_eft_latency:
+            benchmark_operation(KERNELS(benchmark_efadd_latency), "EFADD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_efaddord_latency), "EFADDORD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_efmul_latency), "EFMUL\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_effma_latency), "EFFMA\tLatency", options.format, options.iterations, options.repeats, v_array);
+            break;
+        case benchmark_type_eft_throughput:
+            benchmark_operation(KERNELS(benchmark_efadd_throughput), "EFADD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_efaddord_throughput), "EFADDORD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_efmul_throughput), "EFMUL\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_effma_throughput), "EFFMA\tThroughput", options.format, options.iterations, options.repeats, v_array);
             break;
+        case benchmark_type_simd_latency:
+            benchmark_operation(KERNELS(benchmark_mm_efadd_latency), "EFADD/XMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm_efmul_latency), "EFMUL/XMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm_effma_latency), "EFFMA/XMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efadd_latency), "EFADD/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efmul_latency), "EFMUL/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_effma_latency), "EFFMA/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pdd_latency), "DDADD/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_fast_pdd_latency), "DDADD-FAST/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pdd_latency), "DDMUL/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_loaddeinterleave_interleavestore_latency), "DDLOAD+STORE/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efadd_ps_latency), "EFADD/YMM-PS\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efmul_ps_latency), "EFMUL/YMM-PS\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pff_latency), "FFADD/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_fast_pff_latency), "FFADD-FAST/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pff_latency), "FFMUL/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_loaddeinterleave_interleavestore_pff_latency), "FFLOAD+STORE/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            break;
+        case benchmark_type_simd_throughput:
+            benchmark_operation(KERNELS(benchmark_mm_efadd_throughput), "EFADD/XMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm_efmul_throughput), "EFMUL/XMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm_effma_throughput), "EFFMA/XMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efadd_throughput), "EFADD/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efmul_throughput), "EFMUL/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_effma_throughput), "EFFMA/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pdd_throughput), "DDADD/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_fast_pdd_throughput), "DDADD-FAST/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pdd_throughput), "DDMUL/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_loaddeinterleave_interleavestore_throughput), "DDLOAD+STORE/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efadd_ps_throughput), "EFADD/YMM-PS\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_efmul_ps_throughput), "EFMUL/YMM-PS\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pff_throughput), "FFADD/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_fast_pff_throughput), "FFADD-FAST/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pff_throughput), "FFMUL/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_loaddeinterleave_interleavestore_pff_throughput), "FFLOAD+STORE/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            break;
+        case benchmark_type_layout_throughput:
+            benchmark_operation(KERNELS(benchmark_aos_ddadd_throughput), "DDADD/AOS\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_soa_ddadd_throughput), "DDADD/SOA\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_aosoa_ddadd_throughput), "DDADD/AOSOA\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_aos_ddmul_throughput), "DDMUL/AOS\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_soa_ddmul_throughput), "DDMUL/SOA\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_aosoa_ddmul_throughput), "DDMUL/AOSOA\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            break;
+        case benchmark_type_complex_latency:
+            benchmark_operation(KERNELS(benchmark_ddcadd_latency), "DDCADD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcmul_latency), "DDCMUL\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcmul3_latency), "DDCMUL3\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcdiv_latency), "DDCDIV\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcabs_latency), "DDCABS\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pddc_latency), "DDCADD/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pddc_latency), "DDCMUL/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul3_pddc_latency), "DDCMUL3/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_div_pddc_latency), "DDCDIV/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_abs_pddc_latency), "DDCABS/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            break;
+        case benchmark_type_complex_throughput:
+            benchmark_operation(KERNELS(benchmark_ddcadd_throughput), "DDCADD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcmul_throughput), "DDCMUL\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcmul3_throughput), "DDCMUL3\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcdiv_throughput), "DDCDIV\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddcabs_throughput), "DDCABS\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pddc_throughput), "DDCADD/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pddc_throughput), "DDCMUL/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul3_pddc_throughput), "DDCMUL3/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_div_pddc_throughput), "DDCDIV/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_abs_pddc_throughput), "DDCABS/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            break;
+        case benchmark_type_interval_latency:
+            benchmark_operation(KERNELS(benchmark_ivadd_latency), "IVADD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivadd_fesetround_latency), "IVADD/FESETROUND\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivadd_upward_latency), "IVADD/UPWARD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivmul_latency), "IVMUL\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivmul_fesetround_latency), "IVMUL/FESETROUND\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivmul_upward_latency), "IVMUL/UPWARD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddivadd_latency), "DDIVADD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddivmul_latency), "DDIVMUL\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pdi_latency), "IVADD/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pdi_upward_latency), "IVADD/YMM-UPWARD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pdi_latency), "IVMUL/YMM\tLatency", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pdi_upward_latency), "IVMUL/YMM-UPWARD\tLatency", options.format, options.iterations, options.repeats, v_array);
+            break;
+        case benchmark_type_interval_throughput:
+            benchmark_operation(KERNELS(benchmark_ivadd_throughput), "IVADD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivadd_fesetround_throughput), "IVADD/FESETROUND\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivadd_upward_throughput), "IVADD/UPWARD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivmul_throughput), "IVMUL\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivmul_fesetround_throughput), "IVMUL/FESETROUND\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ivmul_upward_throughput), "IVMUL/UPWARD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddivadd_throughput), "DDIVADD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_ddivmul_throughput), "DDIVMUL\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pdi_throughput), "IVADD/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_add_pdi_upward_throughput), "IVADD/YMM-UPWARD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pdi_throughput), "IVMUL/YMM\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            benchmark_operation(KERNELS(benchmark_mm256_mul_pdi_upward_throughput), "IVMUL/YMM-UPWARD\tThroughput", options.format, options.iterations, options.repeats, v_array);
+            break;
+#endif
         case benchmark_type_none:
             __builtin_unreachable();
     }
+    report_end();
+    perf_counters_close();
     free(v_array);
 }
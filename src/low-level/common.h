@@ -5,8 +5,11 @@ extern "C" {
 #endif
 
 #include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include <math.h>
 #include <fpplus.h>
+#include <report.h>
 #ifdef FPPLUS_HAVE_FLOAT128
 #include <quadmath.h>
 #endif
@@ -16,55 +19,83 @@ enum benchmark_type {
 	benchmark_type_none = 0,
 	benchmark_type_doubledouble_latency,
 	benchmark_type_doubledouble_throughput,
+#ifndef __KNC__
+	benchmark_type_doubledouble_cxx,
+#endif
 #ifdef FPPLUS_HAVE_FLOAT128
 	benchmark_type_quad_latency,
 #endif
 	benchmark_type_polevl_latency,
+#ifndef __KNC__
+	benchmark_type_eft_latency,
+	benchmark_type_eft_throughput,
+	benchmark_type_simd_latency,
+	benchmark_type_simd_throughput,
+	benchmark_type_layout_throughput,
+	benchmark_type_complex_latency,
+	benchmark_type_complex_throughput,
+	benchmark_type_interval_latency,
+	benchmark_type_interval_throughput,
+#endif
 };
 
 struct benchmark_options {
 	enum benchmark_type type;
 	size_t iterations;
 	size_t repeats;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+	/* Also benchmark the kernels compiled with emulated ADDRE */
+	bool addre;
 };
 
 struct benchmark_options parse_options(int argc, char** argv);
 
 
-/* Benchmarks of double-double precision operations */
 #ifndef __KNC__
 	typedef doubledouble (*benchmark_doubledouble_function)(size_t, doubledouble*restrict);
-	
-	doubledouble vsum(size_t array_elements, const doubledouble array[restrict static array_elements]);
-	doubledouble vprod(size_t array_elements, const doubledouble array[restrict static array_elements]);
-	void vaddc(size_t augend_elements, doubledouble augend[restrict static augend_elements], const doubledouble addend);
-	void vmulc(size_t multiplicand_elements, doubledouble multiplicand[restrict static multiplicand_elements], const doubledouble multiplier);
-
-	inline static doubledouble vaddc_helper(size_t array_elements, doubledouble array[restrict static array_elements]) {
-		vaddc(array_elements, array, (doubledouble) { M_E, M_PI });
-		return (doubledouble) { 0.0, 0.0 };
-	}
-
-	inline static doubledouble vmulc_helper(size_t array_elements, doubledouble array[restrict static array_elements]) {
-		vmulc(array_elements, array, (doubledouble) { M_E, M_PI });
-		return (doubledouble) { 0.0, 0.0 };
-	}
+	typedef double (*benchmark_polevl_function)(double, size_t);
+	/* Each repeat may use up to 16 doubles (128 bytes) of the array, which must be 32-byte aligned */
+	typedef double (*benchmark_operation_function)(size_t, double*restrict);
 #else
 	typedef __m512dd (*benchmark_doubledouble_function)(size_t, __m512dd*restrict);
-	
-	__m512dd vsum(size_t array_elements, const __m512dd array[restrict static array_elements]);
-	__m512dd vprod(size_t array_elements, const __m512dd array[restrict static array_elements]);
-	void vaddc(size_t augend_elements, __m512dd augend[restrict static augend_elements], const __m512dd addend);
-	void vmulc(size_t multiplicand_elements, __m512dd multiplicand[restrict static multiplicand_elements], const __m512dd multiplier);
-
-	inline static __m512dd vaddc_helper(size_t array_elements, __m512dd array[restrict static array_elements]) {
-		vaddc(array_elements, array, (__m512dd) { _mm512_set1_pd(M_E), _mm512_set1_pd(M_PI) });
-		return _mm512_setzero_pdd();
+	typedef __m512d (*benchmark_polevl_function)(__m512d, size_t);
+#endif
+
+/*
+ * Kernels which use error-free transformations are compiled twice: with the default configuration,
+ * and with -DFPPLUS_BENCHMARK_ADDRE -DFPPLUS_EMULATE_FPADDRE, which emulates ADDRE and adds addre_ prefix to kernel names.
+ */
+#define BENCHMARK_KERNEL(name) name
+#include <low-level/kernels.h>
+#undef BENCHMARK_KERNEL
+
+#define BENCHMARK_KERNEL(name) addre_##name
+#include <low-level/kernels.h>
+#undef BENCHMARK_KERNEL
+
+#ifdef FPPLUS_BENCHMARK_ADDRE
+	#define BENCHMARK_KERNEL(name) addre_##name
+#else
+	#define BENCHMARK_KERNEL(name) name
+#endif
+
+#ifndef __KNC__
+	/* Double-double benchmarks written with fpplus::dd C++ class (doubledouble.cpp) */
+	doubledouble cxx_vsum(size_t array_elements, const doubledouble array[restrict static array_elements]);
+	doubledouble cxx_vprod(size_t array_elements, const doubledouble array[restrict static array_elements]);
+	void cxx_vaddc(size_t augend_elements, doubledouble augend[restrict static augend_elements], const doubledouble addend);
+	void cxx_vmulc(size_t multiplicand_elements, doubledouble multiplicand[restrict static multiplicand_elements], const doubledouble multiplier);
+
+	inline static doubledouble cxx_vaddc_helper(size_t array_elements, doubledouble array[restrict static array_elements]) {
+		cxx_vaddc(array_elements, array, (doubledouble) { M_E, M_PI });
+		return (doubledouble) { 0.0, 0.0 };
 	}
 
-	inline static __m512dd vmulc_helper(size_t array_elements, __m512dd array[restrict static array_elements]) {
-		vmulc(array_elements, array, (__m512dd) { _mm512_set1_pd(M_E), _mm512_set1_pd(M_PI) });
-		return _mm512_setzero_pdd();
+	inline static doubledouble cxx_vmulc_helper(size_t array_elements, doubledouble array[restrict static array_elements]) {
+		cxx_vmulc(array_elements, array, (doubledouble) { M_E, M_PI });
+		return (doubledouble) { 0.0, 0.0 };
 	}
 #endif
 
@@ -76,22 +107,6 @@ struct benchmark_options parse_options(int argc, char** argv);
 	__float128 qprod(size_t array_elements, const __float128 array[restrict static array_elements]);
 #endif
 
-
-/* Benchmarks of polynomial evaluation latency */
-#ifndef __KNC__
-	typedef double (*benchmark_polevl_function)(double, size_t);
-
-	double benchmark_compensated_horner15(double x, size_t iterations);
-	double benchmark_muladd_horner15(double x, size_t iterations);
-	double benchmark_fma_horner15(double x, size_t iterations);
-#else
-	typedef __m512d (*benchmark_polevl_function)(__m512d, size_t);
-
-	__m512d benchmark_compensated_horner15(__m512d x, size_t iterations);
-	__m512d benchmark_muladd_horner15(__m512d x, size_t iterations);
-	__m512d benchmark_fma_horner15(__m512d x, size_t iterations);
-#endif
-
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
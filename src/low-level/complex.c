@@ -0,0 +1,198 @@
+#include <low-level/common.h>
+
+#include <fpplus.h>
+
+/*
+ * Benchmarks of complex double-double operations
+ *
+ * Latency benchmarks chain the result of the operation into its next call, with a constant second operand.
+ * Multiplication and division use a second operand of unit magnitude, so the chained result stays in range,
+ * and the magnitude benchmark replaces the real part of the number with its magnitude.
+ * Throughput benchmarks apply the operation to independent numbers (scalar) or SIMD vectors (4 numbers) of an array.
+ */
+
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_ddcadd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex addend = { { M_E, 0x1.0p-60 }, { M_PI, 0x1.0p-60 } };
+		ddcomplex number = *((const ddcomplex*) array);
+		do {
+			number = ddcadd(number, addend);
+		} while (--repeats);
+		return number.re.hi + number.im.hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcmul_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		ddcomplex number = *((const ddcomplex*) array);
+		do {
+			number = ddcmul(number, multiplier);
+		} while (--repeats);
+		return number.re.hi + number.im.hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcmul3_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		ddcomplex number = *((const ddcomplex*) array);
+		do {
+			number = ddcmul3(number, multiplier);
+		} while (--repeats);
+		return number.re.hi + number.im.hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcdiv_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex divisor = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		ddcomplex number = *((const ddcomplex*) array);
+		do {
+			number = ddcdiv(number, divisor);
+		} while (--repeats);
+		return number.re.hi + number.im.hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcabs_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		ddcomplex number = *((const ddcomplex*) array);
+		do {
+			number.re = ddcabs(number);
+		} while (--repeats);
+		return number.re.hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex addend = { { M_E, 0x1.0p-60 }, { M_PI, 0x1.0p-60 } };
+		ddcomplex* numbers = (ddcomplex*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			numbers[i] = ddcadd(numbers[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		ddcomplex* numbers = (ddcomplex*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			numbers[i] = ddcmul(numbers[i], multiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcmul3_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		ddcomplex* numbers = (ddcomplex*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			numbers[i] = ddcmul3(numbers[i], multiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcdiv_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex divisor = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		ddcomplex* numbers = (ddcomplex*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			numbers[i] = ddcdiv(numbers[i], divisor);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddcabs_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		ddcomplex* numbers = (ddcomplex*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			numbers[i].re = ddcabs(numbers[i]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex addend = { { M_E, 0x1.0p-60 }, { M_PI, 0x1.0p-60 } };
+		const __m256ddc vaddend = _mm256_broadcast_sddc(&addend);
+		__m256ddc numbers = *((const __m256ddc*) array);
+		do {
+			numbers = _mm256_add_pddc(numbers, vaddend);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(numbers.re.hi, numbers.im.hi)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		const __m256ddc vmultiplier = _mm256_broadcast_sddc(&multiplier);
+		__m256ddc numbers = *((const __m256ddc*) array);
+		do {
+			numbers = _mm256_mul_pddc(numbers, vmultiplier);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(numbers.re.hi, numbers.im.hi)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul3_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		const __m256ddc vmultiplier = _mm256_broadcast_sddc(&multiplier);
+		__m256ddc numbers = *((const __m256ddc*) array);
+		do {
+			numbers = _mm256_mul3_pddc(numbers, vmultiplier);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(numbers.re.hi, numbers.im.hi)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_div_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex divisor = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		const __m256ddc vdivisor = _mm256_broadcast_sddc(&divisor);
+		__m256ddc numbers = *((const __m256ddc*) array);
+		do {
+			numbers = _mm256_div_pddc(numbers, vdivisor);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(numbers.re.hi, numbers.im.hi)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_abs_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256ddc numbers = *((const __m256ddc*) array);
+		do {
+			numbers.re = _mm256_abs_pddc(numbers);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(numbers.re.hi));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex addend = { { M_E, 0x1.0p-60 }, { M_PI, 0x1.0p-60 } };
+		const __m256ddc vaddend = _mm256_broadcast_sddc(&addend);
+		__m256ddc* vectors = (__m256ddc*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_add_pddc(vectors[i], vaddend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		const __m256ddc vmultiplier = _mm256_broadcast_sddc(&multiplier);
+		__m256ddc* vectors = (__m256ddc*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_mul_pddc(vectors[i], vmultiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul3_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex multiplier = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		const __m256ddc vmultiplier = _mm256_broadcast_sddc(&multiplier);
+		__m256ddc* vectors = (__m256ddc*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_mul3_pddc(vectors[i], vmultiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_div_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddcomplex divisor = { { 0.6, 0x1.0p-60 }, { 0.8, 0x1.0p-60 } };
+		const __m256ddc vdivisor = _mm256_broadcast_sddc(&divisor);
+		__m256ddc* vectors = (__m256ddc*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_div_pddc(vectors[i], vdivisor);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_abs_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256ddc* vectors = (__m256ddc*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i].re = _mm256_abs_pddc(vectors[i]);
+		}
+		return 0.0;
+	}
+#endif
@@ -0,0 +1,39 @@
+#include <cstddef>
+
+#include <fpplus/dd.hpp>
+
+/*
+ * Versions of the double-double benchmarks in doubledouble.c written with fpplus::dd class.
+ * The loops are the same, and the class is expected to compile to the same code as the C API:
+ * doubledouble-cxx benchmark type reports both versions next to each other.
+ */
+
+#ifndef __KNC__
+	extern "C" doubledouble cxx_vsum(size_t array_elements, const doubledouble* __restrict__ array) {
+		fpplus::dd sum = 0.0;
+		do {
+			sum += *array++;
+		} while (--array_elements);
+		return sum;
+	}
+
+	extern "C" doubledouble cxx_vprod(size_t array_elements, const doubledouble* __restrict__ array) {
+		fpplus::dd prod = 1.0;
+		do {
+			prod *= *array++;
+		} while (--array_elements);
+		return prod;
+	}
+
+	extern "C" void cxx_vaddc(size_t augend_elements, doubledouble* __restrict__ augend, const doubledouble addend) {
+		for (size_t i = 0; i < augend_elements; i++) {
+			augend[i] = fpplus::dd(augend[i]) + addend;
+		}
+	}
+
+	extern "C" void cxx_vmulc(size_t multiplicand_elements, doubledouble* __restrict__ multiplicand, const doubledouble multiplier) {
+		for (size_t i = 0; i < multiplicand_elements; i++) {
+			multiplicand[i] = fpplus::dd(multiplicand[i]) * multiplier;
+		}
+	}
+#endif
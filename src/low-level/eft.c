@@ -0,0 +1,85 @@
+#include <low-level/common.h>
+
+#include <fpplus.h>
+
+/*
+ * Benchmarks of scalar error-free transformations
+ *
+ * Latency benchmarks chain the outputs of a transformation into the inputs of the next one.
+ * efadd and efaddord feed back both the sum and the error term, so the chain goes through the slower error output.
+ * efmul and effma feed back only the rounded result, and accumulate the error terms off the critical path.
+ *
+ * Throughput benchmarks apply the transformation to independent elements of an array,
+ * like vaddc and vmulc do for double-double operations.
+ */
+
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_efadd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		double a = array[0], b = array[1];
+		do {
+			a = efadd(a, b, &b);
+		} while (--repeats);
+		return a + b;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_efaddord_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		double a = array[0], b = array[1];
+		do {
+			a = efaddord(a, b, &b);
+		} while (--repeats);
+		return a + b;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_efmul_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		double a = array[0], error_sum = 0.0;
+		const double b = array[1];
+		do {
+			double e;
+			a = efmul(a, b, &e);
+			error_sum += e;
+		} while (--repeats);
+		return a + error_sum;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_effma_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const double a = array[0], b = array[1];
+		double c = array[2], error_high_sum = 0.0, error_low_sum = 0.0;
+		do {
+			double e_high, e_low;
+			c = effma(a, b, c, &e_high, &e_low);
+			error_high_sum += e_high;
+			error_low_sum += e_low;
+		} while (--repeats);
+		return c + error_high_sum + error_low_sum;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_efadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		for (size_t i = 0; i < repeats; i++) {
+			array[2*i] = efadd(array[2*i], array[2*i+1], &array[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_efaddord_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		for (size_t i = 0; i < repeats; i++) {
+			array[2*i] = efaddord(array[2*i], array[2*i+1], &array[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_efmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const double multiplier = 1.0 + 0x1.0p-20;
+		for (size_t i = 0; i < repeats; i++) {
+			array[2*i] = efmul(array[2*i], multiplier, &array[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_effma_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const double multiplier = 1.0 + 0x1.0p-20;
+		for (size_t i = 0; i < repeats; i++) {
+			array[4*i+2] = effma(array[4*i], multiplier, array[4*i+2], &array[4*i+1], &array[4*i+3]);
+		}
+		return 0.0;
+	}
+#endif
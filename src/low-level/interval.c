@@ -0,0 +1,364 @@
+#include <fenv.h>
+
+#include <low-level/common.h>
+
+#include <fpplus.h>
+
+/*
+ * Benchmarks of interval arithmetic with outward rounding from error-free transformations,
+ * and of the same operations with the rounding mode switched by fesetround.
+ *
+ * FESETROUND kernels switch the rounding mode to downward for the lower endpoint and to upward for the upper endpoint
+ * of each operation, and restore round-to-nearest after it, as a library of interval functions callable from ordinary code does.
+ * UPWARD kernels switch to upward rounding once per kernel call, and compute lower endpoints as -((-a) op b),
+ * as interval code which runs entirely in upward rounding does.
+ *
+ * Latency benchmarks chain the result of the operation into its next call, with a constant second operand.
+ * Multiplication uses a second operand [-0.75, 1], so the chained interval stays in range.
+ * Throughput benchmarks apply the operation to independent intervals (scalar) or SIMD vectors (4 intervals) of an array.
+ */
+
+/*
+ * The kernels are compiled without -frounding-math, so the compiler assumes round-to-nearest and could move floating-point
+ * operations across fesetround calls, or fold -((-a) * b) into a * b. An empty asm statement which pretends to modify
+ * its operand pins the operand to its place in the code, and hides its value from the optimizer.
+ */
+#define ROUNDING_BARRIER(value) __asm__ __volatile__ ("" : "+x" (value))
+
+#ifndef __KNC__
+	static inline double min(double a, double b) {
+		return a < b ? a : b;
+	}
+
+	static inline double max(double a, double b) {
+		return a > b ? a : b;
+	}
+
+	static inline doubleinterval ivadd_fesetround(doubleinterval a, const doubleinterval b) {
+		doubleinterval sum;
+		fesetround(FE_DOWNWARD);
+		ROUNDING_BARRIER(a.inf);
+		sum.inf = a.inf + b.inf;
+		ROUNDING_BARRIER(sum.inf);
+		fesetround(FE_UPWARD);
+		ROUNDING_BARRIER(a.sup);
+		sum.sup = a.sup + b.sup;
+		ROUNDING_BARRIER(sum.sup);
+		fesetround(FE_TONEAREST);
+		return sum;
+	}
+
+	static inline doubleinterval ivmul_fesetround(doubleinterval a, const doubleinterval b) {
+		doubleinterval product;
+		fesetround(FE_DOWNWARD);
+		ROUNDING_BARRIER(a.inf);
+		ROUNDING_BARRIER(a.sup);
+		product.inf = min(min(a.inf * b.inf, a.inf * b.sup), min(a.sup * b.inf, a.sup * b.sup));
+		ROUNDING_BARRIER(product.inf);
+		fesetround(FE_UPWARD);
+		ROUNDING_BARRIER(a.inf);
+		ROUNDING_BARRIER(a.sup);
+		product.sup = max(max(a.inf * b.inf, a.inf * b.sup), max(a.sup * b.inf, a.sup * b.sup));
+		ROUNDING_BARRIER(product.sup);
+		fesetround(FE_TONEAREST);
+		return product;
+	}
+
+	/* Must be called in upward rounding mode */
+	static inline doubleinterval ivadd_upward(const doubleinterval a, const doubleinterval b) {
+		double neg_inf = -a.inf;
+		ROUNDING_BARRIER(neg_inf);
+		return (doubleinterval) { -(neg_inf - b.inf), a.sup + b.sup };
+	}
+
+	/* Must be called in upward rounding mode */
+	static inline doubleinterval ivmul_upward(const doubleinterval a, const doubleinterval b) {
+		double neg_a_inf = -a.inf, neg_a_sup = -a.sup;
+		ROUNDING_BARRIER(neg_a_inf);
+		ROUNDING_BARRIER(neg_a_sup);
+		const double neg_lower = max(max(neg_a_inf * b.inf, neg_a_inf * b.sup), max(neg_a_sup * b.inf, neg_a_sup * b.sup));
+		const double upper = max(max(a.inf * b.inf, a.inf * b.sup), max(a.sup * b.inf, a.sup * b.sup));
+		return (doubleinterval) { -neg_lower, upper };
+	}
+
+	/* Must be called in upward rounding mode */
+	static inline __m256di _mm256_add_pdi_upward(const __m256di a, const __m256di b) {
+		__m256d neg_inf = _mm256_xor_pd(a.inf, _mm256_set1_pd(-0.0));
+		ROUNDING_BARRIER(neg_inf);
+		return (__m256di) {
+			_mm256_xor_pd(_mm256_sub_pd(neg_inf, b.inf), _mm256_set1_pd(-0.0)),
+			_mm256_add_pd(a.sup, b.sup)
+		};
+	}
+
+	/* Must be called in upward rounding mode */
+	static inline __m256di _mm256_mul_pdi_upward(const __m256di a, const __m256di b) {
+		__m256d neg_a_inf = _mm256_xor_pd(a.inf, _mm256_set1_pd(-0.0));
+		__m256d neg_a_sup = _mm256_xor_pd(a.sup, _mm256_set1_pd(-0.0));
+		ROUNDING_BARRIER(neg_a_inf);
+		ROUNDING_BARRIER(neg_a_sup);
+		const __m256d neg_lower = _mm256_max_pd(
+			_mm256_max_pd(_mm256_mul_pd(neg_a_inf, b.inf), _mm256_mul_pd(neg_a_inf, b.sup)),
+			_mm256_max_pd(_mm256_mul_pd(neg_a_sup, b.inf), _mm256_mul_pd(neg_a_sup, b.sup)));
+		const __m256d upper = _mm256_max_pd(
+			_mm256_max_pd(_mm256_mul_pd(a.inf, b.inf), _mm256_mul_pd(a.inf, b.sup)),
+			_mm256_max_pd(_mm256_mul_pd(a.sup, b.inf), _mm256_mul_pd(a.sup, b.sup)));
+		return (__m256di) { _mm256_xor_pd(neg_lower, _mm256_set1_pd(-0.0)), upper };
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivadd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		doubleinterval interval = *((const doubleinterval*) array);
+		do {
+			interval = ivadd(interval, addend);
+		} while (--repeats);
+		return interval.inf + interval.sup;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivadd_fesetround_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		doubleinterval interval = *((const doubleinterval*) array);
+		do {
+			interval = ivadd_fesetround(interval, addend);
+		} while (--repeats);
+		return interval.inf + interval.sup;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivadd_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		doubleinterval interval = *((const doubleinterval*) array);
+		fesetround(FE_UPWARD);
+		ROUNDING_BARRIER(interval.inf);
+		ROUNDING_BARRIER(interval.sup);
+		do {
+			interval = ivadd_upward(interval, addend);
+		} while (--repeats);
+		ROUNDING_BARRIER(interval.inf);
+		ROUNDING_BARRIER(interval.sup);
+		fesetround(FE_TONEAREST);
+		return interval.inf + interval.sup;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivmul_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		doubleinterval interval = *((const doubleinterval*) array);
+		do {
+			interval = ivmul(interval, multiplier);
+		} while (--repeats);
+		return interval.inf + interval.sup;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivmul_fesetround_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		doubleinterval interval = *((const doubleinterval*) array);
+		do {
+			interval = ivmul_fesetround(interval, multiplier);
+		} while (--repeats);
+		return interval.inf + interval.sup;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivmul_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		doubleinterval interval = *((const doubleinterval*) array);
+		fesetround(FE_UPWARD);
+		ROUNDING_BARRIER(interval.inf);
+		ROUNDING_BARRIER(interval.sup);
+		do {
+			interval = ivmul_upward(interval, multiplier);
+		} while (--repeats);
+		ROUNDING_BARRIER(interval.inf);
+		ROUNDING_BARRIER(interval.sup);
+		fesetround(FE_TONEAREST);
+		return interval.inf + interval.sup;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddivadd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddinterval addend = { { M_E, 0x1.0p-60 }, { M_PI, 0x1.0p-60 } };
+		ddinterval interval = *((const ddinterval*) array);
+		do {
+			interval = ddivadd(interval, addend);
+		} while (--repeats);
+		return interval.inf.hi + interval.sup.hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddivmul_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddinterval multiplier = { { -0.75, 0x1.0p-60 }, { 1.0, 0x1.0p-60 } };
+		ddinterval interval = *((const ddinterval*) array);
+		do {
+			interval = ddivmul(interval, multiplier);
+		} while (--repeats);
+		return interval.inf.hi + interval.sup.hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		const __m256di vaddend = _mm256_broadcast_sdi(&addend);
+		__m256di intervals = *((const __m256di*) array);
+		do {
+			intervals = _mm256_add_pdi(intervals, vaddend);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(intervals.inf, intervals.sup)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		const __m256di vaddend = _mm256_broadcast_sdi(&addend);
+		__m256di intervals = *((const __m256di*) array);
+		fesetround(FE_UPWARD);
+		ROUNDING_BARRIER(intervals.inf);
+		ROUNDING_BARRIER(intervals.sup);
+		do {
+			intervals = _mm256_add_pdi_upward(intervals, vaddend);
+		} while (--repeats);
+		ROUNDING_BARRIER(intervals.inf);
+		ROUNDING_BARRIER(intervals.sup);
+		fesetround(FE_TONEAREST);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(intervals.inf, intervals.sup)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		const __m256di vmultiplier = _mm256_broadcast_sdi(&multiplier);
+		__m256di intervals = *((const __m256di*) array);
+		do {
+			intervals = _mm256_mul_pdi(intervals, vmultiplier);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(intervals.inf, intervals.sup)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		const __m256di vmultiplier = _mm256_broadcast_sdi(&multiplier);
+		__m256di intervals = *((const __m256di*) array);
+		fesetround(FE_UPWARD);
+		ROUNDING_BARRIER(intervals.inf);
+		ROUNDING_BARRIER(intervals.sup);
+		do {
+			intervals = _mm256_mul_pdi_upward(intervals, vmultiplier);
+		} while (--repeats);
+		ROUNDING_BARRIER(intervals.inf);
+		ROUNDING_BARRIER(intervals.sup);
+		fesetround(FE_TONEAREST);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(intervals.inf, intervals.sup)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		doubleinterval* intervals = (doubleinterval*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ivadd(intervals[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivadd_fesetround_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		doubleinterval* intervals = (doubleinterval*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ivadd_fesetround(intervals[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivadd_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		doubleinterval* intervals = (doubleinterval*) array;
+		fesetround(FE_UPWARD);
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ivadd_upward(intervals[i], addend);
+		}
+		fesetround(FE_TONEAREST);
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		doubleinterval* intervals = (doubleinterval*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ivmul(intervals[i], multiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivmul_fesetround_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		doubleinterval* intervals = (doubleinterval*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ivmul_fesetround(intervals[i], multiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ivmul_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		doubleinterval* intervals = (doubleinterval*) array;
+		fesetround(FE_UPWARD);
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ivmul_upward(intervals[i], multiplier);
+		}
+		fesetround(FE_TONEAREST);
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddivadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddinterval addend = { { M_E, 0x1.0p-60 }, { M_PI, 0x1.0p-60 } };
+		ddinterval* intervals = (ddinterval*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ddivadd(intervals[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_ddivmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const ddinterval multiplier = { { -0.75, 0x1.0p-60 }, { 1.0, 0x1.0p-60 } };
+		ddinterval* intervals = (ddinterval*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			intervals[i] = ddivmul(intervals[i], multiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		const __m256di vaddend = _mm256_broadcast_sdi(&addend);
+		__m256di* vectors = (__m256di*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_add_pdi(vectors[i], vaddend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval addend = { M_E, M_PI };
+		const __m256di vaddend = _mm256_broadcast_sdi(&addend);
+		__m256di* vectors = (__m256di*) array;
+		fesetround(FE_UPWARD);
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_add_pdi_upward(vectors[i], vaddend);
+		}
+		fesetround(FE_TONEAREST);
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		const __m256di vmultiplier = _mm256_broadcast_sdi(&multiplier);
+		__m256di* vectors = (__m256di*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_mul_pdi(vectors[i], vmultiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const doubleinterval multiplier = { -0.75, 1.0 };
+		const __m256di vmultiplier = _mm256_broadcast_sdi(&multiplier);
+		__m256di* vectors = (__m256di*) array;
+		fesetround(FE_UPWARD);
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_mul_pdi_upward(vectors[i], vmultiplier);
+		}
+		fesetround(FE_TONEAREST);
+		return 0.0;
+	}
+#endif
@@ -0,0 +1,156 @@
+/*
+ * Declarations of benchmark kernels which depend on the ADDRE configuration.
+ * This header is included twice from low-level/common.h, with different definitions of BENCHMARK_KERNEL:
+ * once for the kernels compiled with the default configuration, and once for the kernels compiled with emulated ADDRE.
+ */
+
+/* Benchmarks of double-double precision operations */
+#ifndef __KNC__
+	doubledouble BENCHMARK_KERNEL(vsum)(size_t array_elements, const doubledouble array[restrict static array_elements]);
+	doubledouble BENCHMARK_KERNEL(vprod)(size_t array_elements, const doubledouble array[restrict static array_elements]);
+	void BENCHMARK_KERNEL(vaddc)(size_t augend_elements, doubledouble augend[restrict static augend_elements], const doubledouble addend);
+	void BENCHMARK_KERNEL(vmulc)(size_t multiplicand_elements, doubledouble multiplicand[restrict static multiplicand_elements], const doubledouble multiplier);
+
+	inline static doubledouble BENCHMARK_KERNEL(vaddc_helper)(size_t array_elements, doubledouble array[restrict static array_elements]) {
+		BENCHMARK_KERNEL(vaddc)(array_elements, array, (doubledouble) { M_E, M_PI });
+		return (doubledouble) { 0.0, 0.0 };
+	}
+
+	inline static doubledouble BENCHMARK_KERNEL(vmulc_helper)(size_t array_elements, doubledouble array[restrict static array_elements]) {
+		BENCHMARK_KERNEL(vmulc)(array_elements, array, (doubledouble) { M_E, M_PI });
+		return (doubledouble) { 0.0, 0.0 };
+	}
+#else
+	__m512dd BENCHMARK_KERNEL(vsum)(size_t array_elements, const __m512dd array[restrict static array_elements]);
+	__m512dd BENCHMARK_KERNEL(vprod)(size_t array_elements, const __m512dd array[restrict static array_elements]);
+	void BENCHMARK_KERNEL(vaddc)(size_t augend_elements, __m512dd augend[restrict static augend_elements], const __m512dd addend);
+	void BENCHMARK_KERNEL(vmulc)(size_t multiplicand_elements, __m512dd multiplicand[restrict static multiplicand_elements], const __m512dd multiplier);
+
+	inline static __m512dd BENCHMARK_KERNEL(vaddc_helper)(size_t array_elements, __m512dd array[restrict static array_elements]) {
+		BENCHMARK_KERNEL(vaddc)(array_elements, array, (__m512dd) { _mm512_set1_pd(M_E), _mm512_set1_pd(M_PI) });
+		return _mm512_setzero_pdd();
+	}
+
+	inline static __m512dd BENCHMARK_KERNEL(vmulc_helper)(size_t array_elements, __m512dd array[restrict static array_elements]) {
+		BENCHMARK_KERNEL(vmulc)(array_elements, array, (__m512dd) { _mm512_set1_pd(M_E), _mm512_set1_pd(M_PI) });
+		return _mm512_setzero_pdd();
+	}
+#endif
+
+/* Benchmarks of polynomial evaluation latency */
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_compensated_horner15)(double x, size_t iterations);
+	double BENCHMARK_KERNEL(benchmark_muladd_horner15)(double x, size_t iterations);
+	double BENCHMARK_KERNEL(benchmark_fma_horner15)(double x, size_t iterations);
+#else
+	__m512d BENCHMARK_KERNEL(benchmark_compensated_horner15)(__m512d x, size_t iterations);
+	__m512d BENCHMARK_KERNEL(benchmark_muladd_horner15)(__m512d x, size_t iterations);
+	__m512d BENCHMARK_KERNEL(benchmark_fma_horner15)(__m512d x, size_t iterations);
+#endif
+
+/* Benchmarks of individual error-free transformations and SIMD double-double operations */
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_efadd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_efaddord_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_efmul_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_effma_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_efadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_efaddord_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_efmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_effma_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+
+	double BENCHMARK_KERNEL(benchmark_mm_efadd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm_efmul_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm_effma_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_effma_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pdd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_ps_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_ps_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm_efadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm_efmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm_effma_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_effma_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pdd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_ps_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_ps_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+#endif
+
+/* Benchmarks of SIMD double-double operations on arrays in AoS, SoA, and AoSoA layouts */
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_aos_ddadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_soa_ddadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_aosoa_ddadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_aos_ddmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_soa_ddmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_aosoa_ddmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+#endif
+
+/* Benchmarks of scalar and SIMD complex double-double operations */
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_ddcadd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcmul_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcmul3_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcdiv_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcabs_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul3_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_div_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_abs_pddc_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcmul3_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcdiv_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddcabs_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul3_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_div_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_abs_pddc_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+#endif
+
+/* Benchmarks of interval arithmetic with error-free transformations and with switches of the rounding mode */
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_ivadd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivadd_fesetround_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivadd_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivmul_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivmul_fesetround_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivmul_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddivadd_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddivmul_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_upward_latency)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivadd_fesetround_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivadd_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivmul_fesetround_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ivmul_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddivadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_ddivmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdi_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdi_upward_throughput)(size_t repeats, double array[restrict static 16 * repeats]);
+#endif
@@ -0,0 +1,72 @@
+#include <low-level/common.h>
+
+#include <fpplus.h>
+#include <fpplus/layout.h>
+
+/*
+ * Throughput benchmarks of SIMD double-double operations on arrays with different memory layouts
+ *
+ * Each kernel updates an array of 4 * repeats double-double numbers in place, like vaddc and vmulc:
+ * - AoS: array of doubledouble structures, loaded with deinterleaving shuffles and stored with interleaving shuffles
+ * - SoA: high parts in array[0 : 4 * repeats], low parts in array[4 * repeats : 8 * repeats]
+ * - AoSoA: blocks of 4 high parts followed by 4 low parts
+ * One operation processes a whole SIMD vector (4 elements).
+ */
+
+#ifndef __KNC__
+	double BENCHMARK_KERNEL(benchmark_aos_ddadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd addend = { _mm256_set1_pd(M_E), _mm256_set1_pd(0x1.0p-60) };
+		doubledouble* elements = (doubledouble*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			_mm256_interleavestore_pdd(&elements[4*i], _mm256_add_pdd(_mm256_loaddeinterleave_pdd(&elements[4*i]), addend));
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_soa_ddadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd addend = { _mm256_set1_pd(M_E), _mm256_set1_pd(0x1.0p-60) };
+		double* hi = array;
+		double* lo = array + 4 * repeats;
+		for (size_t i = 0; i < repeats; i++) {
+			_mm256_storesoa_pdd(&hi[4*i], &lo[4*i], _mm256_add_pdd(_mm256_loadsoa_pdd(&hi[4*i], &lo[4*i]), addend));
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_aosoa_ddadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd addend = { _mm256_set1_pd(M_E), _mm256_set1_pd(0x1.0p-60) };
+		ddaosoa4* blocks = (ddaosoa4*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			_mm256_storeaosoa_pdd(&blocks[i], _mm256_add_pdd(_mm256_loadaosoa_pdd(&blocks[i]), addend));
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_aos_ddmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd multiplier = { _mm256_set1_pd(1.0 + 0x1.0p-20), _mm256_set1_pd(0x1.0p-80) };
+		doubledouble* elements = (doubledouble*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			_mm256_interleavestore_pdd(&elements[4*i], _mm256_mul_pdd(_mm256_loaddeinterleave_pdd(&elements[4*i]), multiplier));
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_soa_ddmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd multiplier = { _mm256_set1_pd(1.0 + 0x1.0p-20), _mm256_set1_pd(0x1.0p-80) };
+		double* hi = array;
+		double* lo = array + 4 * repeats;
+		for (size_t i = 0; i < repeats; i++) {
+			_mm256_storesoa_pdd(&hi[4*i], &lo[4*i], _mm256_mul_pdd(_mm256_loadsoa_pdd(&hi[4*i], &lo[4*i]), multiplier));
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_aosoa_ddmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd multiplier = { _mm256_set1_pd(1.0 + 0x1.0p-20), _mm256_set1_pd(0x1.0p-80) };
+		ddaosoa4* blocks = (ddaosoa4*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			_mm256_storeaosoa_pdd(&blocks[i], _mm256_mul_pdd(_mm256_loadaosoa_pdd(&blocks[i]), multiplier));
+		}
+		return 0.0;
+	}
+#endif
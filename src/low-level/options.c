@@ -7,18 +7,36 @@
 
 static void print_options_help(const char* program_name) {
 	printf(
-"%s -t type [-i iterations] [-r repeats]\n"
+"%s -t type [-i iterations] [-r repeats] [-f format] [-c counters] [--addre]\n"
 "Required parameters:\n"
 "  -t   --type         The type of benchmark:\n"
 "                          doubledouble-latency\n"
 "                          doubledouble-throughput\n"
+#ifndef __KNC__
+"                          doubledouble-cxx\n"
+#endif
 #ifdef FPPLUS_HAVE_FLOAT128
 "                          quad-latency\n"
 #endif
 "                          polevl-latency\n"
+#ifndef __KNC__
+"                          eft-latency\n"
+"                          eft-throughput\n"
+"                          simd-latency\n"
+"                          simd-throughput\n"
+"                          layout-throughput\n"
+"                          complex-latency\n"
+"                          complex-throughput\n"
+"                          interval-latency\n"
+"                          interval-throughput\n"
+#endif
 "Optional parameters:\n"
 "  -i   --iterations   The number of benchmark iterations (default: 1000)\n"
-"  -r   --repeats      The number of repeats within the benchmark iteration (default: 1024)\n",
+"  -r   --repeats      The number of repeats within the benchmark iteration (default: 1024)\n"
+"  -f   --format       Output format: text (default), csv, or json\n"
+"  -c   --counters     Comma-separated list of performance counters to measure, or all:\n"
+"                      cycles, instructions, fp-scalar, fp-128, fp-256, fp-512, l1d-misses, llc-misses\n"
+"       --addre        Also benchmark the kernels compiled with emulated ADDRE, and report the speedup\n",
 		program_name);
 }
 
@@ -27,6 +45,9 @@ struct benchmark_options parse_options(int argc, char** argv) {
 		.type = benchmark_type_none,
 		.iterations = 1000,
 		.repeats = 1024,
+		.format = report_format_text,
+		.counters = 0,
+		.addre = false,
 	};
 	for (int argi = 1; argi < argc; argi += 1) {
 		if ((strcmp(argv[argi], "--type") == 0) || (strcmp(argv[argi], "-t") == 0)) {
@@ -38,12 +59,36 @@ struct benchmark_options parse_options(int argc, char** argv) {
 				options.type = benchmark_type_doubledouble_latency;
 			} else if (strcmp(argv[argi + 1], "doubledouble-throughput") == 0) {
 				options.type = benchmark_type_doubledouble_throughput;
+#ifndef __KNC__
+			} else if (strcmp(argv[argi + 1], "doubledouble-cxx") == 0) {
+				options.type = benchmark_type_doubledouble_cxx;
+#endif
 #ifdef FPPLUS_HAVE_FLOAT128
 			} else if (strcmp(argv[argi + 1], "quad-latency") == 0) {
 				options.type = benchmark_type_quad_latency;
 #endif
 			} else if (strcmp(argv[argi + 1], "polevl-latency") == 0) {
 				options.type = benchmark_type_polevl_latency;
+#ifndef __KNC__
+			} else if (strcmp(argv[argi + 1], "eft-latency") == 0) {
+				options.type = benchmark_type_eft_latency;
+			} else if (strcmp(argv[argi + 1], "eft-throughput") == 0) {
+				options.type = benchmark_type_eft_throughput;
+			} else if (strcmp(argv[argi + 1], "simd-latency") == 0) {
+				options.type = benchmark_type_simd_latency;
+			} else if (strcmp(argv[argi + 1], "simd-throughput") == 0) {
+				options.type = benchmark_type_simd_throughput;
+			} else if (strcmp(argv[argi + 1], "layout-throughput") == 0) {
+				options.type = benchmark_type_layout_throughput;
+			} else if (strcmp(argv[argi + 1], "complex-latency") == 0) {
+				options.type = benchmark_type_complex_latency;
+			} else if (strcmp(argv[argi + 1], "complex-throughput") == 0) {
+				options.type = benchmark_type_complex_throughput;
+			} else if (strcmp(argv[argi + 1], "interval-latency") == 0) {
+				options.type = benchmark_type_interval_latency;
+			} else if (strcmp(argv[argi + 1], "interval-throughput") == 0) {
+				options.type = benchmark_type_interval_throughput;
+#endif
 			} else {
 				fprintf(stderr, "Error: invalid benchmark type %s\n", argv[argi + 1]);
 				exit(EXIT_FAILURE);
@@ -77,6 +122,33 @@ struct benchmark_options parse_options(int argc, char** argv) {
 				exit(EXIT_FAILURE);
 			}
 			argi += 1;
+		} else if ((strcmp(argv[argi], "--format") == 0) || (strcmp(argv[argi], "-f") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected output format\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_report_format(argv[argi + 1], &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strncmp(argv[argi], "--format=", strlen("--format=")) == 0) {
+			if (!parse_report_format(argv[argi] + strlen("--format="), &options.format)) {
+				fprintf(stderr, "Error: invalid output format %s\n", argv[argi] + strlen("--format="));
+				exit(EXIT_FAILURE);
+			}
+		} else if ((strcmp(argv[argi], "--counters") == 0) || (strcmp(argv[argi], "-c") == 0)) {
+			if (argi + 1 == argc) {
+				fprintf(stderr, "Error: expected list of performance counters\n");
+				exit(EXIT_FAILURE);
+			}
+			if (!parse_perf_counters(argv[argi + 1], &options.counters)) {
+				fprintf(stderr, "Error: invalid list of performance counters %s\n", argv[argi + 1]);
+				exit(EXIT_FAILURE);
+			}
+			argi += 1;
+		} else if (strcmp(argv[argi], "--addre") == 0) {
+			options.addre = true;
 		} else if ((strcmp(argv[argi], "--help") == 0) || (strcmp(argv[argi], "-h") == 0)) {
 			print_options_help(argv[0]);
 			exit(EXIT_SUCCESS);
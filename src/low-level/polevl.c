@@ -6,9 +6,9 @@
 
 /* Polynomial evaluation with compensated Horner scheme */
 #ifndef __KNC__
-double benchmark_compensated_horner15(double x, size_t iterations) {
+double BENCHMARK_KERNEL(benchmark_compensated_horner15)(double x, size_t iterations) {
 #else
-__m512d benchmark_compensated_horner15(__m512d x, size_t iterations) {
+__m512d BENCHMARK_KERNEL(benchmark_compensated_horner15)(__m512d x, size_t iterations) {
 #endif
 	const double c0 = 0x1.78f187ab028a6p-1;
 	const double c1 = 0x1.3f5db1c895000p-11;
@@ -38,9 +38,9 @@ __m512d benchmark_compensated_horner15(__m512d x, size_t iterations) {
 
 /* Polynomial evaluation with Horner scheme with multiplication and addition involving intermediate rounding */
 #ifndef __KNC__
-double benchmark_muladd_horner15(double x, size_t iterations) {
+double BENCHMARK_KERNEL(benchmark_muladd_horner15)(double x, size_t iterations) {
 #else
-__m512d benchmark_muladd_horner15(__m512d x, size_t iterations) {
+__m512d BENCHMARK_KERNEL(benchmark_muladd_horner15)(__m512d x, size_t iterations) {
 #endif
 	const double c0 = 0x1.78f187ab028a6p-1;
 	const double c1 = 0x1.3f5db1c895000p-11;
@@ -70,9 +70,9 @@ __m512d benchmark_muladd_horner15(__m512d x, size_t iterations) {
 
 /* Polynomial evaluation with Horner scheme with fused multiply-add */
 #ifndef __KNC__
-double benchmark_fma_horner15(double x, size_t iterations) {
+double BENCHMARK_KERNEL(benchmark_fma_horner15)(double x, size_t iterations) {
 #else
-__m512d benchmark_fma_horner15(__m512d x, size_t iterations) {
+__m512d BENCHMARK_KERNEL(benchmark_fma_horner15)(__m512d x, size_t iterations) {
 #endif
 	const double c0 = 0x1.78f187ab028a6p-1;
 	const double c1 = 0x1.3f5db1c895000p-11;
@@ -0,0 +1,331 @@
+#include <low-level/common.h>
+
+#include <fpplus.h>
+
+/*
+ * Benchmarks of SIMD error-free transformations and double-double operations
+ *
+ * Latency benchmarks follow the same conventions as the scalar benchmarks in eft.c:
+ * efadd feeds back both outputs, efmul and effma feed back the rounded result and accumulate the error terms
+ * off the critical path, and double-double operations chain the result like vsum and vprod.
+ * Throughput benchmarks apply the operation to independent SIMD vectors of an array.
+ * One operation processes a whole SIMD vector (2 or 4 double-precision elements, or 8 single-precision elements).
+ * Float-float kernels mirror the double-double kernels with the same data, rounded to single precision.
+ */
+
+#ifndef __KNC__
+	/* Forces the value into registers, so the compiler can not merge shuffles of deinterleaving load and interleaving store */
+	#define MATERIALIZE_PDD(x) __asm__ __volatile__ ("" : "+x" ((x).hi), "+x" ((x).lo))
+	#define MATERIALIZE_PFF(x) MATERIALIZE_PDD(x)
+
+	double BENCHMARK_KERNEL(benchmark_mm_efadd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m128d a = _mm_load_pd(&array[0]);
+		__m128d b = _mm_load_pd(&array[2]);
+		do {
+			a = _mm_efadd_pd(a, b, &b);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm_add_pd(a, b));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm_efmul_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m128d a = _mm_load_pd(&array[0]);
+		const __m128d b = _mm_load_pd(&array[2]);
+		__m128d error_sum = _mm_setzero_pd();
+		do {
+			__m128d e;
+			a = _mm_efmul_pd(a, b, &e);
+			error_sum = _mm_add_pd(error_sum, e);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm_add_pd(a, error_sum));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm_effma_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m128d a = _mm_load_pd(&array[0]);
+		const __m128d b = _mm_load_pd(&array[2]);
+		__m128d c = _mm_load_pd(&array[4]);
+		__m128d error_high_sum = _mm_setzero_pd(), error_low_sum = _mm_setzero_pd();
+		do {
+			__m128d e_high, e_low;
+			c = _mm_effma_pd(a, b, c, &e_high, &e_low);
+			error_high_sum = _mm_add_pd(error_high_sum, e_high);
+			error_low_sum = _mm_add_pd(error_low_sum, e_low);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm_add_pd(c, _mm_add_pd(error_high_sum, error_low_sum)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256d a = _mm256_load_pd(&array[0]);
+		__m256d b = _mm256_load_pd(&array[4]);
+		do {
+			a = _mm256_efadd_pd(a, b, &b);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(a, b)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256d a = _mm256_load_pd(&array[0]);
+		const __m256d b = _mm256_load_pd(&array[4]);
+		__m256d error_sum = _mm256_setzero_pd();
+		do {
+			__m256d e;
+			a = _mm256_efmul_pd(a, b, &e);
+			error_sum = _mm256_add_pd(error_sum, e);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(a, error_sum)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_effma_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256d a = _mm256_load_pd(&array[0]);
+		const __m256d b = _mm256_load_pd(&array[4]);
+		__m256d c = a;
+		__m256d error_high_sum = _mm256_setzero_pd(), error_low_sum = _mm256_setzero_pd();
+		do {
+			__m256d e_high, e_low;
+			c = _mm256_effma_pd(a, b, c, &e_high, &e_low);
+			error_high_sum = _mm256_add_pd(error_high_sum, e_high);
+			error_low_sum = _mm256_add_pd(error_low_sum, e_low);
+		} while (--repeats);
+		return _mm_cvtsd_f64(_mm256_castpd256_pd128(_mm256_add_pd(c, _mm256_add_pd(error_high_sum, error_low_sum))));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd x = { _mm256_load_pd(&array[0]), _mm256_setzero_pd() };
+		__m256dd sum = _mm256_setzero_pdd();
+		do {
+			sum = _mm256_add_pdd(sum, x);
+		} while (--repeats);
+		return _mm256_reduce_add_pdd(sum).hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pdd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd x = { _mm256_load_pd(&array[0]), _mm256_setzero_pd() };
+		__m256dd sum = _mm256_setzero_pdd();
+		do {
+			sum = _mm256_add_fast_pdd(sum, x);
+		} while (--repeats);
+		return _mm256_reduce_add_pdd(sum).hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdd_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd x = { _mm256_load_pd(&array[0]), _mm256_setzero_pd() };
+		__m256dd product = x;
+		do {
+			product = _mm256_mul_pdd(product, x);
+		} while (--repeats);
+		return _mm256_reduce_add_pdd(product).hi;
+	}
+
+	/* Round trip through memory: the next load depends on the previous store via store-to-load forwarding */
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		doubledouble* pointer = (doubledouble*) array;
+		do {
+			__m256dd x = _mm256_loaddeinterleave_pdd(pointer);
+			MATERIALIZE_PDD(x);
+			_mm256_interleavestore_pdd(pointer, x);
+			__asm__ __volatile__ ("" : : : "memory");
+		} while (--repeats);
+		return array[0];
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_ps_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256 a = _mm256_load_ps((const float*) &array[0]);
+		__m256 b = _mm256_load_ps((const float*) &array[4]);
+		do {
+			a = _mm256_efadd_ps(a, b, &b);
+		} while (--repeats);
+		return _mm_cvtss_f32(_mm256_castps256_ps128(_mm256_add_ps(a, b)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_ps_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256 a = _mm256_load_ps((const float*) &array[0]);
+		const __m256 b = _mm256_load_ps((const float*) &array[4]);
+		__m256 error_sum = _mm256_setzero_ps();
+		do {
+			__m256 e;
+			a = _mm256_efmul_ps(a, b, &e);
+			error_sum = _mm256_add_ps(error_sum, e);
+		} while (--repeats);
+		return _mm_cvtss_f32(_mm256_castps256_ps128(_mm256_add_ps(a, error_sum)));
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256ff x = { _mm256_load_ps((const float*) &array[0]), _mm256_setzero_ps() };
+		__m256ff sum = _mm256_setzero_pff();
+		do {
+			sum = _mm256_add_pff(sum, x);
+		} while (--repeats);
+		return _mm256_reduce_add_pff(sum).hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256ff x = { _mm256_load_ps((const float*) &array[0]), _mm256_setzero_ps() };
+		__m256ff sum = _mm256_setzero_pff();
+		do {
+			sum = _mm256_add_fast_pff(sum, x);
+		} while (--repeats);
+		return _mm256_reduce_add_pff(sum).hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256ff x = { _mm256_load_ps((const float*) &array[0]), _mm256_setzero_ps() };
+		__m256ff product = x;
+		do {
+			product = _mm256_mul_pff(product, x);
+		} while (--repeats);
+		return _mm256_reduce_add_pff(product).hi;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_pff_latency)(size_t repeats, double array[restrict static 16 * repeats]) {
+		floatfloat* pointer = (floatfloat*) array;
+		do {
+			__m256ff x = _mm256_loaddeinterleave_pff(pointer);
+			MATERIALIZE_PFF(x);
+			_mm256_interleavestore_pff(pointer, x);
+			__asm__ __volatile__ ("" : : : "memory");
+		} while (--repeats);
+		return array[0];
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm_efadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m128d* vectors = (__m128d*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[2*i] = _mm_efadd_pd(vectors[2*i], vectors[2*i+1], &vectors[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm_efmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m128d multiplier = _mm_set1_pd(1.0 + 0x1.0p-20);
+		__m128d* vectors = (__m128d*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[2*i] = _mm_efmul_pd(vectors[2*i], multiplier, &vectors[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm_effma_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m128d multiplier = _mm_set1_pd(1.0 + 0x1.0p-20);
+		__m128d* vectors = (__m128d*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[4*i+1] = _mm_effma_pd(vectors[4*i], multiplier, vectors[4*i+1], &vectors[4*i+2], &vectors[4*i+3]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256d* vectors = (__m256d*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[2*i] = _mm256_efadd_pd(vectors[2*i], vectors[2*i+1], &vectors[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256d multiplier = _mm256_set1_pd(1.0 + 0x1.0p-20);
+		__m256d* vectors = (__m256d*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[2*i] = _mm256_efmul_pd(vectors[2*i], multiplier, &vectors[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_effma_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256d multiplier = _mm256_set1_pd(1.0 + 0x1.0p-20);
+		__m256d* vectors = (__m256d*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[4*i+1] = _mm256_effma_pd(vectors[4*i], multiplier, vectors[4*i+1], &vectors[4*i+2], &vectors[4*i+3]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pdd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd addend = { _mm256_set1_pd(M_E), _mm256_set1_pd(0x1.0p-60) };
+		__m256dd* vectors = (__m256dd*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_add_pdd(vectors[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pdd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd addend = { _mm256_set1_pd(M_E), _mm256_set1_pd(0x1.0p-60) };
+		__m256dd* vectors = (__m256dd*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_add_fast_pdd(vectors[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pdd_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256dd multiplier = { _mm256_set1_pd(1.0 + 0x1.0p-20), _mm256_set1_pd(0x1.0p-80) };
+		__m256dd* vectors = (__m256dd*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_mul_pdd(vectors[i], multiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		doubledouble* pointer = (doubledouble*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			__m256dd x = _mm256_loaddeinterleave_pdd(&pointer[4*i]);
+			MATERIALIZE_PDD(x);
+			_mm256_interleavestore_pdd(&pointer[4*i], x);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efadd_ps_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		__m256* vectors = (__m256*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[2*i] = _mm256_efadd_ps(vectors[2*i], vectors[2*i+1], &vectors[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_efmul_ps_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256 multiplier = _mm256_set1_ps(1.0f + 0x1.0p-10f);
+		__m256* vectors = (__m256*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[2*i] = _mm256_efmul_ps(vectors[2*i], multiplier, &vectors[2*i+1]);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256ff addend = { _mm256_set1_ps((float) M_E), _mm256_set1_ps(0x1.0p-30f) };
+		__m256ff* vectors = (__m256ff*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_add_pff(vectors[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_add_fast_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256ff addend = { _mm256_set1_ps((float) M_E), _mm256_set1_ps(0x1.0p-30f) };
+		__m256ff* vectors = (__m256ff*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_add_fast_pff(vectors[i], addend);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_mul_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		const __m256ff multiplier = { _mm256_set1_ps(1.0f + 0x1.0p-10f), _mm256_set1_ps(0x1.0p-40f) };
+		__m256ff* vectors = (__m256ff*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			vectors[i] = _mm256_mul_pff(vectors[i], multiplier);
+		}
+		return 0.0;
+	}
+
+	double BENCHMARK_KERNEL(benchmark_mm256_loaddeinterleave_interleavestore_pff_throughput)(size_t repeats, double array[restrict static 16 * repeats]) {
+		floatfloat* pointer = (floatfloat*) array;
+		for (size_t i = 0; i < repeats; i++) {
+			__m256ff x = _mm256_loaddeinterleave_pff(&pointer[8*i]);
+			MATERIALIZE_PFF(x);
+			_mm256_interleavestore_pff(&pointer[8*i], x);
+		}
+		return 0.0;
+	}
+#endif
@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+#include <utils.h>
+#include <factor/factor.h>
+#include <refine/common.h>
+
+
+/* Iterative refinement stops earlier if the corrections stop decreasing */
+#define MAX_REFINEMENT_ITERATIONS 10
+
+/* Panel width of the blocked double-double LU factorization, the default of factor-bench */
+#define DDLU_BLOCK_SIZE 64
+
+static void random_unit_vector(size_t n, double v[restrict static n], uint64_t state[restrict static 1]) {
+	double norm = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		v[i] = random_uniform(state);
+		norm += v[i] * v[i];
+	}
+	norm = sqrt(norm);
+	for (size_t i = 0; i < n; i++) {
+		v[i] /= norm;
+	}
+}
+
+/*
+ * Generates A = (I - 2 u u') S (I - 2 v v') with random unit vectors u and v,
+ * and singular values S distributed geometrically between 1 and 1 / condition.
+ */
+static void generate_matrix(size_t n, double condition, double a[restrict static n * n], uint64_t state[restrict static 1]) {
+	double* u = malloc(n * sizeof(double));
+	double* v = malloc(n * sizeof(double));
+	double* s = malloc(n * sizeof(double));
+	random_unit_vector(n, u, state);
+	random_unit_vector(n, v, state);
+	double usv = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		s[i] = pow(condition, -(double) i / (double) (n - 1));
+		usv += u[i] * s[i] * v[i];
+	}
+	for (size_t j = 0; j < n; j++) {
+		for (size_t i = 0; i < n; i++) {
+			a[i + j * n] = (i == j ? s[i] : 0.0) - 2.0 * u[i] * u[j] * s[j] - 2.0 * s[i] * v[i] * v[j] + 4.0 * u[i] * usv * v[j];
+		}
+	}
+	free(u);
+	free(v);
+	free(s);
+}
+
+/* max |x - y| / max |y|, with the difference computed in double-double precision */
+static double relative_difference(size_t n, const doubledouble x[restrict static n], const doubledouble y[restrict static n]) {
+	double max_difference = 0.0, max_y = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		const doubledouble difference = ddadd(x[i], (doubledouble) { -y[i].hi, -y[i].lo });
+		max_difference = fmax(max_difference, fabs(difference.hi));
+		max_y = fmax(max_y, fabs(y[i].hi));
+	}
+	return max_difference / max_y;
+}
+
+static void report_mflops(const char* name, size_t n, size_t iterations, double iteration_times[restrict static iterations],
+	const double counters[restrict static perf_counter_count])
+{
+	/* 2/3 n**3 is the flop count of LU factorization, which dominates the time to solution */
+	const double flops = 2.0 / 3.0 * (double) n * (double) n * (double) n;
+	/* Convert iteration times to MFLOPS in-place */
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		iteration_times[iteration] = 1.0e+3 * flops / iteration_times[iteration];
+	}
+	const struct sample_statistics statistics = compute_sample_statistics(iteration_times, iterations);
+	report_measurement(name, n, report_unit_mflops, &statistics, counters);
+}
+
+static void benchmark(size_t n, double condition, enum report_format format, size_t iterations) {
+	double* a = valloc(n * n * sizeof(double));
+	double* lu = valloc(n * n * sizeof(double));
+	doubledouble* dd_lu = valloc(n * n * sizeof(doubledouble));
+	double* b = valloc(n * sizeof(double));
+	doubledouble* x = valloc(n * sizeof(doubledouble));
+	doubledouble* dd_x = valloc(n * sizeof(doubledouble));
+	double* work = valloc(4 * n * sizeof(double));
+	size_t* pivots = valloc(n * sizeof(size_t));
+	void* workspace = valloc(ddfactor_workspace_size(n, DDLU_BLOCK_SIZE));
+	if (a == NULL || lu == NULL || dd_lu == NULL || b == NULL || x == NULL || dd_x == NULL || work == NULL || pivots == NULL || workspace == NULL) {
+		fprintf(stderr, "Error: failed to allocate memory for the benchmark\n");
+		exit(EXIT_FAILURE);
+	}
+	uint64_t state = UINT64_C(0x853C49E6748FEA9B) + n;
+	generate_matrix(n, condition, a, &state);
+	for (size_t i = 0; i < n; i++) {
+		b[i] = random_uniform(&state);
+	}
+
+	/* Both solvers get the matrix and the right-hand side in double precision, and keep the original matrix intact */
+	double refine_times[iterations], dd_times[iterations];
+	struct perf_counter_values refine_iteration_counters[iterations], dd_iteration_counters[iterations];
+	struct refinement_result refinement = { 0, INFINITY, false };
+	bool nonsingular = true;
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+
+		memcpy(lu, a, n * n * sizeof(double));
+		nonsingular &= dgetrf(n, lu, n, pivots);
+		refinement = ddgesv_refine(n, a, n, lu, n, pivots, b, x, MAX_REFINEMENT_ITERATIONS, work);
+
+		refine_times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&refine_iteration_counters[iteration]);
+	}
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+
+		for (size_t i = 0; i < n * n; i++) {
+			dd_lu[i] = (doubledouble) { a[i], 0.0 };
+		}
+		for (size_t i = 0; i < n; i++) {
+			dd_x[i] = (doubledouble) { b[i], 0.0 };
+		}
+		nonsingular &= ddlu_factor(n, dd_lu, n, pivots, DDLU_BLOCK_SIZE, workspace);
+		ddlu_solve(n, dd_lu, n, pivots, dd_x);
+
+		dd_times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&dd_iteration_counters[iteration]);
+	}
+	if (!nonsingular) {
+		fprintf(stderr, "Error: the generated %zux%zu matrix is singular in working precision\n", n, n);
+		exit(EXIT_FAILURE);
+	}
+	const double difference = relative_difference(n, x, dd_x);
+
+	/* Counters are normalized per matrix element */
+	double refine_counters[perf_counter_count], dd_counters[perf_counter_count];
+	median_perf_counters(iterations, refine_iteration_counters, (double) (n * n), refine_counters);
+	median_perf_counters(iterations, dd_iteration_counters, (double) (n * n), dd_counters);
+	if (format == report_format_text) {
+		const double refine_time_ns = median_double(refine_times, iterations);
+		const double dd_time_ns = median_double(dd_times, iterations);
+		printf("%zu\t" "%.3lf ms\t" "%.3lf ms\t" "%.2lfx\t" "%zu%s\t" "%.2le\t" "%.2le",
+			n, refine_time_ns * 1.0e-6, dd_time_ns * 1.0e-6, dd_time_ns / refine_time_ns,
+			refinement.iterations, refinement.converged ? "" : " (not converged)",
+			refinement.error_estimate, difference);
+		report_text_counters(refine_counters);
+	} else {
+		report_mflops("solve/refine", n, iterations, refine_times, refine_counters);
+		report_mflops("solve/ddlu", n, iterations, dd_times, dd_counters);
+		const struct sample_statistics difference_statistics = compute_sample_statistics((double[1]) { difference }, 1);
+		report_measurement("solve/refine/difference", n, report_unit_relative_error, &difference_statistics, refine_counters);
+	}
+
+	free(a);
+	free(lu);
+	free(dd_lu);
+	free(b);
+	free(x);
+	free(dd_x);
+	free(work);
+	free(pivots);
+	free(workspace);
+}
+
+int main(int argc, char *argv[]) {
+	const struct benchmark_options options = parse_options(argc, argv);
+
+	perf_counters_open(options.counters);
+	report_begin(options.format, "refine-bench", argc, argv);
+	for (size_t n = 16; n <= options.max_size; n *= 2) {
+		benchmark(n, options.condition, options.format, options.iterations);
+	}
+	report_end();
+	perf_counters_close();
+}
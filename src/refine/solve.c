@@ -0,0 +1,184 @@
+#include <math.h>
+
+#include <refine/solve.h>
+
+
+bool dgetrf(size_t n, double a[restrict], size_t lda, size_t pivots[restrict static n]) {
+	for (size_t k = 0; k < n; k++) {
+		double* restrict column_k = &a[k * lda];
+		size_t pivot = k;
+		for (size_t i = k + 1; i < n; i++) {
+			if (fabs(column_k[i]) > fabs(column_k[pivot])) {
+				pivot = i;
+			}
+		}
+		pivots[k] = pivot;
+		if (column_k[pivot] == 0.0) {
+			return false;
+		}
+		if (pivot != k) {
+			for (size_t j = 0; j < n; j++) {
+				const double t = a[k + j * lda];
+				a[k + j * lda] = a[pivot + j * lda];
+				a[pivot + j * lda] = t;
+			}
+		}
+
+		for (size_t i = k + 1; i < n; i++) {
+			column_k[i] /= column_k[k];
+		}
+		/* Right-looking update of the trailing submatrix, column by column for unit-stride inner loops */
+		for (size_t j = k + 1; j < n; j++) {
+			double* restrict column_j = &a[j * lda];
+			const double u = column_j[k];
+			for (size_t i = k + 1; i < n; i++) {
+				column_j[i] = fma(-column_k[i], u, column_j[i]);
+			}
+		}
+	}
+	return true;
+}
+
+void dgetrs(size_t n, const double lu[restrict], size_t lda, const size_t pivots[restrict static n], double b[restrict static n]) {
+	for (size_t k = 0; k < n; k++) {
+		const double t = b[k];
+		b[k] = b[pivots[k]];
+		b[pivots[k]] = t;
+	}
+	/* L y = P b, with unit diagonal of L */
+	for (size_t j = 0; j < n; j++) {
+		const double* restrict column_j = &lu[j * lda];
+		for (size_t i = j + 1; i < n; i++) {
+			b[i] = fma(-column_j[i], b[j], b[i]);
+		}
+	}
+	/* U x = y */
+	for (size_t j = n; j-- != 0;) {
+		const double* restrict column_j = &lu[j * lda];
+		b[j] /= column_j[j];
+		for (size_t i = 0; i < j; i++) {
+			b[i] = fma(-column_j[i], b[j], b[i]);
+		}
+	}
+}
+
+/*
+ * r = b - A x, where x = x_hi + x_lo, as the unevaluated sum r_hi + r_lo.
+ * Columns of A are accumulated with error-free multiplication and addition, as in the compensated dot product,
+ * but for 4 rows at a time, so that the loads from the column-major matrix have unit stride.
+ * A x_lo is below double-double precision of A x_hi, and needs only double precision.
+ */
+static void compensated_residual(size_t n, const double a[restrict], size_t lda, const double b[restrict static n],
+	const double x_hi[restrict static n], const double x_lo[restrict static n],
+	double r_hi[restrict static n], double r_lo[restrict static n])
+{
+	size_t i = 0;
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+	for (; i + 4 <= n; i += 4) {
+		__m256d sum_hi = _mm256_loadu_pd(&b[i]);
+		__m256d sum_lo = _mm256_setzero_pd();
+		for (size_t j = 0; j < n; j++) {
+			const __m256d a_ij = _mm256_loadu_pd(&a[i + j * lda]);
+			__m256d product_error, sum_error;
+			const __m256d product = _mm256_efmul_pd(a_ij, _mm256_set1_pd(-x_hi[j]), &product_error);
+			sum_hi = _mm256_efadd_pd(sum_hi, product, &sum_error);
+			sum_lo = _mm256_add_pd(sum_lo, _mm256_add_pd(sum_error, product_error));
+			sum_lo = _mm256_sub_pd(sum_lo, _mm256_mul_pd(a_ij, _mm256_set1_pd(x_lo[j])));
+		}
+		__m256d error;
+		sum_hi = _mm256_efadd_pd(sum_hi, sum_lo, &error);
+		_mm256_storeu_pd(&r_hi[i], sum_hi);
+		_mm256_storeu_pd(&r_lo[i], error);
+	}
+#endif
+	for (; i < n; i++) {
+		double sum_hi = b[i], sum_lo = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			const double a_ij = a[i + j * lda];
+			double product_error, sum_error;
+			const double product = efmul(a_ij, -x_hi[j], &product_error);
+			sum_hi = efadd(sum_hi, product, &sum_error);
+			sum_lo += sum_error + product_error;
+			sum_lo -= a_ij * x_lo[j];
+		}
+		r_hi[i] = efadd(sum_hi, sum_lo, &r_lo[i]);
+	}
+}
+
+void ddresidual(size_t n, const double a[restrict], size_t lda, const double b[restrict static n],
+	const doubledouble x[restrict static n], doubledouble r[restrict static n],
+	double work[restrict static 4 * n])
+{
+	double* x_hi = work;
+	double* x_lo = work + n;
+	double* r_hi = work + 2 * n;
+	double* r_lo = work + 3 * n;
+	for (size_t j = 0; j < n; j++) {
+		x_hi[j] = x[j].hi;
+		x_lo[j] = x[j].lo;
+	}
+	compensated_residual(n, a, lda, b, x_hi, x_lo, r_hi, r_lo);
+	for (size_t i = 0; i < n; i++) {
+		r[i] = (doubledouble) { r_hi[i], r_lo[i] };
+	}
+}
+
+static double max_abs(size_t n, const double x[restrict static n]) {
+	double result = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		result = fmax(result, fabs(x[i]));
+	}
+	return result;
+}
+
+struct refinement_result ddgesv_refine(size_t n,
+	const double a[restrict], size_t lda,
+	const double lu[restrict], size_t ldlu, const size_t pivots[restrict static n],
+	const double b[restrict static n],
+	doubledouble x[restrict static n],
+	size_t max_iterations,
+	double work[restrict static 4 * n])
+{
+	double* x_hi = work;
+	double* x_lo = work + n;
+	double* correction = work + 2 * n;
+	double* residual_lo = work + 3 * n;
+
+	/* Initial solution in double precision */
+	for (size_t i = 0; i < n; i++) {
+		x_hi[i] = b[i];
+		x_lo[i] = 0.0;
+	}
+	dgetrs(n, lu, ldlu, pivots, x_hi);
+
+	struct refinement_result result = { 0, INFINITY, false };
+	while (result.iterations < max_iterations) {
+		/* The residual is rounded to double: only its leading digits are needed to compute the correction */
+		compensated_residual(n, a, lda, b, x_hi, x_lo, correction, residual_lo);
+		dgetrs(n, lu, ldlu, pivots, correction);
+		for (size_t i = 0; i < n; i++) {
+			const doubledouble sum = ddaddw((doubledouble) { x_hi[i], x_lo[i] }, correction[i]);
+			x_hi[i] = sum.hi;
+			x_lo[i] = sum.lo;
+		}
+		result.iterations += 1;
+
+		const double last_error_estimate = result.error_estimate;
+		/* A zero correction means an exact residual of zero, also for the zero solution of b = 0 */
+		const double max_correction = max_abs(n, correction);
+		result.error_estimate = max_correction == 0.0 ? 0.0 : max_correction / max_abs(n, x_hi);
+		if (result.error_estimate <= 0x1.0p-104) {
+			result.converged = true;
+			break;
+		}
+		if (result.error_estimate > 0.5 * last_error_estimate) {
+			/* Corrections stopped decreasing */
+			result.converged = result.error_estimate <= 0x1.0p-53;
+			break;
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		x[i] = (doubledouble) { x_hi[i], x_lo[i] };
+	}
+	return result;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Dense linear solvers for A x = b. Matrices are stored in column-major order, as in factor/factor.h:
+ * a[i + j * lda] is the element in row i and column j.
+ * The LU factorization in double-double precision is ddlu_factor in factor/factor.h.
+ */
+
+/**
+ * @brief LU factorization with partial pivoting in double precision, P A = L U, in-place
+ * @details On return, the strictly lower part of a contains L (with implicit unit diagonal), and the upper part contains U.
+ * @param pivots - row i was interchanged with row pivots[i] at step i.
+ * @return true on success, false if the matrix is exactly singular.
+ */
+bool dgetrf(size_t n, double *FPPLUS_RESTRICT a, size_t lda, size_t FPPLUS_ARRAY_POINTER(pivots, n));
+
+/**
+ * @brief Solves A x = b in double precision with the factorization from dgetrf, in-place: b is overwritten with x
+ */
+void dgetrs(size_t n, const double *FPPLUS_RESTRICT lu, size_t lda, const size_t FPPLUS_ARRAY_POINTER(pivots, n),
+	double FPPLUS_ARRAY_POINTER(b, n));
+
+/**
+ * @brief Computes the residual r = b - A x of a double-precision system for a double-double solution x
+ * @details Products of the columns of A with the high parts of x are accumulated with error-free multiplication and addition,
+ *          as in the compensated dot product, so the residual is accurate to double-double precision relative to |A| |x|.
+ * @param work - scratch buffer for 4 * n doubles.
+ */
+void ddresidual(size_t n, const double *FPPLUS_RESTRICT a, size_t lda, const double FPPLUS_ARRAY_POINTER(b, n),
+	const doubledouble FPPLUS_ARRAY_POINTER(x, n), doubledouble FPPLUS_ARRAY_POINTER(r, n),
+	double FPPLUS_ARRAY_POINTER(work, 4 * n));
+
+struct refinement_result {
+	/* The number of correction steps */
+	size_t iterations;
+	/* max |correction| / max |x| at the last step, an estimate of the relative error of the solution */
+	double error_estimate;
+	/*
+	 * The corrections decreased below double-double precision, or stopped decreasing below double precision:
+	 * in the latter case the accuracy of the solution is limited by the condition number of the matrix.
+	 * If false, the matrix is too ill-conditioned for refinement with a double-precision factorization.
+	 */
+	bool converged;
+};
+
+/**
+ * @brief Solves a double-precision system A x = b to double-double accuracy with mixed-precision iterative refinement
+ * @details The initial solution and the corrections are computed in double precision with the factorization from dgetrf.
+ *          Residuals are computed with ddresidual, and the corrections are accumulated in double-double precision.
+ *          Refinement stops when the correction drops below double-double precision relative to the solution,
+ *          when the corrections stop decreasing (the matrix is too ill-conditioned), or after max_iterations steps.
+ * @param a - the original matrix.
+ * @param lu - factorization of a from dgetrf.
+ * @param x - the solution, accurate to double-double precision if the refinement converged.
+ * @param work - scratch buffer for 4 * n doubles.
+ */
+struct refinement_result ddgesv_refine(size_t n,
+	const double *FPPLUS_RESTRICT a, size_t lda,
+	const double *FPPLUS_RESTRICT lu, size_t ldlu, const size_t FPPLUS_ARRAY_POINTER(pivots, n),
+	const double FPPLUS_ARRAY_POINTER(b, n),
+	doubledouble FPPLUS_ARRAY_POINTER(x, n),
+	size_t max_iterations,
+	double FPPLUS_ARRAY_POINTER(work, 4 * n));
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
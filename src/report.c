@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
+
+#include <report.h>
+
+#if defined(__INTEL_COMPILER)
+    #define REPORT_COMPILER "Intel " __VERSION__
+#elif defined(__clang__)
+    #define REPORT_COMPILER "Clang " __clang_version__
+#elif defined(__GNUC__)
+    #define REPORT_COMPILER "GCC " __VERSION__
+#else
+    #define REPORT_COMPILER "unknown"
+#endif
+
+/* Compiler flags are passed by the configure script */
+#ifndef FPPLUS_BUILD_FLAGS
+    #define FPPLUS_BUILD_FLAGS "unknown"
+#endif
+
+#if defined(FPPLUS_UARCH_HASWELL)
+    #define REPORT_UARCH "haswell"
+#elif defined(FPPLUS_UARCH_BROADWELL)
+    #define REPORT_UARCH "broadwell"
+#elif defined(FPPLUS_UARCH_SKYLAKE)
+    #define REPORT_UARCH "skylake"
+#elif defined(FPPLUS_UARCH_BULLDOZER)
+    #define REPORT_UARCH "bulldozer"
+#elif defined(FPPLUS_UARCH_PILEDRIVER)
+    #define REPORT_UARCH "piledriver"
+#elif defined(FPPLUS_UARCH_STEAMROLLER)
+    #define REPORT_UARCH "steamroller"
+#elif defined(FPPLUS_UARCH_KNC)
+    #define REPORT_UARCH "knc"
+#else
+    #define REPORT_UARCH "unknown"
+#endif
+
+static enum report_format report_format = report_format_text;
+static size_t report_measurements = 0;
+
+static const char* unit_name(enum report_unit unit) {
+    switch (unit) {
+        case report_unit_cycles_per_element:
+            return "cycles/element";
+        case report_unit_mflops:
+            return "MFLOPS";
+        case report_unit_relative_error:
+            return "relative error";
+        case report_unit_gbytes_per_second:
+            return "GB/s";
+        case report_unit_mbytes_per_second:
+            return "MB/s";
+        case report_unit_mmatrices_per_second:
+            return "Mmatrices/s";
+        case report_unit_cycles_per_call:
+            return "cycles/call";
+        case report_unit_gflops:
+            return "GFLOPS";
+    }
+    __builtin_unreachable();
+}
+
+/* Whether larger values of the measurement are better (used by the comparison tool) */
+static const char* unit_direction(enum report_unit unit) {
+    switch (unit) {
+        case report_unit_cycles_per_element:
+        case report_unit_relative_error:
+        case report_unit_cycles_per_call:
+            return "lower";
+        case report_unit_mflops:
+        case report_unit_gflops:
+        case report_unit_gbytes_per_second:
+        case report_unit_mbytes_per_second:
+        case report_unit_mmatrices_per_second:
+            return "higher";
+    }
+    __builtin_unreachable();
+}
+
+static void get_cpu_name(char name[restrict static 49]) {
+    strcpy(name, "unknown");
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned int max_leaf = __get_cpuid_max(0x80000000u, NULL);
+    if (max_leaf >= 0x80000004u) {
+        unsigned int* registers = (unsigned int*) name;
+        for (unsigned int leaf = 0x80000002u; leaf <= 0x80000004u; leaf++) {
+            __get_cpuid(leaf, &registers[0], &registers[1], &registers[2], &registers[3]);
+            registers += 4;
+        }
+        name[48] = '\0';
+        /* Brand string is right-justified on some processors */
+        const char* first_nonspace = name;
+        while (*first_nonspace == ' ') {
+            first_nonspace++;
+        }
+        memmove(name, first_nonspace, strlen(first_nonspace) + 1);
+    }
+#endif
+}
+
+static void print_json_string(const char* string) {
+    putchar('"');
+    for (; *string != '\0'; string++) {
+        const unsigned char c = (unsigned char) *string;
+        if (c == '"' || c == '\\') {
+            printf("\\%c", c);
+        } else if (c < 0x20) {
+            printf("\\u%04x", (unsigned int) c);
+        } else {
+            putchar(c);
+        }
+    }
+    putchar('"');
+}
+
+static void print_csv_string(const char* string) {
+    if (strpbrk(string, ",\"\n") == NULL) {
+        fputs(string, stdout);
+        return;
+    }
+    putchar('"');
+    for (; *string != '\0'; string++) {
+        if (*string == '"') {
+            putchar('"');
+        }
+        putchar(*string);
+    }
+    putchar('"');
+}
+
+bool parse_report_format(const char* name, enum report_format format[restrict static 1]) {
+    if (strcmp(name, "text") == 0) {
+        *format = report_format_text;
+    } else if (strcmp(name, "csv") == 0) {
+        *format = report_format_csv;
+    } else if (strcmp(name, "json") == 0) {
+        *format = report_format_json;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void report_begin(enum report_format format, const char* benchmark, int argc, char** argv) {
+    report_format = format;
+    report_measurements = 0;
+    if (format == report_format_text) {
+        return;
+    }
+
+    char cpu_name[49];
+    get_cpu_name(cpu_name);
+
+    char timestamp[32];
+    const time_t now = time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    char arguments[1024] = "";
+    for (int argi = 1; argi < argc; argi++) {
+        if (argi != 1) {
+            strncat(arguments, " ", sizeof(arguments) - strlen(arguments) - 1);
+        }
+        strncat(arguments, argv[argi], sizeof(arguments) - strlen(arguments) - 1);
+    }
+
+#ifdef FPPLUS_EMULATE_FPADDRE
+    const char* fpaddre = "emulated";
+#else
+    const char* fpaddre = "none";
+#endif
+
+    char counters[256] = "";
+    for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+        if (perf_counters_enabled() & (UINT32_C(1) << counter)) {
+            if (counters[0] != '\0') {
+                strncat(counters, ",", sizeof(counters) - strlen(counters) - 1);
+            }
+            strncat(counters, perf_counter_name(counter), sizeof(counters) - strlen(counters) - 1);
+        }
+    }
+
+    const struct {
+        const char* key;
+        const char* value;
+    } metadata[] = {
+        { "benchmark", benchmark },
+        { "arguments", arguments },
+        { "cpu", cpu_name },
+        { "compiler", REPORT_COMPILER },
+        { "flags", FPPLUS_BUILD_FLAGS },
+        { "uarch", REPORT_UARCH },
+        { "fpaddre", fpaddre },
+        { "timestamp", timestamp },
+        { "counters", counters },
+    };
+
+    switch (format) {
+        case report_format_csv:
+            for (size_t i = 0; i < sizeof(metadata) / sizeof(metadata[0]); i++) {
+                printf("# %s: %s\n", metadata[i].key, metadata[i].value);
+            }
+            printf("name,size,unit,better,count,min,median,mean,max,stddev");
+            for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+                if (perf_counters_enabled() & (UINT32_C(1) << counter)) {
+                    printf(",%s", perf_counter_name(counter));
+                }
+            }
+            printf("\n");
+            break;
+        case report_format_json:
+            printf("{\n");
+            for (size_t i = 0; i < sizeof(metadata) / sizeof(metadata[0]); i++) {
+                printf("\t\"%s\": ", metadata[i].key);
+                print_json_string(metadata[i].value);
+                printf(",\n");
+            }
+            printf("\t\"results\": [");
+            break;
+        case report_format_text:
+            __builtin_unreachable();
+    }
+}
+
+void report_measurement(const char* name, size_t size, enum report_unit unit,
+    const struct sample_statistics statistics[restrict static 1],
+    const double counters[restrict static perf_counter_count])
+{
+    const uint32_t enabled_counters = perf_counters_enabled();
+    switch (report_format) {
+        case report_format_text:
+            return;
+        case report_format_csv:
+            print_csv_string(name);
+            printf(",%zu,%s,%s,%zu,%.9g,%.9g,%.9g,%.9g,%.9g",
+                size, unit_name(unit), unit_direction(unit), statistics->count,
+                statistics->min, statistics->median, statistics->mean, statistics->max, statistics->stddev);
+            for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+                if (enabled_counters & (UINT32_C(1) << counter)) {
+                    printf(",%.9g", counters[counter]);
+                }
+            }
+            printf("\n");
+            break;
+        case report_format_json:
+            printf("%s\n\t\t{ \"name\": ", report_measurements == 0 ? "" : ",");
+            print_json_string(name);
+            printf(", \"size\": %zu, \"unit\": \"%s\", \"better\": \"%s\", \"count\": %zu, "
+                "\"min\": %.9g, \"median\": %.9g, \"mean\": %.9g, \"max\": %.9g, \"stddev\": %.9g",
+                size, unit_name(unit), unit_direction(unit), statistics->count,
+                statistics->min, statistics->median, statistics->mean, statistics->max, statistics->stddev);
+            if (enabled_counters != 0) {
+                printf(", \"counters\": {");
+                const char* separator = " ";
+                for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+                    if (enabled_counters & (UINT32_C(1) << counter)) {
+                        printf("%s\"%s\": %.9g", separator, perf_counter_name(counter), counters[counter]);
+                        separator = ", ";
+                    }
+                }
+                printf(" }");
+            }
+            printf(" }");
+            break;
+    }
+    report_measurements += 1;
+}
+
+void report_text_counters(const double counters[restrict static perf_counter_count]) {
+    for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+        if (perf_counters_enabled() & (UINT32_C(1) << counter)) {
+            printf("\t%s %.2lf", perf_counter_name(counter), counters[counter]);
+        }
+    }
+    printf("\n");
+}
+
+void report_end(void) {
+    if (report_format == report_format_json) {
+        printf("\n\t]\n}\n");
+    }
+    fflush(stdout);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <utils.h>
+
+/**
+ * @brief Output format of benchmark results
+ */
+enum report_format {
+    /** Human-readable tab-separated lines (the default) */
+    report_format_text = 0,
+    /** Comma-separated values with metadata in leading comment lines */
+    report_format_csv,
+    /** Single JSON document with metadata and an array of results */
+    report_format_json,
+};
+
+/**
+ * @brief Unit of a reported measurement
+ */
+enum report_unit {
+    report_unit_cycles_per_element,
+    report_unit_mflops,
+    report_unit_relative_error,
+    report_unit_gbytes_per_second,
+    report_unit_mbytes_per_second,
+    report_unit_mmatrices_per_second,
+    report_unit_cycles_per_call,
+    report_unit_gflops,
+};
+
+/**
+ * @brief Parses output format name ("text", "csv", or "json")
+ * @return true on success, false if the name is not recognized
+ */
+bool parse_report_format(const char* name, enum report_format format[restrict static 1]);
+
+/**
+ * @brief Starts a machine-readable report and writes the build and host metadata
+ * @note Does nothing for text format: benchmarks print text output themselves.
+ */
+void report_begin(enum report_format format, const char* benchmark, int argc, char** argv);
+
+/**
+ * @brief Writes summary statistics of a single measurement to the report
+ * @param name - identifier of the measured kernel, unique within the benchmark for the given size.
+ * @param size - problem size (array elements, repeats, or block size, depending on the benchmark).
+ * @param counters - median values of the enabled performance counters (see perf_counters_enabled) per operation.
+ */
+void report_measurement(const char* name, size_t size, enum report_unit unit,
+    const struct sample_statistics statistics[restrict static 1],
+    const double counters[restrict static perf_counter_count]);
+
+/**
+ * @brief Terminates a line of text output with the values of enabled performance counters
+ */
+void report_text_counters(const double counters[restrict static perf_counter_count]);
+
+/**
+ * @brief Finishes the report started with report_begin
+ */
+void report_end(void);
@@ -3,11 +3,16 @@ class SimdOperations:
 		assert simd in ["avx", "mic"]
 		self.name = simd
 		self.width = {"avx": 4, "mic": 8}[simd]
+		# Alignment, in bytes, required by aligned vector loads
+		self.alignment = 8 * self.width
 		self.regs = {"avx": 16, "mic": 32}[simd]
 		self.dvec = {"avx": "__m256d", "mic": "__m512d"}[simd]
 		self.ddvec = {"avx": "__m256dd", "mic": "__m512dd"}[simd]
 		self._dzero = {"avx": "_mm256_setzero_pd", "mic": "_mm512_setzero_pd"}[simd]
 		self._dload = {"avx": "_mm256_load_pd", "mic": "_mm512_load_pd"}[simd]
+		self._dloadu = {"avx": "_mm256_loadu_pd", "mic": None}[simd]
+		self._dmaskload = {"avx": "_mm256_maskload_pd", "mic": None}[simd]
+		self._dstore = {"avx": "_mm256_store_pd", "mic": "_mm512_store_pd"}[simd]
 		self._dadd = {"avx": "_mm256_add_pd", "mic": "_mm512_add_pd"}[simd]
 		self._dmul = {"avx": "_mm256_mul_pd", "mic": "_mm512_mul_pd"}[simd]
 		self._dfma = {"avx": "_mm256_fmadd_pd", "mic": "_mm512_fmadd_pd"}[simd]
@@ -21,6 +26,19 @@ class SimdOperations:
 		self.ddinterleavestore = {"avx": "_mm256_interleavestore_pdd", "mic": "_mm512_interleavestore_pdd"}[simd]
 		self.ddinterleavestoreu = {"avx": "_mm256_interleavestoreu_pdd", "mic": "_mm512_interleavestoreu_pdd"}[simd]
 		self.ddbroadcast = {"avx": "_mm256_broadcast_sdd", "mic": "_mm512_broadcast_sdd"}[simd]
+		# Single-precision and float-float operations (float-float arithmetic is implemented only for AVX)
+		self.fwidth = 2 * self.width
+		self.fvec = {"avx": "__m256", "mic": "__m512"}[simd]
+		self.ffvec = {"avx": "__m256ff", "mic": None}[simd]
+		self._fload = {"avx": "_mm256_load_ps", "mic": "_mm512_load_ps"}[simd]
+		self._floadu = {"avx": "_mm256_loadu_ps", "mic": None}[simd]
+		self._fmaskload = {"avx": "_mm256_maskload_ps", "mic": None}[simd]
+		self._fadd = {"avx": "_mm256_add_ps", "mic": "_mm512_add_ps"}[simd]
+		self.ffzero = {"avx": "_mm256_setzero_pff", "mic": None}[simd]
+		self._ffadd = {"avx": "_mm256_add_pff", "mic": None}[simd]
+		self._ffreduce = {"avx": "_mm256_reduce_add_pff", "mic": None}[simd]
+		self._fefadd = {"avx": "_mm256_efadd_ps", "mic": None}[simd]
+		self._fefmul = {"avx": "_mm256_efmul_ps", "mic": None}[simd]
 
 
 	def dzero(self):
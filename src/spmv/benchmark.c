@@ -0,0 +1,188 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+
+#include <utils.h>
+#include <spmv/common.h>
+
+
+/* 5-point finite-difference Laplacian on a grid x grid mesh with Dirichlet boundary conditions */
+static bool generate_laplacian(size_t grid, struct csr_matrix matrix[restrict static 1]) {
+	const size_t rows = grid * grid;
+	const size_t max_entries = 5 * rows;
+	uint32_t* row_indices = malloc(max_entries * sizeof(uint32_t));
+	uint32_t* column_indices = malloc(max_entries * sizeof(uint32_t));
+	double* values = malloc(max_entries * sizeof(double));
+	bool success = false;
+	if (row_indices != NULL && column_indices != NULL && values != NULL) {
+		size_t entries = 0;
+		for (size_t i = 0; i < grid; i++) {
+			for (size_t j = 0; j < grid; j++) {
+				const uint32_t row = (uint32_t) (i * grid + j);
+				const int64_t neighbors[4][2] = { { -1, 0 }, { 0, -1 }, { 0, 1 }, { 1, 0 } };
+				row_indices[entries] = row;
+				column_indices[entries] = row;
+				values[entries++] = 4.0;
+				for (size_t k = 0; k < 4; k++) {
+					const int64_t ni = (int64_t) i + neighbors[k][0], nj = (int64_t) j + neighbors[k][1];
+					if (ni >= 0 && ni < (int64_t) grid && nj >= 0 && nj < (int64_t) grid) {
+						row_indices[entries] = row;
+						column_indices[entries] = (uint32_t) (ni * (int64_t) grid + nj);
+						values[entries++] = -1.0;
+					}
+				}
+			}
+		}
+		success = csr_from_coordinates(rows, rows, entries, row_indices, column_indices, values, matrix);
+	}
+	free(row_indices);
+	free(column_indices);
+	free(values);
+	return success;
+}
+
+/* max |y - reference| / max |reference| */
+static double relative_error(size_t n, const double y[restrict static n], const doubledouble reference[restrict static n]) {
+	double max_error = 0.0, max_reference = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		const doubledouble error = ddaddw(reference[i], -y[i]);
+		max_error = fmax(max_error, fabs(error.hi));
+		max_reference = fmax(max_reference, fabs(reference[i].hi));
+	}
+	return max_reference != 0.0 ? max_error / max_reference : max_error;
+}
+
+/* Prints MFLOPS and effective memory bandwidth, or reports both as separate measurements */
+static void report(
+	const char* name,
+	enum report_format format,
+	size_t iterations,
+	const double iteration_times[restrict static iterations],
+	const struct perf_counter_values iteration_counters[restrict static iterations],
+	size_t rows, size_t nonzeros, size_t bytes)
+{
+	double counters[perf_counter_count];
+	median_perf_counters(iterations, iteration_counters, (double) nonzeros, counters);
+	double iteration_mflops[iterations], iteration_bandwidth[iterations];
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		/* One multiplication and one addition per non-zero */
+		iteration_mflops[iteration] = 2.0e+3 * (double) nonzeros / iteration_times[iteration];
+		iteration_bandwidth[iteration] = (double) bytes / iteration_times[iteration];
+	}
+	if (format == report_format_text) {
+		printf("%s\t" "%10zu\t" "%10zu\t" "%.1lf\t" "%.2lf",
+			name, rows, nonzeros,
+			median_double(iteration_mflops, iterations),
+			median_double(iteration_bandwidth, iterations));
+		report_text_counters(counters);
+	} else {
+		const struct sample_statistics mflops_statistics = compute_sample_statistics(iteration_mflops, iterations);
+		report_measurement(name, nonzeros, report_unit_mflops, &mflops_statistics, counters);
+		const struct sample_statistics bandwidth_statistics = compute_sample_statistics(iteration_bandwidth, iterations);
+		report_measurement(name, nonzeros, report_unit_gbytes_per_second, &bandwidth_statistics, counters);
+	}
+}
+
+static void benchmark(const struct csr_matrix csr[restrict static 1], size_t sigma, enum report_format format, size_t iterations) {
+	struct sell_matrix sell;
+	if (!sell_from_csr(csr, sigma, &sell)) {
+		fprintf(stderr, "Error: failed to convert %zux%zu matrix to SELL-C-sigma format\n", csr->rows, csr->columns);
+		exit(EXIT_FAILURE);
+	}
+	double* x = valloc((csr->columns == 0 ? 1 : csr->columns) * sizeof(double));
+	double* y = valloc((csr->rows == 0 ? 1 : csr->rows) * sizeof(double));
+	doubledouble* dd_y = valloc((csr->rows == 0 ? 1 : csr->rows) * sizeof(doubledouble));
+	if (x == NULL || y == NULL || dd_y == NULL) {
+		fprintf(stderr, "Error: failed to allocate memory for the benchmark\n");
+		exit(EXIT_FAILURE);
+	}
+	uint64_t state = UINT64_C(0x853C49E6748FEA9B) + csr->rows;
+	for (size_t i = 0; i < csr->columns; i++) {
+		x[i] = random_uniform(&state);
+	}
+
+	/* Each kernel reads the matrix and x once, and writes y once */
+	const size_t csr_matrix_bytes = csr->nonzeros * (sizeof(double) + sizeof(uint32_t)) + (csr->rows + 1) * sizeof(size_t);
+	const size_t sell_elements = sell.chunk_offsets[sell.chunks] * SELL_CHUNK_SIZE;
+	const size_t sell_matrix_bytes = sell_elements * (sizeof(double) + sizeof(uint32_t)) +
+		(sell.chunks + 1) * sizeof(size_t) + sell.chunks * SELL_CHUNK_SIZE * sizeof(uint32_t);
+	const size_t x_bytes = csr->columns * sizeof(double);
+
+	double times[iterations];
+	struct perf_counter_values iteration_counters[iterations];
+
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		csr_spmv(csr, x, y);
+		times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	report("spmv/csr/double", format, iterations, times, iteration_counters,
+		csr->rows, csr->nonzeros, csr_matrix_bytes + x_bytes + csr->rows * sizeof(double));
+
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		csr_spmv_compensated(csr, x, dd_y);
+		times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	report("spmv/csr/compensated", format, iterations, times, iteration_counters,
+		csr->rows, csr->nonzeros, csr_matrix_bytes + x_bytes + csr->rows * sizeof(doubledouble));
+	const double double_error = relative_error(csr->rows, y, dd_y);
+
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		perf_counters_start();
+		const double start_time = high_precision_time();
+		sell_spmv_compensated(&sell, x, dd_y);
+		times[iteration] = high_precision_time() - start_time;
+		perf_counters_stop(&iteration_counters[iteration]);
+	}
+	/* Padding elements of SELL-C-sigma format are loaded, but not counted as flops */
+	report("spmv/sell/compensated", format, iterations, times, iteration_counters,
+		csr->rows, csr->nonzeros, sell_matrix_bytes + x_bytes + csr->rows * sizeof(doubledouble));
+
+	if (format == report_format_text) {
+		printf("spmv/csr/double error\t" "%10zu\t" "%10zu\t" "%.2le\n", csr->rows, csr->nonzeros, double_error);
+	} else {
+		const double no_counters[perf_counter_count] = { 0 };
+		const struct sample_statistics error_statistics = compute_sample_statistics((double[1]) { double_error }, 1);
+		report_measurement("spmv/csr/double/error", csr->nonzeros, report_unit_relative_error, &error_statistics, no_counters);
+	}
+
+	free(x);
+	free(y);
+	free(dd_y);
+	sell_release(&sell);
+}
+
+int main(int argc, char *argv[]) {
+	const struct benchmark_options options = parse_options(argc, argv);
+
+	perf_counters_open(options.counters);
+	report_begin(options.format, "spmv-bench", argc, argv);
+	struct csr_matrix matrix;
+	if (options.matrix_path != NULL) {
+		if (!csr_load_matrix_market(options.matrix_path, &matrix)) {
+			exit(EXIT_FAILURE);
+		}
+		benchmark(&matrix, options.sigma, options.format, options.iterations);
+		csr_release(&matrix);
+	} else {
+		for (size_t grid = 32; grid <= options.max_grid; grid *= 2) {
+			if (!generate_laplacian(grid, &matrix)) {
+				fprintf(stderr, "Error: failed to generate %zux%zu Laplacian matrix\n", grid * grid, grid * grid);
+				exit(EXIT_FAILURE);
+			}
+			benchmark(&matrix, options.sigma, options.format, options.iterations);
+			csr_release(&matrix);
+		}
+	}
+	report_end();
+	perf_counters_close();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <report.h>
+#include <spmv/spmv.h>
+
+
+struct benchmark_options {
+	size_t iterations;
+	/* Matrix Market file to benchmark, or NULL for the generated 2D Laplacian matrices */
+	const char* matrix_path;
+	/* The largest grid size of the generated 2D Laplacian matrices */
+	size_t max_grid;
+	/* Sorting window of the SELL-C-sigma format */
+	size_t sigma;
+	enum report_format format;
+	/* Bit mask of performance counters (1 << enum perf_counter) */
+	uint32_t counters;
+};
+
+struct benchmark_options parse_options(int argc, char** argv);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include <spmv/spmv.h>
+
+
+enum matrix_market_field {
+	matrix_market_field_real,
+	matrix_market_field_integer,
+	matrix_market_field_pattern,
+};
+
+enum matrix_market_symmetry {
+	matrix_market_symmetry_general,
+	matrix_market_symmetry_symmetric,
+	matrix_market_symmetry_skew_symmetric,
+};
+
+static bool parse_banner(const char* line, enum matrix_market_field field[restrict static 1], enum matrix_market_symmetry symmetry[restrict static 1]) {
+	char object[32], format[32], field_name[32], symmetry_name[32];
+	if (sscanf(line, "%%%%MatrixMarket %31s %31s %31s %31s", object, format, field_name, symmetry_name) != 4) {
+		fprintf(stderr, "Error: invalid Matrix Market banner\n");
+		return false;
+	}
+	if (strcasecmp(object, "matrix") != 0 || strcasecmp(format, "coordinate") != 0) {
+		fprintf(stderr, "Error: unsupported Matrix Market object %s %s: only sparse matrices in coordinate format are supported\n", object, format);
+		return false;
+	}
+	if (strcasecmp(field_name, "real") == 0) {
+		*field = matrix_market_field_real;
+	} else if (strcasecmp(field_name, "integer") == 0) {
+		*field = matrix_market_field_integer;
+	} else if (strcasecmp(field_name, "pattern") == 0) {
+		*field = matrix_market_field_pattern;
+	} else {
+		fprintf(stderr, "Error: unsupported Matrix Market field %s\n", field_name);
+		return false;
+	}
+	if (strcasecmp(symmetry_name, "general") == 0) {
+		*symmetry = matrix_market_symmetry_general;
+	} else if (strcasecmp(symmetry_name, "symmetric") == 0) {
+		*symmetry = matrix_market_symmetry_symmetric;
+	} else if (strcasecmp(symmetry_name, "skew-symmetric") == 0) {
+		*symmetry = matrix_market_symmetry_skew_symmetric;
+	} else {
+		fprintf(stderr, "Error: unsupported Matrix Market symmetry %s\n", symmetry_name);
+		return false;
+	}
+	return true;
+}
+
+bool csr_load_matrix_market(const char* path, struct csr_matrix matrix[restrict static 1]) {
+	memset(matrix, 0, sizeof(struct csr_matrix));
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		fprintf(stderr, "Error: failed to open file %s\n", path);
+		return false;
+	}
+
+	bool success = false;
+	uint32_t* row_indices = NULL;
+	uint32_t* column_indices = NULL;
+	double* values = NULL;
+	char line[1024];
+	enum matrix_market_field field;
+	enum matrix_market_symmetry symmetry;
+	if (fgets(line, sizeof(line), file) == NULL || !parse_banner(line, &field, &symmetry)) {
+		goto cleanup;
+	}
+
+	/* Comment lines start with %, the first other line is the size line */
+	size_t rows, columns, lines;
+	do {
+		if (fgets(line, sizeof(line), file) == NULL) {
+			fprintf(stderr, "Error: unexpected end of file %s\n", path);
+			goto cleanup;
+		}
+	} while (line[0] == '%');
+	if (sscanf(line, "%zu %zu %zu", &rows, &columns, &lines) != 3) {
+		fprintf(stderr, "Error: invalid Matrix Market size line\n");
+		goto cleanup;
+	}
+	/* Column indices must fit into signed 32-bit integers for AVX2 gather instructions */
+	if (rows > INT32_MAX || columns > INT32_MAX) {
+		fprintf(stderr, "Error: %zux%zu matrix is too large\n", rows, columns);
+		goto cleanup;
+	}
+	if (symmetry != matrix_market_symmetry_general && rows != columns) {
+		fprintf(stderr, "Error: %zux%zu matrix can not be symmetric\n", rows, columns);
+		goto cleanup;
+	}
+
+	/* Off-diagonal entries of symmetric matrices are stored twice */
+	const size_t max_entries = symmetry == matrix_market_symmetry_general ? lines : 2 * lines;
+	row_indices = malloc((max_entries == 0 ? 1 : max_entries) * sizeof(uint32_t));
+	column_indices = malloc((max_entries == 0 ? 1 : max_entries) * sizeof(uint32_t));
+	values = malloc((max_entries == 0 ? 1 : max_entries) * sizeof(double));
+	if (row_indices == NULL || column_indices == NULL || values == NULL) {
+		fprintf(stderr, "Error: failed to allocate memory for %zu matrix entries\n", max_entries);
+		goto cleanup;
+	}
+	size_t entries = 0;
+	for (size_t i = 0; i < lines; i++) {
+		size_t row, column;
+		double value = 1.0;
+		const int parsed = field == matrix_market_field_pattern ?
+			fscanf(file, "%zu %zu", &row, &column) :
+			fscanf(file, "%zu %zu %lf", &row, &column, &value);
+		if (parsed != (field == matrix_market_field_pattern ? 2 : 3)) {
+			fprintf(stderr, "Error: failed to parse entry %zu of %zu\n", i + 1, lines);
+			goto cleanup;
+		}
+		/* Indices in Matrix Market files are 1-based */
+		if (row == 0 || row > rows || column == 0 || column > columns) {
+			fprintf(stderr, "Error: entry (%zu, %zu) is outside of the %zux%zu matrix\n", row, column, rows, columns);
+			goto cleanup;
+		}
+		row_indices[entries] = (uint32_t) (row - 1);
+		column_indices[entries] = (uint32_t) (column - 1);
+		values[entries] = value;
+		entries += 1;
+		if (symmetry != matrix_market_symmetry_general && row != column) {
+			row_indices[entries] = (uint32_t) (column - 1);
+			column_indices[entries] = (uint32_t) (row - 1);
+			values[entries] = symmetry == matrix_market_symmetry_skew_symmetric ? -value : value;
+			entries += 1;
+		}
+	}
+
+	success = csr_from_coordinates(rows, columns, entries, row_indices, column_indices, values, matrix);
+	if (!success) {
+		fprintf(stderr, "Error: failed to allocate memory for %zux%zu matrix\n", rows, columns);
+	}
+
+cleanup:
+	free(row_indices);
+	free(column_indices);
+	free(values);
+	fclose(file);
+	return success;
+}
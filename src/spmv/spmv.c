@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <spmv/spmv.h>
+
+
+struct coordinate_entry {
+	uint32_t column;
+	double value;
+};
+
+static int compare_coordinate_entries(const void* a, const void* b) {
+	const uint32_t column_a = ((const struct coordinate_entry*) a)->column;
+	const uint32_t column_b = ((const struct coordinate_entry*) b)->column;
+	return (column_a > column_b) - (column_a < column_b);
+}
+
+bool csr_from_coordinates(size_t rows, size_t columns, size_t entries,
+	const uint32_t row_indices[restrict static entries],
+	const uint32_t column_indices[restrict static entries],
+	const double values[restrict static entries],
+	struct csr_matrix matrix[restrict static 1])
+{
+	memset(matrix, 0, sizeof(struct csr_matrix));
+	matrix->rows = rows;
+	matrix->columns = columns;
+	matrix->row_offsets = calloc(rows + 1, sizeof(size_t));
+	struct coordinate_entry* sorted_entries = malloc((entries == 0 ? 1 : entries) * sizeof(struct coordinate_entry));
+	if (matrix->row_offsets == NULL || sorted_entries == NULL) {
+		free(sorted_entries);
+		csr_release(matrix);
+		return false;
+	}
+
+	/* Bucket the entries by row, then sort each row by column */
+	for (size_t i = 0; i < entries; i++) {
+		matrix->row_offsets[row_indices[i] + 1] += 1;
+	}
+	for (size_t row = 0; row < rows; row++) {
+		matrix->row_offsets[row + 1] += matrix->row_offsets[row];
+	}
+	for (size_t i = 0; i < entries; i++) {
+		const size_t position = matrix->row_offsets[row_indices[i]]++;
+		sorted_entries[position] = (struct coordinate_entry) { column_indices[i], values[i] };
+	}
+	/* row_offsets[row] now points to the end of the row */
+	for (size_t row = rows; row != 0; row--) {
+		matrix->row_offsets[row] = matrix->row_offsets[row - 1];
+	}
+	matrix->row_offsets[0] = 0;
+
+	/* Sum duplicate entries, and compact the rows in-place */
+	size_t nonzeros = 0;
+	for (size_t row = 0; row < rows; row++) {
+		const size_t begin = matrix->row_offsets[row], end = matrix->row_offsets[row + 1];
+		qsort(&sorted_entries[begin], end - begin, sizeof(struct coordinate_entry), compare_coordinate_entries);
+		matrix->row_offsets[row] = nonzeros;
+		for (size_t i = begin; i < end; i++) {
+			if (nonzeros != matrix->row_offsets[row] && sorted_entries[nonzeros - 1].column == sorted_entries[i].column) {
+				sorted_entries[nonzeros - 1].value += sorted_entries[i].value;
+			} else {
+				sorted_entries[nonzeros++] = sorted_entries[i];
+			}
+		}
+	}
+	matrix->row_offsets[rows] = nonzeros;
+	matrix->nonzeros = nonzeros;
+
+	matrix->column_indices = malloc((nonzeros == 0 ? 1 : nonzeros) * sizeof(uint32_t));
+	matrix->values = malloc((nonzeros == 0 ? 1 : nonzeros) * sizeof(double));
+	if (matrix->column_indices == NULL || matrix->values == NULL) {
+		free(sorted_entries);
+		csr_release(matrix);
+		return false;
+	}
+	for (size_t i = 0; i < nonzeros; i++) {
+		matrix->column_indices[i] = sorted_entries[i].column;
+		matrix->values[i] = sorted_entries[i].value;
+	}
+	free(sorted_entries);
+	return true;
+}
+
+void csr_release(struct csr_matrix matrix[restrict static 1]) {
+	free(matrix->row_offsets);
+	free(matrix->column_indices);
+	free(matrix->values);
+	memset(matrix, 0, sizeof(struct csr_matrix));
+}
+
+
+struct row_length {
+	size_t length;
+	uint32_t row;
+};
+
+/* Decreasing length, and increasing row index for rows of the same length */
+static int compare_row_lengths(const void* a, const void* b) {
+	const struct row_length* row_a = a;
+	const struct row_length* row_b = b;
+	if (row_a->length != row_b->length) {
+		return row_a->length < row_b->length ? 1 : -1;
+	}
+	return (row_a->row > row_b->row) - (row_a->row < row_b->row);
+}
+
+bool sell_from_csr(const struct csr_matrix csr[restrict static 1], size_t sigma,
+	struct sell_matrix matrix[restrict static 1])
+{
+	memset(matrix, 0, sizeof(struct sell_matrix));
+	const size_t chunks = (csr->rows + SELL_CHUNK_SIZE - 1) / SELL_CHUNK_SIZE;
+	const size_t padded_rows = chunks * SELL_CHUNK_SIZE;
+	matrix->rows = csr->rows;
+	matrix->columns = csr->columns;
+	matrix->chunks = chunks;
+	matrix->sigma = sigma;
+	matrix->chunk_offsets = malloc((chunks + 1) * sizeof(size_t));
+	matrix->row_permutation = malloc((padded_rows == 0 ? 1 : padded_rows) * sizeof(uint32_t));
+	struct row_length* row_lengths = malloc((padded_rows == 0 ? 1 : padded_rows) * sizeof(struct row_length));
+	if (matrix->chunk_offsets == NULL || matrix->row_permutation == NULL || row_lengths == NULL) {
+		free(row_lengths);
+		sell_release(matrix);
+		return false;
+	}
+
+	/* Padding rows beyond csr->rows have no non-zeros, and their results are not stored */
+	for (size_t row = 0; row < padded_rows; row++) {
+		const size_t length = row < csr->rows ? csr->row_offsets[row + 1] - csr->row_offsets[row] : 0;
+		row_lengths[row] = (struct row_length) { length, (uint32_t) row };
+	}
+	for (size_t window = 0; window < padded_rows; window += sigma) {
+		const size_t window_rows = padded_rows - window < sigma ? padded_rows - window : sigma;
+		qsort(&row_lengths[window], window_rows, sizeof(struct row_length), compare_row_lengths);
+	}
+
+	matrix->chunk_offsets[0] = 0;
+	for (size_t chunk = 0; chunk < chunks; chunk++) {
+		size_t chunk_length = 0;
+		for (size_t lane = 0; lane < SELL_CHUNK_SIZE; lane++) {
+			const struct row_length row = row_lengths[chunk * SELL_CHUNK_SIZE + lane];
+			matrix->row_permutation[chunk * SELL_CHUNK_SIZE + lane] = row.row;
+			chunk_length = row.length > chunk_length ? row.length : chunk_length;
+		}
+		matrix->chunk_offsets[chunk + 1] = matrix->chunk_offsets[chunk] + chunk_length;
+	}
+	free(row_lengths);
+
+	/* Aligned, so the kernel loads the values of a chunk with aligned SIMD loads */
+	const size_t elements = matrix->chunk_offsets[chunks] * SELL_CHUNK_SIZE;
+	if (posix_memalign((void**) &matrix->values, 64, (elements == 0 ? 1 : elements) * sizeof(double)) != 0) {
+		matrix->values = NULL;
+	}
+	matrix->column_indices = malloc((elements == 0 ? 1 : elements) * sizeof(uint32_t));
+	if (matrix->values == NULL || matrix->column_indices == NULL) {
+		sell_release(matrix);
+		return false;
+	}
+	for (size_t chunk = 0; chunk < chunks; chunk++) {
+		const size_t chunk_length = matrix->chunk_offsets[chunk + 1] - matrix->chunk_offsets[chunk];
+		uint32_t* chunk_columns = &matrix->column_indices[matrix->chunk_offsets[chunk] * SELL_CHUNK_SIZE];
+		double* chunk_values = &matrix->values[matrix->chunk_offsets[chunk] * SELL_CHUNK_SIZE];
+		for (size_t lane = 0; lane < SELL_CHUNK_SIZE; lane++) {
+			const size_t row = matrix->row_permutation[chunk * SELL_CHUNK_SIZE + lane];
+			const size_t begin = row < csr->rows ? csr->row_offsets[row] : 0;
+			const size_t length = row < csr->rows ? csr->row_offsets[row + 1] - begin : 0;
+			for (size_t j = 0; j < chunk_length; j++) {
+				/* Padding repeats the last column of the row, so it does not load x from other cache lines */
+				if (j < length) {
+					chunk_columns[j * SELL_CHUNK_SIZE + lane] = csr->column_indices[begin + j];
+					chunk_values[j * SELL_CHUNK_SIZE + lane] = csr->values[begin + j];
+				} else {
+					chunk_columns[j * SELL_CHUNK_SIZE + lane] = length != 0 ? csr->column_indices[begin + length - 1] : 0;
+					chunk_values[j * SELL_CHUNK_SIZE + lane] = 0.0;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void sell_release(struct sell_matrix matrix[restrict static 1]) {
+	free(matrix->chunk_offsets);
+	free(matrix->row_permutation);
+	free(matrix->column_indices);
+	free(matrix->values);
+	memset(matrix, 0, sizeof(struct sell_matrix));
+}
+
+
+void csr_spmv(const struct csr_matrix matrix[restrict static 1], const double x[restrict], double y[restrict]) {
+	const size_t* row_offsets = matrix->row_offsets;
+	const uint32_t* column_indices = matrix->column_indices;
+	const double* values = matrix->values;
+	for (size_t row = 0; row < matrix->rows; row++) {
+		double sum = 0.0;
+		for (size_t i = row_offsets[row]; i < row_offsets[row + 1]; i++) {
+			sum += values[i] * x[column_indices[i]];
+		}
+		y[row] = sum;
+	}
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+static inline __m256d gather_pd(const double x[restrict], const uint32_t indices[restrict static 4]) {
+#if defined(__AVX2__)
+	return _mm256_i32gather_pd(x, _mm_loadu_si128((const __m128i*) indices), sizeof(double));
+#else
+	return _mm256_set_pd(x[indices[3]], x[indices[2]], x[indices[1]], x[indices[0]]);
+#endif
+}
+#endif
+
+void csr_spmv_compensated(const struct csr_matrix matrix[restrict static 1], const double x[restrict], doubledouble y[restrict]) {
+	const size_t* row_offsets = matrix->row_offsets;
+	const uint32_t* column_indices = matrix->column_indices;
+	const double* values = matrix->values;
+	for (size_t row = 0; row < matrix->rows; row++) {
+		size_t i = row_offsets[row];
+		const size_t end = row_offsets[row + 1];
+		doubledouble sum = { 0.0, 0.0 };
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+		if (end - i >= 4) {
+			__m256dd vsum = _mm256_setzero_pdd();
+			for (; i + 4 <= end; i += 4) {
+				__m256d vproduct_error, vsum_error;
+				const __m256d vproduct = _mm256_efmul_pd(_mm256_loadu_pd(&values[i]), gather_pd(x, &column_indices[i]), &vproduct_error);
+				vsum.hi = _mm256_efadd_pd(vsum.hi, vproduct, &vsum_error);
+				vsum.lo = _mm256_add_pd(vsum.lo, _mm256_add_pd(vsum_error, vproduct_error));
+			}
+			sum = _mm256_reduce_add_pdd(vsum);
+		}
+#endif
+		for (; i < end; i++) {
+			double product_error, sum_error;
+			const double product = efmul(values[i], x[column_indices[i]], &product_error);
+			sum.hi = efadd(sum.hi, product, &sum_error);
+			sum.lo += sum_error + product_error;
+		}
+		/* Normalize */
+		sum.hi = efaddord(sum.hi, sum.lo, &sum.lo);
+		y[row] = sum;
+	}
+}
+
+void sell_spmv_compensated(const struct sell_matrix matrix[restrict static 1], const double x[restrict], doubledouble y[restrict]) {
+	for (size_t chunk = 0; chunk < matrix->chunks; chunk++) {
+		const size_t chunk_length = matrix->chunk_offsets[chunk + 1] - matrix->chunk_offsets[chunk];
+		const uint32_t* chunk_columns = &matrix->column_indices[matrix->chunk_offsets[chunk] * SELL_CHUNK_SIZE];
+		const double* chunk_values = &matrix->values[matrix->chunk_offsets[chunk] * SELL_CHUNK_SIZE];
+		const uint32_t* chunk_rows = &matrix->row_permutation[chunk * SELL_CHUNK_SIZE];
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+		/* Each lane accumulates one row of the chunk */
+		__m256dd vsum = _mm256_setzero_pdd();
+		for (size_t j = 0; j < chunk_length; j++) {
+			__m256d vproduct_error, vsum_error;
+			const __m256d vproduct = _mm256_efmul_pd(
+				_mm256_load_pd(&chunk_values[j * SELL_CHUNK_SIZE]),
+				gather_pd(x, &chunk_columns[j * SELL_CHUNK_SIZE]),
+				&vproduct_error);
+			vsum.hi = _mm256_efadd_pd(vsum.hi, vproduct, &vsum_error);
+			vsum.lo = _mm256_add_pd(vsum.lo, _mm256_add_pd(vsum_error, vproduct_error));
+		}
+		vsum.hi = _mm256_efaddord_pd(vsum.hi, vsum.lo, &vsum.lo);
+		double sum_hi[SELL_CHUNK_SIZE], sum_lo[SELL_CHUNK_SIZE];
+		_mm256_storeu_pd(sum_hi, vsum.hi);
+		_mm256_storeu_pd(sum_lo, vsum.lo);
+		for (size_t lane = 0; lane < SELL_CHUNK_SIZE; lane++) {
+			if (chunk_rows[lane] < matrix->rows) {
+				y[chunk_rows[lane]] = (doubledouble) { sum_hi[lane], sum_lo[lane] };
+			}
+		}
+#else
+		for (size_t lane = 0; lane < SELL_CHUNK_SIZE; lane++) {
+			doubledouble sum = { 0.0, 0.0 };
+			for (size_t j = 0; j < chunk_length; j++) {
+				double product_error, sum_error;
+				const double product = efmul(chunk_values[j * SELL_CHUNK_SIZE + lane],
+					x[chunk_columns[j * SELL_CHUNK_SIZE + lane]], &product_error);
+				sum.hi = efadd(sum.hi, product, &sum_error);
+				sum.lo += sum_error + product_error;
+			}
+			sum.hi = efaddord(sum.hi, sum.lo, &sum.lo);
+			if (chunk_rows[lane] < matrix->rows) {
+				y[chunk_rows[lane]] = sum;
+			}
+		}
+#endif
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <fpplus.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sparse matrix in compressed sparse row (CSR) format
+ */
+struct csr_matrix {
+	size_t rows;
+	size_t columns;
+	size_t nonzeros;
+	/* Non-zeros of row i are at positions row_offsets[i]...row_offsets[i+1]-1, rows + 1 elements */
+	size_t* row_offsets;
+	/* Column indices of the non-zeros, in increasing order within each row */
+	uint32_t* column_indices;
+	double* values;
+};
+
+/* The number of rows in a chunk of SELL-C-sigma matrix: one row per lane of a 256-bit SIMD vector */
+#define SELL_CHUNK_SIZE 4
+
+/**
+ * @brief Sparse matrix in SELL-C-sigma format with C = SELL_CHUNK_SIZE
+ * @details Rows are sorted by decreasing length within windows of sigma rows, and grouped in chunks of C rows.
+ *          Each chunk is padded to the length of its longest row, and stored column by column:
+ *          the j-th non-zeros of the C rows of a chunk are adjacent in memory, so a SIMD kernel processes C rows at once.
+ */
+struct sell_matrix {
+	size_t rows;
+	size_t columns;
+	size_t chunks;
+	size_t sigma;
+	/* Non-zeros of chunk c start at chunk_offsets[c] * SELL_CHUNK_SIZE, chunks + 1 elements */
+	size_t* chunk_offsets;
+	/* Original index of the row in position i of the sorted matrix, chunks * SELL_CHUNK_SIZE elements */
+	uint32_t* row_permutation;
+	/* Column indices and values of non-zeros, with padding elements of value 0 */
+	uint32_t* column_indices;
+	double* values;
+};
+
+/**
+ * @brief Builds a CSR matrix from entries in arbitrary order
+ * @details Entries with the same row and column are summed.
+ * @return true on success, false if memory can not be allocated.
+ */
+bool csr_from_coordinates(size_t rows, size_t columns, size_t entries,
+	const uint32_t FPPLUS_ARRAY_POINTER(row_indices, entries),
+	const uint32_t FPPLUS_ARRAY_POINTER(column_indices, entries),
+	const double FPPLUS_ARRAY_POINTER(values, entries),
+	struct csr_matrix FPPLUS_NONNULL_POINTER(matrix));
+
+/**
+ * @brief Loads a real, integer, or pattern matrix in Matrix Market coordinate format
+ * @details General, symmetric, and skew-symmetric matrices are supported; for symmetric matrices both triangles are stored.
+ * @return true on success, false if the file can not be read or parsed (with an error message on stderr).
+ */
+bool csr_load_matrix_market(const char* path, struct csr_matrix FPPLUS_NONNULL_POINTER(matrix));
+
+/**
+ * @brief Releases the arrays of a CSR matrix
+ */
+void csr_release(struct csr_matrix FPPLUS_NONNULL_POINTER(matrix));
+
+/**
+ * @brief Converts a CSR matrix to SELL-C-sigma format
+ * @param sigma - the size of the sorting window, a multiple of SELL_CHUNK_SIZE. sigma = SELL_CHUNK_SIZE keeps the order of rows.
+ * @return true on success, false if memory can not be allocated.
+ */
+bool sell_from_csr(const struct csr_matrix FPPLUS_NONNULL_POINTER(csr), size_t sigma,
+	struct sell_matrix FPPLUS_NONNULL_POINTER(matrix));
+
+/**
+ * @brief Releases the arrays of a SELL-C-sigma matrix
+ */
+void sell_release(struct sell_matrix FPPLUS_NONNULL_POINTER(matrix));
+
+/**
+ * @brief y = A x in double precision, for reference
+ */
+void csr_spmv(const struct csr_matrix FPPLUS_NONNULL_POINTER(matrix), const double *FPPLUS_RESTRICT x, double *FPPLUS_RESTRICT y);
+
+/**
+ * @brief y = A x with double-precision A and x, and products of each row accumulated error-free into a double-double result
+ * @details The accumulation is the compensated dot product algorithm: the result is as accurate
+ *          as if computed in double-double precision and rounded.
+ */
+void csr_spmv_compensated(const struct csr_matrix FPPLUS_NONNULL_POINTER(matrix), const double *FPPLUS_RESTRICT x, doubledouble *FPPLUS_RESTRICT y);
+
+/**
+ * @brief y = A x with SELL-C-sigma matrix, with the same compensated accumulation as csr_spmv_compensated
+ * @details y is in the original order of rows.
+ */
+void sell_spmv_compensated(const struct sell_matrix FPPLUS_NONNULL_POINTER(matrix), const double *FPPLUS_RESTRICT x, doubledouble *FPPLUS_RESTRICT y);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
@@ -1,4 +1,19 @@
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
 
 #include <utils.h>
 
@@ -35,3 +50,279 @@ uint64_t median_uint64(uint64_t array[], size_t length) {
         return array[length / 2];
     }
 }
+
+struct sample_statistics compute_sample_statistics(double samples[], size_t count) {
+    struct sample_statistics statistics = { .count = count };
+    if (count == 0) {
+        return statistics;
+    }
+
+    statistics.median = median_double(samples, count);
+    statistics.min = samples[0];
+    statistics.max = samples[count - 1];
+
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    statistics.mean = sum / ((double) count);
+
+    if (count > 1) {
+        double sum_squares = 0.0;
+        for (size_t i = 0; i < count; i++) {
+            const double deviation = samples[i] - statistics.mean;
+            sum_squares += deviation * deviation;
+        }
+        statistics.stddev = sqrt(sum_squares / ((double) (count - 1)));
+    }
+    return statistics;
+}
+
+static const char* perf_counter_names[perf_counter_count] = {
+    [perf_counter_cycles] = "cycles",
+    [perf_counter_instructions] = "instructions",
+    [perf_counter_fp_scalar] = "fp-scalar",
+    [perf_counter_fp_128] = "fp-128",
+    [perf_counter_fp_256] = "fp-256",
+    [perf_counter_fp_512] = "fp-512",
+    [perf_counter_l1d_misses] = "l1d-misses",
+    [perf_counter_llc_misses] = "llc-misses",
+};
+
+const char* perf_counter_name(enum perf_counter counter) {
+    return perf_counter_names[counter];
+}
+
+bool parse_perf_counters(const char* list, uint32_t counters[restrict static 1]) {
+    uint32_t mask = 0;
+    while (*list != '\0') {
+        const size_t length = strcspn(list, ",");
+        if (length == strlen("all") && strncmp(list, "all", length) == 0) {
+            mask |= (UINT32_C(1) << perf_counter_count) - 1;
+        } else {
+            enum perf_counter counter = 0;
+            while (counter < perf_counter_count &&
+                !(strlen(perf_counter_names[counter]) == length && strncmp(list, perf_counter_names[counter], length) == 0))
+            {
+                counter++;
+            }
+            if (counter == perf_counter_count) {
+                return false;
+            }
+            mask |= UINT32_C(1) << counter;
+        }
+        list += length;
+        if (*list == ',') {
+            list++;
+        }
+    }
+    *counters = mask;
+    return true;
+}
+
+static uint32_t perf_counters_mask = 0;
+#if defined(__linux__)
+static int perf_counters_fd[perf_counter_count];
+/*
+ * All counters are opened as one group, so they are enabled and disabled at once, measure the same window,
+ * and are scheduled (and multiplex-scaled) together. The leader is the first counter which opens successfully.
+ */
+static int perf_counters_group_fd = -1;
+/* Position of the counter value in the group read by perf_counters_stop */
+static size_t perf_counters_group_index[perf_counter_count];
+static size_t perf_counters_group_size = 0;
+
+/*
+ * FP_ARITH_INST_RETIRED (event 0xC7) is only available on Intel big cores starting with Broadwell.
+ * Raw events have model-specific meaning, so they are enabled only for known processor models.
+ */
+static bool has_fp_arith_events(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    /* "GenuineIntel" */
+    if (ebx != 0x756E6547u || edx != 0x49656E69u || ecx != 0x6C65746Eu) {
+        return false;
+    }
+    __get_cpuid(1, &eax, &ebx, &ecx, &edx);
+    const unsigned int family = (eax >> 8) & 0xF;
+    const unsigned int model = ((eax >> 4) & 0xF) | ((eax >> 12) & 0xF0);
+    if (family != 6) {
+        return false;
+    }
+    static const unsigned char models[] = {
+        /* Broadwell */
+        0x3D, 0x47, 0x4F, 0x56,
+        /* Skylake, Kaby Lake, Coffee Lake, Cascade Lake */
+        0x4E, 0x5E, 0x55, 0x8E, 0x9E,
+        /* Cannon Lake, Ice Lake, Tiger Lake */
+        0x66, 0x6A, 0x6C, 0x7D, 0x7E, 0x8C, 0x8D, 0xA7,
+        /* Sapphire Rapids, Emerald Rapids, Granite Rapids */
+        0x8F, 0xCF, 0xAD, 0xAE,
+    };
+    for (size_t i = 0; i < sizeof(models) / sizeof(models[0]); i++) {
+        if (models[i] == model) {
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+static bool get_perf_event_attr(enum perf_counter counter, struct perf_event_attr attr[restrict static 1]) {
+    memset(attr, 0, sizeof(struct perf_event_attr));
+    attr->size = sizeof(struct perf_event_attr);
+    attr->disabled = 1;
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    switch (counter) {
+        case perf_counter_cycles:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_CPU_CYCLES;
+            return true;
+        case perf_counter_instructions:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_INSTRUCTIONS;
+            return true;
+        case perf_counter_fp_scalar:
+        case perf_counter_fp_128:
+        case perf_counter_fp_256:
+        case perf_counter_fp_512:
+        {
+            /* Single- and double-precision umasks for each width: 0x03 (scalar), 0x0C (128-bit), 0x30 (256-bit), 0xC0 (512-bit) */
+            const uint64_t umask = UINT64_C(0x03) << (2 * (counter - perf_counter_fp_scalar));
+            attr->type = PERF_TYPE_RAW;
+            attr->config = UINT64_C(0xC7) | (umask << 8);
+            return has_fp_arith_events();
+        }
+        case perf_counter_l1d_misses:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_L1D |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            return true;
+        case perf_counter_llc_misses:
+            attr->type = PERF_TYPE_HARDWARE;
+            attr->config = PERF_COUNT_HW_CACHE_MISSES;
+            return true;
+        case perf_counter_count:
+            break;
+    }
+    __builtin_unreachable();
+}
+#endif
+
+uint32_t perf_counters_open(uint32_t counters) {
+    perf_counters_mask = 0;
+#if defined(__linux__)
+    perf_counters_group_fd = -1;
+    perf_counters_group_size = 0;
+#endif
+    for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+        if (!(counters & (UINT32_C(1) << counter))) {
+            continue;
+        }
+#if defined(__linux__)
+        struct perf_event_attr attr;
+        if (!get_perf_event_attr(counter, &attr)) {
+            fprintf(stderr, "Warning: counter %s is not supported on this processor\n", perf_counter_names[counter]);
+            continue;
+        }
+        /* Group members follow the state of the leader, so only the leader is created disabled */
+        attr.disabled = perf_counters_group_fd == -1;
+        const int fd = (int) syscall(__NR_perf_event_open, &attr, 0, -1, perf_counters_group_fd, 0);
+        if (fd == -1) {
+            fprintf(stderr, "Warning: counter %s is not available: %s\n", perf_counter_names[counter], strerror(errno));
+            continue;
+        }
+        if (perf_counters_group_fd == -1) {
+            perf_counters_group_fd = fd;
+        }
+        perf_counters_fd[counter] = fd;
+        perf_counters_group_index[counter] = perf_counters_group_size++;
+        perf_counters_mask |= UINT32_C(1) << counter;
+#else
+        fprintf(stderr, "Warning: counter %s is not available: performance counters are only supported on Linux\n",
+            perf_counter_names[counter]);
+#endif
+    }
+    return perf_counters_mask;
+}
+
+uint32_t perf_counters_enabled(void) {
+    return perf_counters_mask;
+}
+
+void perf_counters_start(void) {
+#if defined(__linux__)
+    if (perf_counters_mask != 0) {
+        ioctl(perf_counters_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(perf_counters_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+}
+
+void perf_counters_stop(struct perf_counter_values values[restrict static 1]) {
+    memset(values, 0, sizeof(struct perf_counter_values));
+#if defined(__linux__)
+    if (perf_counters_mask == 0) {
+        return;
+    }
+    ioctl(perf_counters_group_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    /* number of counters, time enabled, time running, and the values in the order the counters joined the group */
+    uint64_t data[3 + perf_counter_count];
+    const ssize_t size = (ssize_t) ((3 + perf_counters_group_size) * sizeof(uint64_t));
+    if (read(perf_counters_group_fd, data, (size_t) size) != size) {
+        return;
+    }
+    if (data[2] == 0) {
+        /* The group never got on the PMU, e.g. because it needs more hardware counters than the processor has */
+        static bool warned = false;
+        if (!warned) {
+            fprintf(stderr, "Warning: performance counters were not scheduled, request fewer counters\n");
+            warned = true;
+        }
+        return;
+    }
+    /* The whole group is multiplexed together, so all counters have the same scaling factor */
+    const double scale = data[2] < data[1] ? (double) data[1] / (double) data[2] : 1.0;
+    for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+        if (perf_counters_mask & (UINT32_C(1) << counter)) {
+            const uint64_t value = data[3 + perf_counters_group_index[counter]];
+            values->values[counter] = scale == 1.0 ? value : (uint64_t) ((double) value * scale);
+        }
+    }
+#endif
+}
+
+void perf_counters_close(void) {
+#if defined(__linux__)
+    for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+        if (perf_counters_mask & (UINT32_C(1) << counter)) {
+            close(perf_counters_fd[counter]);
+        }
+    }
+    perf_counters_group_fd = -1;
+    perf_counters_group_size = 0;
+#endif
+    perf_counters_mask = 0;
+}
+
+void median_perf_counters(size_t iterations, const struct perf_counter_values samples[restrict static iterations],
+    double operations, double medians[restrict static perf_counter_count])
+{
+    uint64_t counter_samples[iterations];
+    for (enum perf_counter counter = 0; counter < perf_counter_count; counter++) {
+        medians[counter] = 0.0;
+        if (perf_counters_mask & (UINT32_C(1) << counter)) {
+            for (size_t iteration = 0; iteration < iterations; iteration++) {
+                counter_samples[iteration] = samples[iteration].values[counter];
+            }
+            medians[counter] = ((double) median_uint64(counter_samples, iterations)) / operations;
+        }
+    }
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <math.h>
 
 #if defined(__APPLE__) && defined(__MACH__)
 #include <mach/mach.h>
@@ -54,5 +57,117 @@ FPPLUS_STATIC_INLINE uint64_t cpu_ticks() {
     return (((uint64_t) counter_hi) << 32) | counter_lo;
 }
 
+/**
+ * @brief Advances the state of a 64-bit linear congruential generator and returns the 53 high bits of the new state
+ * @details Benchmarks generate their inputs with this generator from a fixed seed, so that all runs process the same inputs.
+ */
+FPPLUS_STATIC_INLINE uint64_t random_bits(uint64_t state[restrict static 1]) {
+    *state = *state * UINT64_C(6364136223846793005) + UINT64_C(1442695040888963407);
+    return *state >> 11;
+}
+
+/**
+ * @brief Returns a random double-precision number, uniformly distributed in [-1, 1), and advances the generator state
+ */
+FPPLUS_STATIC_INLINE double random_uniform(uint64_t state[restrict static 1]) {
+    return ldexp((double) random_bits(state), -52) - 1.0;
+}
+
+/**
+ * @brief Summary statistics of per-iteration benchmark measurements
+ */
+struct sample_statistics {
+    size_t count;
+    double min;
+    double max;
+    double mean;
+    double median;
+    double stddev;
+};
+
 double median_double(double array[], size_t length);
 uint64_t median_uint64(uint64_t array[], size_t length);
+
+/**
+ * @brief Computes summary statistics of the samples
+ * @note The samples array is sorted in-place.
+ */
+struct sample_statistics compute_sample_statistics(double samples[], size_t count);
+
+/**
+ * @brief Hardware performance counters supported by the benchmarks
+ */
+enum perf_counter {
+    /** Core clock cycles (unlike cpu_ticks, these are not reference cycles) */
+    perf_counter_cycles = 0,
+    /** Retired instructions */
+    perf_counter_instructions,
+    /** Retired scalar floating-point arithmetic instructions (Intel Broadwell and newer) */
+    perf_counter_fp_scalar,
+    /** Retired 128-bit packed floating-point arithmetic instructions (Intel Broadwell and newer) */
+    perf_counter_fp_128,
+    /** Retired 256-bit packed floating-point arithmetic instructions (Intel Broadwell and newer) */
+    perf_counter_fp_256,
+    /** Retired 512-bit packed floating-point arithmetic instructions (Intel Skylake-SP and newer) */
+    perf_counter_fp_512,
+    /** L1 data cache load misses */
+    perf_counter_l1d_misses,
+    /** Last-level cache misses */
+    perf_counter_llc_misses,
+    perf_counter_count
+};
+
+/**
+ * @brief Values of the performance counters over a measured region
+ */
+struct perf_counter_values {
+    uint64_t values[perf_counter_count];
+};
+
+/**
+ * @brief Returns the name of the counter as used in the --counters option and in reports
+ */
+const char* perf_counter_name(enum perf_counter counter);
+
+/**
+ * @brief Parses a comma-separated list of counter names (or "all") into a bit mask of counters
+ * @return true on success, false if the list contains an unknown counter name
+ */
+bool parse_perf_counters(const char* list, uint32_t counters[restrict static 1]);
+
+/**
+ * @brief Opens the requested performance counters for the calling thread
+ * @details Counters which are not supported by the processor or the operating system (or are not permitted by
+ *          /proc/sys/kernel/perf_event_paranoid) are skipped with a warning on stderr.
+ *          The counters are opened as one group, so they are started, stopped, and scheduled together.
+ * @return Bit mask of the counters which were successfully opened.
+ */
+uint32_t perf_counters_open(uint32_t counters);
+
+/**
+ * @brief Returns the bit mask of the open performance counters
+ */
+uint32_t perf_counters_enabled(void);
+
+/**
+ * @brief Resets and starts the open performance counters
+ * @note Does nothing if no counters are open, and does not affect cpu_ticks measurements when called outside the timed region.
+ */
+void perf_counters_start(void);
+
+/**
+ * @brief Stops the open performance counters and reads their values
+ * @note If the kernel multiplexes the group, all values are scaled by the fraction of time the group was scheduled.
+ */
+void perf_counters_stop(struct perf_counter_values values[restrict static 1]);
+
+/**
+ * @brief Closes the performance counters opened with perf_counters_open
+ */
+void perf_counters_close(void);
+
+/**
+ * @brief Computes medians of the counter values over iterations, divided by the number of operations in an iteration
+ */
+void median_perf_counters(size_t iterations, const struct perf_counter_values samples[restrict static iterations],
+    double operations, double medians[restrict static perf_counter_count]);
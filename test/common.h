@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+
+#include <mpfr.h>
+
+#include <gtest/gtest.h>
+
+#include <fpplus.h>
+
+/* Seed of random number generators: each run of the tests checks different inputs */
+static inline uint_fast32_t random_seed() {
+	return std::chrono::system_clock::now().time_since_epoch().count();
+}
+
+/* Generator of uniformly distributed random double-precision numbers in [min, max) */
+static inline std::function<double()> random_uniform(double min, double max) {
+	return std::bind(std::uniform_real_distribution<double>(min, max), std::mt19937(random_seed()));
+}
+
+/* Generates random normalized double-double number with the high part from rng */
+template<class GeneratorT>
+static inline doubledouble random_dd(GeneratorT& rng) {
+	doubledouble a = { rng(), rng() * DBL_EPSILON };
+	a.hi = efaddord(a.hi, a.lo, &a.lo);
+	return a;
+}
+
+/* Generates array of random normalized double-double numbers */
+template<class GeneratorT>
+static inline std::vector<doubledouble> random_dd_array(GeneratorT& rng, size_t n) {
+	std::vector<doubledouble> array(n);
+	for (doubledouble& element : array) {
+		element = random_dd(rng);
+	}
+	return array;
+}
+
+/* Test fixture with a random engine seeded for each test */
+class RandomTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		engine.seed(random_seed());
+	}
+
+	/* Uniformly distributed random double-precision number in [-1, 1) */
+	double rng() {
+		return std::uniform_real_distribution<double>(-1.0, 1.0)(engine);
+	}
+
+	/* Random normalized double-double number with the high part in [-1, 1) */
+	doubledouble randomDD() {
+		auto uniform = [this] { return rng(); };
+		return random_dd(uniform);
+	}
+
+	std::mt19937 engine;
+};
+
+/* Exact sum of double-precision numbers, double-double numbers, and products of their parts, accumulated with MPFR */
+class ExactSum {
+public:
+	ExactSum() {
+		mpfr_init2(sum, 2048);
+		mpfr_init2(product, 2 * DBL_MANT_DIG);
+		mpfr_set_d(sum, 0.0, MPFR_RNDN);
+	}
+
+	ExactSum(const ExactSum&) = delete;
+
+	ExactSum& operator=(const ExactSum&) = delete;
+
+	~ExactSum() {
+		mpfr_clear(sum);
+		mpfr_clear(product);
+	}
+
+	void reset() {
+		mpfr_set_d(sum, 0.0, MPFR_RNDN);
+	}
+
+	void add(double x) {
+		mpfr_add_d(sum, sum, x, MPFR_RNDN);
+	}
+
+	void add(doubledouble x) {
+		mpfr_add_d(sum, sum, x.hi, MPFR_RNDN);
+		mpfr_add_d(sum, sum, x.lo, MPFR_RNDN);
+	}
+
+	void subtract(doubledouble x) {
+		mpfr_sub_d(sum, sum, x.hi, MPFR_RNDN);
+		mpfr_sub_d(sum, sum, x.lo, MPFR_RNDN);
+	}
+
+	void addProduct(double a, double b) {
+		mpfr_set_d(product, a, MPFR_RNDN);
+		mpfr_mul_d(product, product, b, MPFR_RNDN);
+		mpfr_add(sum, sum, product, MPFR_RNDN);
+	}
+
+	void subtractProduct(double a, double b) {
+		mpfr_set_d(product, a, MPFR_RNDN);
+		mpfr_mul_d(product, product, b, MPFR_RNDN);
+		mpfr_sub(sum, sum, product, MPFR_RNDN);
+	}
+
+	void subtractProduct(doubledouble a, doubledouble b) {
+		subtractProduct(a.hi, b.hi);
+		subtractProduct(a.hi, b.lo);
+		subtractProduct(a.lo, b.hi);
+		subtractProduct(a.lo, b.lo);
+	}
+
+	/* The sum rounded to double precision */
+	double get() const {
+		return mpfr_get_d(sum, MPFR_RNDN);
+	}
+
+private:
+	mpfr_t sum;
+	mpfr_t product;
+};
+
+/*
+ * max |b - A x| / (|||A|||_inf max |x|) for an n x n system, computed exactly with MPFR.
+ * a(i, j) and b(i) return the elements of the matrix and of the right-hand side as double-double numbers.
+ */
+template<class MatrixT, class VectorT>
+static double normwise_residual(size_t n, MatrixT a, VectorT b, const std::vector<doubledouble>& x) {
+	ExactSum residual;
+	double max_residual = 0.0, max_row_norm = 0.0, max_x = 0.0;
+	for (size_t i = 0; i < n; i++) {
+		residual.reset();
+		residual.add(b(i));
+		double row_norm = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			const doubledouble a_ij = a(i, j);
+			residual.subtractProduct(a_ij, x[j]);
+			row_norm += std::fabs(a_ij.hi);
+		}
+		max_residual = std::max(max_residual, std::fabs(residual.get()));
+		max_row_norm = std::max(max_row_norm, row_norm);
+		max_x = std::max(max_x, std::fabs(x[i].hi));
+	}
+	return max_residual / (max_row_norm * max_x);
+}
@@ -0,0 +1,221 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <random>
+#include <functional>
+
+#include <mpfr.h>
+
+#include <gtest/gtest.h>
+
+#include <fpplus.h>
+
+#include "common.h"
+
+static ddcomplex random_ddcomplex(std::function<double()>& rng) {
+	return ddcomplex { random_dd(rng), random_dd(rng) };
+}
+
+/* Reference complex arithmetic with MPFR */
+class MPComplex {
+public:
+	MPComplex() {
+		mpfr_init2(re, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+		mpfr_init2(im, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	}
+
+	explicit MPComplex(ddcomplex z) : MPComplex() {
+		mpfr_set_d(re, z.re.hi, MPFR_RNDN);
+		mpfr_add_d(re, re, z.re.lo, MPFR_RNDN);
+		mpfr_set_d(im, z.im.hi, MPFR_RNDN);
+		mpfr_add_d(im, im, z.im.lo, MPFR_RNDN);
+	}
+
+	MPComplex(const MPComplex&) = delete;
+
+	MPComplex& operator=(const MPComplex&) = delete;
+
+	~MPComplex() {
+		mpfr_clear(re);
+		mpfr_clear(im);
+	}
+
+	/* Relative error of a double-double number x w.r.t. the reference number r */
+	static double relativeError(const mpfr_t r, doubledouble x) {
+		mpfr_t error;
+		mpfr_init2(error, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+		mpfr_sub_d(error, r, x.hi, MPFR_RNDN);
+		mpfr_sub_d(error, error, x.lo, MPFR_RNDN);
+		mpfr_div(error, error, r, MPFR_RNDN);
+		const double result = std::fabs(mpfr_get_d(error, MPFR_RNDN));
+		mpfr_clear(error);
+		return result;
+	}
+
+	/* Maximum of relative errors of the real and imaginary parts of z w.r.t. the magnitude of the reference number */
+	double normwiseError(ddcomplex z) const {
+		mpfr_t error_re, error_im, magnitude;
+		mpfr_init2(error_re, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+		mpfr_init2(error_im, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+		mpfr_init2(magnitude, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+		mpfr_sub_d(error_re, re, z.re.hi, MPFR_RNDN);
+		mpfr_sub_d(error_re, error_re, z.re.lo, MPFR_RNDN);
+		mpfr_sub_d(error_im, im, z.im.hi, MPFR_RNDN);
+		mpfr_sub_d(error_im, error_im, z.im.lo, MPFR_RNDN);
+		mpfr_hypot(magnitude, re, im, MPFR_RNDN);
+		mpfr_div(error_re, error_re, magnitude, MPFR_RNDN);
+		mpfr_div(error_im, error_im, magnitude, MPFR_RNDN);
+		const double result = std::max(std::fabs(mpfr_get_d(error_re, MPFR_RNDN)), std::fabs(mpfr_get_d(error_im, MPFR_RNDN)));
+		mpfr_clear(error_re);
+		mpfr_clear(error_im);
+		mpfr_clear(magnitude);
+		return result;
+	}
+
+	mpfr_t re;
+	mpfr_t im;
+};
+
+TEST(ddcmul, accuracy) {
+	std::function<double()> rng = random_uniform(0.5, 1.0);
+	MPComplex product, temp;
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const ddcomplex a = random_ddcomplex(rng);
+		const ddcomplex b = random_ddcomplex(rng);
+		const MPComplex mp_a(a), mp_b(b);
+
+		mpfr_mul(product.re, mp_a.re, mp_b.re, MPFR_RNDN);
+		mpfr_mul(temp.re, mp_a.im, mp_b.im, MPFR_RNDN);
+		mpfr_sub(product.re, product.re, temp.re, MPFR_RNDN);
+		mpfr_mul(product.im, mp_a.re, mp_b.im, MPFR_RNDN);
+		mpfr_mul(temp.im, mp_a.im, mp_b.re, MPFR_RNDN);
+		mpfr_add(product.im, product.im, temp.im, MPFR_RNDN);
+
+		EXPECT_LE(product.normwiseError(ddcmul(a, b)), std::ldexp(1.0, -100));
+		EXPECT_LE(product.normwiseError(ddcmul3(a, b)), std::ldexp(1.0, -100));
+	}
+}
+
+TEST(ddcdiv, accuracy) {
+	std::function<double()> rng = random_uniform(0.5, 1.0);
+	MPComplex quotient, temp;
+	mpfr_t norm;
+	mpfr_init2(norm, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const ddcomplex a = random_ddcomplex(rng);
+		const ddcomplex b = random_ddcomplex(rng);
+		const MPComplex mp_a(a), mp_b(b);
+
+		mpfr_sqr(norm, mp_b.re, MPFR_RNDN);
+		mpfr_sqr(temp.re, mp_b.im, MPFR_RNDN);
+		mpfr_add(norm, norm, temp.re, MPFR_RNDN);
+		mpfr_mul(quotient.re, mp_a.re, mp_b.re, MPFR_RNDN);
+		mpfr_mul(temp.re, mp_a.im, mp_b.im, MPFR_RNDN);
+		mpfr_add(quotient.re, quotient.re, temp.re, MPFR_RNDN);
+		mpfr_div(quotient.re, quotient.re, norm, MPFR_RNDN);
+		mpfr_mul(quotient.im, mp_a.im, mp_b.re, MPFR_RNDN);
+		mpfr_mul(temp.im, mp_a.re, mp_b.im, MPFR_RNDN);
+		mpfr_sub(quotient.im, quotient.im, temp.im, MPFR_RNDN);
+		mpfr_div(quotient.im, quotient.im, norm, MPFR_RNDN);
+
+		EXPECT_LE(quotient.normwiseError(ddcdiv(a, b)), std::ldexp(1.0, -100));
+	}
+	mpfr_clear(norm);
+}
+
+TEST(ddcabs, accuracy) {
+	std::function<double()> rng = random_uniform(0.5, 1.0);
+	mpfr_t magnitude;
+	mpfr_init2(magnitude, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const ddcomplex a = random_ddcomplex(rng);
+		const MPComplex mp_a(a);
+		mpfr_hypot(magnitude, mp_a.re, mp_a.im, MPFR_RNDN);
+		EXPECT_LE(MPComplex::relativeError(magnitude, ddcabs(a)), std::ldexp(1.0, -100));
+	}
+	mpfr_clear(magnitude);
+}
+
+/* Check that magnitudes of numbers near the ends of the double-precision range do not overflow or underflow */
+TEST(ddcabs, range) {
+	const ddcomplex large = { { 0.75 * DBL_MAX, 0.0 }, { 0.5 * DBL_MAX, 0.0 } };
+	const doubledouble large_magnitude = ddcabs(large);
+	EXPECT_TRUE(std::isfinite(large_magnitude.hi));
+	EXPECT_EQ(std::hypot(0.75, 0.5) * DBL_MAX, large_magnitude.hi);
+
+	const ddcomplex small = { { 3.0 * DBL_MIN, 0.0 }, { 4.0 * DBL_MIN, 0.0 } };
+	EXPECT_EQ(5.0 * DBL_MIN, ddcabs(small).hi);
+
+	const ddcomplex zero = { { 0.0, 0.0 }, { -0.0, 0.0 } };
+	EXPECT_EQ(0.0, ddcabs(zero).hi);
+
+	const ddcomplex infinite = { { 1.0, 0.0 }, { -std::numeric_limits<double>::infinity(), 0.0 } };
+	EXPECT_TRUE(std::isinf(ddcabs(infinite).hi));
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+/* Check that SIMD functions produce bitwise the same results as scalar functions */
+TEST(mm256_pddc, same_as_scalar) {
+	std::function<double()> rng = random_uniform(-1.0, 1.0);
+	for (size_t iteration = 0; iteration < 100; iteration++) {
+		ddcomplex a[4], b[4];
+		for (size_t i = 0; i < 4; i++) {
+			a[i] = random_ddcomplex(rng);
+			b[i] = random_ddcomplex(rng);
+		}
+		/* Scale magnitudes of some numbers, including subnormal and zero parts, to test scaling in absolute value */
+		a[1].re.hi *= 0x1.0p+1000;
+		a[1].re.lo *= 0x1.0p+1000;
+		a[2].im.hi *= 0x1.0p-1070;
+		a[2].im.lo = 0.0;
+		a[2].re = doubledouble { 0.0, 0.0 };
+		a[3] = ddcomplex { { 0.0, 0.0 }, { 0.0, 0.0 } };
+
+		const __m256ddc va = _mm256_loaddeinterleaveu_pddc(a);
+		const __m256ddc vb = _mm256_loaddeinterleaveu_pddc(b);
+		ddcomplex sum[4], product[4], product3[4], quotient[4], magnitude[4];
+		_mm256_interleavestoreu_pddc(sum, _mm256_add_pddc(va, vb));
+		_mm256_interleavestoreu_pddc(product, _mm256_mul_pddc(va, vb));
+		_mm256_interleavestoreu_pddc(product3, _mm256_mul3_pddc(va, vb));
+		_mm256_interleavestoreu_pddc(quotient, _mm256_div_pddc(vb, va));
+		const __m256dd vmagnitude = _mm256_abs_pddc(va);
+		_mm256_interleavestoreu_pddc(magnitude, (__m256ddc) { vmagnitude, _mm256_setzero_pdd() });
+
+		for (size_t i = 0; i < 4; i++) {
+			EXPECT_EQ(ddcadd(a[i], b[i]).re.hi, sum[i].re.hi);
+			EXPECT_EQ(ddcadd(a[i], b[i]).re.lo, sum[i].re.lo);
+			EXPECT_EQ(ddcadd(a[i], b[i]).im.hi, sum[i].im.hi);
+			EXPECT_EQ(ddcadd(a[i], b[i]).im.lo, sum[i].im.lo);
+
+			EXPECT_EQ(ddcmul(a[i], b[i]).re.hi, product[i].re.hi);
+			EXPECT_EQ(ddcmul(a[i], b[i]).re.lo, product[i].re.lo);
+			EXPECT_EQ(ddcmul(a[i], b[i]).im.hi, product[i].im.hi);
+			EXPECT_EQ(ddcmul(a[i], b[i]).im.lo, product[i].im.lo);
+
+			EXPECT_EQ(ddcmul3(a[i], b[i]).re.hi, product3[i].re.hi);
+			EXPECT_EQ(ddcmul3(a[i], b[i]).re.lo, product3[i].re.lo);
+			EXPECT_EQ(ddcmul3(a[i], b[i]).im.hi, product3[i].im.hi);
+			EXPECT_EQ(ddcmul3(a[i], b[i]).im.lo, product3[i].im.lo);
+
+			/* The squared magnitude of the divisor is not scaled: only the unscaled divisor is in range */
+			if (i == 0) {
+				EXPECT_EQ(ddcdiv(b[i], a[i]).re.hi, quotient[i].re.hi) << "i = " << i;
+				EXPECT_EQ(ddcdiv(b[i], a[i]).re.lo, quotient[i].re.lo) << "i = " << i;
+				EXPECT_EQ(ddcdiv(b[i], a[i]).im.hi, quotient[i].im.hi) << "i = " << i;
+				EXPECT_EQ(ddcdiv(b[i], a[i]).im.lo, quotient[i].im.lo) << "i = " << i;
+			}
+
+			EXPECT_EQ(ddcabs(a[i]).hi, magnitude[i].re.hi) << "i = " << i;
+			EXPECT_EQ(ddcabs(a[i]).lo, magnitude[i].re.lo) << "i = " << i;
+		}
+	}
+}
+#endif
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
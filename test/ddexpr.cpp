@@ -0,0 +1,54 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include <fpplus/ddexpr.hpp>
+
+#include "common.h"
+
+using namespace fpplus::ddexpr;
+
+/* Check that fused expressions produce bitwise the same results as scalar functions for all array lengths */
+TEST(ddexpr, axpbz) {
+	std::function<double()> rng = random_uniform(0.0, 1.0);
+	for (size_t n = 0; n < 32; n++) {
+		const std::vector<doubledouble> a = random_dd_array(rng, n), x = random_dd_array(rng, n);
+		const std::vector<doubledouble> b = random_dd_array(rng, n), z = random_dd_array(rng, n);
+		std::vector<doubledouble> y(n);
+		evaluate(n, y.data(), array(a.data()) * array(x.data()) + array(b.data()) * array(z.data()));
+		for (size_t i = 0; i < n; i++) {
+			const doubledouble reference = ddadd(ddmul(a[i], x[i]), ddmul(b[i], z[i]));
+			EXPECT_EQ(reference.hi, y[i].hi) << "n = " << n << " i = " << i;
+			EXPECT_EQ(reference.lo, y[i].lo) << "n = " << n << " i = " << i;
+		}
+	}
+}
+
+/* Check subtraction and constant operands, with the result stored in-place to one of the input arrays */
+TEST(ddexpr, constant_subtract_inplace) {
+	std::function<double()> rng = random_uniform(0.0, 1.0);
+	const doubledouble c = { M_PI, 1.2246467991473532e-16 };
+	for (size_t n = 0; n < 32; n++) {
+		const std::vector<doubledouble> x = random_dd_array(rng, n);
+		std::vector<doubledouble> y = random_dd_array(rng, n);
+		const std::vector<doubledouble> y_original = y;
+		evaluate(n, y.data(), c * array(x.data()) - array(y.data()));
+		for (size_t i = 0; i < n; i++) {
+			const doubledouble minus_y = { -y_original[i].hi, -y_original[i].lo };
+			const doubledouble reference = ddadd(ddmul(c, x[i]), minus_y);
+			EXPECT_EQ(reference.hi, y[i].hi) << "n = " << n << " i = " << i;
+			EXPECT_EQ(reference.lo, y[i].lo) << "n = " << n << " i = " << i;
+		}
+	}
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,213 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+#include <random>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <ddfile/ddfile.h>
+
+#include "common.h"
+
+static doubledouble getElement(const struct ddfile_array& array, size_t i, size_t j) {
+	const size_t index = i * array.row_stride + j;
+	switch (array.layout) {
+		case ddfile_layout_aos:
+			return array.aos[index];
+		case ddfile_layout_soa:
+			return doubledouble { array.hi[index], array.lo[index] };
+		case ddfile_layout_aosoa4:
+			return doubledouble { array.aosoa4[index / 4].hi[index % 4], array.aosoa4[index / 4].lo[index % 4] };
+	}
+	return doubledouble { 0.0, 0.0 };
+}
+
+static void setElement(struct ddfile_array& array, size_t i, size_t j, doubledouble value) {
+	const size_t index = i * array.row_stride + j;
+	switch (array.layout) {
+		case ddfile_layout_aos:
+			array.aos[index] = value;
+			break;
+		case ddfile_layout_soa:
+			array.hi[index] = value.hi;
+			array.lo[index] = value.lo;
+			break;
+		case ddfile_layout_aosoa4:
+			array.aosoa4[index / 4].hi[index % 4] = value.hi;
+			array.aosoa4[index / 4].lo[index % 4] = value.lo;
+			break;
+	}
+}
+
+static const enum ddfile_layout layouts[] = { ddfile_layout_aos, ddfile_layout_soa, ddfile_layout_aosoa4 };
+
+class DDFileTest : public RandomTest {
+protected:
+	void SetUp() override {
+		RandomTest::SetUp();
+		strcpy(path, "/tmp/ddfile-test-XXXXXX");
+		const int fd = mkstemp(path);
+		ASSERT_NE(-1, fd);
+		close(fd);
+	}
+
+	void TearDown() override {
+		unlink(path);
+	}
+
+	void fillRandom(struct ddfile_array& array) {
+		std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+		for (size_t i = 0; i < array.rows; i++) {
+			for (size_t j = 0; j < array.columns; j++) {
+				doubledouble value;
+				value.hi = efaddord(distribution(engine), ldexp(distribution(engine), -53), &value.lo);
+				setElement(array, i, j, value);
+			}
+		}
+	}
+
+	/* Checks dimensions, elements, and zero padding of the loaded array */
+	void expectEqual(const struct ddfile_array& expected, const struct ddfile_array& actual) {
+		ASSERT_EQ(expected.layout, actual.layout);
+		ASSERT_EQ(expected.rows, actual.rows);
+		ASSERT_EQ(expected.columns, actual.columns);
+		ASSERT_EQ(expected.row_stride, actual.row_stride);
+		for (size_t i = 0; i < actual.rows; i++) {
+			for (size_t j = 0; j < actual.row_stride; j++) {
+				const doubledouble expected_element = getElement(expected, i, j);
+				const doubledouble actual_element = getElement(actual, i, j);
+				EXPECT_EQ(expected_element.hi, actual_element.hi) << "row " << i << ", column " << j;
+				EXPECT_EQ(expected_element.lo, actual_element.lo) << "row " << i << ", column " << j;
+			}
+		}
+	}
+
+	void writeBytes(size_t offset, const void* data, size_t size) {
+		FILE* file = fopen(path, "r+b");
+		ASSERT_NE(nullptr, file);
+		fseek(file, (long) offset, SEEK_SET);
+		fwrite(data, size, 1, file);
+		fclose(file);
+	}
+
+	char path[64];
+};
+
+TEST_F(DDFileTest, round_trip) {
+	const size_t sizes[][2] = { {1, 1}, {5, 3}, {17, 9}, {64, 64}, {3, 1000} };
+	for (enum ddfile_layout layout : layouts) {
+		for (auto size : sizes) {
+			struct ddfile_array array;
+			ASSERT_TRUE(ddfile_array_alloc(layout, size[0], size[1], &array));
+			fillRandom(array);
+			ASSERT_TRUE(ddfile_write(path, &array));
+
+			struct ddfile_array loaded;
+			ASSERT_TRUE(ddfile_read(path, &loaded));
+			EXPECT_FALSE(loaded.mapped);
+			expectEqual(array, loaded);
+			ddfile_array_release(&loaded);
+
+			for (bool populate : { false, true }) {
+				ASSERT_TRUE(ddfile_map(path, populate, &loaded));
+				EXPECT_TRUE(loaded.mapped);
+				expectEqual(array, loaded);
+				ddfile_array_release(&loaded);
+			}
+			ddfile_array_release(&array);
+		}
+	}
+}
+
+TEST_F(DDFileTest, alignment) {
+	for (enum ddfile_layout layout : layouts) {
+		struct ddfile_array array;
+		ASSERT_TRUE(ddfile_array_alloc(layout, 7, 13, &array));
+		ASSERT_TRUE(ddfile_write(path, &array));
+		ddfile_array_release(&array);
+
+		struct ddfile_array mapped;
+		ASSERT_TRUE(ddfile_map(path, false, &mapped));
+		EXPECT_EQ(0u, mapped.row_stride % DDFILE_ROW_ALIGNMENT);
+		for (size_t i = 0; i < mapped.rows; i++) {
+			const size_t index = i * mapped.row_stride;
+			switch (layout) {
+				case ddfile_layout_aos:
+					EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mapped.aos + index) % FPPLUS_LAYOUT_ALIGNMENT);
+					break;
+				case ddfile_layout_soa:
+					EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mapped.hi + index) % FPPLUS_LAYOUT_ALIGNMENT);
+					EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mapped.lo + index) % FPPLUS_LAYOUT_ALIGNMENT);
+					break;
+				case ddfile_layout_aosoa4:
+					EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(mapped.aosoa4 + index / 4) % FPPLUS_LAYOUT_ALIGNMENT);
+					break;
+			}
+		}
+		ddfile_array_release(&mapped);
+	}
+}
+
+TEST_F(DDFileTest, private_mapping) {
+	struct ddfile_array array;
+	ASSERT_TRUE(ddfile_array_alloc(ddfile_layout_soa, 4, 4, &array));
+	fillRandom(array);
+	ASSERT_TRUE(ddfile_write(path, &array));
+
+	struct ddfile_array mapped;
+	ASSERT_TRUE(ddfile_map(path, false, &mapped));
+	mapped.hi[0] = 42.0;
+	ddfile_array_release(&mapped);
+
+	ASSERT_TRUE(ddfile_read(path, &mapped));
+	expectEqual(array, mapped);
+	ddfile_array_release(&mapped);
+	ddfile_array_release(&array);
+}
+
+TEST_F(DDFileTest, invalid_header) {
+	struct ddfile_array array;
+	ASSERT_TRUE(ddfile_array_alloc(ddfile_layout_aos, 2, 2, &array));
+	ASSERT_TRUE(ddfile_write(path, &array));
+	ddfile_array_release(&array);
+
+	struct ddfile_array loaded;
+	const char magic[] = "NOTADDFL";
+	writeBytes(offsetof(struct ddfile_header, magic), magic, sizeof(magic) - 1);
+	EXPECT_FALSE(ddfile_read(path, &loaded));
+	EXPECT_FALSE(ddfile_map(path, false, &loaded));
+	writeBytes(offsetof(struct ddfile_header, magic), DDFILE_MAGIC, sizeof(magic) - 1);
+	ASSERT_TRUE(ddfile_read(path, &loaded));
+	ddfile_array_release(&loaded);
+
+	const uint32_t version = DDFILE_VERSION + 1;
+	writeBytes(offsetof(struct ddfile_header, version), &version, sizeof(version));
+	EXPECT_FALSE(ddfile_read(path, &loaded));
+	EXPECT_FALSE(ddfile_map(path, false, &loaded));
+}
+
+TEST_F(DDFileTest, truncated_file) {
+	struct ddfile_array array;
+	ASSERT_TRUE(ddfile_array_alloc(ddfile_layout_soa, 16, 16, &array));
+	ASSERT_TRUE(ddfile_write(path, &array));
+	ddfile_array_release(&array);
+
+	ASSERT_EQ(0, truncate(path, DDFILE_PAGE_SIZE + 100));
+	struct ddfile_array loaded;
+	EXPECT_FALSE(ddfile_read(path, &loaded));
+	EXPECT_FALSE(ddfile_map(path, false, &loaded));
+
+	ASSERT_EQ(0, truncate(path, 10));
+	EXPECT_FALSE(ddfile_read(path, &loaded));
+	EXPECT_FALSE(ddfile_map(path, false, &loaded));
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
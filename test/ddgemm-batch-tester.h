@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include <fpplus.h>
+
+#include <ddgemm-batch/ddgemm-batch.h>
+#include <ddgemm-batch/pack.h>
+
+#include "common.h"
+
+
+static inline size_t ddgemm_batch_packed_size(size_t n, size_t batch) {
+	const size_t groups = (batch + DDGEMM_BATCH_SIMD_WIDTH - 1) / DDGEMM_BATCH_SIMD_WIDTH;
+	return 2 * groups * DDGEMM_BATCH_SIMD_WIDTH * n * n;
+}
+
+template<size_t nT, ddgemm_batch_function FunctionT>
+class DDGEMMBatchTester {
+public:
+	/*
+	 * Batched kernels use the same operations in the same order as a scalar loop,
+	 * so the results must match the scalar reference exactly.
+	 */
+	void test(size_t batch = 2 * DDGEMM_BATCH_SIMD_WIDTH + 1) const {
+		std::function<double()> rng = random_uniform(-1.0, 1.0);
+
+		std::vector<doubledouble> a(batch * nT * nT), b(batch * nT * nT), c(batch * nT * nT), reference(batch * nT * nT);
+		for (std::vector<doubledouble>* matrices : { &a, &b, &c }) {
+			*matrices = random_dd_array(rng, batch * nT * nT);
+		}
+		for (size_t matrix = 0; matrix < batch; matrix++) {
+			const size_t offset = matrix * nT * nT;
+			for (size_t i = 0; i < nT; i++) {
+				for (size_t j = 0; j < nT; j++) {
+					doubledouble sum = { 0.0, 0.0 };
+					for (size_t k = 0; k < nT; k++) {
+						sum = ddadd(sum, ddmul(a[offset + i * nT + k], b[offset + k * nT + j]));
+					}
+					reference[offset + i * nT + j] = ddadd(c[offset + i * nT + j], sum);
+				}
+			}
+		}
+
+		const size_t packed_size = ddgemm_batch_packed_size(nT, batch);
+		double* packed_a = (double*) valloc(packed_size * sizeof(double));
+		double* packed_b = (double*) valloc(packed_size * sizeof(double));
+		double* packed_c = (double*) valloc(packed_size * sizeof(double));
+		ddgemm_batch_pack(nT, DDGEMM_BATCH_SIMD_WIDTH, batch, a.data(), packed_a);
+		ddgemm_batch_pack(nT, DDGEMM_BATCH_SIMD_WIDTH, batch, b.data(), packed_b);
+		ddgemm_batch_pack(nT, DDGEMM_BATCH_SIMD_WIDTH, batch, c.data(), packed_c);
+
+		FunctionT(packed_size / (2 * DDGEMM_BATCH_SIMD_WIDTH * nT * nT), packed_a, packed_b, packed_c);
+
+		ddgemm_batch_unpack(nT, DDGEMM_BATCH_SIMD_WIDTH, batch, packed_c, c.data());
+		for (size_t matrix = 0; matrix < batch; matrix++) {
+			for (size_t element = 0; element < nT * nT; element++) {
+				const size_t index = matrix * nT * nT + element;
+				EXPECT_EQ(reference[index].hi, c[index].hi) <<
+					"C" << matrix << "[" << element / nT << "][" << element % nT << "]";
+				EXPECT_EQ(reference[index].lo, c[index].lo) <<
+					"C" << matrix << "[" << element / nT << "][" << element % nT << "]";
+			}
+		}
+
+		free(packed_a);
+		free(packed_b);
+		free(packed_c);
+	}
+};
+
+
+template<size_t nT>
+class DDGEMMBatchPackTester {
+public:
+	/* Batch sizes below, at, and above multiples of the SIMD width, so the last group is partially or fully used */
+	void test() const {
+		for (size_t batch : { size_t(1), size_t(DDGEMM_BATCH_SIMD_WIDTH - 1), size_t(DDGEMM_BATCH_SIMD_WIDTH),
+			size_t(DDGEMM_BATCH_SIMD_WIDTH + 3), size_t(3 * DDGEMM_BATCH_SIMD_WIDTH + 1) })
+		{
+			SCOPED_TRACE(::testing::Message() << "batch = " << batch);
+			test(batch);
+		}
+	}
+
+	void test(size_t batch) const {
+		std::function<double()> rng = random_uniform(0.0, 1.0);
+
+		const std::vector<doubledouble> matrices = random_dd_array(rng, batch * nT * nT);
+		std::vector<doubledouble> unpacked(batch * nT * nT);
+
+		const size_t packed_size = ddgemm_batch_packed_size(nT, batch);
+		double* packed = (double*) valloc(packed_size * sizeof(double));
+		ddgemm_batch_pack(nT, DDGEMM_BATCH_SIMD_WIDTH, batch, matrices.data(), packed);
+
+		/* Element of matrix b is in lane b % simd_width of group b / simd_width, padding lanes are zeros */
+		const size_t groups = packed_size / (2 * DDGEMM_BATCH_SIMD_WIDTH * nT * nT);
+		for (size_t matrix = 0; matrix < groups * DDGEMM_BATCH_SIMD_WIDTH; matrix++) {
+			const size_t group = matrix / DDGEMM_BATCH_SIMD_WIDTH, lane = matrix % DDGEMM_BATCH_SIMD_WIDTH;
+			for (size_t element = 0; element < nT * nT; element++) {
+				const double* block = packed + 2 * DDGEMM_BATCH_SIMD_WIDTH * (group * nT * nT + element);
+				const doubledouble expected = matrix < batch ? matrices[matrix * nT * nT + element] : doubledouble { 0.0, 0.0 };
+				EXPECT_EQ(expected.hi, block[lane]) << "matrix " << matrix << ", element " << element;
+				EXPECT_EQ(expected.lo, block[DDGEMM_BATCH_SIMD_WIDTH + lane]) << "matrix " << matrix << ", element " << element;
+			}
+		}
+
+		ddgemm_batch_unpack(nT, DDGEMM_BATCH_SIMD_WIDTH, batch, packed, unpacked.data());
+		for (size_t index = 0; index < batch * nT * nT; index++) {
+			EXPECT_EQ(matrices[index].hi, unpacked[index].hi) << "element " << index;
+			EXPECT_EQ(matrices[index].lo, unpacked[index].lo) << "element " << index;
+		}
+
+		free(packed);
+	}
+};
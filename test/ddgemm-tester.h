@@ -19,6 +19,7 @@
 #include <fpplus.h>
 
 #include <ddgemm/ddgemm.h>
+#include <ddgemm/pack.h>
 
 
 template<size_t mrT, size_t nrT, size_t simdWidthT, ddgemm_function FunctionT>
@@ -115,3 +116,43 @@ public:
 private:
 	double errorLimit_;
 };
+
+
+template<size_t mrT, size_t nrT, size_t simdWidthT>
+class DDGEMMPackTester {
+public:
+	void test(size_t kc = 37, size_t lda = mrT + 3, size_t ldb = 41) const {
+		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+		auto rng = std::bind(std::uniform_real_distribution<double>(), std::mt19937(seed));
+
+		std::vector<doubledouble> a(lda * kc), b(ldb * nrT);
+		for (doubledouble& element : a) {
+			element = { rng(), DBL_EPSILON * rng() };
+		}
+		for (doubledouble& element : b) {
+			element = { rng(), DBL_EPSILON * rng() };
+		}
+
+		double* packed_a = (double*) valloc(2 * mrT * kc * sizeof(double));
+		doubledouble* packed_b = (doubledouble*) valloc(nrT * kc * sizeof(doubledouble));
+		ddgemm_pack_a(mrT, simdWidthT, kc, a.data(), lda, packed_a);
+		ddgemm_pack_b(nrT, kc, b.data(), ldb, packed_b);
+
+		/* Packed layout is the same as in DDGEMMTester */
+		for (size_t k = 0; k < kc; k++) {
+			for (size_t m = 0; m < mrT; m++) {
+				EXPECT_EQ(a[k * lda + m].hi, packed_a[2 * k * mrT + (m / simdWidthT) * (2 * simdWidthT) + m % simdWidthT]) <<
+					"A[" << m << "][" << k << "]";
+				EXPECT_EQ(a[k * lda + m].lo, packed_a[2 * k * mrT + (m / simdWidthT) * (2 * simdWidthT) + simdWidthT + m % simdWidthT]) <<
+					"A[" << m << "][" << k << "]";
+			}
+			for (size_t n = 0; n < nrT; n++) {
+				EXPECT_EQ(b[n * ldb + k].hi, packed_b[k * nrT + n].hi) << "B[" << k << "][" << n << "]";
+				EXPECT_EQ(b[n * ldb + k].lo, packed_b[k * nrT + n].lo) << "B[" << k << "][" << n << "]";
+			}
+		}
+
+		free(packed_a);
+		free(packed_b);
+	}
+};
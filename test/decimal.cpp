@@ -0,0 +1,269 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+#include <cmath>
+#include <cfloat>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <mpfr.h>
+
+#include <gtest/gtest.h>
+
+#include <decimal/decimal.h>
+
+#include "common.h"
+
+class DecimalTest : public RandomTest {
+protected:
+	/* Random decimal string with 1 to 60 significant digits, and decimal exponent between -340 and 320 */
+	std::string randomDecimal() {
+		std::uniform_int_distribution<int> digits_distribution(1, 60);
+		std::uniform_int_distribution<int> digit_distribution(0, 9);
+		std::uniform_int_distribution<int> exponent_distribution(-340, 320);
+		std::string decimal = std::bernoulli_distribution(0.5)(engine) ? "-" : "";
+		decimal += static_cast<char>('1' + digit_distribution(engine) % 9);
+		decimal += '.';
+		const int digits = digits_distribution(engine);
+		for (int i = 1; i < digits; i++) {
+			decimal += static_cast<char>('0' + digit_distribution(engine));
+		}
+		decimal += "e" + std::to_string(exponent_distribution(engine));
+		return decimal;
+	}
+
+	/*
+	 * Random normalized double-double number with a gap of 0 to 20 bits between the high and the low parts,
+	 * or in 1 of 8 cases up to 2100 bits, where the low part is subnormal or zero
+	 */
+	doubledouble randomDoubleDouble() {
+		std::uniform_real_distribution<double> mantissa_distribution(1.0, 2.0);
+		std::uniform_int_distribution<int> exponent_distribution(-1000, 1000);
+		std::uniform_int_distribution<int> gap_distribution(0, std::bernoulli_distribution(0.125)(engine) ? 2100 : 20);
+		const double sign = std::bernoulli_distribution(0.5)(engine) ? -1.0 : 1.0;
+		const double hi = sign * std::ldexp(mantissa_distribution(engine), exponent_distribution(engine));
+		const double lo = std::ldexp(mantissa_distribution(engine) - 1.5, std::ilogb(hi) - 53 - gap_distribution(engine));
+		doubledouble x;
+		x.hi = efaddord(hi, lo, &x.lo);
+		return x;
+	}
+
+	/* hi = round(x), lo = round(x - hi) computed with MPFR */
+	static doubledouble referenceParse(const std::string& decimal) {
+		mpfr_t x;
+		mpfr_init2(x, 8192);
+		mpfr_set_str(x, decimal.c_str(), 10, MPFR_RNDN);
+		doubledouble result;
+		result.hi = mpfr_get_d(x, MPFR_RNDN);
+		mpfr_sub_d(x, x, result.hi, MPFR_RNDN);
+		result.lo = mpfr_get_d(x, MPFR_RNDN);
+		mpfr_clear(x);
+		return result;
+	}
+
+	/* The same high part, including the sign of zero, and the same low part, except for the sign of zero and for infinities */
+	static bool identical(doubledouble a, doubledouble b) {
+		return std::memcmp(&a.hi, &b.hi, sizeof(double)) == 0 && (a.lo == b.lo || std::isinf(a.hi));
+	}
+};
+
+TEST_F(DecimalTest, parse_exact) {
+	char* end;
+	doubledouble x = strtodd("1", &end);
+	EXPECT_EQ(1.0, x.hi);
+	EXPECT_EQ(0.0, x.lo);
+	EXPECT_EQ('\0', *end);
+
+	/* The low part of an exact negative number is +0.0 */
+	x = strtodd("-1", &end);
+	EXPECT_EQ(-1.0, x.hi);
+	EXPECT_EQ(0.0, x.lo);
+	EXPECT_FALSE(std::signbit(x.lo));
+
+	x = strtodd("  -0.125e+1xyz", &end);
+	EXPECT_EQ(-1.25, x.hi);
+	EXPECT_EQ(0.0, x.lo);
+	EXPECT_STREQ("xyz", end);
+
+	/* 2**53 + 1 is not a double, and is a tie between 2**53 and 2**53 + 2 */
+	x = strtodd("9007199254740993", &end);
+	EXPECT_EQ(9007199254740992.0, x.hi);
+	EXPECT_EQ(1.0, x.lo);
+
+	/* 2**-1074 + 2**-1075: the low part rounds to the even zero */
+	x = strtodd("7.4109846876186981626485318930233205854758970392148714663837852375101326090531312779794975454245398856969484704316857659638998506553390969459816219401617281718945106978546710679176872575177347315553307795408549809608457500958111373034747658096871009590975442271004757307809711118935784838675653998783503015228055934046593739791790738723868299395818481660169122019456499931289798411362062484498678713572180352209017023903285791732520220528974020802906854021606612375549983402671300035812486479041385743401875520901590172592547146296175134159774938718574737870961645638908718119841271673056017045493004705269590165763776884908267986972573366521765567941072508764337560846003984904972149117463085539556354188641513168478436313080237596295773983001708984375e-324", &end);
+	EXPECT_EQ(std::ldexp(1.0, -1073), x.hi);
+	EXPECT_EQ(0.0, x.lo);
+
+	/* 2**53 + 1 + 10**-1501: digits after the 1400-th only break the tie */
+	const std::string above_tie = "9007199254740993." + std::string(1500, '0') + "1";
+	x = strtodd(above_tie.c_str(), &end);
+	EXPECT_EQ(9007199254740994.0, x.hi);
+	EXPECT_EQ(-1.0, x.lo);
+	EXPECT_EQ('\0', *end);
+}
+
+TEST_F(DecimalTest, parse_special) {
+	char* end;
+	const char* string = "inf";
+	doubledouble x = strtodd(string, &end);
+	EXPECT_TRUE(std::isinf(x.hi) && x.hi > 0.0);
+	EXPECT_EQ(string + 3, end);
+
+	string = "-Infinity";
+	x = strtodd(string, &end);
+	EXPECT_TRUE(std::isinf(x.hi) && x.hi < 0.0);
+	EXPECT_EQ(string + 9, end);
+
+	x = strtodd("NaN", &end);
+	EXPECT_TRUE(std::isnan(x.hi));
+
+	x = strtodd("-0.000", &end);
+	EXPECT_EQ(0.0, x.hi);
+	EXPECT_TRUE(std::signbit(x.hi));
+
+	x = strtodd("1e400", &end);
+	EXPECT_TRUE(std::isinf(x.hi));
+	x = strtodd("1e-400", &end);
+	EXPECT_EQ(0.0, x.hi);
+	EXPECT_EQ(0.0, x.lo);
+
+	/* Not a number: end points to the beginning of the string */
+	string = "  .e5";
+	x = strtodd(string, &end);
+	EXPECT_EQ(string, end);
+
+	/* Exponent without digits is not a part of the number */
+	string = "2e+";
+	x = strtodd(string, &end);
+	EXPECT_EQ(2.0, x.hi);
+	EXPECT_EQ(string + 1, end);
+}
+
+TEST_F(DecimalTest, parse_random) {
+	for (size_t iteration = 0; iteration < 10000; iteration++) {
+		const std::string decimal = randomDecimal();
+		const doubledouble x = strtodd(decimal.c_str(), nullptr);
+		const doubledouble reference = referenceParse(decimal);
+		EXPECT_TRUE(identical(reference, x)) << decimal << ": "
+			<< std::hexfloat << x.hi << " + " << x.lo << " vs " << reference.hi << " + " << reference.lo;
+	}
+}
+
+TEST_F(DecimalTest, print_special) {
+	char buffer[DD_DECIMAL_MAX_LENGTH];
+	EXPECT_EQ(5u, ddtoa(doubledouble { 0.0, 0.0 }, buffer));
+	EXPECT_STREQ("0e+00", buffer);
+	ddtoa(doubledouble { -0.0, 0.0 }, buffer);
+	EXPECT_STREQ("-0e+00", buffer);
+	ddtoa(doubledouble { 1.0, 0.0 }, buffer);
+	EXPECT_STREQ("1e+00", buffer);
+	ddtoa(doubledouble { 0.1, 0.0 }, buffer);
+	/* The low part 0 is exact, so the output is the exact value of the double nearest to 0.1 */
+	EXPECT_STREQ("1.000000000000000055511151231257827021181583404541015625e-01", buffer);
+	ddtoa(doubledouble { -INFINITY, 0.0 }, buffer);
+	EXPECT_STREQ("-inf", buffer);
+	ddtoa(doubledouble { NAN, 0.0 }, buffer);
+	EXPECT_STREQ("nan", buffer);
+
+	/* The exact value of the smallest subnormal number has 751 digits, but low part 0 is not exact */
+	ddtoa(doubledouble { std::ldexp(1.0, -1074), 0.0 }, buffer);
+	EXPECT_STREQ("5e-324", buffer);
+}
+
+TEST_F(DecimalTest, print_longest) {
+	char buffer[DD_DECIMAL_MAX_LENGTH];
+	const doubledouble x = { DBL_MAX, std::ldexp(1.0, -1074) };
+	const size_t length = ddtoa(x, buffer);
+	EXPECT_LT(length, size_t(DD_DECIMAL_MAX_LENGTH));
+	EXPECT_TRUE(identical(x, strtodd(buffer, nullptr))) << buffer;
+}
+
+TEST_F(DecimalTest, round_trip) {
+	char buffer[DD_DECIMAL_MAX_LENGTH];
+	for (size_t iteration = 0; iteration < 10000; iteration++) {
+		const doubledouble x = randomDoubleDouble();
+		const size_t length = ddtoa(x, buffer);
+		ASSERT_EQ(std::strlen(buffer), length);
+		char* end;
+		const doubledouble y = strtodd(buffer, &end);
+		EXPECT_EQ(buffer + length, end);
+		EXPECT_TRUE(identical(x, y)) << buffer;
+	}
+}
+
+TEST_F(DecimalTest, round_trip_double) {
+	char buffer[DD_DECIMAL_MAX_LENGTH];
+	std::uniform_int_distribution<uint64_t> bits_distribution(0, UINT64_C(0x7FEFFFFFFFFFFFFF));
+	for (size_t iteration = 0; iteration < 10000; iteration++) {
+		/* Doubles with any exponent, including subnormals, and zero low part */
+		const uint64_t bits = bits_distribution(engine);
+		doubledouble x = { 0.0, 0.0 };
+		std::memcpy(&x.hi, &bits, sizeof(double));
+		const size_t length = ddtoa(x, buffer);
+		ASSERT_EQ(std::strlen(buffer), length);
+		EXPECT_TRUE(identical(x, strtodd(buffer, nullptr))) << buffer;
+	}
+}
+
+TEST_F(DecimalTest, shortest) {
+	char buffer[DD_DECIMAL_MAX_LENGTH];
+	for (size_t iteration = 0; iteration < 10000; iteration++) {
+		const doubledouble x = randomDoubleDouble();
+		ddtoa(x, buffer);
+		const std::string decimal(buffer);
+		const size_t exponent_position = decimal.find('e');
+		const size_t sign_length = decimal[0] == '-' ? 1 : 0;
+		std::string digits = decimal.substr(sign_length, exponent_position - sign_length);
+		digits.erase(std::remove(digits.begin(), digits.end(), '.'), digits.end());
+		if (digits.size() == 1) {
+			continue;
+		}
+
+		/* Neither of the two nearest decimals with one digit less converts to the same number */
+		const int exponent = std::stoi(decimal.substr(exponent_position + 1));
+		std::string truncated = digits.substr(0, digits.size() - 1);
+		std::string incremented = truncated;
+		int incremented_exponent = exponent;
+		size_t position = incremented.size();
+		while (position != 0 && incremented[position - 1] == '9') {
+			incremented[--position] = '0';
+		}
+		if (position == 0) {
+			incremented.insert(incremented.begin(), '1');
+			incremented_exponent += 1;
+		} else {
+			incremented[position - 1] += 1;
+		}
+		const std::string sign = decimal.substr(0, sign_length);
+		const std::string lower = sign + "0." + truncated + "e" + std::to_string(exponent + 1);
+		const std::string upper = sign + "0." + incremented + "e" + std::to_string(incremented_exponent + 1);
+		EXPECT_FALSE(identical(x, strtodd(lower.c_str(), nullptr))) << decimal << " vs " << lower;
+		EXPECT_FALSE(identical(x, strtodd(upper.c_str(), nullptr))) << decimal << " vs " << upper;
+	}
+}
+
+TEST_F(DecimalTest, arrays) {
+	const size_t n = 100;
+	std::vector<doubledouble> x(n), y(n + 1);
+	for (doubledouble& element : x) {
+		element = randomDoubleDouble();
+	}
+	std::vector<char> buffer(n * DD_DECIMAL_MAX_LENGTH);
+	const size_t length = ddtoa_array(n, x.data(), buffer.data());
+	EXPECT_EQ(std::strlen(buffer.data()), length);
+	char* end;
+	ASSERT_EQ(n, strtodd_array(n + 1, buffer.data(), &end, y.data()));
+	EXPECT_EQ(buffer.data() + length - 1, end);
+	for (size_t i = 0; i < n; i++) {
+		EXPECT_TRUE(identical(x[i], y[i])) << "element " << i;
+	}
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
@@ -25,8 +25,14 @@ class DotTester {
 public:
 	DotTester() :
 		arrayElements_(1027),
+		inputMin_(-1.0),
+		inputMax_(1.0),
+		offsetA_(0),
+		offsetB_(0),
 		a(nullptr),
-		b(nullptr)
+		b(nullptr),
+		aAllocation(nullptr),
+		bAllocation(nullptr)
 	{
 		mpfr_init2(mp_tmp, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
 		mpfr_init2(mp_sum, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
@@ -41,8 +47,8 @@ public:
 	~DotTester() {
 		mpfr_clear(this->mp_tmp);
 		mpfr_clear(this->mp_sum);
-		free(this->a);
-		free(this->b);
+		free(this->aAllocation);
+		free(this->bAllocation);
 	}
 
 	DotTester& arrayElements(size_t arrayElements) {
@@ -55,6 +61,22 @@ public:
 		return this->arrayElements_;
 	}
 
+	/**
+	 * @brief Sets the offsets, in elements, of @b a and @b b arrays from page-aligned addresses.
+	 */
+	DotTester& arrayOffsets(size_t offsetA, size_t offsetB) {
+		this->offsetA_ = offsetA;
+		this->offsetB_ = offsetB;
+		this->resize();
+		return *this;
+	}
+
+	DotTester& inputRange(double inputMin, double inputMax) {
+		this->inputMin_ = inputMin;
+		this->inputMax_ = inputMax;
+		return *this;
+	}
+
 	void testDotProduct(dot_product_function dotProduct, double errorLimit = 5.0 * DBL_EPSILON) {
 		this->regenerateArrays();
 		this->recomputeReference();
@@ -83,15 +105,44 @@ public:
 		ASSERT_LT(relativeError, errorLimit);
 	}
 
+	/* Inputs are rounded to single precision, and the reference is computed from the rounded inputs */
+	void testCompensatedDotProductF32(
+		compensated_dot_product_f32_function compensatedDotProduct,
+		double errorLimit = 10.0 * FLT_EPSILON * FLT_EPSILON)
+	{
+		this->regenerateArrays();
+		float* aFloatAllocation = static_cast<float*>(valloc((this->offsetA_ + arrayElements()) * sizeof(float)));
+		float* bFloatAllocation = static_cast<float*>(valloc((this->offsetB_ + arrayElements()) * sizeof(float)));
+		float* aFloat = aFloatAllocation + this->offsetA_;
+		float* bFloat = bFloatAllocation + this->offsetB_;
+		for (size_t i = 0; i < arrayElements(); i++) {
+			aFloat[i] = this->a[i] = float(this->a[i]);
+			bFloat[i] = this->b[i] = float(this->b[i]);
+		}
+		this->recomputeReference();
+
+		floatfloat sum = compensatedDotProduct(arrayElements(), aFloat, bFloat);
+		mpfr_sub_d(mp_tmp, mp_sum, sum.hi, MPFR_RNDN);
+		mpfr_sub_d(mp_tmp, mp_tmp, sum.lo, MPFR_RNDN);
+		mpfr_div(mp_tmp, mp_tmp, mp_sum, MPFR_RNDN);
+		free(aFloatAllocation);
+		free(bFloatAllocation);
+
+		const double relativeError = fabs(mpfr_get_d(mp_tmp, MPFR_RNDN));
+		ASSERT_LT(relativeError, errorLimit);
+	}
+
 private:
 	/**
-	 * @brief Rellocates @b a and @b b arrays according to arrayElements() value.
+	 * @brief Rellocates @b a and @b b arrays according to arrayElements() value and array offsets.
 	 */
 	void resize() {
-		free(this->a);
-		free(this->b);
-		this->a = static_cast<double*>(valloc(arrayElements() * sizeof(double)));
-		this->b = static_cast<double*>(valloc(arrayElements() * sizeof(double)));
+		free(this->aAllocation);
+		free(this->bAllocation);
+		this->aAllocation = static_cast<double*>(valloc((this->offsetA_ + arrayElements()) * sizeof(double)));
+		this->bAllocation = static_cast<double*>(valloc((this->offsetB_ + arrayElements()) * sizeof(double)));
+		this->a = this->aAllocation + this->offsetA_;
+		this->b = this->bAllocation + this->offsetB_;
 	}
 
 	/**
@@ -99,7 +150,7 @@ private:
 	 */
 	void regenerateArrays() {
 		const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
-		auto rng = std::bind(std::uniform_real_distribution<double>(-1.0, 1.0), std::mt19937(seed));
+		auto rng = std::bind(std::uniform_real_distribution<double>(this->inputMin_, this->inputMax_), std::mt19937(seed));
 		std::generate(this->a, this->a + arrayElements(), rng);
 		std::generate(this->b, this->b + arrayElements(), rng);
 	}
@@ -117,8 +168,14 @@ private:
 	}
 
 	size_t arrayElements_;
+	double inputMin_;
+	double inputMax_;
+	size_t offsetA_;
+	size_t offsetB_;
 	mutable double* a;
 	mutable double* b;
+	mutable double* aAllocation;
+	mutable double* bAllocation;
 	mutable mpfr_t mp_tmp;
 	mutable mpfr_t mp_sum;
 };
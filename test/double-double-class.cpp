@@ -0,0 +1,116 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <random>
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include <fpplus/dd.hpp>
+
+#include "common.h"
+
+/* Construction from double-precision numbers and from the parts can be evaluated at compile time */
+static constexpr fpplus::dd one = 1.0;
+static constexpr fpplus::dd pi = fpplus::dd(M_PI, 1.2246467991473532e-16);
+static_assert(one.hi == 1.0 && one.lo == 0.0, "constexpr construction from double");
+static_assert(pi.hi == M_PI, "constexpr construction from parts");
+static_assert(one < pi && pi > one && one != pi && !(one == pi), "constexpr comparison");
+
+/* Check that operators on fpplus::dd produce bitwise the same results as the functions of C API */
+TEST(dd_class, same_as_c_api) {
+	std::function<double()> rng = random_uniform(0.0, 1.0);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const fpplus::dd a = random_dd(rng);
+		const fpplus::dd b = random_dd(rng);
+
+		const doubledouble sum = ddadd(a, b);
+		EXPECT_EQ(sum.hi, (a + b).hi);
+		EXPECT_EQ(sum.lo, (a + b).lo);
+
+		const doubledouble minus_b = { -b.hi, -b.lo };
+		const doubledouble difference = ddadd(a, minus_b);
+		EXPECT_EQ(difference.hi, (a - b).hi);
+		EXPECT_EQ(difference.lo, (a - b).lo);
+
+		const doubledouble product = ddmul(a, b);
+		EXPECT_EQ(product.hi, (a * b).hi);
+		EXPECT_EQ(product.lo, (a * b).lo);
+
+		const doubledouble quotient = dddiv(a, b);
+		EXPECT_EQ(quotient.hi, (a / b).hi);
+		EXPECT_EQ(quotient.lo, (a / b).lo);
+
+		fpplus::dd accumulator = a;
+		accumulator += b;
+		EXPECT_EQ(sum.hi, accumulator.hi);
+		EXPECT_EQ(sum.lo, accumulator.lo);
+		accumulator = a;
+		accumulator *= b;
+		EXPECT_EQ(product.hi, accumulator.hi);
+		EXPECT_EQ(product.lo, accumulator.lo);
+	}
+}
+
+/* Check that operators with double-precision operands map to the wide functions of C API */
+TEST(dd_class, mixed_operands) {
+	std::function<double()> rng = random_uniform(0.0, 1.0);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const fpplus::dd a = random_dd(rng);
+		const double b = rng();
+
+		const doubledouble sum = ddaddw(a, b);
+		EXPECT_EQ(sum.hi, (a + b).hi);
+		EXPECT_EQ(sum.lo, (a + b).lo);
+		EXPECT_EQ(sum.hi, (b + a).hi);
+		EXPECT_EQ(sum.lo, (b + a).lo);
+
+		const doubledouble difference = ddaddw(a, -b);
+		EXPECT_EQ(difference.hi, (a - b).hi);
+		EXPECT_EQ(difference.lo, (a - b).lo);
+
+		const doubledouble product = ddmulw(a, b);
+		EXPECT_EQ(product.hi, (a * b).hi);
+		EXPECT_EQ(product.lo, (a * b).lo);
+		EXPECT_EQ(product.hi, (b * a).hi);
+		EXPECT_EQ(product.lo, (b * a).lo);
+	}
+}
+
+/* Check that comparisons order numbers by the high parts first, and by the low parts if the high parts are equal */
+TEST(dd_class, comparison) {
+	const fpplus::dd a(1.0, -DBL_EPSILON / 4.0);
+	const fpplus::dd b(1.0, 0.0);
+	const fpplus::dd c(1.0, DBL_EPSILON / 4.0);
+	const fpplus::dd d(1.0 + DBL_EPSILON, -DBL_EPSILON / 4.0);
+	EXPECT_TRUE(a < b && b < c && c < d);
+	EXPECT_TRUE(d > c && c > b && b > a);
+	EXPECT_TRUE(a <= a && a >= a && a == a);
+	EXPECT_TRUE(a != b);
+	EXPECT_TRUE(b == 1.0);
+	EXPECT_TRUE(c > 1.0);
+}
+
+TEST(dd_class, numeric_limits) {
+	typedef std::numeric_limits<fpplus::dd> limits;
+	EXPECT_TRUE(limits::is_specialized);
+	EXPECT_EQ(+limits::digits, 2 * DBL_MANT_DIG - 1);
+	EXPECT_EQ(limits::epsilon().hi, DBL_EPSILON * DBL_EPSILON);
+
+	/* The extreme values are normalized */
+	EXPECT_EQ(limits::max().hi, DBL_MAX);
+	EXPECT_EQ(limits::max().hi + limits::max().lo, limits::max().hi);
+	EXPECT_EQ(limits::lowest().hi, -DBL_MAX);
+	EXPECT_EQ(limits::min().hi, std::ldexp(DBL_MIN, DBL_MANT_DIG));
+
+	EXPECT_TRUE(std::isinf(limits::infinity().hi));
+	EXPECT_TRUE(std::isnan(limits::quiet_NaN().hi));
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
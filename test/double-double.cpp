@@ -400,6 +400,136 @@ TEST(ddmul, accuracy) {
 	mpfr_clear(mp_error_double);
 }
 
+/* Check that the result is at least as accuate as double-precision multiplication */
+TEST(ddmulw, accuracy) {
+	const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+	auto rng = std::bind(std::uniform_real_distribution<double>(), std::mt19937(seed));
+	mpfr_t mp_a, mp_prod_a_b, mp_sum_hi_lo, mp_error_doubledouble, mp_error_double;
+	mpfr_init2(mp_a, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_prod_a_b, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_sum_hi_lo, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_error_doubledouble, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_error_double, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		/* Generate random normalized double-double number */
+		doubledouble a = { rng(), rng() * DBL_EPSILON };
+		a.hi = efaddord(a.hi, a.lo, &a.lo);
+
+		const double b = rng();
+		const doubledouble prod = ddmulw(a, b);
+
+		mpfr_set_d(mp_a, a.hi, MPFR_RNDN);
+		mpfr_add_d(mp_a, mp_a, a.lo, MPFR_RNDN);
+
+		mpfr_mul_d(mp_prod_a_b, mp_a, b, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, prod.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, prod.lo, MPFR_RNDN);
+
+		mpfr_sub(mp_error_doubledouble, mp_prod_a_b, mp_sum_hi_lo, MPFR_RNDN);
+		mpfr_sub_d(mp_error_double, mp_prod_a_b, a.hi * b + a.lo * b, MPFR_RNDN);
+
+		EXPECT_LE(mpfr_cmpabs(mp_error_doubledouble, mp_error_double), 0) <<
+			"a = " << a.hi << " + " << a.lo << " b = " << b;
+	}
+	mpfr_clear(mp_a);
+	mpfr_clear(mp_prod_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+	mpfr_clear(mp_error_doubledouble);
+	mpfr_clear(mp_error_double);
+}
+
+/* Check that the relative error of the quotient is within a few units of double-double precision (2**-100) */
+TEST(dddiv, accuracy) {
+	const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+	auto rng = std::bind(std::uniform_real_distribution<double>(0.5, 1.0), std::mt19937(seed));
+	mpfr_t mp_a, mp_b, mp_quot_a_b, mp_sum_hi_lo, mp_error_doubledouble;
+	mpfr_init2(mp_a, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_b, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_quot_a_b, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_sum_hi_lo, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_error_doubledouble, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		/* Generate random normalized double-double numbers */
+		doubledouble a = { rng(), rng() * DBL_EPSILON };
+		doubledouble b = { rng(), rng() * DBL_EPSILON };
+		a.hi = efaddord(a.hi, a.lo, &a.lo);
+		b.hi = efaddord(b.hi, b.lo, &b.lo);
+
+		const doubledouble quot = dddiv(a, b);
+
+		mpfr_set_d(mp_a, a.hi, MPFR_RNDN);
+		mpfr_add_d(mp_a, mp_a, a.lo, MPFR_RNDN);
+
+		mpfr_set_d(mp_b, b.hi, MPFR_RNDN);
+		mpfr_add_d(mp_b, mp_b, b.lo, MPFR_RNDN);
+
+		mpfr_div(mp_quot_a_b, mp_a, mp_b, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, quot.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, quot.lo, MPFR_RNDN);
+
+		mpfr_sub(mp_error_doubledouble, mp_quot_a_b, mp_sum_hi_lo, MPFR_RNDN);
+		mpfr_div(mp_error_doubledouble, mp_error_doubledouble, mp_quot_a_b, MPFR_RNDN);
+
+		EXPECT_LE(std::fabs(mpfr_get_d(mp_error_doubledouble, MPFR_RNDN)), std::ldexp(1.0, -100)) <<
+			"a = " << a.hi << " + " << a.lo << " b = " << b.hi << " + " << b.lo;
+	}
+	mpfr_clear(mp_a);
+	mpfr_clear(mp_b);
+	mpfr_clear(mp_quot_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+	mpfr_clear(mp_error_doubledouble);
+}
+
+TEST(ddsqrt, accuracy) {
+	const uint_fast32_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+	auto rng = std::bind(std::uniform_real_distribution<double>(0.5, 4.0), std::mt19937(seed));
+	mpfr_t mp_a, mp_sqrt_a, mp_sum_hi_lo, mp_error_doubledouble;
+	mpfr_init2(mp_a, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_sqrt_a, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_sum_hi_lo, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	mpfr_init2(mp_error_doubledouble, DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		/* Generate random normalized double-double number */
+		doubledouble a = { rng(), rng() * DBL_EPSILON };
+		a.hi = efaddord(a.hi, a.lo, &a.lo);
+
+		const doubledouble root = ddsqrt(a);
+
+		mpfr_set_d(mp_a, a.hi, MPFR_RNDN);
+		mpfr_add_d(mp_a, mp_a, a.lo, MPFR_RNDN);
+		mpfr_sqrt(mp_sqrt_a, mp_a, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, root.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, root.lo, MPFR_RNDN);
+
+		mpfr_sub(mp_error_doubledouble, mp_sqrt_a, mp_sum_hi_lo, MPFR_RNDN);
+		mpfr_div(mp_error_doubledouble, mp_error_doubledouble, mp_sqrt_a, MPFR_RNDN);
+
+		EXPECT_LE(std::fabs(mpfr_get_d(mp_error_doubledouble, MPFR_RNDN)), std::ldexp(1.0, -100)) <<
+			"a = " << a.hi << " + " << a.lo;
+	}
+	mpfr_clear(mp_a);
+	mpfr_clear(mp_sqrt_a);
+	mpfr_clear(mp_sum_hi_lo);
+	mpfr_clear(mp_error_doubledouble);
+}
+
+/* Check that zero and special inputs produce double-precision square root of the high part */
+TEST(ddsqrt, special_values) {
+	const doubledouble zero = { 0.0, 0.0 };
+	EXPECT_EQ(0.0, ddsqrt(zero).hi);
+	EXPECT_EQ(0.0, ddsqrt(zero).lo);
+
+	const doubledouble infinity = { std::numeric_limits<double>::infinity(), 0.0 };
+	EXPECT_TRUE(std::isinf(ddsqrt(infinity).hi));
+	EXPECT_EQ(0.0, ddsqrt(infinity).lo);
+
+	const doubledouble negative = { -1.0, 0.0 };
+	EXPECT_TRUE(std::isnan(ddsqrt(negative).hi));
+}
+
 int main(int ac, char* av[]) {
 	testing::InitGoogleTest(&ac, av);
 	return RUN_ALL_TESTS();
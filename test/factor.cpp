@@ -0,0 +1,344 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <factor/factor.h>
+
+#include "common.h"
+
+class FactorTest : public RandomTest {
+protected:
+	/* Random column-major matrix with lda = n + 3 */
+	std::vector<doubledouble> randomMatrix(size_t n) {
+		std::vector<doubledouble> a((n + 3) * n);
+		for (doubledouble& element : a) {
+			element = randomDD();
+		}
+		return a;
+	}
+
+	/* Random symmetric diagonally dominant matrix with lda = n + 3 */
+	std::vector<doubledouble> randomSPDMatrix(size_t n) {
+		const size_t lda = n + 3;
+		std::vector<doubledouble> a = randomMatrix(n);
+		for (size_t j = 0; j < n; j++) {
+			for (size_t i = 0; i < j; i++) {
+				a[i + j * lda] = a[j + i * lda];
+			}
+			a[j + j * lda] = ddaddw(a[j + j * lda], (double) n);
+		}
+		return a;
+	}
+
+	std::vector<doubledouble> randomVector(size_t n) {
+		std::vector<doubledouble> b(n);
+		for (doubledouble& element : b) {
+			element = randomDD();
+		}
+		return b;
+	}
+
+	/* max |b - A x| / (|||A|||_inf max |x|), computed exactly with MPFR */
+	static double normwiseResidual(size_t n, const std::vector<doubledouble>& a, size_t lda,
+		const std::vector<doubledouble>& b, const std::vector<doubledouble>& x)
+	{
+		return normwise_residual(n,
+			[&](size_t i, size_t j) { return a[i + j * lda]; },
+			[&](size_t i) { return b[i]; },
+			x);
+	}
+
+	/*
+	 * Random diagonally dominant triangular matrix with lda = n + 3, and its dense copy with zeros in the other triangle.
+	 * The triangle which must not be referenced (and the diagonal of a unit triangular matrix) is filled with NaNs.
+	 */
+	std::vector<doubledouble> randomTriangularMatrix(size_t n, enum ddtriangular_uplo uplo, bool unit_diagonal,
+		std::vector<doubledouble>& dense)
+	{
+		const size_t lda = n + 3;
+		std::vector<doubledouble> a = randomMatrix(n);
+		dense = a;
+		const doubledouble nan = { NAN, NAN };
+		for (size_t j = 0; j < n; j++) {
+			for (size_t i = 0; i < n; i++) {
+				if (i == j) {
+					if (unit_diagonal) {
+						a[i + j * lda] = nan;
+						dense[i + j * lda] = doubledouble { 1.0, 0.0 };
+					} else {
+						a[i + j * lda] = dense[i + j * lda] = ddaddw(a[i + j * lda], std::copysign((double) n, a[i + j * lda].hi));
+					}
+				} else if ((uplo == ddtriangular_lower) == (i < j)) {
+					a[i + j * lda] = nan;
+					dense[i + j * lda] = doubledouble { 0.0, 0.0 };
+				}
+			}
+		}
+		return a;
+	}
+
+	/* max |B - A X| / (|||A|||_inf max |X|) for the left side, and max |B - X A| / (|||A|||_1 max |X|) for the right side */
+	static double triangularResidual(enum ddtriangular_side side, size_t m, size_t n,
+		const std::vector<doubledouble>& dense, size_t lda,
+		const std::vector<doubledouble>& b, const std::vector<doubledouble>& x, size_t ldb)
+	{
+		/* A' x_i = b_i for each row i of X A = B */
+		const size_t size = side == ddtriangular_left ? m : n;
+		std::vector<doubledouble> a(size * size);
+		for (size_t j = 0; j < size; j++) {
+			for (size_t i = 0; i < size; i++) {
+				a[i + j * size] = side == ddtriangular_left ? dense[i + j * lda] : dense[j + i * lda];
+			}
+		}
+		double max_residual = 0.0;
+		const size_t rhs_count = side == ddtriangular_left ? n : m;
+		for (size_t r = 0; r < rhs_count; r++) {
+			std::vector<doubledouble> b_r(size), x_r(size);
+			for (size_t i = 0; i < size; i++) {
+				const size_t index = side == ddtriangular_left ? i + r * ldb : r + i * ldb;
+				b_r[i] = b[index];
+				x_r[i] = x[index];
+			}
+			max_residual = std::max(max_residual, normwiseResidual(size, a, size, b_r, x_r));
+		}
+		return max_residual;
+	}
+
+	/*
+	 * max |C - C0 - op(A) op(B)| / (|C0| + |op(A)| |op(B)|) over the elements of C for which isComputed(i, j) is true,
+	 * computed exactly with MPFR. op(A) is m x k and op(B) is k x n.
+	 */
+	static double productError(bool transpose_a, bool transpose_b, size_t m, size_t n, size_t k,
+		const std::vector<doubledouble>& a, size_t lda, const std::vector<doubledouble>& b, size_t ldb,
+		const std::vector<doubledouble>& c0, const std::vector<doubledouble>& c, size_t ldc,
+		std::function<bool(size_t, size_t)> isComputed)
+	{
+		ExactSum error;
+		double max_error = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			for (size_t i = 0; i < m; i++) {
+				if (!isComputed(i, j)) {
+					continue;
+				}
+				const doubledouble c_ij = c[i + j * ldc], c0_ij = c0[i + j * ldc];
+				error.reset();
+				error.add(c_ij);
+				error.subtract(c0_ij);
+				double magnitude = std::fabs(c0_ij.hi);
+				for (size_t p = 0; p < k; p++) {
+					const doubledouble a_ip = transpose_a ? a[p + i * lda] : a[i + p * lda];
+					const doubledouble b_pj = transpose_b ? b[j + p * ldb] : b[p + j * ldb];
+					error.subtractProduct(a_ip, b_pj);
+					magnitude += std::fabs(a_ip.hi * b_pj.hi);
+				}
+				if (magnitude != 0.0) {
+					max_error = std::max(max_error, std::fabs(error.get()) / magnitude);
+				}
+			}
+		}
+		return max_error;
+	}
+};
+
+TEST_F(FactorTest, lu) {
+	for (size_t block_size : { 1, 5, 16, 64 }) {
+		for (size_t n = 1; n <= 70; n += 3) {
+			const size_t lda = n + 3;
+			const std::vector<doubledouble> a = randomMatrix(n);
+			const std::vector<doubledouble> b = randomVector(n);
+			std::vector<doubledouble> lu = a, x = b;
+			std::vector<size_t> pivots(n);
+			void* workspace = valloc(ddfactor_workspace_size(n, block_size));
+			ASSERT_TRUE(ddlu_factor(n, lu.data(), lda, pivots.data(), block_size, workspace));
+			free(workspace);
+			ddlu_solve(n, lu.data(), lda, pivots.data(), x.data());
+			EXPECT_LE(normwiseResidual(n, a, lda, b, x), n * std::ldexp(1.0, -100)) <<
+				"n = " << n << ", block size = " << block_size;
+		}
+	}
+}
+
+TEST_F(FactorTest, cholesky) {
+	for (size_t block_size : { 1, 5, 16, 64 }) {
+		for (size_t n = 1; n <= 70; n += 3) {
+			const size_t lda = n + 3;
+			const std::vector<doubledouble> a = randomSPDMatrix(n);
+			const std::vector<doubledouble> b = randomVector(n);
+			std::vector<doubledouble> l = a, x = b;
+			void* workspace = valloc(ddfactor_workspace_size(n, block_size));
+			ASSERT_TRUE(ddcholesky_factor(n, l.data(), lda, block_size, workspace));
+			free(workspace);
+			/* The strictly upper triangle is not referenced */
+			for (size_t j = 0; j < n; j++) {
+				for (size_t i = 0; i < j; i++) {
+					EXPECT_EQ(a[i + j * lda].hi, l[i + j * lda].hi);
+					EXPECT_EQ(a[i + j * lda].lo, l[i + j * lda].lo);
+				}
+			}
+			ddcholesky_solve(n, l.data(), lda, x.data());
+			EXPECT_LE(normwiseResidual(n, a, lda, b, x), n * std::ldexp(1.0, -100)) <<
+				"n = " << n << ", block size = " << block_size;
+		}
+	}
+}
+
+TEST_F(FactorTest, singular) {
+	const size_t n = 40, lda = n + 3, block_size = 16;
+	std::vector<doubledouble> a = randomMatrix(n);
+	/* Column 30 is zero, and stays zero after the updates, so the second panel has no pivot for it */
+	for (size_t i = 0; i < n; i++) {
+		a[i + 30 * lda] = doubledouble { 0.0, 0.0 };
+	}
+	std::vector<size_t> pivots(n);
+	void* workspace = valloc(ddfactor_workspace_size(n, block_size));
+	EXPECT_FALSE(ddlu_factor(n, a.data(), lda, pivots.data(), block_size, workspace));
+	free(workspace);
+}
+
+TEST_F(FactorTest, not_positive_definite) {
+	const size_t n = 40, lda = n + 3, block_size = 16;
+	std::vector<doubledouble> a = randomSPDMatrix(n);
+	a[35 + 35 * lda] = doubledouble { -1.0, 0.0 };
+	void* workspace = valloc(ddfactor_workspace_size(n, block_size));
+	EXPECT_FALSE(ddcholesky_factor(n, a.data(), lda, block_size, workspace));
+	free(workspace);
+}
+
+TEST_F(FactorTest, trsv) {
+	for (enum ddtriangular_side side : { ddtriangular_left, ddtriangular_right }) {
+		for (enum ddtriangular_uplo uplo : { ddtriangular_lower, ddtriangular_upper }) {
+			for (bool unit_diagonal : { false, true }) {
+				for (size_t n = 1; n <= 70; n += 3) {
+					std::vector<doubledouble> dense;
+					const std::vector<doubledouble> a = randomTriangularMatrix(n, uplo, unit_diagonal, dense);
+					const std::vector<doubledouble> b = randomVector(n);
+					std::vector<doubledouble> x = b;
+					ddtrsv(side, uplo, unit_diagonal, n, a.data(), n + 3, x.data());
+					/* x is a column of n x 1 matrix for the left side, and a row of 1 x n matrix for the right side */
+					const double residual = side == ddtriangular_left ?
+						triangularResidual(side, n, 1, dense, n + 3, b, x, n) :
+						triangularResidual(side, 1, n, dense, n + 3, b, x, 1);
+					EXPECT_LE(residual, n * std::ldexp(1.0, -100)) <<
+						"n = " << n << ", side = " << side << ", uplo = " << uplo << ", unit diagonal = " << unit_diagonal;
+				}
+			}
+		}
+	}
+}
+
+TEST_F(FactorTest, trsm) {
+	const size_t sizes[][2] = { {1, 1}, {7, 3}, {20, 33}, {45, 9}, {64, 64}, {70, 17} };
+	for (enum ddtriangular_side side : { ddtriangular_left, ddtriangular_right }) {
+		for (enum ddtriangular_uplo uplo : { ddtriangular_lower, ddtriangular_upper }) {
+			for (bool unit_diagonal : { false, true }) {
+				for (size_t block_size : { 1, 5, 16, 64 }) {
+					for (auto size : sizes) {
+						const size_t m = size[0], n = size[1], ldb = m + 5;
+						const size_t a_size = side == ddtriangular_left ? m : n;
+						std::vector<doubledouble> dense;
+						const std::vector<doubledouble> a = randomTriangularMatrix(a_size, uplo, unit_diagonal, dense);
+						const std::vector<doubledouble> b = randomVector(ldb * n);
+						std::vector<doubledouble> x = b;
+						void* workspace = valloc(ddtrsm_workspace_size(m, n, block_size));
+						ddtrsm(side, uplo, unit_diagonal, m, n, a.data(), a_size + 3, x.data(), ldb, block_size, workspace);
+						free(workspace);
+						EXPECT_LE(triangularResidual(side, m, n, dense, a_size + 3, b, x, ldb), a_size * std::ldexp(1.0, -100)) <<
+							"m = " << m << ", n = " << n << ", side = " << side << ", uplo = " << uplo <<
+							", unit diagonal = " << unit_diagonal << ", block size = " << block_size;
+						/* Padding rows of B are not modified */
+						for (size_t j = 0; j < n; j++) {
+							for (size_t i = m; i < ldb; i++) {
+								EXPECT_EQ(b[i + j * ldb].hi, x[i + j * ldb].hi);
+								EXPECT_EQ(b[i + j * ldb].lo, x[i + j * ldb].lo);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST_F(FactorTest, gemm_blocked) {
+	const size_t sizes[][3] = { {1, 1, 1}, {7, 3, 20}, {20, 33, 5}, {45, 9, 70}, {70, 17, 33} };
+	for (bool transpose_a : { false, true }) {
+		for (bool transpose_b : { false, true }) {
+			for (size_t block_size : { 1, 5, 16, 64 }) {
+				for (auto size : sizes) {
+					const size_t m = size[0], n = size[1], k = size[2];
+					const size_t lda = (transpose_a ? k : m) + 3, ldb = (transpose_b ? n : k) + 2, ldc = m + 5;
+					const std::vector<doubledouble> a = randomVector(lda * (transpose_a ? m : k));
+					const std::vector<doubledouble> b = randomVector(ldb * (transpose_b ? k : n));
+					const std::vector<doubledouble> c0 = randomVector(ldc * n);
+					std::vector<doubledouble> c = c0;
+					void* workspace = valloc(ddgemm_blocked_workspace_size(m, n, k, block_size));
+					ddgemm_blocked(transpose_a, transpose_b, m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc, block_size, workspace);
+					free(workspace);
+					EXPECT_LE(productError(transpose_a, transpose_b, m, n, k, a, lda, b, ldb, c0, c, ldc,
+							[](size_t, size_t) { return true; }), k * std::ldexp(1.0, -100)) <<
+						"m = " << m << ", n = " << n << ", k = " << k << ", transpose A = " << transpose_a <<
+						", transpose B = " << transpose_b << ", block size = " << block_size;
+				}
+			}
+		}
+	}
+}
+
+TEST_F(FactorTest, syrk) {
+	const size_t sizes[][2] = { {1, 1}, {7, 3}, {20, 33}, {45, 9}, {70, 17}, {9, 150} };
+	for (enum ddtriangular_uplo uplo : { ddtriangular_lower, ddtriangular_upper }) {
+		for (bool transpose : { false, true }) {
+			for (bool mixed : { false, true }) {
+				for (size_t block_size : { 1, 5, 16, 64 }) {
+					for (auto size : sizes) {
+						const size_t n = size[0], k = size[1], ldc = n + 5;
+						const size_t lda = (transpose ? k : n) + 3;
+						std::vector<doubledouble> a = randomVector(lda * (transpose ? n : k));
+						std::vector<double> a_double(a.size());
+						for (size_t i = 0; i < a.size(); i++) {
+							a_double[i] = a[i].hi;
+							if (mixed) {
+								a[i].lo = 0.0;
+							}
+						}
+						const std::vector<doubledouble> c0 = randomVector(ldc * n);
+						std::vector<doubledouble> c = c0;
+						void* workspace = valloc(ddsyrk_workspace_size(n, k, block_size));
+						if (mixed) {
+							ddsyrk_mixed(uplo, transpose, n, k, a_double.data(), lda, c.data(), ldc, block_size, workspace);
+						} else {
+							ddsyrk(uplo, transpose, n, k, a.data(), lda, c.data(), ldc, block_size, workspace);
+						}
+						free(workspace);
+						auto inTriangle = [uplo](size_t i, size_t j) { return uplo == ddtriangular_lower ? i >= j : i <= j; };
+						EXPECT_LE(productError(transpose, !transpose, n, n, k, a, lda, a, lda, c0, c, ldc, inTriangle),
+								k * std::ldexp(1.0, -100)) <<
+							"n = " << n << ", k = " << k << ", uplo = " << uplo << ", transpose = " << transpose <<
+							", mixed = " << mixed << ", block size = " << block_size;
+						/* The other triangle and the padding rows of C are not modified */
+						for (size_t j = 0; j < n; j++) {
+							for (size_t i = 0; i < ldc; i++) {
+								if (i >= n || !inTriangle(i, j)) {
+									EXPECT_EQ(c0[i + j * ldc].hi, c[i + j * ldc].hi);
+									EXPECT_EQ(c0[i + j * ldc].lo, c[i + j * ldc].lo);
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
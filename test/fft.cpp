@@ -0,0 +1,227 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <functional>
+#include <algorithm>
+
+#include <mpfr.h>
+
+#include <gtest/gtest.h>
+
+#include <fft/fft.h>
+
+#include "common.h"
+
+static std::vector<ddcomplex> random_input(size_t n) {
+	std::function<double()> rng = random_uniform(-1.0, 1.0);
+	std::vector<ddcomplex> x(n);
+	for (ddcomplex& element : x) {
+		element = ddcomplex { random_dd(rng), random_dd(rng) };
+	}
+	return x;
+}
+
+/* max |x - y| / max |y| over real and imaginary parts */
+static double relative_error(const std::vector<ddcomplex>& x, const std::vector<ddcomplex>& y) {
+	double max_error = 0.0, max_abs = 0.0;
+	for (size_t j = 0; j < x.size(); j++) {
+		const ddcomplex difference = ddcsub(x[j], y[j]);
+		max_error = std::max(max_error, std::max(std::fabs(difference.re.hi), std::fabs(difference.im.hi)));
+		max_abs = std::max(max_abs, std::max(std::fabs(y[j].re.hi), std::fabs(y[j].im.hi)));
+	}
+	return max_error / max_abs;
+}
+
+/* Forward DFT by definition, with 256-bit MPFR arithmetic, rounded to double-double */
+static std::vector<ddcomplex> reference_dft(const std::vector<ddcomplex>& x) {
+	const size_t n = x.size();
+	const mpfr_prec_t precision = 256;
+	mpfr_t* cos_table = new mpfr_t[n];
+	mpfr_t* sin_table = new mpfr_t[n];
+	mpfr_t* x_re = new mpfr_t[n];
+	mpfr_t* x_im = new mpfr_t[n];
+	mpfr_t angle, sum_re, sum_im, temp;
+	mpfr_init2(angle, precision);
+	mpfr_init2(sum_re, precision);
+	mpfr_init2(sum_im, precision);
+	mpfr_init2(temp, precision);
+	for (size_t j = 0; j < n; j++) {
+		mpfr_init2(cos_table[j], precision);
+		mpfr_init2(sin_table[j], precision);
+		mpfr_init2(x_re[j], precision);
+		mpfr_init2(x_im[j], precision);
+		/* 2 j / n is exact, because n is a power of 2 */
+		mpfr_const_pi(angle, MPFR_RNDN);
+		mpfr_mul_d(angle, angle, 2.0 * (double) j / (double) n, MPFR_RNDN);
+		mpfr_sin_cos(sin_table[j], cos_table[j], angle, MPFR_RNDN);
+		mpfr_set_d(x_re[j], x[j].re.hi, MPFR_RNDN);
+		mpfr_add_d(x_re[j], x_re[j], x[j].re.lo, MPFR_RNDN);
+		mpfr_set_d(x_im[j], x[j].im.hi, MPFR_RNDN);
+		mpfr_add_d(x_im[j], x_im[j], x[j].im.lo, MPFR_RNDN);
+	}
+	std::vector<ddcomplex> y(n);
+	for (size_t k = 0; k < n; k++) {
+		mpfr_set_zero(sum_re, 0);
+		mpfr_set_zero(sum_im, 0);
+		for (size_t j = 0; j < n; j++) {
+			/* x[j] * exp(-2 pi i j k / n) = x[j] * (cos - i sin) */
+			const size_t index = j * k % n;
+			mpfr_mul(temp, x_re[j], cos_table[index], MPFR_RNDN);
+			mpfr_add(sum_re, sum_re, temp, MPFR_RNDN);
+			mpfr_mul(temp, x_im[j], sin_table[index], MPFR_RNDN);
+			mpfr_add(sum_re, sum_re, temp, MPFR_RNDN);
+			mpfr_mul(temp, x_im[j], cos_table[index], MPFR_RNDN);
+			mpfr_add(sum_im, sum_im, temp, MPFR_RNDN);
+			mpfr_mul(temp, x_re[j], sin_table[index], MPFR_RNDN);
+			mpfr_sub(sum_im, sum_im, temp, MPFR_RNDN);
+		}
+		y[k].re.hi = mpfr_get_d(sum_re, MPFR_RNDN);
+		mpfr_sub_d(sum_re, sum_re, y[k].re.hi, MPFR_RNDN);
+		y[k].re.lo = mpfr_get_d(sum_re, MPFR_RNDN);
+		y[k].im.hi = mpfr_get_d(sum_im, MPFR_RNDN);
+		mpfr_sub_d(sum_im, sum_im, y[k].im.hi, MPFR_RNDN);
+		y[k].im.lo = mpfr_get_d(sum_im, MPFR_RNDN);
+	}
+	for (size_t j = 0; j < n; j++) {
+		mpfr_clear(cos_table[j]);
+		mpfr_clear(sin_table[j]);
+		mpfr_clear(x_re[j]);
+		mpfr_clear(x_im[j]);
+	}
+	mpfr_clear(angle);
+	mpfr_clear(sum_re);
+	mpfr_clear(sum_im);
+	mpfr_clear(temp);
+	delete[] cos_table;
+	delete[] sin_table;
+	delete[] x_re;
+	delete[] x_im;
+	return y;
+}
+
+TEST(fft_plan, invalid_size) {
+	struct fft_plan plan;
+	EXPECT_FALSE(fft_plan_init(&plan, 0));
+	EXPECT_FALSE(fft_plan_init(&plan, 12));
+	EXPECT_FALSE(fft_plan_init(&plan, 1000));
+}
+
+TEST(fft_plan, invalid_rows) {
+	struct fft_plan plan;
+	EXPECT_FALSE(fft_plan_init_blocked(&plan, 1024, FFT_BLOCK / 2));
+	EXPECT_FALSE(fft_plan_init_blocked(&plan, 1024, 1024 / (FFT_BLOCK / 2)));
+	EXPECT_FALSE(fft_plan_init_blocked(&plan, 1024, 3 * FFT_BLOCK));
+	ASSERT_TRUE(fft_plan_init_blocked(&plan, 1024, 2 * FFT_BLOCK));
+	fft_plan_release(&plan);
+}
+
+TEST(ddfft, accuracy) {
+	for (size_t n = 1; n <= 512; n *= 2) {
+		struct fft_plan plan;
+		ASSERT_TRUE(fft_plan_init(&plan, n));
+		const std::vector<ddcomplex> x = random_input(n);
+		const std::vector<ddcomplex> reference = reference_dft(x);
+		std::vector<ddcomplex> y = x;
+		ddfft_forward(&plan, y.data());
+		EXPECT_LE(relative_error(y, reference), std::ldexp(1.0, -98)) << "n = " << n;
+		fft_plan_release(&plan);
+	}
+}
+
+/* The four-step algorithm with more columns than rows, as square as possible, and with more rows than columns */
+TEST(ddfft, blocked_accuracy) {
+	const size_t n = 4 * FFT_BLOCK * FFT_BLOCK;
+	for (size_t rows = FFT_BLOCK; rows <= n / FFT_BLOCK; rows *= 2) {
+		struct fft_plan plan;
+		ASSERT_TRUE(fft_plan_init_blocked(&plan, n, rows));
+		const std::vector<ddcomplex> x = random_input(n);
+		const std::vector<ddcomplex> reference = reference_dft(x);
+		std::vector<ddcomplex> y = x;
+		ddfft_forward(&plan, y.data());
+		EXPECT_LE(relative_error(y, reference), std::ldexp(1.0, -98)) << "rows = " << rows;
+		fft_plan_release(&plan);
+	}
+}
+
+/* Large transforms with the four-step algorithm must match the unblocked algorithm to double-double precision */
+TEST(ddfft, blocked_large) {
+	for (size_t n = 16384; n <= 131072; n *= 2) {
+		struct fft_plan plan, blocked_plan;
+		ASSERT_TRUE(fft_plan_init_blocked(&plan, n, 0));
+		ASSERT_TRUE(fft_plan_init_blocked(&blocked_plan, n, n / 128));
+		const std::vector<ddcomplex> x = random_input(n);
+		std::vector<ddcomplex> y = x, blocked_y = x;
+		ddfft_forward(&plan, y.data());
+		ddfft_forward(&blocked_plan, blocked_y.data());
+		EXPECT_LE(relative_error(blocked_y, y), std::ldexp(1.0, -98)) << "n = " << n;
+
+		ddfft_inverse(&blocked_plan, blocked_y.data());
+		EXPECT_LE(relative_error(blocked_y, x), std::ldexp(1.0, -98)) << "n = " << n;
+
+		std::vector<dcomplex> dx(n), blocked_dx(n);
+		for (size_t j = 0; j < n; j++) {
+			dx[j] = blocked_dx[j] = dcomplex { x[j].re.hi, x[j].im.hi };
+		}
+		dfft_forward(&plan, dx.data());
+		dfft_forward(&blocked_plan, blocked_dx.data());
+		std::vector<ddcomplex> dy(n), blocked_dy(n);
+		for (size_t j = 0; j < n; j++) {
+			dy[j] = ddcomplex { { dx[j].re, 0.0 }, { dx[j].im, 0.0 } };
+			blocked_dy[j] = ddcomplex { { blocked_dx[j].re, 0.0 }, { blocked_dx[j].im, 0.0 } };
+		}
+		EXPECT_LE(relative_error(blocked_dy, dy), std::ldexp(1.0, -48)) << "n = " << n;
+		fft_plan_release(&plan);
+		fft_plan_release(&blocked_plan);
+	}
+}
+
+TEST(ddfft, roundtrip) {
+	for (size_t n = 1; n <= 16384; n *= 2) {
+		struct fft_plan plan;
+		ASSERT_TRUE(fft_plan_init(&plan, n));
+		const std::vector<ddcomplex> x = random_input(n);
+		std::vector<ddcomplex> y = x;
+		ddfft_forward(&plan, y.data());
+		ddfft_inverse(&plan, y.data());
+		EXPECT_LE(relative_error(y, x), std::ldexp(1.0, -98)) << "n = " << n;
+		fft_plan_release(&plan);
+	}
+}
+
+/* The double-precision FFT must have the accuracy of double precision w.r.t. the double-double FFT */
+TEST(dfft, accuracy) {
+	for (size_t n = 1; n <= 16384; n *= 2) {
+		struct fft_plan plan;
+		ASSERT_TRUE(fft_plan_init(&plan, n));
+		std::vector<ddcomplex> x = random_input(n);
+		std::vector<dcomplex> dx(n);
+		for (size_t j = 0; j < n; j++) {
+			x[j].re.lo = x[j].im.lo = 0.0;
+			dx[j] = dcomplex { x[j].re.hi, x[j].im.hi };
+		}
+		ddfft_forward(&plan, x.data());
+		dfft_forward(&plan, dx.data());
+		std::vector<ddcomplex> y(n);
+		for (size_t j = 0; j < n; j++) {
+			y[j] = ddcomplex { { dx[j].re, 0.0 }, { dx[j].im, 0.0 } };
+		}
+		EXPECT_LE(relative_error(y, x), std::ldexp(1.0, -48)) << "n = " << n;
+
+		dfft_inverse(&plan, dx.data());
+		ddfft_inverse(&plan, x.data());
+		for (size_t j = 0; j < n; j++) {
+			y[j] = ddcomplex { { dx[j].re, 0.0 }, { dx[j].im, 0.0 } };
+		}
+		EXPECT_LE(relative_error(y, x), std::ldexp(1.0, -48)) << "n = " << n;
+		fft_plan_release(&plan);
+	}
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,545 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <random>
+#include <functional>
+
+#include <mpfr.h>
+
+#include <gtest/gtest.h>
+
+#include <fpplus.h>
+
+#include "common.h"
+
+/* Precision sufficient to represent exactly any sum of two single-precision numbers */
+#define FLT_EXACT_PREC (FLT_MANT_DIG + FLT_MAX_EXP - FLT_MIN_EXP)
+
+inline float ulpf(float x) {
+	x = fabsf(x);
+	return nextafterf(x, std::numeric_limits<float>::infinity()) - x;
+}
+
+/* Generator of uniformly distributed random single-precision numbers in [0, 1) */
+static inline std::function<float()> random_uniformf() {
+	return std::bind(std::uniform_real_distribution<float>(), std::mt19937(random_seed()));
+}
+
+/* Generates random normalized float-float number with the high part from rng */
+static inline floatfloat random_ff(std::function<float()>& rng) {
+	floatfloat a = { rng(), rng() * FLT_EPSILON };
+	a.hi = efaddordf(a.hi, a.lo, &a.lo);
+	return a;
+}
+
+/* Check that the high float is the sum of addends rounded to closest single-precision number */
+TEST(efaddf, high_float) {
+	auto rng = random_uniformf();
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float a = rng();
+		const float b = rng();
+		float e;
+		const float sum = efaddf(a, b, &e);
+		EXPECT_EQ(sum, a + b) << "a = " << a << " b = " << b;
+	}
+}
+
+/* Check that the low float is not greater than half ULP of the high float */
+TEST(efaddf, low_float) {
+	auto rng = random_uniformf();
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float a = rng();
+		const float b = rng();
+		float e;
+		const float sum = efaddf(a, b, &e);
+		EXPECT_LE(fabsf(e), 0.5f * ulpf(sum)) << "a = " << a << " b = " << b;
+	}
+}
+
+/* Check that the sum of outputs equals the sum of inputs when inputs have the same or opposite signs */
+TEST(efaddf, error_free) {
+	auto rng = random_uniformf();
+	mpfr_t sum_ab, sum_se;
+	mpfr_init2(sum_ab, FLT_EXACT_PREC);
+	mpfr_init2(sum_se, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float a = rng();
+		const float b = iteration % 2 == 0 ? rng() : -rng();
+		float e;
+		const float s = efaddf(a, b, &e);
+
+		mpfr_set_d(sum_ab, a, MPFR_RNDN);
+		mpfr_add_d(sum_ab, sum_ab, b, MPFR_RNDN);
+
+		mpfr_set_d(sum_se, s, MPFR_RNDN);
+		mpfr_add_d(sum_se, sum_se, e, MPFR_RNDN);
+
+		EXPECT_TRUE(mpfr_equal_p(sum_ab, sum_se)) << "a = " << a << " b = " << b;
+	}
+	mpfr_clear(sum_ab);
+	mpfr_clear(sum_se);
+}
+
+/* Check that the high float is the sum of addends rounded to closest single-precision number */
+TEST(efaddordf, high_float) {
+	auto rng = random_uniformf();
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float x = rng();
+		const float y = rng();
+		const float a = fmaxf(x, y);
+		const float b = fminf(x, y);
+		float e;
+		const float sum = efaddordf(a, b, &e);
+		EXPECT_EQ(sum, a + b) << "a = " << a << " b = " << b;
+	}
+}
+
+/* Check that the sum of outputs equals the sum of inputs when inputs have the same or opposite signs */
+TEST(efaddordf, error_free) {
+	auto rng = random_uniformf();
+	mpfr_t sum_ab, sum_se;
+	mpfr_init2(sum_ab, FLT_EXACT_PREC);
+	mpfr_init2(sum_se, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float x = rng();
+		const float y = rng();
+		const float a = fmaxf(x, y);
+		const float b = iteration % 2 == 0 ? fminf(x, y) : -fminf(x, y);
+		float e;
+		const float s = efaddordf(a, b, &e);
+
+		mpfr_set_d(sum_ab, a, MPFR_RNDN);
+		mpfr_add_d(sum_ab, sum_ab, b, MPFR_RNDN);
+
+		mpfr_set_d(sum_se, s, MPFR_RNDN);
+		mpfr_add_d(sum_se, sum_se, e, MPFR_RNDN);
+
+		EXPECT_TRUE(mpfr_equal_p(sum_ab, sum_se)) << "a = " << a << " b = " << b;
+		EXPECT_LE(fabsf(e), 0.5f * ulpf(s)) << "a = " << a << " b = " << b;
+	}
+	mpfr_clear(sum_ab);
+	mpfr_clear(sum_se);
+}
+
+/* Check that the high float is the product of factors rounded to closest single-precision number */
+TEST(efmulf, high_float) {
+	auto rng = random_uniformf();
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float a = rng();
+		const float b = rng();
+		float e;
+		const float product = efmulf(a, b, &e);
+		EXPECT_EQ(product, a * b) << "a = " << a << " b = " << b;
+		EXPECT_LE(fabsf(e), 0.5f * ulpf(product)) << "a = " << a << " b = " << b;
+	}
+}
+
+/* Check that the sum of outputs equals the product of inputs */
+TEST(efmulf, error_free) {
+	auto rng = random_uniformf();
+	mpfr_t prod_ab, sum_pe;
+	mpfr_init2(prod_ab, FLT_EXACT_PREC);
+	mpfr_init2(sum_pe, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float a = rng();
+		const float b = rng();
+		float e;
+		const float p = efmulf(a, b, &e);
+
+		mpfr_set_d(prod_ab, a, MPFR_RNDN);
+		mpfr_mul_d(prod_ab, prod_ab, b, MPFR_RNDN);
+
+		mpfr_set_d(sum_pe, p, MPFR_RNDN);
+		mpfr_add_d(sum_pe, sum_pe, e, MPFR_RNDN);
+
+		EXPECT_TRUE(mpfr_equal_p(prod_ab, sum_pe)) << "a = " << a << " b = " << b;
+	}
+	mpfr_clear(prod_ab);
+	mpfr_clear(sum_pe);
+}
+
+/* Check that the result is the exact sum of addends, with the high float rounded to closest single-precision number */
+TEST(ffaddl, error_free) {
+	auto rng = random_uniformf();
+	mpfr_t mp_sum_a_b, mp_sum_hi_lo;
+	mpfr_init2(mp_sum_a_b, FLT_EXACT_PREC);
+	mpfr_init2(mp_sum_hi_lo, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float a = rng();
+		const float b = iteration % 2 == 0 ? rng() : -rng();
+		const floatfloat sum = ffaddl(a, b);
+		EXPECT_EQ(sum.hi, a + b) << "a = " << a << " b = " << b;
+
+		mpfr_set_d(mp_sum_a_b, a, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, b, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, sum.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, sum.lo, MPFR_RNDN);
+
+		EXPECT_TRUE(mpfr_equal_p(mp_sum_a_b, mp_sum_hi_lo)) << "a = " << a << " b = " << b;
+	}
+	mpfr_clear(mp_sum_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+}
+
+/* Check that the result is at least as accuate as single-precision addition when addends have the same or opposite signs */
+TEST(ffaddw, accuracy) {
+	auto rng = random_uniformf();
+	mpfr_t mp_sum_a_b, mp_sum_hi_lo, mp_error_floatfloat, mp_error_float;
+	mpfr_init2(mp_sum_a_b, FLT_EXACT_PREC);
+	mpfr_init2(mp_sum_hi_lo, FLT_EXACT_PREC);
+	mpfr_init2(mp_error_floatfloat, FLT_EXACT_PREC);
+	mpfr_init2(mp_error_float, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const floatfloat a = random_ff(rng);
+		const float b = iteration % 2 == 0 ? rng() : -rng();
+		const floatfloat sum = ffaddw(a, b);
+
+		mpfr_set_d(mp_sum_a_b, a.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, a.lo, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, b, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, sum.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, sum.lo, MPFR_RNDN);
+
+		mpfr_sub(mp_error_floatfloat, mp_sum_a_b, mp_sum_hi_lo, MPFR_RNDN);
+		mpfr_sub_d(mp_error_float, mp_sum_a_b, (a.hi + b) + a.lo, MPFR_RNDN);
+
+		EXPECT_LE(mpfr_cmpabs(mp_error_floatfloat, mp_error_float), 0) << "a = " << a.hi << " + " << a.lo << " b = " << b;
+	}
+	mpfr_clear(mp_sum_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+	mpfr_clear(mp_error_floatfloat);
+	mpfr_clear(mp_error_float);
+}
+
+/* Check that the result is at least as accuate as single-precision addition when addends have the same or opposite signs */
+TEST(ffadd, accuracy) {
+	auto rng = random_uniformf();
+	mpfr_t mp_sum_a_b, mp_sum_hi_lo, mp_error_floatfloat, mp_error_float;
+	mpfr_init2(mp_sum_a_b, FLT_EXACT_PREC);
+	mpfr_init2(mp_sum_hi_lo, FLT_EXACT_PREC);
+	mpfr_init2(mp_error_floatfloat, FLT_EXACT_PREC);
+	mpfr_init2(mp_error_float, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const floatfloat a = random_ff(rng);
+		floatfloat b = random_ff(rng);
+		if (iteration % 2 != 0) {
+			b = floatfloat { -b.hi, -b.lo };
+		}
+
+		const floatfloat sum = ffadd(a, b);
+
+		mpfr_set_d(mp_sum_a_b, a.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, a.lo, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, b.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, b.lo, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, sum.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, sum.lo, MPFR_RNDN);
+
+		mpfr_sub(mp_error_floatfloat, mp_sum_a_b, mp_sum_hi_lo, MPFR_RNDN);
+		mpfr_sub_d(mp_error_float, mp_sum_a_b, (a.hi + b.hi) + (a.lo + b.lo), MPFR_RNDN);
+
+		EXPECT_LE(mpfr_cmpabs(mp_error_floatfloat, mp_error_float), 0) <<
+			"a = " << a.hi << " + " << a.lo << " b = " << b.hi << " + " << b.lo;
+	}
+	mpfr_clear(mp_sum_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+	mpfr_clear(mp_error_floatfloat);
+	mpfr_clear(mp_error_float);
+}
+
+/* Check that the result is at least as accuate as single-precision addition when addends have the same or opposite signs */
+TEST(ffadd_fast, accuracy) {
+	auto rng = random_uniformf();
+	mpfr_t mp_sum_a_b, mp_sum_hi_lo, mp_error_floatfloat, mp_error_float;
+	mpfr_init2(mp_sum_a_b, FLT_EXACT_PREC);
+	mpfr_init2(mp_sum_hi_lo, FLT_EXACT_PREC);
+	mpfr_init2(mp_error_floatfloat, FLT_EXACT_PREC);
+	mpfr_init2(mp_error_float, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const floatfloat a = random_ff(rng);
+		floatfloat b = random_ff(rng);
+		if (iteration % 2 != 0) {
+			b = floatfloat { -b.hi, -b.lo };
+		}
+
+		const floatfloat sum = ffadd_fast(a, b);
+
+		mpfr_set_d(mp_sum_a_b, a.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, a.lo, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, b.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_a_b, mp_sum_a_b, b.lo, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, sum.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, sum.lo, MPFR_RNDN);
+
+		mpfr_sub(mp_error_floatfloat, mp_sum_a_b, mp_sum_hi_lo, MPFR_RNDN);
+		mpfr_sub_d(mp_error_float, mp_sum_a_b, (a.hi + b.hi) + (a.lo + b.lo), MPFR_RNDN);
+
+		EXPECT_LE(mpfr_cmpabs(mp_error_floatfloat, mp_error_float), 0) <<
+			"a = " << a.hi << " + " << a.lo << " b = " << b.hi << " + " << b.lo;
+	}
+	mpfr_clear(mp_sum_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+	mpfr_clear(mp_error_floatfloat);
+	mpfr_clear(mp_error_float);
+}
+
+/* Check that the result is the exact product of factors, with the high float rounded to closest single-precision number */
+TEST(ffmull, error_free) {
+	auto rng = random_uniformf();
+	mpfr_t mp_prod_a_b, mp_sum_hi_lo;
+	mpfr_init2(mp_prod_a_b, FLT_EXACT_PREC);
+	mpfr_init2(mp_sum_hi_lo, FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const float a = rng();
+		const float b = rng();
+		const floatfloat product = ffmull(a, b);
+		EXPECT_EQ(product.hi, a * b) << "a = " << a << " b = " << b;
+
+		mpfr_set_d(mp_prod_a_b, a, MPFR_RNDN);
+		mpfr_mul_d(mp_prod_a_b, mp_prod_a_b, b, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, product.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, product.lo, MPFR_RNDN);
+
+		EXPECT_TRUE(mpfr_equal_p(mp_prod_a_b, mp_sum_hi_lo)) << "a = " << a << " b = " << b;
+	}
+	mpfr_clear(mp_prod_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+}
+
+/* Check that the result is at least as accuate as single-precision multiplication */
+TEST(ffmul, accuracy) {
+	auto rng = random_uniformf();
+	mpfr_t mp_a, mp_b, mp_prod_a_b, mp_sum_hi_lo, mp_error_floatfloat, mp_error_float;
+	mpfr_init2(mp_a, FLT_EXACT_PREC);
+	mpfr_init2(mp_b, FLT_EXACT_PREC);
+	mpfr_init2(mp_prod_a_b, 2 * FLT_EXACT_PREC);
+	mpfr_init2(mp_sum_hi_lo, 2 * FLT_EXACT_PREC);
+	mpfr_init2(mp_error_floatfloat, 2 * FLT_EXACT_PREC);
+	mpfr_init2(mp_error_float, 2 * FLT_EXACT_PREC);
+	for (size_t iteration = 0; iteration < 1000; iteration++) {
+		const floatfloat a = random_ff(rng);
+		const floatfloat b = random_ff(rng);
+
+		const floatfloat prod = ffmul(a, b);
+
+		mpfr_set_d(mp_a, a.hi, MPFR_RNDN);
+		mpfr_add_d(mp_a, mp_a, a.lo, MPFR_RNDN);
+
+		mpfr_set_d(mp_b, b.hi, MPFR_RNDN);
+		mpfr_add_d(mp_b, mp_b, b.lo, MPFR_RNDN);
+
+		mpfr_mul(mp_prod_a_b, mp_a, mp_b, MPFR_RNDN);
+
+		mpfr_set_d(mp_sum_hi_lo, prod.hi, MPFR_RNDN);
+		mpfr_add_d(mp_sum_hi_lo, mp_sum_hi_lo, prod.lo, MPFR_RNDN);
+
+		mpfr_sub(mp_error_floatfloat, mp_prod_a_b, mp_sum_hi_lo, MPFR_RNDN);
+		mpfr_sub_d(mp_error_float, mp_prod_a_b, a.hi * b.hi + ((a.lo * b.hi + a.hi * b.lo) + a.lo * b.lo), MPFR_RNDN);
+
+		EXPECT_LE(mpfr_cmpabs(mp_error_floatfloat, mp_error_float), 0) <<
+			"a = " << a.hi << " + " << a.lo << " b = " << b.hi << " + " << b.lo;
+	}
+	mpfr_clear(mp_a);
+	mpfr_clear(mp_b);
+	mpfr_clear(mp_prod_a_b);
+	mpfr_clear(mp_sum_hi_lo);
+	mpfr_clear(mp_error_floatfloat);
+	mpfr_clear(mp_error_float);
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+/* Check that SIMD error-free transformations produce bitwise the same results as scalar ones */
+TEST(mm_efaddf, same_as_scalar) {
+	auto rng = random_uniformf();
+	for (size_t iteration = 0; iteration < 100; iteration++) {
+		alignas(32) float a[8], b[8], ordered_b[8];
+		for (size_t i = 0; i < 8; i++) {
+			a[i] = rng();
+			b[i] = i % 2 == 0 ? rng() : -rng();
+			ordered_b[i] = b[i] * a[i];
+		}
+
+		alignas(32) float sum128[4], sum128_error[4], ordsum128[4], ordsum128_error[4], product128[4], product128_error[4];
+		alignas(32) float sum256[8], sum256_error[8], ordsum256[8], ordsum256_error[8], product256[8], product256_error[8];
+		__m128 e128;
+		__m256 e256;
+		_mm_store_ps(sum128, _mm_efadd_ps(_mm_load_ps(a), _mm_load_ps(b), &e128));
+		_mm_store_ps(sum128_error, e128);
+		_mm_store_ps(ordsum128, _mm_efaddord_ps(_mm_load_ps(a), _mm_load_ps(ordered_b), &e128));
+		_mm_store_ps(ordsum128_error, e128);
+		_mm_store_ps(product128, _mm_efmul_ps(_mm_load_ps(a), _mm_load_ps(b), &e128));
+		_mm_store_ps(product128_error, e128);
+		_mm256_store_ps(sum256, _mm256_efadd_ps(_mm256_load_ps(a), _mm256_load_ps(b), &e256));
+		_mm256_store_ps(sum256_error, e256);
+		_mm256_store_ps(ordsum256, _mm256_efaddord_ps(_mm256_load_ps(a), _mm256_load_ps(ordered_b), &e256));
+		_mm256_store_ps(ordsum256_error, e256);
+		_mm256_store_ps(product256, _mm256_efmul_ps(_mm256_load_ps(a), _mm256_load_ps(b), &e256));
+		_mm256_store_ps(product256_error, e256);
+
+		float e;
+		EXPECT_EQ(efaddf(a[0], b[0], &e), _mm_cvtss_f32(_mm_efadd_ss(_mm_load_ps(a), _mm_load_ps(b), &e128)));
+		EXPECT_EQ(e, _mm_cvtss_f32(e128));
+		EXPECT_EQ(efaddordf(a[0], ordered_b[0], &e), _mm_cvtss_f32(_mm_efaddord_ss(_mm_load_ps(a), _mm_load_ps(ordered_b), &e128)));
+		EXPECT_EQ(e, _mm_cvtss_f32(e128));
+		EXPECT_EQ(efmulf(a[0], b[0], &e), _mm_cvtss_f32(_mm_efmul_ss(_mm_load_ps(a), _mm_load_ps(b), &e128)));
+		EXPECT_EQ(e, _mm_cvtss_f32(e128));
+		for (size_t i = 0; i < 8; i++) {
+			if (i < 4) {
+				EXPECT_EQ(efaddf(a[i], b[i], &e), sum128[i]) << "i = " << i;
+				EXPECT_EQ(e, sum128_error[i]) << "i = " << i;
+				EXPECT_EQ(efaddordf(a[i], ordered_b[i], &e), ordsum128[i]) << "i = " << i;
+				EXPECT_EQ(e, ordsum128_error[i]) << "i = " << i;
+				EXPECT_EQ(efmulf(a[i], b[i], &e), product128[i]) << "i = " << i;
+				EXPECT_EQ(e, product128_error[i]) << "i = " << i;
+			}
+			EXPECT_EQ(efaddf(a[i], b[i], &e), sum256[i]) << "i = " << i;
+			EXPECT_EQ(e, sum256_error[i]) << "i = " << i;
+			EXPECT_EQ(efaddordf(a[i], ordered_b[i], &e), ordsum256[i]) << "i = " << i;
+			EXPECT_EQ(e, ordsum256_error[i]) << "i = " << i;
+			EXPECT_EQ(efmulf(a[i], b[i], &e), product256[i]) << "i = " << i;
+			EXPECT_EQ(e, product256_error[i]) << "i = " << i;
+		}
+	}
+}
+
+static void expect_same_ff(const floatfloat& expected, const floatfloat& actual, const char* operation, size_t i) {
+	EXPECT_EQ(expected.hi, actual.hi) << operation << " i = " << i;
+	EXPECT_EQ(expected.lo, actual.lo) << operation << " i = " << i;
+}
+
+/* Check that 128-bit SIMD functions produce bitwise the same results as scalar functions */
+TEST(mm_pff, same_as_scalar) {
+	auto rng = random_uniformf();
+	for (size_t iteration = 0; iteration < 100; iteration++) {
+		alignas(16) floatfloat a[4], b[4];
+		alignas(16) float c[4];
+		for (size_t i = 0; i < 4; i++) {
+			a[i] = random_ff(rng);
+			b[i] = random_ff(rng);
+			c[i] = i % 2 == 0 ? rng() : -rng();
+		}
+
+		const __m128ff va = _mm_loaddeinterleave_pff(a);
+		const __m128ff vb = _mm_loaddeinterleaveu_pff(b);
+		const __m128 vc = _mm_load_ps(c);
+
+		const __m128ff results[] = {
+			_mm_addl_ps(va.hi, vc),
+			_mm_addw_pff(va, vc),
+			_mm_add_pff(va, vb),
+			_mm_add_fast_pff(va, vb),
+			_mm_mull_ps(va.hi, vc),
+			_mm_mul_pff(va, vb),
+		};
+		const char* names[] = { "addl", "addw", "add", "add_fast", "mull", "mul" };
+		for (size_t r = 0; r < sizeof(results) / sizeof(results[0]); r++) {
+			alignas(16) float hi[4], lo[4];
+			_mm_store_ps(hi, results[r].hi);
+			_mm_store_ps(lo, results[r].lo);
+			for (size_t i = 0; i < 4; i++) {
+				floatfloat expected = { 0.0f, 0.0f };
+				switch (r) {
+					case 0: expected = ffaddl(a[i].hi, c[i]); break;
+					case 1: expected = ffaddw(a[i], c[i]); break;
+					case 2: expected = ffadd(a[i], b[i]); break;
+					case 3: expected = ffadd_fast(a[i], b[i]); break;
+					case 4: expected = ffmull(a[i].hi, c[i]); break;
+					case 5: expected = ffmul(a[i], b[i]); break;
+				}
+				expect_same_ff(expected, floatfloat { hi[i], lo[i] }, names[r], i);
+			}
+		}
+
+		expect_same_ff(ffaddl(a[0].hi, c[0]), _mm_cvtsff_f32ff(_mm_addl_ss(va.hi, vc)), "addl_ss", 0);
+		expect_same_ff(ffaddw(a[0], c[0]), _mm_cvtsff_f32ff(_mm_addw_sff(va, vc)), "addw_sff", 0);
+		expect_same_ff(ffadd(a[0], b[0]), _mm_cvtsff_f32ff(_mm_add_sff(va, vb)), "add_sff", 0);
+		expect_same_ff(ffadd_fast(a[0], b[0]), _mm_cvtsff_f32ff(_mm_add_fast_sff(va, vb)), "add_fast_sff", 0);
+		expect_same_ff(ffmull(a[0].hi, c[0]), _mm_cvtsff_f32ff(_mm_mull_ss(va.hi, vc)), "mull_ss", 0);
+		expect_same_ff(ffmul(a[0], b[0]), _mm_cvtsff_f32ff(_mm_mul_sff(va, vb)), "mul_sff", 0);
+
+		expect_same_ff(a[2], _mm_cvtsff_f32ff(_mm_broadcast_sff(&a[2])), "broadcast", 0);
+
+		/* The reduction adds elements 2 apart, then the two partial sums */
+		const floatfloat reduction = ffadd(ffadd(a[0], a[2]), ffadd(a[1], a[3]));
+		expect_same_ff(reduction, _mm_reduce_add_pff(va), "reduce_add", 0);
+	}
+}
+
+/* Check that 256-bit SIMD functions produce bitwise the same results as scalar functions */
+TEST(mm256_pff, same_as_scalar) {
+	auto rng = random_uniformf();
+	for (size_t iteration = 0; iteration < 100; iteration++) {
+		alignas(32) floatfloat a[8], b[8];
+		alignas(32) float c[8];
+		for (size_t i = 0; i < 8; i++) {
+			a[i] = random_ff(rng);
+			b[i] = random_ff(rng);
+			c[i] = i % 2 == 0 ? rng() : -rng();
+		}
+
+		const __m256ff va = _mm256_loaddeinterleave_pff(a);
+		const __m256ff vb = _mm256_loaddeinterleaveu_pff(b);
+		const __m256 vc = _mm256_load_ps(c);
+
+		/* Deinterleaving load followed by interleaving store must reproduce the input */
+		alignas(32) floatfloat a_copy[8], b_copy[8];
+		_mm256_interleavestore_pff(a_copy, va);
+		_mm256_interleavestoreu_pff(b_copy, vb);
+		for (size_t i = 0; i < 8; i++) {
+			expect_same_ff(a[i], a_copy[i], "loaddeinterleave", i);
+			expect_same_ff(b[i], b_copy[i], "loaddeinterleaveu", i);
+		}
+
+		const __m256ff results[] = {
+			_mm256_addl_ps(va.hi, vc),
+			_mm256_addw_pff(va, vc),
+			_mm256_add_pff(va, vb),
+			_mm256_add_fast_pff(va, vb),
+			_mm256_mull_ps(va.hi, vc),
+			_mm256_mul_pff(va, vb),
+			_mm256_broadcast_sff(&a[5]),
+			_mm256_setzero_pff(),
+		};
+		const char* names[] = { "addl", "addw", "add", "add_fast", "mull", "mul", "broadcast", "setzero" };
+		for (size_t r = 0; r < sizeof(results) / sizeof(results[0]); r++) {
+			alignas(32) floatfloat result[8];
+			_mm256_interleavestore_pff(result, results[r]);
+			for (size_t i = 0; i < 8; i++) {
+				floatfloat expected = { 0.0f, 0.0f };
+				switch (r) {
+					case 0: expected = ffaddl(a[i].hi, c[i]); break;
+					case 1: expected = ffaddw(a[i], c[i]); break;
+					case 2: expected = ffadd(a[i], b[i]); break;
+					case 3: expected = ffadd_fast(a[i], b[i]); break;
+					case 4: expected = ffmull(a[i].hi, c[i]); break;
+					case 5: expected = ffmul(a[i], b[i]); break;
+					case 6: expected = a[5]; break;
+					case 7: expected = floatfloat { 0.0f, 0.0f }; break;
+				}
+				expect_same_ff(expected, result[i], names[r], i);
+			}
+		}
+
+		/* The reduction adds elements 4 apart, then reduces the 4 partial sums as the 128-bit version */
+		floatfloat partial[4];
+		for (size_t i = 0; i < 4; i++) {
+			partial[i] = ffadd(a[i], a[i + 4]);
+		}
+		const floatfloat reduction = ffadd(ffadd(partial[0], partial[2]), ffadd(partial[1], partial[3]));
+		expect_same_ff(reduction, _mm256_reduce_add_pff(va), "reduce_add", 0);
+	}
+}
+#endif
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
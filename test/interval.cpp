@@ -0,0 +1,366 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <limits>
+#include <random>
+#include <functional>
+#include <algorithm>
+
+#include <mpfr.h>
+
+#include <gtest/gtest.h>
+
+#include <fpplus.h>
+
+#include "common.h"
+
+/* Generates random double-precision number with random sign and exponent in [min_exponent, max_exponent] */
+class RandomDouble {
+public:
+	RandomDouble(int minExponent, int maxExponent) :
+		rng(random_seed()),
+		mantissa(1.0, 2.0),
+		exponent(minExponent, maxExponent),
+		sign(0, 1)
+	{
+	}
+
+	double operator()() {
+		const double magnitude = std::ldexp(mantissa(rng), exponent(rng));
+		return sign(rng) ? -magnitude : magnitude;
+	}
+
+private:
+	std::mt19937 rng;
+	std::uniform_real_distribution<double> mantissa;
+	std::uniform_int_distribution<int> exponent;
+	std::uniform_int_distribution<int> sign;
+};
+
+/* Reference operations on doubles, correctly rounded in the given direction with MPFR, including subnormal results */
+static double mpfr_directed(int (*operation)(mpfr_ptr, mpfr_srcptr, mpfr_srcptr, mpfr_rnd_t), double a, double b, mpfr_rnd_t rounding) {
+	mpfr_t mp_a, mp_b, result;
+	mpfr_init2(mp_a, DBL_MANT_DIG);
+	mpfr_init2(mp_b, DBL_MANT_DIG);
+	mpfr_init2(result, DBL_MANT_DIG);
+	mpfr_set_d(mp_a, a, MPFR_RNDN);
+	mpfr_set_d(mp_b, b, MPFR_RNDN);
+	const int ternary = operation(result, mp_a, mp_b, rounding);
+	mpfr_subnormalize(result, ternary, rounding);
+	const double value = mpfr_get_d(result, rounding);
+	mpfr_clear(mp_a);
+	mpfr_clear(mp_b);
+	mpfr_clear(result);
+	return value;
+}
+
+static double mpfr_sqrt_directed(double a, mpfr_rnd_t rounding) {
+	mpfr_t result;
+	mpfr_init2(result, DBL_MANT_DIG);
+	mpfr_set_d(result, a, MPFR_RNDN);
+	const int ternary = mpfr_sqrt(result, result, rounding);
+	mpfr_subnormalize(result, ternary, rounding);
+	const double value = mpfr_get_d(result, rounding);
+	mpfr_clear(result);
+	return value;
+}
+
+/* Checks that x is the correctly rounded result, or, where the error-free transformations may underflow, at most 2 steps outward */
+static void expect_directed(double expected, double x, bool towardNegative, bool underflow) {
+	if (!underflow) {
+		EXPECT_EQ(expected, x);
+	} else {
+		const double direction = towardNegative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+		if (towardNegative) {
+			EXPECT_LE(x, expected);
+		} else {
+			EXPECT_GE(x, expected);
+		}
+		const double limit = std::nextafter(std::nextafter(expected, direction), direction);
+		if (towardNegative) {
+			EXPECT_GE(x, limit);
+		} else {
+			EXPECT_LE(x, limit);
+		}
+	}
+}
+
+static const double tiny = std::ldexp(1.0, -960);
+
+TEST(ivpred, nextafter) {
+	const double special[] = {
+		0.0, -0.0, std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::denorm_min(), DBL_MIN, -DBL_MIN, 2.0 * DBL_MIN, 4.0 * DBL_MIN, 1.0, -1.0,
+		std::nextafter(1.0, 2.0), std::nextafter(1.0, 0.0), 0x1.0p+1000, DBL_MAX, -DBL_MAX
+	};
+	RandomDouble rng(-1074, 1023);
+	for (size_t iteration = 0; iteration < 100000; iteration++) {
+		const double x = iteration < sizeof(special) / sizeof(special[0]) ? special[iteration] : rng();
+		const double pred = std::nextafter(x, -std::numeric_limits<double>::infinity());
+		const double succ = std::nextafter(x, std::numeric_limits<double>::infinity());
+		if (std::fabs(x) <= 0x1.0p-1020 && std::fabs(x) >= DBL_MIN) {
+			EXPECT_LE(ivpred(x), pred) << "x = " << x;
+			EXPECT_GE(ivpred(x), std::nextafter(pred, -std::numeric_limits<double>::infinity())) << "x = " << x;
+			EXPECT_GE(ivsucc(x), succ) << "x = " << x;
+			EXPECT_LE(ivsucc(x), std::nextafter(succ, std::numeric_limits<double>::infinity())) << "x = " << x;
+		} else {
+			EXPECT_EQ(pred, ivpred(x)) << "x = " << x;
+			EXPECT_EQ(succ, ivsucc(x)) << "x = " << x;
+		}
+	}
+}
+
+TEST(addrd, mpfr) {
+	RandomDouble rng(-1074, 1023), narrow_rng(-10, 10);
+	for (size_t iteration = 0; iteration < 100000; iteration++) {
+		/* Operands of similar magnitude for cancellation, and of any magnitude for overflow */
+		const double a = (iteration % 2) ? rng() : narrow_rng();
+		const double b = (iteration % 2) ? rng() : narrow_rng();
+		/* Predecessor and successor of sums in [2**-1022, 2**-1020] may be 2 steps away */
+		const bool underflow = std::fabs(a + b) <= 0x1.0p-1020;
+		expect_directed(mpfr_directed(mpfr_add, a, b, MPFR_RNDD), addrd(a, b), true, underflow);
+		expect_directed(mpfr_directed(mpfr_add, a, b, MPFR_RNDU), addru(a, b), false, underflow);
+	}
+	EXPECT_EQ(DBL_MAX, addrd(DBL_MAX, DBL_MAX));
+	EXPECT_EQ(std::numeric_limits<double>::infinity(), addru(DBL_MAX, DBL_MAX));
+	EXPECT_EQ(-std::numeric_limits<double>::infinity(), addrd(-DBL_MAX, -DBL_MAX));
+	EXPECT_EQ(-DBL_MAX, addru(-DBL_MAX, -DBL_MAX));
+}
+
+TEST(mulrd, mpfr) {
+	RandomDouble rng(-600, 600);
+	for (size_t iteration = 0; iteration < 100000; iteration++) {
+		const double a = rng(), b = (iteration % 100 == 0) ? 0.0 : rng();
+		const bool underflow = std::fabs(a * b) < tiny && b != 0.0;
+		expect_directed(mpfr_directed(mpfr_mul, a, b, MPFR_RNDD), mulrd(a, b), true, underflow);
+		expect_directed(mpfr_directed(mpfr_mul, a, b, MPFR_RNDU), mulru(a, b), false, underflow);
+	}
+	EXPECT_EQ(0.0, mulrd(0.0, std::numeric_limits<double>::denorm_min()));
+	EXPECT_EQ(0.0, mulru(std::numeric_limits<double>::denorm_min(), 0.0));
+	EXPECT_EQ(-std::numeric_limits<double>::denorm_min(), mulrd(std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::denorm_min()));
+	EXPECT_EQ(std::numeric_limits<double>::denorm_min(), mulru(std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::denorm_min()));
+	EXPECT_EQ(DBL_MAX, mulrd(DBL_MAX, 2.0));
+	EXPECT_EQ(-DBL_MAX, mulru(DBL_MAX, -2.0));
+}
+
+TEST(divrd, mpfr) {
+	RandomDouble rng(-600, 600);
+	for (size_t iteration = 0; iteration < 100000; iteration++) {
+		const double a = (iteration % 100 == 0) ? 0.0 : rng(), b = rng();
+		const double q = a / b;
+		const bool underflow = (std::fabs(q) < tiny || std::fabs(a) < tiny) && a != 0.0;
+		expect_directed(mpfr_directed(mpfr_div, a, b, MPFR_RNDD), divrd(a, b), true, underflow);
+		expect_directed(mpfr_directed(mpfr_div, a, b, MPFR_RNDU), divru(a, b), false, underflow);
+	}
+	EXPECT_EQ(DBL_MAX, divrd(DBL_MAX, 0.5));
+	EXPECT_EQ(-DBL_MAX, divru(DBL_MAX, -0.5));
+}
+
+TEST(sqrtrd, mpfr) {
+	RandomDouble rng(-1074, 1023);
+	for (size_t iteration = 0; iteration < 100000; iteration++) {
+		const double a = std::fabs(rng());
+		const bool underflow = a < tiny;
+		expect_directed(mpfr_sqrt_directed(a, MPFR_RNDD), sqrtrd(a), true, underflow);
+		expect_directed(mpfr_sqrt_directed(a, MPFR_RNDU), sqrtru(a), false, underflow);
+	}
+	EXPECT_EQ(0.0, sqrtrd(0.0));
+	EXPECT_EQ(0.0, sqrtru(0.0));
+	EXPECT_EQ(3.0, sqrtrd(9.0));
+	EXPECT_EQ(3.0, sqrtru(9.0));
+}
+
+static doubleinterval random_interval(RandomDouble& rng) {
+	const double a = rng(), b = rng();
+	return doubleinterval { std::min(a, b), std::max(a, b) };
+}
+
+/* Interval arithmetic with endpoints rounded by MPFR: the results must match exactly outside of the underflow range */
+TEST(ivarith, mpfr) {
+	RandomDouble rng(-100, 100);
+	for (size_t iteration = 0; iteration < 10000; iteration++) {
+		doubleinterval a = random_interval(rng), b = random_interval(rng);
+		if (iteration % 10 == 0) {
+			a = doubleinterval { 0.0, std::fabs(a.sup) };
+		}
+
+		const doubleinterval sum = ivadd(a, b);
+		EXPECT_EQ(mpfr_directed(mpfr_add, a.inf, b.inf, MPFR_RNDD), sum.inf);
+		EXPECT_EQ(mpfr_directed(mpfr_add, a.sup, b.sup, MPFR_RNDU), sum.sup);
+
+		const doubleinterval difference = ivsub(a, b);
+		EXPECT_EQ(mpfr_directed(mpfr_sub, a.inf, b.sup, MPFR_RNDD), difference.inf);
+		EXPECT_EQ(mpfr_directed(mpfr_sub, a.sup, b.inf, MPFR_RNDU), difference.sup);
+
+		const double a_endpoints[2] = { a.inf, a.sup }, b_endpoints[2] = { b.inf, b.sup };
+		double product_inf = std::numeric_limits<double>::infinity(), product_sup = -std::numeric_limits<double>::infinity();
+		double quotient_inf = std::numeric_limits<double>::infinity(), quotient_sup = -std::numeric_limits<double>::infinity();
+		for (double x : a_endpoints) {
+			for (double y : b_endpoints) {
+				product_inf = std::min(product_inf, mpfr_directed(mpfr_mul, x, y, MPFR_RNDD));
+				product_sup = std::max(product_sup, mpfr_directed(mpfr_mul, x, y, MPFR_RNDU));
+				quotient_inf = std::min(quotient_inf, mpfr_directed(mpfr_div, x, y, MPFR_RNDD));
+				quotient_sup = std::max(quotient_sup, mpfr_directed(mpfr_div, x, y, MPFR_RNDU));
+			}
+		}
+		const doubleinterval product = ivmul(a, b);
+		EXPECT_EQ(product_inf, product.inf);
+		EXPECT_EQ(product_sup, product.sup);
+
+		const doubleinterval quotient = ivdiv(a, b);
+		if (b.inf <= 0.0 && b.sup >= 0.0) {
+			EXPECT_EQ(-std::numeric_limits<double>::infinity(), quotient.inf);
+			EXPECT_EQ(std::numeric_limits<double>::infinity(), quotient.sup);
+		} else {
+			EXPECT_EQ(quotient_inf, quotient.inf);
+			EXPECT_EQ(quotient_sup, quotient.sup);
+		}
+
+		const doubleinterval root = ivsqrt(a);
+		if (a.sup >= 0.0) {
+			EXPECT_EQ(mpfr_sqrt_directed(std::max(a.inf, 0.0), MPFR_RNDD), root.inf);
+			EXPECT_EQ(mpfr_sqrt_directed(a.sup, MPFR_RNDU), root.sup);
+		}
+	}
+}
+
+static ddinterval random_ddinterval(RandomDouble& rng) {
+	const doubledouble a = random_dd(rng), b = random_dd(rng);
+	return ddmin(a, b).hi == a.hi && ddmin(a, b).lo == a.lo ? ddinterval { a, b } : ddinterval { b, a };
+}
+
+/* Exact value of a double-double number and operations on it */
+class MPDoubleDouble {
+public:
+	MPDoubleDouble() {
+		mpfr_init2(value, 4 * (DBL_MANT_DIG + DBL_MAX_EXP - DBL_MIN_EXP));
+	}
+
+	explicit MPDoubleDouble(doubledouble x) : MPDoubleDouble() {
+		mpfr_set_d(value, x.hi, MPFR_RNDN);
+		mpfr_add_d(value, value, x.lo, MPFR_RNDN);
+	}
+
+	MPDoubleDouble(const MPDoubleDouble&) = delete;
+
+	MPDoubleDouble& operator=(const MPDoubleDouble&) = delete;
+
+	~MPDoubleDouble() {
+		mpfr_clear(value);
+	}
+
+	mpfr_t value;
+};
+
+/* Checks that the double-double number is normalized, on the given side of the exact value, and within 2**-97 * |scale| of it */
+static void expect_bound(doubledouble x, const mpfr_t exact, const mpfr_t scale, bool lower) {
+	const MPDoubleDouble bound(x);
+	if (lower) {
+		EXPECT_LE(mpfr_cmp(bound.value, exact), 0);
+	} else {
+		EXPECT_GE(mpfr_cmp(bound.value, exact), 0);
+	}
+
+	double lo;
+	EXPECT_EQ(x.hi, efaddord(x.hi, x.lo, &lo));
+
+	MPDoubleDouble error;
+	mpfr_sub(error.value, bound.value, exact, MPFR_RNDN);
+	mpfr_div(error.value, error.value, scale, MPFR_RNDN);
+	EXPECT_LE(std::fabs(mpfr_get_d(error.value, MPFR_RNDN)), std::ldexp(1.0, -97));
+}
+
+TEST(ddivarith, enclosure) {
+	RandomDouble rng(-1, 0);
+	MPDoubleDouble exact;
+	for (size_t iteration = 0; iteration < 10000; iteration++) {
+		const ddinterval a = random_ddinterval(rng), b = random_ddinterval(rng);
+		const MPDoubleDouble a_inf(a.inf), a_sup(a.sup), b_inf(b.inf), b_sup(b.sup);
+
+		const ddinterval sum = ddivadd(a, b);
+		mpfr_add(exact.value, a_inf.value, b_inf.value, MPFR_RNDN);
+		expect_bound(sum.inf, exact.value, exact.value, true);
+		mpfr_add(exact.value, a_sup.value, b_sup.value, MPFR_RNDN);
+		expect_bound(sum.sup, exact.value, exact.value, false);
+
+		const ddinterval difference = ddivsub(a, b);
+		mpfr_sub(exact.value, a_inf.value, b_sup.value, MPFR_RNDN);
+		expect_bound(difference.inf, exact.value, exact.value, true);
+		mpfr_sub(exact.value, a_sup.value, b_inf.value, MPFR_RNDN);
+		expect_bound(difference.sup, exact.value, exact.value, false);
+
+		/* The endpoints of the product are the smallest and the largest product of endpoints */
+		const mpfr_t* a_endpoints[2] = { &a_inf.value, &a_sup.value };
+		const mpfr_t* b_endpoints[2] = { &b_inf.value, &b_sup.value };
+		MPDoubleDouble product_inf, product_sup;
+		mpfr_set_inf(product_inf.value, 1);
+		mpfr_set_inf(product_sup.value, -1);
+		for (const mpfr_t* x : a_endpoints) {
+			for (const mpfr_t* y : b_endpoints) {
+				mpfr_mul(exact.value, *x, *y, MPFR_RNDN);
+				mpfr_min(product_inf.value, product_inf.value, exact.value, MPFR_RNDN);
+				mpfr_max(product_sup.value, product_sup.value, exact.value, MPFR_RNDN);
+			}
+		}
+		/* Both endpoints are widened by the error bound of the largest product */
+		const ddinterval product = ddivmul(a, b);
+		const MPDoubleDouble& scale = mpfr_cmpabs(product_inf.value, product_sup.value) > 0 ? product_inf : product_sup;
+		expect_bound(product.inf, product_inf.value, scale.value, true);
+		expect_bound(product.sup, product_sup.value, scale.value, false);
+	}
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+/* Check that SIMD functions produce bitwise the same results as scalar functions */
+TEST(mm256_pdi, same_as_scalar) {
+	RandomDouble rng(-600, 600);
+	for (size_t iteration = 0; iteration < 10000; iteration++) {
+		doubleinterval a[4], b[4];
+		for (size_t i = 0; i < 4; i++) {
+			a[i] = random_interval(rng);
+			b[i] = random_interval(rng);
+		}
+		/* Lanes with a zero endpoint, and with overflowing sums */
+		a[1] = doubleinterval { 0.0, std::fabs(a[1].sup) };
+		if (iteration % 2 == 0) {
+			a[2] = doubleinterval { DBL_MAX, DBL_MAX };
+			b[2] = doubleinterval { -DBL_MAX, DBL_MAX };
+		}
+
+		const __m256di va = { _mm256_setr_pd(a[0].inf, a[1].inf, a[2].inf, a[3].inf), _mm256_setr_pd(a[0].sup, a[1].sup, a[2].sup, a[3].sup) };
+		const __m256di vb = { _mm256_setr_pd(b[0].inf, b[1].inf, b[2].inf, b[3].inf), _mm256_setr_pd(b[0].sup, b[1].sup, b[2].sup, b[3].sup) };
+		double sum_inf[4], sum_sup[4], difference_inf[4], difference_sup[4], product_inf[4], product_sup[4], pred[4], succ[4];
+		const __m256di sum = _mm256_add_pdi(va, vb);
+		const __m256di difference = _mm256_sub_pdi(va, vb);
+		const __m256di product = _mm256_mul_pdi(va, vb);
+		_mm256_storeu_pd(sum_inf, sum.inf);
+		_mm256_storeu_pd(sum_sup, sum.sup);
+		_mm256_storeu_pd(difference_inf, difference.inf);
+		_mm256_storeu_pd(difference_sup, difference.sup);
+		_mm256_storeu_pd(product_inf, product.inf);
+		_mm256_storeu_pd(product_sup, product.sup);
+		_mm256_storeu_pd(pred, _mm256_pred_pd(va.inf));
+		_mm256_storeu_pd(succ, _mm256_succ_pd(va.sup));
+
+		for (size_t i = 0; i < 4; i++) {
+			EXPECT_EQ(ivadd(a[i], b[i]).inf, sum_inf[i]) << "i = " << i;
+			EXPECT_EQ(ivadd(a[i], b[i]).sup, sum_sup[i]) << "i = " << i;
+			EXPECT_EQ(ivsub(a[i], b[i]).inf, difference_inf[i]) << "i = " << i;
+			EXPECT_EQ(ivsub(a[i], b[i]).sup, difference_sup[i]) << "i = " << i;
+			EXPECT_EQ(ivmul(a[i], b[i]).inf, product_inf[i]) << "i = " << i;
+			EXPECT_EQ(ivmul(a[i], b[i]).sup, product_sup[i]) << "i = " << i;
+			EXPECT_EQ(ivpred(a[i].inf), pred[i]) << "i = " << i;
+			EXPECT_EQ(ivsucc(a[i].sup), succ[i]) << "i = " << i;
+		}
+	}
+}
+#endif
+
+int main(int ac, char* av[]) {
+	/* Exponent range of doubles, for mpfr_subnormalize */
+	mpfr_set_emin(DBL_MIN_EXP - DBL_MANT_DIG + 1);
+	mpfr_set_emax(DBL_MAX_EXP);
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,115 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include <fpplus/layout.h>
+
+#include "common.h"
+
+TEST(ddsoa, alloc) {
+	for (size_t n = 1; n < 32; n++) {
+		ddsoa array = ddsoa_alloc(n);
+		ASSERT_NE(array.hi, nullptr);
+		EXPECT_EQ(n, array.length);
+		EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(array.hi) % FPPLUS_LAYOUT_ALIGNMENT);
+		EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(array.lo) % FPPLUS_LAYOUT_ALIGNMENT);
+		/* Padding to a whole number of SIMD vectors is zero-initialized */
+		for (size_t i = n; i < (n + 3) / 4 * 4; i++) {
+			EXPECT_EQ(0.0, array.hi[i]);
+			EXPECT_EQ(0.0, array.lo[i]);
+		}
+		ddsoa_free(array);
+	}
+}
+
+/* Check that conversion to SoA and back preserves all elements, for SIMD and remainder elements */
+TEST(ddsoa, round_trip) {
+	std::function<double()> rng = random_uniform(0.0, 1.0);
+	for (size_t n = 1; n < 32; n++) {
+		const std::vector<doubledouble> aos = random_dd_array(rng, n);
+		ddsoa soa = ddsoa_alloc(n);
+		ddsoa_from_aos(n, aos.data(), soa.hi, soa.lo);
+		for (size_t i = 0; i < n; i++) {
+			EXPECT_EQ(aos[i].hi, soa.hi[i]) << "n = " << n << " i = " << i;
+			EXPECT_EQ(aos[i].lo, soa.lo[i]) << "n = " << n << " i = " << i;
+		}
+		std::vector<doubledouble> result(n);
+		ddsoa_to_aos(n, soa.hi, soa.lo, result.data());
+		for (size_t i = 0; i < n; i++) {
+			EXPECT_EQ(aos[i].hi, result[i].hi) << "n = " << n << " i = " << i;
+			EXPECT_EQ(aos[i].lo, result[i].lo) << "n = " << n << " i = " << i;
+		}
+		ddsoa_free(soa);
+	}
+}
+
+/* Check that conversion to AoSoA and back preserves all elements, and pads the last block with zeros */
+TEST(ddaosoa4, round_trip) {
+	std::function<double()> rng = random_uniform(0.0, 1.0);
+	for (size_t n = 1; n < 32; n++) {
+		const std::vector<doubledouble> aos = random_dd_array(rng, n);
+		ddaosoa4* blocks = ddaosoa4_alloc(n);
+		ASSERT_NE(blocks, nullptr);
+		EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(blocks) % FPPLUS_LAYOUT_ALIGNMENT);
+		ddaosoa4_from_aos(n, aos.data(), blocks);
+		for (size_t i = 0; i < (n + 3) / 4 * 4; i++) {
+			EXPECT_EQ(i < n ? aos[i].hi : 0.0, blocks[i / 4].hi[i % 4]) << "n = " << n << " i = " << i;
+			EXPECT_EQ(i < n ? aos[i].lo : 0.0, blocks[i / 4].lo[i % 4]) << "n = " << n << " i = " << i;
+		}
+		std::vector<doubledouble> result(n);
+		ddaosoa4_to_aos(n, blocks, result.data());
+		for (size_t i = 0; i < n; i++) {
+			EXPECT_EQ(aos[i].hi, result[i].hi) << "n = " << n << " i = " << i;
+			EXPECT_EQ(aos[i].lo, result[i].lo) << "n = " << n << " i = " << i;
+		}
+		ddaosoa4_free(blocks);
+	}
+}
+
+#if defined(__AVX__) && (defined(__FMA__) || defined(__FMA4__) || defined(__AVX2__))
+/* Check that SIMD operations on SoA and AoSoA layouts produce the same results as on AoS layout */
+TEST(layout, mm256_add_pdd) {
+	std::function<double()> rng = random_uniform(0.0, 1.0);
+	const size_t n = 64;
+	const std::vector<doubledouble> a = random_dd_array(rng, n), b = random_dd_array(rng, n);
+
+	ddsoa a_soa = ddsoa_alloc(n), b_soa = ddsoa_alloc(n);
+	ddsoa_from_aos(n, a.data(), a_soa.hi, a_soa.lo);
+	ddsoa_from_aos(n, b.data(), b_soa.hi, b_soa.lo);
+	ddaosoa4* a_aosoa = ddaosoa4_alloc(n);
+	ddaosoa4* b_aosoa = ddaosoa4_alloc(n);
+	ddaosoa4_from_aos(n, a.data(), a_aosoa);
+	ddaosoa4_from_aos(n, b.data(), b_aosoa);
+
+	for (size_t i = 0; i < n; i += 4) {
+		_mm256_storesoa_pdd(&a_soa.hi[i], &a_soa.lo[i],
+			_mm256_add_pdd(_mm256_loadsoa_pdd(&a_soa.hi[i], &a_soa.lo[i]), _mm256_loadsoa_pdd(&b_soa.hi[i], &b_soa.lo[i])));
+		_mm256_storeaosoa_pdd(&a_aosoa[i / 4],
+			_mm256_add_pdd(_mm256_loadaosoa_pdd(&a_aosoa[i / 4]), _mm256_loadaosoa_pdd(&b_aosoa[i / 4])));
+	}
+	for (size_t i = 0; i < n; i++) {
+		const doubledouble reference = ddadd(a[i], b[i]);
+		EXPECT_EQ(reference.hi, a_soa.hi[i]) << "i = " << i;
+		EXPECT_EQ(reference.lo, a_soa.lo[i]) << "i = " << i;
+		EXPECT_EQ(reference.hi, a_aosoa[i / 4].hi[i % 4]) << "i = " << i;
+		EXPECT_EQ(reference.lo, a_aosoa[i / 4].lo[i % 4]) << "i = " << i;
+	}
+
+	ddsoa_free(a_soa);
+	ddsoa_free(b_soa);
+	ddaosoa4_free(a_aosoa);
+	ddaosoa4_free(b_aosoa);
+}
+#endif
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+#include <cstddef>
+#include <cstdlib>
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <refine/solve.h>
+
+#include "common.h"
+
+class RefineTest : public RandomTest {
+protected:
+	/* Leading dimension larger than n, and not a multiple of the SIMD width */
+	static size_t leadingDimension(size_t n) {
+		return n + 3;
+	}
+
+	/* Random matrix in column-major order */
+	std::vector<double> randomMatrix(size_t n) {
+		std::vector<double> a(n * leadingDimension(n));
+		std::generate(a.begin(), a.end(), [this] { return rng(); });
+		return a;
+	}
+
+	std::vector<double> randomVector(size_t n) {
+		std::vector<double> b(n);
+		std::generate(b.begin(), b.end(), [this] { return rng(); });
+		return b;
+	}
+
+	/* max |b - A x| / (|||A|||_inf max |x|), computed exactly with MPFR */
+	static double normwiseResidual(size_t n, const std::vector<double>& a, size_t lda, const std::vector<double>& b, const std::vector<doubledouble>& x) {
+		return normwise_residual(n,
+			[&](size_t i, size_t j) { return doubledouble { a[i + j * lda], 0.0 }; },
+			[&](size_t i) { return doubledouble { b[i], 0.0 }; },
+			x);
+	}
+};
+
+TEST_F(RefineTest, dgetrs) {
+	for (size_t n = 1; n <= 64; n++) {
+		const size_t lda = leadingDimension(n);
+		const std::vector<double> a = randomMatrix(n);
+		const std::vector<double> b = randomVector(n);
+		std::vector<double> lu = a, x = b;
+		std::vector<size_t> pivots(n);
+		ASSERT_TRUE(dgetrf(n, lu.data(), lda, pivots.data()));
+		dgetrs(n, lu.data(), lda, pivots.data(), x.data());
+		std::vector<doubledouble> dd_x(n);
+		for (size_t i = 0; i < n; i++) {
+			dd_x[i] = doubledouble { x[i], 0.0 };
+		}
+		EXPECT_LE(normwiseResidual(n, a, lda, b, dd_x), 64 * DBL_EPSILON) << "n = " << n;
+	}
+}
+
+TEST_F(RefineTest, ddresidual) {
+	const size_t n = 32, lda = leadingDimension(n);
+	const std::vector<double> a = randomMatrix(n);
+	const std::vector<double> b = randomVector(n);
+	std::vector<doubledouble> x(n), r(n);
+	for (size_t i = 0; i < n; i++) {
+		x[i] = doubledouble { rng(), rng() * 0x1.0p-60 };
+	}
+	std::vector<double> work(4 * n);
+	ddresidual(n, a.data(), lda, b.data(), x.data(), r.data(), work.data());
+
+	/* r is the residual of x for the right-hand side b, so x has no residual for the right-hand side b - r */
+	ExactSum sum;
+	for (size_t i = 0; i < n; i++) {
+		sum.reset();
+		sum.add(b[i]);
+		sum.subtract(r[i]);
+		double row_norm = 0.0;
+		for (size_t j = 0; j < n; j++) {
+			sum.subtractProduct(a[i + j * lda], x[j].hi);
+			sum.subtractProduct(a[i + j * lda], x[j].lo);
+			row_norm += std::fabs(a[i + j * lda]);
+		}
+		EXPECT_LE(std::fabs(sum.get()), std::ldexp(row_norm, -100)) << "i = " << i;
+	}
+}
+
+TEST_F(RefineTest, ddgesv_refine) {
+	for (size_t n = 1; n <= 64; n++) {
+		const size_t lda = leadingDimension(n);
+		const std::vector<double> a = randomMatrix(n);
+		const std::vector<double> b = randomVector(n);
+		std::vector<double> lu = a;
+		std::vector<doubledouble> x(n);
+		std::vector<size_t> pivots(n);
+		ASSERT_TRUE(dgetrf(n, lu.data(), lda, pivots.data()));
+		std::vector<double> work(4 * n);
+		const struct refinement_result result =
+			ddgesv_refine(n, a.data(), lda, lu.data(), lda, pivots.data(), b.data(), x.data(), 20, work.data());
+
+		EXPECT_TRUE(result.converged) << "n = " << n;
+		EXPECT_LE(normwiseResidual(n, a, lda, b, x), std::ldexp(1.0, -100)) << "n = " << n;
+	}
+}
+
+TEST_F(RefineTest, ddgesv_refine_zero) {
+	const size_t n = 16, lda = leadingDimension(n);
+	const std::vector<double> a = randomMatrix(n);
+	const std::vector<double> b(n, 0.0);
+	std::vector<double> lu = a;
+	std::vector<doubledouble> x(n, doubledouble { 1.0, 0.0 });
+	std::vector<size_t> pivots(n);
+	ASSERT_TRUE(dgetrf(n, lu.data(), lda, pivots.data()));
+	std::vector<double> work(4 * n);
+	const struct refinement_result result =
+		ddgesv_refine(n, a.data(), lda, lu.data(), lda, pivots.data(), b.data(), x.data(), 20, work.data());
+
+	/* The initial solution is exact, so the first correction is zero */
+	EXPECT_TRUE(result.converged);
+	EXPECT_EQ(result.iterations, size_t(1));
+	EXPECT_EQ(result.error_estimate, 0.0);
+	for (size_t i = 0; i < n; i++) {
+		EXPECT_EQ(x[i].hi, 0.0) << "i = " << i;
+		EXPECT_EQ(x[i].lo, 0.0) << "i = " << i;
+	}
+}
+
+TEST_F(RefineTest, singular) {
+	const size_t n = 8, lda = leadingDimension(n);
+	std::vector<double> a = randomMatrix(n);
+	/* Row 5 is a copy of row 2 */
+	for (size_t j = 0; j < n; j++) {
+		a[5 + j * lda] = a[2 + j * lda];
+	}
+	std::vector<size_t> pivots(n);
+	/* Elimination of a row with its exact copy leaves exact zeros */
+	EXPECT_FALSE(dgetrf(n, a.data(), lda, pivots.data()));
+	std::fill(a.begin(), a.end(), 0.0);
+	EXPECT_FALSE(dgetrf(n, a.data(), lda, pivots.data()));
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,168 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+
+#include <cmath>
+#include <cfloat>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <spmv/spmv.h>
+
+#include "common.h"
+
+class SpmvTest : public RandomTest {
+protected:
+	/* Random matrix with rows of 0 to max_row_length entries, including duplicates, and values of widely different magnitudes */
+	struct csr_matrix randomMatrix(size_t rows, size_t columns, size_t max_row_length) {
+		std::uniform_int_distribution<size_t> length_distribution(0, max_row_length);
+		std::uniform_int_distribution<uint32_t> column_distribution(0, columns - 1);
+		std::uniform_real_distribution<double> value_distribution(-1.0, 1.0);
+		std::uniform_int_distribution<int> exponent_distribution(-40, 40);
+		std::vector<uint32_t> row_indices, column_indices;
+		std::vector<double> values;
+		for (size_t row = 0; row < rows; row++) {
+			const size_t length = length_distribution(engine);
+			for (size_t i = 0; i < length; i++) {
+				row_indices.push_back(row);
+				column_indices.push_back(column_distribution(engine));
+				values.push_back(std::ldexp(value_distribution(engine), exponent_distribution(engine)));
+			}
+		}
+		struct csr_matrix matrix;
+		EXPECT_TRUE(csr_from_coordinates(rows, columns, values.size(),
+			row_indices.data(), column_indices.data(), values.data(), &matrix));
+		return matrix;
+	}
+
+	std::vector<double> randomVector(size_t n) {
+		std::uniform_real_distribution<double> value_distribution(-1.0, 1.0);
+		std::vector<double> x(n);
+		for (double& element : x) {
+			element = value_distribution(engine);
+		}
+		return x;
+	}
+
+	/*
+	 * Checks |y[i] - (A x)[i]| <= 2**-90 sum |A[i][j] x[j]| with (A x)[i] computed exactly with MPFR.
+	 * The bound of the compensated dot product is |s| u**2 + gamma(n)**2 sum |A[i][j] x[j]|, and rows in the tests are short.
+	 */
+	static void expectAccurate(const struct csr_matrix& matrix, const std::vector<double>& x, const std::vector<doubledouble>& y) {
+		ExactSum error;
+		for (size_t row = 0; row < matrix.rows; row++) {
+			error.reset();
+			error.subtract(y[row]);
+			double absolute_sum = 0.0;
+			for (size_t i = matrix.row_offsets[row]; i < matrix.row_offsets[row + 1]; i++) {
+				error.addProduct(matrix.values[i], x[matrix.column_indices[i]]);
+				absolute_sum += std::fabs(matrix.values[i] * x[matrix.column_indices[i]]);
+			}
+			EXPECT_LE(std::fabs(error.get()), std::ldexp(absolute_sum, -90)) << "row " << row;
+		}
+	}
+};
+
+TEST_F(SpmvTest, csr_from_coordinates) {
+	/* Unordered entries with a duplicate (1, 2) and an empty row 2 */
+	const std::vector<uint32_t> row_indices = { 3, 1, 0, 1, 1, 3 };
+	const std::vector<uint32_t> column_indices = { 0, 2, 1, 0, 2, 3 };
+	const std::vector<double> values = { 1.0, 2.0, 3.0, 4.0, 5.0, 6.0 };
+	struct csr_matrix matrix;
+	ASSERT_TRUE(csr_from_coordinates(4, 4, values.size(),
+		row_indices.data(), column_indices.data(), values.data(), &matrix));
+	ASSERT_EQ(5u, matrix.nonzeros);
+	const std::vector<size_t> row_offsets(matrix.row_offsets, matrix.row_offsets + matrix.rows + 1);
+	EXPECT_EQ(std::vector<size_t>({ 0, 1, 3, 3, 5 }), row_offsets);
+	const std::vector<uint32_t> columns(matrix.column_indices, matrix.column_indices + matrix.nonzeros);
+	EXPECT_EQ(std::vector<uint32_t>({ 1, 0, 2, 0, 3 }), columns);
+	const std::vector<double> merged_values(matrix.values, matrix.values + matrix.nonzeros);
+	EXPECT_EQ(std::vector<double>({ 3.0, 4.0, 7.0, 1.0, 6.0 }), merged_values);
+	csr_release(&matrix);
+}
+
+TEST_F(SpmvTest, csr_spmv) {
+	const size_t rows = 257, columns = 131;
+	struct csr_matrix matrix = randomMatrix(rows, columns, 40);
+	const std::vector<double> x = randomVector(columns);
+	std::vector<double> y(rows);
+	csr_spmv(&matrix, x.data(), y.data());
+	for (size_t row = 0; row < rows; row++) {
+		double sum = 0.0, absolute_sum = 0.0;
+		for (size_t i = matrix.row_offsets[row]; i < matrix.row_offsets[row + 1]; i++) {
+			sum += matrix.values[i] * x[matrix.column_indices[i]];
+			absolute_sum += std::fabs(matrix.values[i] * x[matrix.column_indices[i]]);
+		}
+		EXPECT_LE(std::fabs(y[row] - sum), 64 * DBL_EPSILON * absolute_sum) << "row " << row;
+	}
+	csr_release(&matrix);
+}
+
+TEST_F(SpmvTest, csr_spmv_compensated) {
+	const size_t rows = 257, columns = 131;
+	struct csr_matrix matrix = randomMatrix(rows, columns, 40);
+	const std::vector<double> x = randomVector(columns);
+	std::vector<doubledouble> y(rows);
+	csr_spmv_compensated(&matrix, x.data(), y.data());
+	expectAccurate(matrix, x, y);
+	csr_release(&matrix);
+}
+
+TEST_F(SpmvTest, sell_spmv_compensated) {
+	for (size_t rows = 1; rows <= 67; rows += 11) {
+		const size_t columns = 97;
+		struct csr_matrix csr = randomMatrix(rows, columns, 40);
+		const std::vector<double> x = randomVector(columns);
+		for (size_t sigma : { 4, 8, 32, 128 }) {
+			struct sell_matrix sell;
+			ASSERT_TRUE(sell_from_csr(&csr, sigma, &sell));
+			std::vector<doubledouble> y(rows, doubledouble { NAN, NAN });
+			sell_spmv_compensated(&sell, x.data(), y.data());
+			expectAccurate(csr, x, y);
+			sell_release(&sell);
+		}
+		csr_release(&csr);
+	}
+}
+
+TEST_F(SpmvTest, csr_load_matrix_market) {
+	char path[] = "/tmp/spmv-test-XXXXXX";
+	const int fd = mkstemp(path);
+	ASSERT_NE(-1, fd);
+	FILE* file = fdopen(fd, "w");
+	ASSERT_NE(nullptr, file);
+	fputs(
+		"%%MatrixMarket matrix coordinate real symmetric\n"
+		"% 3x3 symmetric matrix, lower triangle\n"
+		"3 3 4\n"
+		"1 1 2.0\n"
+		"2 1 -1.0\n"
+		"3 2 -1.5\n"
+		"3 3 0.5\n", file);
+	fclose(file);
+
+	struct csr_matrix matrix;
+	const bool loaded = csr_load_matrix_market(path, &matrix);
+	unlink(path);
+	ASSERT_TRUE(loaded);
+	ASSERT_EQ(3u, matrix.rows);
+	ASSERT_EQ(3u, matrix.columns);
+	ASSERT_EQ(6u, matrix.nonzeros);
+	const std::vector<double> x = { 1.0, 2.0, 3.0 };
+	std::vector<double> y(3);
+	csr_spmv(&matrix, x.data(), y.data());
+	EXPECT_EQ(0.0, y[0]);
+	EXPECT_EQ(-1.0 - 4.5, y[1]);
+	EXPECT_EQ(-3.0 + 1.5, y[2]);
+	csr_release(&matrix);
+}
+
+int main(int ac, char* av[]) {
+	testing::InitGoogleTest(&ac, av);
+	return RUN_ALL_TESTS();
+}